@@ -19,6 +19,7 @@
 #include "pgmodelercliapp.h"
 #include "utilsns.h"
 #include "settings/appearanceconfigwidget.h"
+#include <set>
 
 QTextStream PgModelerCliApp::out(stdout);
 
@@ -54,11 +55,15 @@ const QString PgModelerCliApp::User("--user");
 const QString PgModelerCliApp::Passwd("--passwd");
 const QString PgModelerCliApp::InitialDb("--initial-db");
 const QString PgModelerCliApp::Silent("--silent");
+const QString PgModelerCliApp::Timings("--timings");
+const QString PgModelerCliApp::MemoryReport("--memory-report");
+const QString PgModelerCliApp::CaptureAttribs("--capture-attribs");
 const QString PgModelerCliApp::ListConns("--list-conns");
 const QString PgModelerCliApp::Simulate("--simulate");
 const QString PgModelerCliApp::FixModel("--fix-model");
 const QString PgModelerCliApp::FixTries("--fix-tries");
 const QString PgModelerCliApp::ZoomFactor("--zoom");
+const QString PgModelerCliApp::TileSize("--tile-size");
 const QString PgModelerCliApp::UseTmpNames("--use-tmp-names");
 const QString PgModelerCliApp::DbmMimeType("--dbm-mime-type");
 const QString PgModelerCliApp::Install("install");
@@ -108,7 +113,7 @@ attribs_map PgModelerCliApp::short_opts = {
 	{ ShowDelimiters, "-sl" },	{ PageByPage, "-pp" },	{ IgnoreDuplicates, "-ir" },
 	{ IgnoreErrorCodes, "-ic" },	{ ConnAlias, "-ca" },	{ Host, "-H" },
 	{ Port, "-p" },	{ User, "-u" },	{ Passwd, "-w" },
-	{ InitialDb, "-D" },	{ Silent, "-s" },	{ ListConns, "-lc" },
+	{ InitialDb, "-D" },	{ Silent, "-s" },	{ Timings, "-tm" },	{ MemoryReport, "-mr" },	{ CaptureAttribs, "-cb" },	{ ListConns, "-lc" },
 	{ Simulate, "-sm" },	{ FixModel, "-fm" },	{ FixTries, "-ft" },
 	{ ZoomFactor, "-zf" },	{ UseTmpNames, "-tn" },	{ DbmMimeType, "-mt" },
 	{ IgnoreImportErrors, "-ie" },	{ ImportSystemObjs, "-is" },	{ ImportExtensionObjs, "-ix" },
@@ -120,7 +125,8 @@ attribs_map PgModelerCliApp::short_opts = {
 	{ ForceDropColsConstrs, "-fd" },	{ RenameDb, "-rn" },
 	{ NoSequenceReuse, "-ns" },	{ NoCascadeDrop, "-nd" },	{ ForceRecreateObjs, "-nf" },
 	{ OnlyUnmodifiable, "-nu" },	{ NoIndex, "-ni" },	{ Split, "-sp" },
-	{ SystemWide, "-sw" },	{ CreateConfigs, "-cc" }, { Force, "-ff" }, { MissingOnly, "-mo" }
+	{ SystemWide, "-sw" },	{ CreateConfigs, "-cc" }, { Force, "-ff" }, { MissingOnly, "-mo" },
+	{ TileSize, "-ts" }
 };
 
 std::map<QString, bool> PgModelerCliApp::long_opts = {
@@ -144,13 +150,14 @@ std::map<QString, bool> PgModelerCliApp::long_opts = {
 	{ NoSequenceReuse, false },	{ NoCascadeDrop, false },
 	{ ForceRecreateObjs, false },	{ OnlyUnmodifiable, false },	{ ExportToDict, false },
 	{ NoIndex, false },	{ Split, false },	{ SystemWide, false },
-	{ CreateConfigs, false }, { Force, false }, { MissingOnly, false }
+	{ CreateConfigs, false }, { Force, false }, { MissingOnly, false },
+	{ TileSize, true },	{ Timings, false },	{ MemoryReport, false },	{ CaptureAttribs, true }
 };
 
 std::map<QString, QStringList> PgModelerCliApp::accepted_opts = {
 	{{ Attributes::Connection }, { ConnAlias, Host, Port, User, Passwd, InitialDb }},
 	{{ ExportToFile }, { Input, Output, PgSqlVer, Split }},
-	{{ ExportToPng },  { Input, Output, ShowGrid, ShowDelimiters, PageByPage, ZoomFactor }},
+	{{ ExportToPng },  { Input, Output, ShowGrid, ShowDelimiters, PageByPage, ZoomFactor, TileSize }},
 	{{ ExportToSvg },  { Input, Output, ShowGrid, ShowDelimiters }},
 	{{ ExportToDict }, { Input, Output, Split, NoIndex }},
 
@@ -185,6 +192,7 @@ PgModelerCliApp::PgModelerCliApp(int argc, char **argv) : Application(argc, argv
 		scene=nullptr;
 		xmlparser=nullptr;
 		zoom=1;
+		tile_size=0;
 
 		export_hlp = nullptr;
 		import_hlp = nullptr;
@@ -240,6 +248,11 @@ PgModelerCliApp::PgModelerCliApp(int argc, char **argv) : Application(argc, argv
 			xmlparser=model->getXMLParser();
 			silent_mode=(parsed_opts.count(Silent));
 
+			/* Capturing the attributes used to generate the code of the objects so they can be used
+			 * to profile the schema files in the schema editor */
+			if(parsed_opts.count(CaptureAttribs))
+				SchemaParser::setAttributesCaptureFile(parsed_opts[CaptureAttribs]);
+
 			//If the export is to png or svg loads additional configurations
 			if(parsed_opts.count(ExportToPng) || parsed_opts.count(ExportToSvg) || parsed_opts.count(ImportDb))
 			{
@@ -276,10 +289,10 @@ PgModelerCliApp::PgModelerCliApp(int argc, char **argv) : Application(argc, argv
 
 			if(!silent_mode && export_hlp && import_hlp && diff_hlp)
 			{
-				connect(export_hlp, SIGNAL(s_progressUpdated(int,QString)), this, SLOT(updateProgress(int,QString)));
+				connect(export_hlp, SIGNAL(s_progressUpdated(int,QString,ObjectType,QString)), this, SLOT(updateProgress(int,QString,ObjectType,QString)));
 				connect(export_hlp, SIGNAL(s_errorIgnored(QString,QString,QString)), this, SLOT(printIgnoredError(QString,QString,QString)));
-				connect(import_hlp, SIGNAL(s_progressUpdated(int,QString,ObjectType)), this, SLOT(updateProgress(int,QString)));
-				connect(diff_hlp, SIGNAL(s_progressUpdated(int,QString,ObjectType)), this, SLOT(updateProgress(int,QString)));
+				connect(import_hlp, SIGNAL(s_progressUpdated(int,QString,ObjectType)), this, SLOT(updateProgress(int,QString,ObjectType)));
+				connect(diff_hlp, SIGNAL(s_progressUpdated(int,QString,ObjectType)), this, SLOT(updateProgress(int,QString,ObjectType)));
 			}
 		}
 	}
@@ -326,6 +339,138 @@ void PgModelerCliApp::printMessage(const QString &txt)
 		printText(txt);
 }
 
+void PgModelerCliApp::storeTimings(const QString &source, ProgressReporter &reporter)
+{
+	for(auto &phase : reporter.getPhaseTimings())
+		timings.push_back({ source, phase });
+}
+
+void PgModelerCliApp::printTimings()
+{
+	/* The import helper timings are stored right after each import (since the diff runs
+	 * it twice) while the timings of the other helpers are collected only at the end */
+	if(model)
+		storeTimings(tr("model"), model->getProgressReporter());
+
+	if(diff_hlp)
+		storeTimings(tr("diff"), diff_hlp->getProgressReporter());
+
+	if(export_hlp)
+		storeTimings(tr("export"), export_hlp->getProgressReporter());
+
+	printText();
+	printText(tr("Timings breakdown:"));
+
+	if(timings.empty())
+		printText(tr("  No timed phases were executed."));
+
+	for(auto &itr : timings)
+	{
+		printText(QString("  [%1] %2%3: %4 ms%5")
+							.arg(itr.first)
+							.arg(QString("  ").repeated(itr.second.depth))
+							.arg(itr.second.name)
+							.arg(itr.second.elapsed)
+							.arg(itr.second.items > 0 ? tr(" (%1 items)").arg(itr.second.items) : ""));
+	}
+
+	printText();
+}
+
+size_t PgModelerCliApp::getObjectInstanceSize(BaseObject *object)
+{
+	static const std::map<ObjectType, size_t> sizes = {
+		{ ObjectType::Column, sizeof(Column) }, { ObjectType::Constraint, sizeof(Constraint) },
+		{ ObjectType::Function, sizeof(Function) }, { ObjectType::Trigger, sizeof(Trigger) },
+		{ ObjectType::Index, sizeof(Index) }, { ObjectType::Rule, sizeof(Rule) },
+		{ ObjectType::Table, sizeof(Table) }, { ObjectType::View, sizeof(View) },
+		{ ObjectType::Domain, sizeof(Domain) }, { ObjectType::Schema, sizeof(Schema) },
+		{ ObjectType::Aggregate, sizeof(Aggregate) }, { ObjectType::Operator, sizeof(Operator) },
+		{ ObjectType::Sequence, sizeof(Sequence) }, { ObjectType::Role, sizeof(Role) },
+		{ ObjectType::Conversion, sizeof(Conversion) }, { ObjectType::Cast, sizeof(Cast) },
+		{ ObjectType::Language, sizeof(Language) }, { ObjectType::Type, sizeof(Type) },
+		{ ObjectType::Tablespace, sizeof(Tablespace) }, { ObjectType::OpFamily, sizeof(OperatorFamily) },
+		{ ObjectType::OpClass, sizeof(OperatorClass) }, { ObjectType::Database, sizeof(DatabaseModel) },
+		{ ObjectType::Collation, sizeof(Collation) }, { ObjectType::Extension, sizeof(Extension) },
+		{ ObjectType::EventTrigger, sizeof(EventTrigger) }, { ObjectType::Policy, sizeof(Policy) },
+		{ ObjectType::ForeignDataWrapper, sizeof(ForeignDataWrapper) }, { ObjectType::ForeignServer, sizeof(ForeignServer) },
+		{ ObjectType::ForeignTable, sizeof(ForeignTable) }, { ObjectType::UserMapping, sizeof(UserMapping) },
+		{ ObjectType::Transform, sizeof(Transform) }, { ObjectType::Procedure, sizeof(Procedure) },
+		{ ObjectType::Relationship, sizeof(Relationship) }, { ObjectType::Textbox, sizeof(Textbox) },
+		{ ObjectType::Permission, sizeof(Permission) }, { ObjectType::Tag, sizeof(Tag) },
+		{ ObjectType::GenericSql, sizeof(GenericSQL) }, { ObjectType::BaseRelationship, sizeof(BaseRelationship) }
+	};
+
+	if(!object || sizes.count(object->getObjectType()) == 0)
+		return sizeof(BaseObject);
+
+	return sizes.at(object->getObjectType());
+}
+
+void PgModelerCliApp::printMemoryReport()
+{
+	std::map<ObjectType, std::pair<unsigned, size_t>> usage;
+	std::vector<BaseObject *> objects, *obj_list = nullptr;
+	BaseTable *table = nullptr;
+	size_t total = 0;
+	unsigned count = 0;
+
+	printText();
+	printText(tr("Memory usage report (estimate):"));
+
+	if(!model)
+	{
+		printText(tr("  No model was loaded by the operation."));
+		printText();
+		return;
+	}
+
+	objects.push_back(model);
+
+	for(auto &type : BaseObject::getObjectTypes(false, { ObjectType::Database }))
+	{
+		obj_list = model->getObjectList(type);
+
+		if(!obj_list)
+			continue;
+
+		for(auto &obj : *obj_list)
+		{
+			objects.push_back(obj);
+			table = dynamic_cast<BaseTable *>(obj);
+
+			// Table children (columns, constraints, etc) aren't stored in the model's lists
+			if(table)
+			{
+				for(auto &child : table->getObjects())
+					objects.push_back(child);
+			}
+		}
+	}
+
+	for(auto &obj : objects)
+	{
+		auto &type_usage = usage[obj->getObjectType()];
+		type_usage.first++;
+		type_usage.second += getObjectInstanceSize(obj) + obj->getMemoryUsage();
+	}
+
+	for(auto &itr : usage)
+	{
+		printText(QString("  %1: %2 %3, %4 KB")
+							.arg(BaseObject::getTypeName(itr.first))
+							.arg(itr.second.first)
+							.arg(tr("object(s)"))
+							.arg(QString::number(itr.second.second / 1024.0, 'f', 1)));
+
+		count += itr.second.first;
+		total += itr.second.second;
+	}
+
+	printText(tr("  Total: %1 object(s), %2 MB").arg(count).arg(QString::number(total / (1024.0 * 1024.0), 'f', 2)));
+	printText();
+}
+
 void PgModelerCliApp::configureConnection(bool extra_conn)
 {
 	QString chr = (extra_conn ? "1" : "");
@@ -418,6 +563,9 @@ void PgModelerCliApp::showMenu()
 	printText(tr("  %1, %2 [FILE|DIRECTORY]    Output file or directory. This is mandatory for fixing model or exporting to file, png or svg.").arg(short_opts[Output]).arg(Output));
 	printText(tr("  %1, %2\t\t    Force the PostgreSQL syntax to the specified version when generating SQL code. The version string must be in form major.minor.").arg(short_opts[PgSqlVer]).arg(PgSqlVer));
 	printText(tr("  %1, %2\t\t\t    Silent execution. Only critical messages and errors are shown during process.").arg(short_opts[Silent]).arg(Silent));
+	printText(tr("  %1, %2\t\t    Prints the time spent in each phase of the operation (loading, code generation, import, etc) when it finishes.").arg(short_opts[Timings]).arg(Timings));
+	printText(tr("  %1, %2\t    Prints an estimate of the memory used by the objects of the model, by object type, when the operation finishes.").arg(short_opts[MemoryReport]).arg(MemoryReport));
+	printText(tr("  %1, %2 [FILE]\t    Appends to the file the attributes used to generate the code of each object (one JSON object per line). The file can be used to profile schema files in the schema editor.").arg(short_opts[CaptureAttribs]).arg(CaptureAttribs));
 	printText();
 
 	printText(tr("SQL file export options: "));
@@ -429,6 +577,7 @@ void PgModelerCliApp::showMenu()
 	printText(tr("  %1, %2\t    Draws the page delimiters in the exported image.").arg(short_opts[ShowDelimiters]).arg(ShowDelimiters));
 	printText(tr("  %1, %2\t\t    Each page will be exported in a separated png image. (Only for PNG images)").arg(short_opts[PageByPage]).arg(PageByPage));
 	printText(tr("  %1, %2 [FACTOR]\t\t    Applies a zoom (in percent) before export to png image. Accepted zoom interval: %3-%4 (Only for PNG images)").arg(short_opts[ZoomFactor]).arg(ZoomFactor).arg(ModelWidget::MinimumZoom*100).arg(ModelWidget::MaximumZoom*100));
+	printText(tr("  %1, %2 [SIZE]\t\t    Renders the png image in tiles of SIZE x SIZE pixels (minimum: %3) saving each tile in a separated file. Useful for huge models. (Only for PNG images)").arg(short_opts[TileSize]).arg(TileSize).arg(ModelExportHelper::MinimumTileSize));
 	printText();
 
 	printText(tr("Data dictionary export options: "));
@@ -555,6 +704,7 @@ void PgModelerCliApp::showMenu()
 	printText();
 	printText(tr("** The partial diff operation will always force the options %1 and %2 = %3 for more reliable results.").arg(OnlyMatching).arg(ForceChildren).arg(AllChildren));
 	printText(tr("   * The options %1 and %2 accepts the ISO8601 date/time format: yyyy-MM-dd hh:mm:ss").arg(StartDate).arg(EndDate));
+	printText(tr("   * When filtering by date, only the objects in the changelog and their dependencies are retrieved from the database being compared."));
 	printText();
 	printText(tr("** When running the diff using two databases (%1 and %2) there's the option to specify two separated connections/aliases.").arg(InputDb).arg(CompareTo));
 	printText(tr("   If only one connection is set then it will be used to import the input database as well to retrieve the database used in the comparison."));
@@ -651,6 +801,18 @@ void PgModelerCliApp::parseOptions(attribs_map &opts)
 		if(opts.count(ZoomFactor))
 			zoom=opts[ZoomFactor].toDouble()/static_cast<double>(100);
 
+		if(opts.count(TileSize))
+		{
+			bool is_num = false;
+			int size = opts[TileSize].toInt(&is_num);
+
+			if(!is_num || size < static_cast<int>(ModelExportHelper::MinimumTileSize))
+				throw Exception(tr("Invalid tile size specified! The minimum accepted size is %1 pixels.").arg(ModelExportHelper::MinimumTileSize),
+												ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+			tile_size = static_cast<unsigned>(size);
+		}
+
 		if(other_modes_cnt==0 && exp_mode_cnt==0)
 			throw Exception(tr("No operation mode was specified!"), ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 		
@@ -785,7 +947,8 @@ void PgModelerCliApp::parseOptions(attribs_map &opts)
 		{
 			long_opt = itr.first;
 
-			if(long_opt == curr_op_mode || long_opt == Silent)
+			if(long_opt == curr_op_mode || long_opt == Silent || long_opt == Timings ||
+				 long_opt == MemoryReport || long_opt == CaptureAttribs)
 				continue;
 
 			/* Before validate the option we need to remove any appended number to the option name
@@ -823,6 +986,12 @@ int PgModelerCliApp::exec()
 				diffModelDatabase();
 			else
 				exportModel();
+
+			if(parsed_opts.count(Timings))
+				printTimings();
+
+			if(parsed_opts.count(MemoryReport))
+				printMemoryReport();
 		}
 
 		return 0;
@@ -833,8 +1002,12 @@ int PgModelerCliApp::exec()
 	}
 }
 
-void PgModelerCliApp::updateProgress(int progress, QString msg, ObjectType)
+void PgModelerCliApp::updateProgress(int progress, QString msg, ObjectType obj_type, QString cmd)
 {
+	// The messages about each object or command are printed at a limited rate, the other ones are always printed
+	if((obj_type != ObjectType::BaseObject || !cmd.isEmpty()) && !output_rep.isReportDue(progress))
+		return;
+
 	if(progress > 0)
 		printMessage(QString("[%1%] ").arg(progress > 100 ? 100 : progress) + msg);
 	else
@@ -1714,7 +1887,8 @@ void PgModelerCliApp::exportModel()
 		export_hlp->exportToPNG(scene, parsed_opts[Output], zoom,
 								 parsed_opts.count(ShowGrid) > 0,
 								 parsed_opts.count(ShowDelimiters) > 0,
-								 parsed_opts.count(PageByPage) > 0);
+								 parsed_opts.count(PageByPage) > 0,
+								 nullptr, tile_size);
 	}
 	//Export to SVG
 	else if(parsed_opts.count(ExportToSvg))
@@ -1832,6 +2006,9 @@ void PgModelerCliApp::importDatabase(DatabaseModel *model, Connection conn)
 		import_hlp->setSelectedOIDs(model, obj_oids, col_oids);
 		import_hlp->importDatabase();
 		import_hlp->closeConnection();
+
+		if(parsed_opts.count(Timings))
+			storeTimings(tr("import"), import_hlp->getProgressReporter());
 	}
 	catch(Exception &e)
 	{
@@ -1866,9 +2043,36 @@ void PgModelerCliApp::diffModelDatabase()
 
 			// Filtering by modification date always forces the signature matching
 			if(start_date.isValid() || end_date.isValid())
-				obj_filters.append(model->getFiltersFromChangelog(start_date, end_date));
+			{
+				QStringList missing_filters;
+
+				/* The changelog entries are mapped directly to the model objects and the target database
+				 * is filtered by the exact signatures of them and their dependencies. Since the filters
+				 * cover all the needed objects the only-matching option is disabled, avoiding the listing
+				 * of all the other object types in the target database */
+				filtered_objs = model->getObjectsFromChangelog(start_date, end_date, &missing_filters);
+
+				/* The objects matched by the filters provided by the user are diffed too,
+				 * so they are merged (without duplicates) to the ones retrieved from the changelog */
+				if(!obj_filters.isEmpty())
+				{
+					std::set<BaseObject *> changelog_objs(filtered_objs.begin(), filtered_objs.end());
 
-			filtered_objs = model->findObjects(obj_filters, search_attr);
+					for(auto &obj : model->findObjects(obj_filters, search_attr))
+					{
+						if(changelog_objs.insert(obj).second)
+							filtered_objs.push_back(obj);
+					}
+				}
+
+				obj_filters.append(missing_filters);
+				parsed_opts.erase(OnlyMatching);
+
+				if(!filtered_objs.empty())
+					obj_filters.append(getChangelogFilters(filtered_objs));
+			}
+			else
+				filtered_objs = model->findObjects(obj_filters, search_attr);
 
 			/* We need to finish the diff if no object was found based on the filters
 			 * this will avoid the diff between an empty database model and a full database model
@@ -1893,8 +2097,9 @@ void PgModelerCliApp::diffModelDatabase()
 				 * and in the set of filtered model objects we have one or more many-to-many, inheritance or partitioning
 				 * relationships we need to inject filters to force the retrieval of the all involved tables in those relationships
 				 * from the destination database,this way we avoid the diff try to create everytime all tables
-				 * in the those relationships. */
-				obj_filters.append(ModelsDiffHelper::getRelationshipFilters(filtered_objs, search_attr == Attributes::Signature));
+				 * in the those relationships. When filtering by the changelog these tables are already in the filters */
+				if(!start_date.isValid() && !end_date.isValid())
+					obj_filters.append(ModelsDiffHelper::getRelationshipFilters(filtered_objs, search_attr == Attributes::Signature));
 			}
 		}
 	}
@@ -2010,6 +2215,70 @@ void PgModelerCliApp::diffModelDatabase()
 	printMessage(tr("Diff successfully ended!\n"));
 }
 
+QStringList PgModelerCliApp::getChangelogFilters(const std::vector<BaseObject *> &objects)
+{
+	std::vector<BaseObject *> deps;
+	std::vector<ObjectType> filter_types = Catalog::getFilterableObjectTypes();
+	QStringList filters;
+	QString signature;
+	TableObject *tab_obj = nullptr;
+
+	// Escapes the regexp meta characters in the signatures so the catalog matches them exactly
+	auto escape_sig = [](const QString &sig) {
+		static const QString meta_chars("\\.^$|?*+()[]{}");
+		QString esc_sig;
+
+		for(auto &chr : sig)
+		{
+			if(meta_chars.contains(chr))
+				esc_sig += QChar('\\');
+
+			esc_sig += chr;
+		}
+
+		return esc_sig;
+	};
+
+	for(auto &obj : objects)
+	{
+		tab_obj = dynamic_cast<TableObject *>(obj);
+
+		if(tab_obj && tab_obj->getParentTable())
+			model->getObjectDependecies(tab_obj->getParentTable(), deps, true);
+
+		model->getObjectDependecies(obj, deps, true);
+	}
+
+	for(auto &tab : ModelsDiffHelper::getRelationshipTables(objects))
+		model->getObjectDependecies(tab, deps, true);
+
+	for(auto &obj : deps)
+	{
+		if(obj->isSystemObject() ||
+			 std::find(filter_types.begin(), filter_types.end(), obj->getObjectType()) == filter_types.end())
+			continue;
+
+		tab_obj = dynamic_cast<TableObject *>(obj);
+
+		// Table children objects are matched using the parent's signature followed by their names
+		if(tab_obj && !tab_obj->getParentTable())
+			continue;
+		else if(tab_obj)
+			signature = tab_obj->getParentTable()->getSignature() + "." + obj->getName();
+		else
+			signature = obj->getSignature();
+
+		filters.append(BaseObject::getSchemaName(obj->getObjectType()) +
+									 UtilsNs::FilterSeparator +
+									 QString("^%1$").arg(escape_sig(signature.remove('"'))) +
+									 UtilsNs::FilterSeparator +
+									 UtilsNs::FilterRegExp);
+	}
+
+	filters.removeDuplicates();
+	return filters;
+}
+
 void PgModelerCliApp::updateMimeType()
 {
 #ifndef Q_OS_MAC
@@ -108,6 +108,9 @@ class PgModelerCliApp: public Application {
 		//! \brief Zoom to be applied onto the png export
 		double zoom;
 
+		//! \brief Size of the tiles in which the png export is split (0 means a single image)
+		unsigned tile_size;
+
 		//! \brief Start date used for filter changelog of the input database model (partial diff)
 		QDateTime start_date,
 
@@ -121,6 +124,14 @@ class PgModelerCliApp: public Application {
 		//! \brief Stores the changelog of the model that is being fixed to reproduce it in the output model
 		QString changelog;
 
+		/*! \brief Stores the phases timings collected from the model and helpers (see --timings option).
+		 * Each item holds the source of the timings (model, import, diff or export) and the phase itself */
+		std::vector<std::pair<QString, ProgressReporter::PhaseTiming>> timings;
+
+		/*! \brief Limits the rate in which the messages about each object or command are printed.
+		 * The helpers emit all of them since the GUI forms log each one */
+		ProgressReporter output_rep;
+
 		static const QRegularExpression PasswordRegExp;
 		static const QString PasswordPlaceholder;
 
@@ -151,11 +162,15 @@ class PgModelerCliApp: public Application {
 		Passwd,
 		InitialDb,
 		Silent,
+		Timings,
+		MemoryReport,
+		CaptureAttribs,
 		ListConns,
 		Simulate,
 		FixModel,
 		FixTries,
 		ZoomFactor,
+		TileSize,
 		UseTmpNames,
 		DbmMimeType,
 		Install,
@@ -247,6 +262,10 @@ class PgModelerCliApp: public Application {
 		void exportModel();
 		void importDatabase();
 		void diffModelDatabase();
+
+		/*! \brief Returns the filters that retrieve from the database being compared exactly the provided objects
+		 * (retrieved from the model's changelog) and their dependencies, including the tables involved in the relationships */
+		QStringList getChangelogFilters(const std::vector<BaseObject *> &objects);
 		void updateMimeType();
 		void configureConnection(bool extra_conn);
 		void importDatabase(DatabaseModel *model, Connection conn);
@@ -258,6 +277,19 @@ class PgModelerCliApp: public Application {
 		//! \brief Prints to the stdout only if the silent mode is not active
 		void printMessage(const QString &txt = "");
 
+		//! \brief Copies the phases timings of the provided reporter to the list of timings identifying them with the source name
+		void storeTimings(const QString &source, ProgressReporter &reporter);
+
+		//! \brief Prints the breakdown of the time spent in each phase of the executed operation
+		void printTimings();
+
+		//! \brief Returns the size of the instance of the provided object according to its type
+		static size_t getObjectInstanceSize(BaseObject *object);
+
+		/*! \brief Prints an estimate of the memory used by the objects of the loaded model broken down by object type.
+		 * The estimate considers the size of the instances plus the data they allocate (names, cached code, attributes, etc) */
+		void printMemoryReport();
+
 		void handleLinuxMimeDatabase(bool uninstall, bool system_wide, bool force);
 		void handleWindowsMimeDatabase(bool uninstall, bool system_wide, bool force);
 		void createConfigurations();
@@ -270,7 +302,7 @@ class PgModelerCliApp: public Application {
 
 	private slots:
 		void handleObjectAddition(BaseObject *);
-		void updateProgress(int progress, QString msg, ObjectType = ObjectType::BaseObject);
+		void updateProgress(int progress, QString msg, ObjectType obj_type = ObjectType::BaseObject, QString cmd = "");
 		void printIgnoredError(QString err_cod, QString err_msg, QString cmd);
 		void handleObjectRemoval(BaseObject *object);
 };
@@ -2,6 +2,8 @@
 #include "messagebox.h"
 #include "guiutilsns.h"
 #include "utilsns.h"
+#include <QFileDialog>
+#include <QInputDialog>
 
 QPalette SourceEditorWidget::def_editor_pal;
 
@@ -55,13 +57,19 @@ SourceEditorWidget::SourceEditorWidget(QWidget *parent) : QWidget(parent)
 	act_break_inline_ifs->setCheckable(true);
 	act_break_inline_ifs->setChecked(false);
 
+	// Profiling is only possible for schema files since the captured attributes are searched by the file name
+	profile_tb->setEnabled(false);
+
 	connect(code_compl_wgt, SIGNAL(s_wordSelected(QString)), this, SLOT(handleSelectedSnippet(QString)));
 	connect(find_wgt, SIGNAL(s_hideRequested()), find_tb, SLOT(toggle()));
 	connect(validate_tb, SIGNAL(clicked(bool)), this, SLOT(validateSyntax()));
+	connect(profile_tb, SIGNAL(clicked(bool)), this, SLOT(profileTemplate()));
 	connect(indent_tb, SIGNAL(clicked(bool)), this, SLOT(	applyIndentation()));
 	connect(editor_txt, SIGNAL(modificationChanged(bool)), this, SLOT(restoreEditorPalette()));
 	connect(editor_txt, SIGNAL(undoAvailable(bool)), this, SLOT(setModified(bool)));
 	connect(editor_txt, SIGNAL(cursorPositionChanged()), this, SLOT(restoreEditorPalette()));
+	connect(editor_txt, SIGNAL(cursorPositionChanged()), this, SLOT(highlightHotLines()));
+	connect(editor_txt->document(), SIGNAL(undoCommandAdded()), this, SLOT(clearHotLines()));
 	connect(find_tb, SIGNAL(toggled(bool)), find_parent, SLOT(setVisible(bool)));
 }
 
@@ -71,6 +79,7 @@ void SourceEditorWidget::saveFile(const QString &filename)
 
 	QFileInfo fi(filename);
 	validate_tb->setEnabled(filename.endsWith(GlobalAttributes::SchemaExt));
+	profile_tb->setEnabled(filename.endsWith(GlobalAttributes::SchemaExt));
 	indent_tb->setEnabled(filename.endsWith(GlobalAttributes::SchemaExt));
 	this->filename = filename;
 	source_file_sel->setSelectedFile(filename);
@@ -111,8 +120,10 @@ void SourceEditorWidget::loadFile(const QString &filename)
 
 	bool enable = filename.endsWith(GlobalAttributes::SchemaExt);
 
+	clearHotLines();
 	editor_txt->setPlainText(UtilsNs::loadFile(filename));
 	validate_tb->setEnabled(enable);
+	profile_tb->setEnabled(enable);
 	indent_tb->setEnabled(enable);
 	code_compl_wgt->setEnabled(enable);
 	this->filename = filename;
@@ -165,6 +176,157 @@ void SourceEditorWidget::validateSyntax()
 	}
 }
 
+void SourceEditorWidget::profileTemplate()
+{
+	QFileDialog file_dlg;
+	QFileInfo fi(filename);
+	QString capture_file, schema, report, row_fmt;
+	std::vector<attribs_map> attr_sets;
+	std::vector<std::pair<int, SchemaParser::LineProfile>> hot_lines;
+	SchemaParser schparser;
+	Messagebox msgbox;
+	QElapsedTimer timer;
+	qint64 total_time = 0, lines_time = 0;
+	int iterations = 0;
+	bool ok = false;
+
+	file_dlg.setNameFilters({ tr("Captured attributes file (*.jsonl)"), tr("All files (*.*)") });
+	file_dlg.setWindowTitle(tr("Load captured attributes"));
+	file_dlg.setFileMode(QFileDialog::ExistingFile);
+	file_dlg.setAcceptMode(QFileDialog::AcceptOpen);
+	GuiUtilsNs::restoreFileDialogState(&file_dlg);
+
+	if(file_dlg.exec() == QFileDialog::Accepted)
+		capture_file = file_dlg.selectedFiles().at(0);
+
+	GuiUtilsNs::saveFileDialogState(&file_dlg);
+
+	if(capture_file.isEmpty())
+		return;
+
+	iterations = QInputDialog::getInt(this, tr("Profile schema file"), tr("Renderings per attribute set:"),
+																		DefProfileIterations, 1, 1000000, 1, &ok);
+
+	if(!ok)
+		return;
+
+	try
+	{
+		/* The sets are searched using the schema file and its parent directory (e.g. sql/table.sch).
+		 * If nothing is found (e.g. the file is a copy outside the schemas tree) only the file name is used */
+		schema = fi.dir().dirName() + "/" + fi.fileName();
+		attr_sets = SchemaParser::loadCapturedAttributes(capture_file, schema);
+
+		if(attr_sets.empty())
+			attr_sets = SchemaParser::loadCapturedAttributes(capture_file, fi.fileName());
+
+		if(attr_sets.empty())
+		{
+			msgbox.show(tr("There are no attribute sets captured for the schema file <strong>%1</strong> in <strong>%2</strong>!")
+									.arg(schema, capture_file), Messagebox::AlertIcon);
+			return;
+		}
+
+		clearHotLines();
+		editor_txt->setPalette(def_editor_pal);
+		QApplication::setOverrideCursor(Qt::WaitCursor);
+
+		schparser.setProfilingEnabled(true);
+		timer.start();
+
+		for(int iter = 0; iter < iterations; iter++)
+		{
+			for(auto &attribs : attr_sets)
+			{
+				// The parser resets its buffer and options after each rendering so they need to be configured again
+				schparser.ignoreEmptyAttributes(true);
+				schparser.ignoreUnkownAttributes(true);
+				schparser.loadBuffer(editor_txt->toPlainText());
+				schparser.getCodeDefinition(attribs);
+			}
+		}
+
+		total_time = timer.nsecsElapsed();
+		QApplication::restoreOverrideCursor();
+	}
+	catch(Exception &e)
+	{
+		QApplication::restoreOverrideCursor();
+		msgbox.show(e);
+		return;
+	}
+
+	for(auto &itr : schparser.getProfile())
+	{
+		lines_time += itr.second.elapsed;
+		hot_lines.push_back(itr);
+	}
+
+	std::sort(hot_lines.begin(), hot_lines.end(),
+						[](const std::pair<int, SchemaParser::LineProfile> &prof_a, const std::pair<int, SchemaParser::LineProfile> &prof_b) {
+		return prof_a.second.elapsed > prof_b.second.elapsed;
+	});
+
+	if(hot_lines.size() > static_cast<unsigned>(MaxReportedLines))
+		hot_lines.resize(MaxReportedLines);
+
+	report = tr("Rendered <strong>%1</strong> attribute set(s) <strong>%2</strong> time(s) in <strong>%3 ms</strong> (%4 ms spent in code generation, the remaining in buffer loading).")
+					 .arg(attr_sets.size()).arg(iterations).arg(total_time / 1000000.0, 0, 'f', 2).arg(lines_time / 1000000.0, 0, 'f', 2);
+
+	report += QString("<br/><br/><table cellpadding='3'><tr><th>%1</th><th>%2</th><th>%3</th><th>%4</th><th>%5</th><th>%6</th><th>%7</th><th>%8</th></tr>")
+						.arg(tr("Line"), tr("Time (ms)"), tr("Time (%)"), tr("Hits"), "%if", "%set", tr("Attributes"), tr("Allocations"));
+
+	row_fmt = "<tr><td>%1</td><td align='right'>%2</td><td align='right'>%3</td><td align='right'>%4</td><td align='right'>%5</td><td align='right'>%6</td><td align='right'>%7</td><td align='right'>%8</td></tr>";
+
+	for(auto &[line, prof] : hot_lines)
+	{
+		double share = lines_time > 0 ? (prof.elapsed * 100.0) / lines_time : 0;
+
+		report += row_fmt.arg(line)
+							.arg(prof.elapsed / 1000000.0, 0, 'f', 2)
+							.arg(share, 0, 'f', 1)
+							.arg(prof.hits).arg(prof.if_count).arg(prof.set_count)
+							.arg(prof.attrib_count).arg(prof.alloc_count);
+
+		// Only the lines responsible for at least 1% of the time are highlighted, the hotter the line the stronger the color
+		if(share >= 1)
+		{
+			QTextEdit::ExtraSelection sel;
+			QColor color("#f00000");
+
+			color.setAlpha(40 + qRound(prof.elapsed * 120.0 / hot_lines.front().second.elapsed));
+			sel.format.setBackground(color);
+			sel.format.setProperty(QTextFormat::FullWidthSelection, true);
+			sel.cursor = QTextCursor(editor_txt->document()->findBlockByNumber(line - 1));
+			hot_lines_sel.append(sel);
+		}
+	}
+
+	report += "</table>";
+	highlightHotLines();
+	msgbox.show(tr("Profiling results"), report, Messagebox::InfoIcon);
+}
+
+void SourceEditorWidget::highlightHotLines()
+{
+	if(hot_lines_sel.isEmpty())
+		return;
+
+	/* The hot lines are appended to the editor's current selections
+	 * so the highlighting of the current line is preserved */
+	editor_txt->setExtraSelections(editor_txt->extraSelections() + hot_lines_sel);
+}
+
+void SourceEditorWidget::clearHotLines()
+{
+	if(hot_lines_sel.isEmpty())
+		return;
+
+	hot_lines_sel.clear();
+	editor_txt->setExtraSelections({});
+	editor_txt->highlightCurrentLine();
+}
+
 void SourceEditorWidget::restoreEditorPalette()
 {
 	editor_txt->setPalette(def_editor_pal);
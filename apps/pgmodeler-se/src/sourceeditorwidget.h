@@ -59,6 +59,15 @@ class SourceEditorWidget: public QWidget, public Ui::SourceEditorWidget {
 
 		bool is_modified;
 
+		//! \brief Stores the highlighting of the lines that took most of the rendering time in the last profiling
+		QList<QTextEdit::ExtraSelection> hot_lines_sel;
+
+		//! \brief Amount of times each captured attribute set is rendered when profiling the schema file
+		static constexpr int DefProfileIterations = 100;
+
+		//! \brief Maximum amount of lines listed in the profiling report
+		static constexpr int MaxReportedLines = 15;
+
 	public:
 		explicit SourceEditorWidget(QWidget *parent = nullptr);
 
@@ -80,6 +89,17 @@ class SourceEditorWidget: public QWidget, public Ui::SourceEditorWidget {
 		//! \brief Validates the syntax of the editor's content (only for schema micro-language code)
 		void validateSyntax();
 
+		/*! \brief Renders the editor's contents repeatedly against the attribute sets captured for the current schema file
+		 * (see pgmodeler-cli --capture-attribs) reporting the time, evaluated instructions and allocations per line.
+		 * The lines that took most of the time are highlighted in the editor */
+		void profileTemplate();
+
+		//! \brief Reapplies the highlighting of the hot lines (the editor resets the extra selections when the cursor moves)
+		void highlightHotLines();
+
+		//! \brief Removes the highlighting of the hot lines (called when the editor's contents change)
+		void clearHotLines();
+
 		//! \brief Restores the editor default colors after highlighting an syntax error in a portion of the text
 		void restoreEditorPalette();
 
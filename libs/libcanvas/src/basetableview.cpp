@@ -20,6 +20,7 @@
 
 bool BaseTableView::hide_ext_attribs = false;
 bool BaseTableView::hide_tags = false;
+bool BaseTableView::lazy_rendering = false;
 unsigned BaseTableView::attribs_per_page[2] = { 10, 5 };
 
 BaseTableView::BaseTableView(BaseTable *base_tab) : BaseObjectView(base_tab)
@@ -27,7 +28,7 @@ BaseTableView::BaseTableView(BaseTable *base_tab) : BaseObjectView(base_tab)
 	if(!base_tab)
 		throw Exception(ErrorCode::AsgNotAllocattedObject, __PRETTY_FUNCTION__, __FILE__, __LINE__);
 
-	pending_geom_update = false;
+	pending_geom_update = geom_configured = false;
 	body=new RoundedRectItem;
 	body->setRoundedCorners(RoundedRectItem::BottomLeftCorner | RoundedRectItem::BottomRightCorner);
 
@@ -111,6 +112,16 @@ void BaseTableView::setHideTags(bool value)
 	hide_tags=value;
 }
 
+void BaseTableView::setLazyRendering(bool value)
+{
+	lazy_rendering = value;
+}
+
+bool BaseTableView::isLazyRendering()
+{
+	return lazy_rendering;
+}
+
 bool BaseTableView::isExtAttributesHidden()
 {
 	return hide_ext_attribs;
@@ -131,10 +142,12 @@ QVariant BaseTableView::itemChange(GraphicsItemChange change, const QVariant &va
 	}
 	else if(change == ItemVisibleHasChanged)
 	{
+		/* The pending flag is reset before the configuration because the
+		 * object can still have its geometry deferred (see deferGeometryConfig()) */
 		if(value.toBool() && pending_geom_update)
 		{
-			this->configureObject();
 			pending_geom_update = false;
+			this->configureObject();
 		}
 	}
 	else if(change == ItemZValueHasChanged)
@@ -150,6 +163,30 @@ QVariant BaseTableView::itemChange(GraphicsItemChange change, const QVariant &va
 	return value;
 }
 
+void BaseTableView::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+	/* While the full geometry is pending the object has no children items to be drawn
+	 * so we paint a simple box using the estimated bounding rect instead */
+	if(!geom_configured && pending_geom_update)
+	{
+		BaseTable *tab = dynamic_cast<BaseTable *>(getUnderlyingObject());
+		QString body_id;
+
+		if(tab->getObjectType() == ObjectType::Table)
+			body_id = Attributes::TableBody;
+		else if(tab->getObjectType() == ObjectType::View)
+			body_id = Attributes::ViewBody;
+		else
+			body_id = Attributes::ForeignTableBody;
+
+		painter->setPen(BaseObjectView::getBorderStyle(body_id));
+		painter->setBrush(BaseObjectView::getFillStyle(body_id));
+		painter->drawRect(bounding_rect);
+	}
+
+	QGraphicsItemGroup::paint(painter, option, widget);
+}
+
 void BaseTableView::mousePressEvent(QGraphicsSceneMouseEvent *event)
 {
 	//Emit a signal containing the select child object if the user right-click the focused item
@@ -590,6 +627,63 @@ bool BaseTableView::configurePaginationParams(unsigned section_id, unsigned tota
 	}
 }
 
+bool BaseTableView::deferGeometryConfig(unsigned attribs_count)
+{
+	if(geom_configured)
+		return false;
+
+	if(!lazy_rendering)
+	{
+		geom_configured = true;
+		return false;
+	}
+
+	BaseTable *tab = dynamic_cast<BaseTable *>(getUnderlyingObject());
+	QFontMetricsF fm(BaseObjectView::getFontStyle(Attributes::Global).font());
+	double row_h = fm.height() + (2 * VertSpacing), width = 0;
+	unsigned rows = 0;
+
+	if(tab->getCollapseMode() != CollapseMode::AllAttribsCollapsed)
+	{
+		rows = attribs_count;
+
+		if(tab->isPaginationEnabled() && rows > attribs_per_page[BaseTable::AttribsSection])
+			rows = attribs_per_page[BaseTable::AttribsSection];
+	}
+
+	/* The estimated dimensions consider the title and the attributes toggler as two extra rows
+	 * and the width of the object's signature since the attributes widths are still unknown */
+	width = std::max<double>(fm.horizontalAdvance(tab->getSignature()), 20 * fm.averageCharWidth()) + (10 * HorizSpacing);
+
+	prepareGeometryChange();
+	bounding_rect = QRectF(0, 0, width, (rows + 2) * row_h);
+	this->setPos(tab->getPosition());
+	pending_geom_update = true;
+
+	return true;
+}
+
+bool BaseTableView::hasPendingGeometry()
+{
+	return !geom_configured && pending_geom_update;
+}
+
+void BaseTableView::configurePendingGeometry()
+{
+	if(geom_configured)
+		return;
+
+	geom_configured = true;
+
+	/* If the object is invisible (e.g. in an inactive layer) the pending geometry
+	 * will be configured as soon as it gets visible again (see itemChange()) */
+	if(pending_geom_update && this->isVisible())
+	{
+		pending_geom_update = false;
+		this->configureObject();
+	}
+}
+
 void BaseTableView::configureCollapsedSections(CollapseMode coll_mode)
 {
 	startGeometryUpdate();
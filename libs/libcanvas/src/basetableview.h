@@ -56,6 +56,11 @@ class BaseTableView: public BaseObjectView {
 		 * to false and the geometry updated immediately (see BaseTableView::itemChange()) */
 		bool pending_geom_update;
 
+		/*! \brief Indicates that the full geometry of the object (title, attributes, extended attributes, etc) was
+		 * configured at least once. While this attribute is false and the lazy rendering is enabled the object
+		 * is represented only by a lightweight box with an estimated size (see deferGeometryConfig()) */
+		bool geom_configured;
+
 		//! \brief Item groups that stores columns and extended attributes, respectively
 		QGraphicsItemGroup *columns,
 
@@ -65,7 +70,11 @@ class BaseTableView: public BaseObjectView {
 		static bool hide_ext_attribs,
 
 		//! brief Indicates if the tag object should be hidden
-		hide_tags;
+		hide_tags,
+
+		/*! \brief Indicates that tables/views must have their full geometry configured only when
+		 * they get exposed in the viewport (see ObjectsScene::configurePendingGeometries()) */
+		lazy_rendering;
 
 		//! brief Controls the maximum amount of attributes visible per page (columns/references + extended attributes)
 		static unsigned attribs_per_page[2];
@@ -124,6 +133,12 @@ class BaseTableView: public BaseObjectView {
 		 * to be displayed in the current page. See configureObject() on TableView and GraphicalView */
 		bool configurePaginationParams(unsigned page_id, unsigned total_attrs, unsigned &start_attr, unsigned &end_attr);
 
+		/*! \brief Returns true when the full configuration of the object must be postponed because the lazy rendering
+		 * is enabled and the object wasn't exposed in the viewport yet. In that case, the object's bounding rect is estimated
+		 * from the amount of attributes provided and the geometry update is marked as pending. This method must be called
+		 * in the beginning of configureObject() of the derived classes */
+		bool deferGeometryConfig(unsigned attribs_count);
+
 	public:
 		static constexpr unsigned LeftConnPoint=0,
 		RightConnPoint=1;
@@ -134,6 +149,7 @@ class BaseTableView: public BaseObjectView {
 		void hoverLeaveEvent(QGraphicsSceneHoverEvent *);
 		void hoverMoveEvent(QGraphicsSceneHoverEvent *event);
 		void mousePressEvent(QGraphicsSceneMouseEvent *event);
+		void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = nullptr);
 
 		//! brief Defines the amount of attributes per page to be displayed
 		static void setAttributesPerPage(unsigned section_id, unsigned value);
@@ -147,6 +163,12 @@ class BaseTableView: public BaseObjectView {
 		//! \brief Hides the table tags. This applies to all table instances
 		static void setHideTags(bool value);
 
+		//! \brief Defines if the full geometry of tables/views must be configured only when they get exposed in the viewport
+		static void setLazyRendering(bool value);
+
+		//! \brief Returns the current state of the lazy rendering
+		static bool isLazyRendering();
+
 		//! \brief Returns the current visibility state of extended attributes
 		static bool isExtAttributesHidden();
 
@@ -176,6 +198,13 @@ class BaseTableView: public BaseObjectView {
 		//! \brief Selects all the relationships connected to the table
 		void selectRelationships();
 
+		//! \brief Returns true when the object still waits its full geometry configuration (see deferGeometryConfig())
+		bool hasPendingGeometry();
+
+		/*! \brief Configures the full geometry of the object in case it was postponed by the lazy rendering.
+		 * After calling this method the object is configured as usual each time the source object changes */
+		void configurePendingGeometry();
+
 	private slots:
 		/*! \brief This slot reconfigures the table when the attributes toggler emits the signal s_collapseModeChanged
 		 * hiding or exposing the sections related to the current collapse mode */
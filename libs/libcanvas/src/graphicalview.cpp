@@ -41,6 +41,12 @@ void GraphicalView::configureObject()
 	}
 
 	View *view=dynamic_cast<View *>(this->getUnderlyingObject());
+
+	/* When lazy rendering is enabled the children items are created only
+	 * when the object gets exposed in the viewport for the first time */
+	if(deferGeometryConfig(view->getColumns().size()))
+		return;
+
 	int i = 0, count = 0;
 	unsigned start_col = 0, end_col = 0, start_ext = 0, end_ext = 0;
 	QPen pen;
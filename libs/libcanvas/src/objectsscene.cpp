@@ -250,7 +250,6 @@ void ObjectsScene::removeLayers(bool reset_obj_layers)
 		return;
 
 	LayerItem *layer_path = nullptr;
-	BaseObjectView *obj_view = nullptr;
 	QString def_layer = layers[DefaultLayer];
 	bool is_active = active_layers.contains(def_layer);
 
@@ -273,15 +272,10 @@ void ObjectsScene::removeLayers(bool reset_obj_layers)
 
 	if(reset_obj_layers)
 	{
-		for(auto &item : this->items())
+		for(auto &obj_view : obj_views)
 		{
-			obj_view = dynamic_cast<BaseObjectView *>(item);
-
-			if(obj_view && !obj_view->parentItem())
-			{
-				obj_view->resetLayers();
-				obj_view->setVisible(is_active);
-			}
+			obj_view->resetLayers();
+			obj_view->setVisible(is_active);
 		}
 	}
 
@@ -307,7 +301,6 @@ void ObjectsScene::setActiveLayers(QStringList act_layers)
 
 void ObjectsScene::setActiveLayers(QList<unsigned> layers_idxs)
 {
-	BaseObjectView *obj_view = nullptr;
 	active_layers.clear();
 
 	if(!layers_idxs.isEmpty())
@@ -316,33 +309,28 @@ void ObjectsScene::setActiveLayers(QList<unsigned> layers_idxs)
 		unsigned layer_cnt = static_cast<unsigned>(layers.size());
 		SchemaView *sch_view = nullptr;
 
-		for(auto &item : this->items())
+		for(auto &obj_view : obj_views)
 		{
-			obj_view = dynamic_cast<BaseObjectView *>(item);
+			sch_view = dynamic_cast<SchemaView *>(obj_view);
+			is_in_layer = false;
 
-			if(obj_view && !obj_view->parentItem())
+			for(auto &idx : layers_idxs)
 			{
-				sch_view = dynamic_cast<SchemaView *>(obj_view);
-				is_in_layer = false;
-
-				for(auto &idx : layers_idxs)
+				if(obj_view->isInLayer(idx))
 				{
-					if(obj_view->isInLayer(idx))
-					{
-						is_in_layer = true;
-						break;
-					}
+					is_in_layer = true;
+					break;
 				}
+			}
 
-				if(!obj_view->isVisible() && is_in_layer)
-				{
-					if(!sch_view ||
-						 (sch_view && dynamic_cast<Schema *>(sch_view->getUnderlyingObject())->isRectVisible()))
-					 obj_view->setVisible(true);
-				}
-				else if(obj_view->isVisible() && !is_in_layer)
-					obj_view->setVisible(false);
+			if(!obj_view->isVisible() && is_in_layer)
+			{
+				if(!sch_view ||
+					 (sch_view && dynamic_cast<Schema *>(sch_view->getUnderlyingObject())->isRectVisible()))
+				 obj_view->setVisible(true);
 			}
+			else if(obj_view->isVisible() && !is_in_layer)
+				obj_view->setVisible(false);
 		}
 
 		for(auto &idx : layers_idxs)
@@ -353,13 +341,8 @@ void ObjectsScene::setActiveLayers(QList<unsigned> layers_idxs)
 	}
 	else
 	{
-		for(auto &item : this->items())
-		{
-			obj_view = dynamic_cast<BaseObjectView *>(item);
-
-			if(obj_view && !obj_view->parentItem())
-				obj_view->setVisible(false);
-		}
+		for(auto &obj_view : obj_views)
+			obj_view->setVisible(false);
 	}
 
 	updateLayerRects();
@@ -368,6 +351,8 @@ void ObjectsScene::setActiveLayers(QList<unsigned> layers_idxs)
 
 void ObjectsScene::updateLayerRects()
 {
+	layers_rects.clear();
+
 	if(layers_paths.isEmpty())
 		return;
 
@@ -377,60 +362,109 @@ void ObjectsScene::updateLayerRects()
 	if(!is_layer_rects_visible)
 		return;
 
-	int idx = 0, act_layer_idx = 0;
-	BaseObjectView *obj_view = nullptr;
-	ObjectType obj_type;
+	QSet<unsigned> upd_layers;
+
+	for(auto &obj_view : obj_views)
+		updateObjectLayerRects(obj_view, upd_layers);
+
+	// All active layers are updated, even those without objects, so their paths can be cleared
+	for(auto &layer_name : active_layers)
+		upd_layers.insert(layers.indexOf(layer_name));
+
+	updateLayerPaths(upd_layers);
+}
+
+bool ObjectsScene::hasLayerRects(BaseObjectView *obj_view)
+{
+	if(!obj_view || obj_view->parentItem() || !obj_view->getUnderlyingObject())
+		return false;
+
+	ObjectType obj_type = obj_view->getUnderlyingObject()->getObjectType();
+
+	/* Schemas and relationship are ignored when determining the paths for the layers
+	 * because since these objects can have big bounding rects it may polute. For now
+	 * only table-like objects and textboxes can display layer boxes. */
+	return obj_type != ObjectType::Schema &&
+				 obj_type != ObjectType::BaseRelationship &&
+				 obj_type != ObjectType::Relationship;
+}
+
+void ObjectsScene::removeObjectLayerRects(BaseObjectView *obj_view, QSet<unsigned> &upd_layers)
+{
+	for(auto itr = layers_rects.begin(); itr != layers_rects.end(); itr++)
+	{
+		if(itr.value().remove(obj_view) > 0)
+			upd_layers.insert(itr.key());
+	}
+}
+
+void ObjectsScene::updateObjectLayerRects(BaseObjectView *obj_view, QSet<unsigned> &upd_layers)
+{
+	if(!hasLayerRects(obj_view))
+		return;
+
 	QRectF brect;
-	QMap<int, QList<QRectF>> rects;
 	QFontMetricsF fm(LayerItem::getDefaultFont());
 
-	for(auto &item : this->items())
+	removeObjectLayerRects(obj_view, upd_layers);
+	brect = obj_view->boundingRect();
+	brect.moveTo(obj_view->pos());
+
+	for(auto &layer_id : obj_view->getLayers())
 	{
-		obj_view = dynamic_cast<BaseObjectView *>(item);
+		if(static_cast<int>(layer_id) >= layers.size() ||
+			 !active_layers.contains(layers.at(layer_id)))
+			continue;
 
-		if(obj_view && !obj_view->parentItem())
-		{
-			obj_type = 	obj_view->getUnderlyingObject()->getObjectType();
+		/* We need to adjust the bounding rect dimension in such a way
+		 * to take into account the font height (if the layer names are visible)
+		 * as well as a default padding so the rectangles doesn't have the same size
+		 * of the object's bounding rect */
+		brect.adjust(-LayerItem::LayerPadding,
+								 (is_layer_names_visible ? -fm.height() : -LayerItem::LayerPadding),
+								 LayerItem::LayerPadding,
+								 LayerItem::LayerPadding);
+
+		layers_rects[layer_id][obj_view] = brect;
+		upd_layers.insert(layer_id);
+	}
+}
 
-			/* Schemas and relationship are ignored when determining the paths for the layers
-			 * because since these objects can have big bounding rects it may polute. For now
-			 * only table-like objects and textboxes can display layer boxes. */
-			if(obj_type == ObjectType::Schema ||
-				 obj_type ==ObjectType::BaseRelationship ||
-				 obj_type ==ObjectType::Relationship)
-				continue;
+void ObjectsScene::updateObjectsLayerRects(const QList<BaseObjectView *> &objs, bool remove)
+{
+	if(layers_paths.isEmpty() || !is_layer_rects_visible)
+		return;
 
-			brect = obj_view->boundingRect();
-			brect.moveTo(obj_view->pos());
+	QSet<unsigned> upd_layers;
 
-			for(auto &layer_id : obj_view->getLayers())
-			{
-				if(static_cast<int>(layer_id) >= layers.size() ||
-					 !active_layers.contains(layers.at(layer_id)))
-					continue;
-
-				/* We need to adjust the bounding rect dimension in such a way
-				 * to take into account the font height (if the layer names are visible)
-				 * as well as a default padding so the rectangles doesn't have the same size
-				 * of the object's bounding rect */
-				brect.adjust(-LayerItem::LayerPadding,
-										 (is_layer_names_visible ? -fm.height() : -LayerItem::LayerPadding),
-										 LayerItem::LayerPadding,
-										 LayerItem::LayerPadding);
-
-				rects[layer_id].append(brect);
-			}
-		}
+	for(auto &obj_view : objs)
+	{
+		if(remove)
+			removeObjectLayerRects(obj_view, upd_layers);
+		else
+			updateObjectLayerRects(obj_view, upd_layers);
 	}
 
+	updateLayerPaths(upd_layers);
+}
+
+void ObjectsScene::updateLayerPaths(const QSet<unsigned> &upd_layers)
+{
+	int idx = 0, act_layer_idx = 0;
+
 	//Based the active layers we reconfigure the graphical items of each layer
 	for(auto &layer_name : active_layers)
 	{
 		idx = layers.indexOf(layer_name);
-		layers_paths[idx]->setTextAlignment(act_layer_idx % 2 == 0 ? Qt::AlignLeft : Qt::AlignRight);
-		layers_paths[idx]->setText(is_layer_names_visible ? layer_name : "");
-		layers_paths[idx]->setRects(rects[idx]);
-		layers_paths[idx]->setVisible(true);
+
+		if(idx >= 0 && idx < layers_paths.size() && upd_layers.contains(idx))
+		{
+			layers_paths[idx]->setTextAlignment(act_layer_idx % 2 == 0 ? Qt::AlignLeft : Qt::AlignRight);
+			layers_paths[idx]->setText(is_layer_names_visible ? layer_name : "");
+			layers_paths[idx]->setRects(layers_rects.value(idx).values());
+			layers_paths[idx]->setVisible(true);
+		}
+
 		act_layer_idx++;
 	}
 }
@@ -459,42 +493,36 @@ bool ObjectsScene::isLayerNamesVisible()
 
 void ObjectsScene::validateLayerRemoval(unsigned old_layer)
 {
-	BaseObjectView *obj_view = nullptr;
 	unsigned total_layers = layers.size();
 	QList<unsigned> obj_layers;
 
 	if(old_layer == DefaultLayer || old_layer >= total_layers)
 		return;
 
-	for(auto &item : this->items())
+	for(auto &obj_view : obj_views)
 	{
-		obj_view = dynamic_cast<BaseObjectView *>(item);
-
-		if(obj_view && !obj_view->parentItem())
+		// Remove the object from the layer to be deleted and add it to the default one
+		if(obj_view->isInLayer(old_layer))
 		{
-			// Remove the object from the layer to be deleted and add it to the default one
-			if(obj_view->isInLayer(old_layer))
-			{
-				obj_view->removeFromLayer(old_layer);
-				obj_view->addToLayer(DefaultLayer);
-				obj_view->setVisible(isLayerActive(layers[DefaultLayer]));
-			}
-
-			/* Shifting the remainging layers ids if the layer to be removed is
-			 * >= 1 or < layers.size(). For example, if we have the following layers:
-			 * (0, 1, 2, 3). If the layer 1 is to be deleted, then there's the need to
-			 * shift the ids (2, 3) to (1, 2) since after the delition of the layer 1
-			 * the id 3 is invalid */
-			obj_layers = obj_view->getLayers();
+			obj_view->removeFromLayer(old_layer);
+			obj_view->addToLayer(DefaultLayer);
+			obj_view->setVisible(isLayerActive(layers[DefaultLayer]));
+		}
 
-			for(auto &layer_id : obj_layers)
-			{
-				if(layer_id > old_layer)
-					layer_id--;
-			}
+		/* Shifting the remainging layers ids if the layer to be removed is
+		 * >= 1 or < layers.size(). For example, if we have the following layers:
+		 * (0, 1, 2, 3). If the layer 1 is to be deleted, then there's the need to
+		 * shift the ids (2, 3) to (1, 2) since after the delition of the layer 1
+		 * the id 3 is invalid */
+		obj_layers = obj_view->getLayers();
 
-			obj_view->setLayers(obj_layers);
+		for(auto &layer_id : obj_layers)
+		{
+			if(layer_id > old_layer)
+				layer_id--;
 		}
+
+		obj_view->setLayers(obj_layers);
 	}
 
 	emit s_objectsMovedLayer();
@@ -643,7 +671,19 @@ QRectF ObjectsScene::itemsBoundingRect(bool seek_only_db_objs, bool selected_onl
 	else
 	{
 		QRectF rect=QGraphicsScene::itemsBoundingRect();
-		QList<QGraphicsItem *> items= (selected_only ? this->selectedItems() : this->items());
+		QList<QGraphicsItem *> items;
+
+		/* When considering all objects we use only the top-level views registered in the scene
+		 * instead of all items (which includes the children of each object) */
+		if(selected_only)
+			items = this->selectedItems();
+		else
+		{
+			items.reserve(obj_views.size());
+
+			for(auto &obj_view : obj_views)
+				items.append(obj_view);
+		}
 		double x=rect.width(), y=rect.height(), x2 = -10000, y2 = -10000;
 		BaseObjectView *obj_view=nullptr;
 		QPointF pnt;
@@ -716,6 +756,40 @@ QRectF ObjectsScene::itemsBoundingRect(bool seek_only_db_objs, bool selected_onl
 	}
 }
 
+void ObjectsScene::configurePendingGeometries(const QRectF &rect)
+{
+	if(!BaseTableView::isLazyRendering())
+		return;
+
+	QList<QGraphicsItem *> items = (rect.isValid() ? this->items(rect) : this->items());
+	std::vector<BaseTableView *> tab_views;
+	std::vector<BaseObject *> schemas;
+	BaseTableView *tab_view = nullptr;
+	BaseObject *schema = nullptr;
+
+	/* Retrieving the pending objects first since the configuration of each one
+	 * creates new items in the scene which could invalidate the items list */
+	for(auto &item : items)
+	{
+		tab_view = dynamic_cast<BaseTableView *>(item);
+
+		if(tab_view && tab_view->hasPendingGeometry())
+			tab_views.push_back(tab_view);
+	}
+
+	for(auto &view : tab_views)
+	{
+		view->configurePendingGeometry();
+		schema = dynamic_cast<BaseTable *>(view->getUnderlyingObject())->getSchema();
+
+		if(schema && std::find(schemas.begin(), schemas.end(), schema) == schemas.end())
+			schemas.push_back(schema);
+	}
+
+	for(auto &sch : schemas)
+		dynamic_cast<Schema *>(sch)->setModified(true);
+}
+
 void ObjectsScene::setGridSize(unsigned size)
 {
 	if(size >= 20 || grid.style()==Qt::NoBrush)
@@ -922,13 +996,16 @@ void ObjectsScene::addItem(QGraphicsItem *item)
 
 			// Tables and textboxes are observed for dimension changes so the layers they are in are correctly updated
 			if(tab || txtbox)
-				connect(obj, SIGNAL(s_objectDimensionChanged()), this, SLOT(updateLayerRects()));
+				connect(obj, SIGNAL(s_objectDimensionChanged()), this, SLOT(handleObjectDimensionChanged()));
 		}
 
 		QGraphicsScene::addItem(item);
 
+		if(obj && !obj->parentItem())
+			obj_views.insert(obj);
+
 		if(tab || txtbox)
-			updateLayerRects();
+			updateObjectsLayerRects({ obj });
 	}
 }
 
@@ -950,9 +1027,11 @@ void ObjectsScene::removeItem(QGraphicsItem *item)
 		{
 			BaseObject *obj = obj_view->getUnderlyingObject();
 
+			obj_views.remove(obj_view);
+
 			if(BaseTable::isBaseTable(obj->getObjectType()) ||
 				 obj->getObjectType() == ObjectType::Textbox)
-				updateLayerRects();
+				updateObjectsLayerRects({ obj_view }, true);
 
 			disconnect(obj_view, nullptr, this, nullptr);
 			disconnect(obj_view, nullptr, dynamic_cast<BaseGraphicObject*>(obj_view->getUnderlyingObject()), nullptr);
@@ -962,6 +1041,14 @@ void ObjectsScene::removeItem(QGraphicsItem *item)
 	}
 }
 
+void ObjectsScene::handleObjectDimensionChanged()
+{
+	BaseObjectView *obj_view = dynamic_cast<BaseObjectView *>(sender());
+
+	if(obj_view && obj_views.contains(obj_view))
+		updateObjectsLayerRects({ obj_view });
+}
+
 void ObjectsScene::blockItemsSignals(bool block)
 {
 	BaseObjectView *obj_view = nullptr;
@@ -1568,57 +1655,63 @@ void ObjectsScene::finishObjectsMove(const QPointF &pnt_end)
 	sel_ini_pnt.setX(DNaN);
 	sel_ini_pnt.setY(DNaN);
 
-	updateLayerRects();
+	// Only the layer rects of the moved objects (and the ones inside moved schemas) are updated
+	QList<BaseObjectView *> moved_objs(tables.begin(), tables.end());
+
+	for(auto &item : items)
+	{
+		obj_view = dynamic_cast<BaseObjectView *>(item);
+
+		if(obj_view && !tables.contains(obj_view))
+			moved_objs.append(obj_view);
+	}
+
+	updateObjectsLayerRects(moved_objs);
 }
 
 void ObjectsScene::alignObjectsToGrid()
 {
-	QList<QGraphicsItem *> items=this->items();
 	RelationshipView *rel=nullptr;
 	BaseTableView *tab=nullptr;
 	TextboxView *lab=nullptr;
 	std::vector<QPointF> points;
 	std::vector<Schema *> schemas;
-	unsigned i, count, i1, count1;
+	unsigned i1, count1;
 
-	count=items.size();
-	for(i=0; i < count; i++)
+	for(auto &obj_view : obj_views)
 	{
-		if(dynamic_cast<QGraphicsItemGroup *>(items[i]) && !items[i]->parentItem())
+		tab=dynamic_cast<BaseTableView *>(obj_view);
+		rel=dynamic_cast<RelationshipView *>(obj_view);
+
+		if(tab)
+			tab->setPos(this->alignPointToGrid(tab->pos()));
+		else if(rel)
 		{
-			tab=dynamic_cast<BaseTableView *>(items[i]);
-			rel=dynamic_cast<RelationshipView *>(items[i]);
+			//Align the relationship points
+			points=rel->getUnderlyingObject()->getPoints();
+			count1=points.size();
+			for(i1=0; i1 < count1; i1++)
+				points[i1]=this->alignPointToGrid(points[i1]);
 
-			if(tab)
-				tab->setPos(this->alignPointToGrid(tab->pos()));
-			else if(rel)
+			if(count1 > 0)
 			{
-				//Align the relationship points
-				points=rel->getUnderlyingObject()->getPoints();
-				count1=points.size();
-				for(i1=0; i1 < count1; i1++)
-					points[i1]=this->alignPointToGrid(points[i1]);
-
-				if(count1 > 0)
-				{
-					rel->getUnderlyingObject()->setPoints(points);
-					rel->configureLine();
-				}
+				rel->getUnderlyingObject()->setPoints(points);
+				rel->configureLine();
+			}
 
-				//Align the labels
-				for(i1=BaseRelationship::SrcCardLabel;
-					i1<=BaseRelationship::RelNameLabel; i1++)
-				{
-					lab=rel->getLabel(i1);
-					if(lab)
-						lab->setPos(this->alignPointToGrid(lab->pos()));
-				}
+			//Align the labels
+			for(i1=BaseRelationship::SrcCardLabel;
+				i1<=BaseRelationship::RelNameLabel; i1++)
+			{
+				lab=rel->getLabel(i1);
+				if(lab)
+					lab->setPos(this->alignPointToGrid(lab->pos()));
 			}
-			else if(!dynamic_cast<SchemaView *>(items[i]))
-				items[i]->setPos(this->alignPointToGrid(items[i]->pos()));
-			else
-				schemas.push_back(dynamic_cast<Schema *>(dynamic_cast<BaseObjectView *>(items[i])->getUnderlyingObject()));
 		}
+		else if(!dynamic_cast<SchemaView *>(obj_view))
+			obj_view->setPos(this->alignPointToGrid(obj_view->pos()));
+		else
+			schemas.push_back(dynamic_cast<Schema *>(obj_view->getUnderlyingObject()));
 	}
 
 	//Updating schemas dimensions
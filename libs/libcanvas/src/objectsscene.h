@@ -61,6 +61,16 @@ class ObjectsScene: public QGraphicsScene {
 		//! \brief Holds the tables/views which have selected children objects
 		QList<BaseTableView *> tabs_sel_children;
 
+		/*! \brief Holds the top-level views of the database objects in the scene (tables, views, textboxes, schemas and relationships).
+		 * This set is used to avoid iterating over all the items of the scene (including the children of each object) and
+		 * casting them every time the whole set of objects must be inspected, e.g., bounding rect calculation and layers handling */
+		QSet<BaseObjectView *> obj_views;
+
+		/*! \brief Stores per active layer id the rectangles (in scene coordinates and including the layer padding) of the
+		 * tables, views and textboxes inside that layer. These rectangles are updated incrementally when objects are added,
+		 * removed, moved or resized so only the paths of the affected layers need to be rebuilt */
+		QMap<unsigned, QHash<BaseObjectView *, QRectF>> layers_rects;
+
 		//! \brief Indicates if the corner move is enabled for the scene
 		static bool corner_move,
 
@@ -146,6 +156,22 @@ class ObjectsScene: public QGraphicsScene {
 
 		void clearTablesChildrenSelection();
 
+		//! \brief Returns true when the object can be displayed inside layer rects (tables, views and textboxes)
+		bool hasLayerRects(BaseObjectView *obj_view);
+
+		//! \brief Removes the layer rects of the object from the cache storing the affected layers ids in upd_layers
+		void removeObjectLayerRects(BaseObjectView *obj_view, QSet<unsigned> &upd_layers);
+
+		//! \brief (Re)calculates the layer rects of the object storing the affected layers ids in upd_layers
+		void updateObjectLayerRects(BaseObjectView *obj_view, QSet<unsigned> &upd_layers);
+
+		/*! \brief Updates only the layer rects related to the provided objects and rebuilds the paths of the affected layers.
+		 * If remove is true the objects have their rects removed from the layers */
+		void updateObjectsLayerRects(const QList<BaseObjectView *> &objs, bool remove = false);
+
+		//! \brief Rebuilds the paths of the active layers which ids are in the provided set
+		void updateLayerPaths(const QSet<unsigned> &upd_layers);
+
 	protected:
 		//! \brief Brush used to draw the grid over the scene
 		static QBrush grid;
@@ -284,6 +310,11 @@ class ObjectsScene: public QGraphicsScene {
 		Note: using this method with seek_only_db_objs=true can be time expensive depending on the size of the model so use it wisely. */
 		QRectF itemsBoundingRect(bool seek_only_db_objs=false, bool selected_only = false, bool incl_layer_rects = false);
 
+		/*! \brief Configures the full geometry of the tables/views which had it postponed due to lazy rendering (see BaseTableView::setLazyRendering()).
+		 * If a valid rect is provided only the objects intersecting it are configured, otherwise, all pending objects in the scene are configured.
+		 * The schemas of the configured objects are updated so their rectangles can embrace the new objects' dimensions */
+		void configurePendingGeometries(const QRectF &rect = QRectF());
+
 		//! \brief Returns a vector containing all the page rects considering the provided page layout settings
 		std::vector<QRectF> getPagesForPrinting(const QPageLayout &page_lt, unsigned &h_page_cnt, unsigned &v_page_cnt);
 
@@ -340,6 +371,9 @@ class ObjectsScene: public QGraphicsScene {
 		//! \brief Handles the tables children objects selection changes
 		void handleChildrenSelectionChanged();
 
+		//! \brief Updates the layer rects of the table/textbox that had its dimensions changed
+		void handleObjectDimensionChanged();
+
 	signals:
 		//! \brief Signal emitted when the user start or finalizes a object movement.
 		void s_objectsMoved(bool end_moviment);
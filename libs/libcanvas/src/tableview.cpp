@@ -36,6 +36,12 @@ void TableView::configureObject()
 	}
 
 	PhysicalTable *table=dynamic_cast<PhysicalTable *>(this->getUnderlyingObject());
+
+	/* When lazy rendering is enabled the children items are created only
+	 * when the object gets exposed in the viewport for the first time */
+	if(deferGeometryConfig(table->getColumnCount()))
+		return;
+
 	int i, count, obj_idx;
 	double width=0, px=0, cy=0, old_width=0, old_height=0;
 	unsigned start_col = 0, end_col = 0, start_ext = 0, end_ext = 0;
@@ -18,13 +18,13 @@
 #include "catalog.h"
 #include "coreutilsns.h"
 #include "utilsns.h"
+#include <algorithm>
 
 const QString Catalog::QueryList("list");
 const QString Catalog::QueryAttribs("attribs");
 const QString Catalog::PgSqlTrue("t");
 const QString Catalog::PgSqlFalse("f");
 const QString Catalog::BoolField("_bool");
-const QString Catalog::ArrayPattern("((\\[)[0-9]+(\\:)[0-9]+(\\])=)?(\\{)((.)+(,)*)*(\\})$");
 const QString Catalog::PgModelerTempDbObj("__pgmodeler_tmp");
 const QString Catalog::InvFilterPattern("__invalid__pattern__");
 const QString Catalog::AliasPlaceholder("$alias$");
@@ -34,6 +34,8 @@ const QString Catalog::GetExtensionObjsSql("SELECT d.objid AS oid, e.extname AS
 																					 WHERE objid > 0 AND refobjid > 0 AND deptype='e'\
 																					 ORDER BY extname;");
 attribs_map Catalog::catalog_queries;
+std::map<QString, std::shared_ptr<const Catalog::DatabaseContext>> Catalog::db_contexts;
+QMutex Catalog::db_contexts_mutex;
 
 std::map<ObjectType, QString> Catalog::oid_fields=
 { {ObjectType::Database, "oid"}, {ObjectType::Role, "oid"}, {ObjectType::Schema,"oid"},
@@ -82,7 +84,7 @@ std::map<ObjectType, QString> Catalog::name_fields=
 Catalog::Catalog()
 {
 	match_signature = true;
-	last_sys_oid=0;
+	db_context = std::make_shared<const DatabaseContext>();
 	setQueryFilter(ExclExtensionObjs | ExclSystemObjs);
 }
 
@@ -91,43 +93,91 @@ Catalog::Catalog(const Catalog &catalog)
 	(*this)=catalog;
 }
 
-void Catalog::setConnection(Connection &conn)
+void Catalog::setConnection(Connection &conn, bool refresh_context)
 {
 	try
 	{
-		ResultSet res;
-		QStringList obj_oids;
+		QString conn_str;
 
 		connection.close();
 		connection.setConnectionParams(conn.getConnectionParams());
+		conn_str = connection.getConnectionString();
+
+		//Reusing the metadata of the database if it was already retrieved by another catalog
+		if(!refresh_context)
+		{
+			QMutexLocker locker(&db_contexts_mutex);
+			auto itr = db_contexts.find(conn_str);
+
+			if(itr != db_contexts.end())
+			{
+				db_context = itr->second;
+				return;
+			}
+		}
+
+		db_context = loadDatabaseContext();
+
+		QMutexLocker locker(&db_contexts_mutex);
+		db_contexts[conn_str] = db_context;
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void Catalog::clearDatabaseContexts()
+{
+	QMutexLocker locker(&db_contexts_mutex);
+	db_contexts.clear();
+}
+
+Connection &Catalog::getConnection()
+{
+	if(!connection.isStablished())
 		connection.connect();
 
+	return connection;
+}
+
+std::shared_ptr<const Catalog::DatabaseContext> Catalog::loadDatabaseContext()
+{
+	try
+	{
+		ResultSet res;
+		std::map<QString, std::vector<unsigned>> ext_objs;
+		std::shared_ptr<DatabaseContext> context = std::make_shared<DatabaseContext>();
+
+		/* The new context is assigned to the catalog right away because the server
+		 * version stored in it is used to generate the catalog queries below */
+		context->pgsql_version = getConnection().getPgSQLVersion(true);
+		db_context = context;
+
 		//Retrieving the last system oid
 		executeCatalogQuery(QueryList, ObjectType::Database, res, true,
-		{{Attributes::Name, conn.getConnectionParam(Connection::ParamDbName)}});
+		{{Attributes::Name, connection.getConnectionParam(Connection::ParamDbName)}});
 
 		if(res.accessTuple(ResultSet::FirstTuple))
 		{
 			attribs_map attribs=changeAttributeNames(res.getTupleValues());
-			last_sys_oid=attribs[Attributes::LastSysOid].toUInt();
+			context->last_sys_oid=attribs[Attributes::LastSysOid].toUInt();
 		}
 
 		//Retrieving the list of objects created by extensions
-		ext_objects.clear();
-		ext_objs_oids = "";
-		this->connection.executeDMLCommand(GetExtensionObjsSql, res);
+		getConnection().executeDMLCommand(GetExtensionObjsSql, res);
 
 		if(res.accessTuple(ResultSet::FirstTuple))
 		{
 			do
 			{
-				obj_oids.append(res.getColumnValue(Attributes::Oid));
-				ext_objects[res.getColumnValue(Attributes::Name)].append(res.getColumnValue(Attributes::Oid));
+				ext_objs[res.getColumnValue(Attributes::Name)].push_back(QString(res.getColumnValue(Attributes::Oid)).toUInt());
 			}
 			while(res.accessTuple(ResultSet::NextTuple));
-
-			ext_objs_oids = obj_oids.join(',');
 		}
+
+		setExtensionObjects(ext_objs);
+		return db_context;
 	}
 	catch(Exception &e)
 	{
@@ -342,31 +392,56 @@ void Catalog::clearObjectFilters()
 
 unsigned Catalog::getLastSysObjectOID()
 {
-	return last_sys_oid;
+	return db_context->last_sys_oid;
 }
 
 bool Catalog::isSystemObject(unsigned oid)
 {
-	return (oid <= last_sys_oid);
+	return (oid <= db_context->last_sys_oid);
 }
 
 bool Catalog::isExtensionObject(unsigned oid, const QString &ext_name)
 {
-	if(!ext_name.isEmpty() && ext_objects.count(ext_name) == 0)
-		return false;
+	if(ext_name.isEmpty())
+		return db_context->ext_obj_oids.count(oid) != 0;
+
+	auto itr = db_context->ext_objects.find(ext_name);
+	return itr != db_context->ext_objects.end() && itr->second.count(oid) != 0;
+}
+
+const std::unordered_set<unsigned> &Catalog::getExtensionObjectsOids(const QString &ext_name)
+{
+	static const std::unordered_set<unsigned> empty_set;
 
 	if(ext_name.isEmpty())
+		return db_context->ext_obj_oids;
+
+	auto itr = db_context->ext_objects.find(ext_name);
+	return itr != db_context->ext_objects.end() ? itr->second : empty_set;
+}
+
+void Catalog::setExtensionObjects(const std::map<QString, std::vector<unsigned>> &ext_objs)
+{
+	QStringList obj_oids;
+
+	/* The context can be shared with other catalogs so the changes are
+	 * made in a copy of it which is then used only by this catalog */
+	std::shared_ptr<DatabaseContext> context = std::make_shared<DatabaseContext>(*db_context);
+
+	context->ext_objects.clear();
+	context->ext_obj_oids.clear();
+
+	for(auto &itr : ext_objs)
 	{
-		for(auto &itr : ext_objects)
-		{
-			if(itr.second.contains(QString::number(oid)))
-				return true;
-		}
+		context->ext_objects[itr.first].insert(itr.second.begin(), itr.second.end());
+		context->ext_obj_oids.insert(itr.second.begin(), itr.second.end());
 
-		return false;
+		for(auto &oid : itr.second)
+			obj_oids.append(QString::number(oid));
 	}
 
-	return ext_objects[ext_name].contains(QString::number(oid));
+	context->ext_objs_oids = obj_oids.join(',');
+	db_context = context;
 }
 
 void Catalog::loadCatalogQuery(const QString &qry_id)
@@ -389,11 +464,11 @@ QString Catalog::getCatalogQuery(const QString &qry_type, ObjectType obj_type, b
 			attr.second.replace(QChar('\''), QString("''"));
 	}
 
-	schparser.setPgSQLVersion(connection.getPgSQLVersion(true));
+	schparser.setPgSQLVersion(getPgSQLVersion());
 	attribs[qry_type]=Attributes::True;
 
 	if(exclude_sys_objs || list_only_sys_objs)
-		attribs[Attributes::LastSysOid]=QString::number(last_sys_oid);
+		attribs[Attributes::LastSysOid]=QString::number(db_context->last_sys_oid);
 
 	if(list_only_sys_objs)
 		attribs[Attributes::OidFilterOp]=QString("<=");
@@ -464,7 +539,7 @@ void Catalog::executeCatalogQuery(const QString &qry_type, ObjectType obj_type,
 {
 	try
 	{
-		connection.executeDMLCommand(getCatalogQuery(qry_type, obj_type, single_result, attribs), result);
+		getConnection().executeDMLCommand(getCatalogQuery(qry_type, obj_type, single_result, attribs), result);
 	}
 	catch(Exception &e)
 	{
@@ -526,9 +601,8 @@ void Catalog::getObjectsOIDs(std::map<ObjectType, std::vector<unsigned> > &obj_o
 		std::vector<ObjectType> types=BaseObject::getObjectTypes(true, { ObjectType::Database, ObjectType::Relationship, ObjectType::BaseRelationship,
 																																ObjectType::Textbox, ObjectType::Tag, ObjectType::Column, ObjectType::Permission,
 																																ObjectType::GenericSql });
-		attribs_map attribs, col_attribs, sch_names;
-		std::vector<attribs_map> tab_attribs;
-		unsigned tab_oid=0;
+		attribs_map attribs;
+		std::vector<unsigned> tab_oids;
 
 		for(ObjectType type : types)
 		{
@@ -544,25 +618,19 @@ void Catalog::getObjectsOIDs(std::map<ObjectType, std::vector<unsigned> > &obj_o
 			{
 				obj_oids[type].push_back(attr.first.toUInt());
 
-				//Store the schemas names in order to retrieve the tables' columns correctly
-				if(type==ObjectType::Schema)
-					sch_names[attr.first]=attr.second;
-				else if(type==ObjectType::Table)
-				{
-					//Get the full set of attributes of the table
-					tab_oid=attr.first.toUInt();
-					tab_attribs=getObjectsAttributes(type, "", "", { tab_oid });
-
-					//Retrieve the oid and names of the table's columns
-					col_attribs=getObjectsNames(ObjectType::Column, sch_names[tab_attribs[0][Attributes::Schema]], attr.second);
-
-					for(auto &col_attr : col_attribs)
-						col_oids[tab_oid].push_back(col_attr.first.toUInt());
-				}
+				//The tables' columns are retrieved all at once after listing the objects
+				if(type==ObjectType::Table)
+					tab_oids.push_back(attr.first.toUInt());
 			}
 
 			attribs.clear();
 		}
+
+		for(auto &itr : getTablesColumnsAttributes(tab_oids))
+		{
+			for(auto &col_attr : itr.second)
+				col_oids[itr.first].push_back(col_attr[Attributes::Oid].toUInt());
+		}
 	}
 	catch(Exception &e)
 	{
@@ -636,7 +704,7 @@ std::vector<attribs_map> Catalog::getObjectsNames(std::vector<ObjectType> obj_ty
 		if(sort_results)
 			sql += QString(" ORDER BY oid, object_type");
 
-		connection.executeDMLCommand(sql, res);
+		getConnection().executeDMLCommand(sql, res);
 
 		if(res.accessTuple(ResultSet::FirstTuple))
 		{
@@ -723,6 +791,46 @@ std::vector<attribs_map> Catalog::getMultipleAttributes(ObjectType obj_type, att
 	}
 }
 
+std::map<unsigned, std::vector<attribs_map>> Catalog::getTablesColumnsAttributes(const std::vector<unsigned> &tab_oids, const std::map<unsigned, std::vector<unsigned>> &col_ids)
+{
+	std::map<unsigned, std::vector<attribs_map>> columns;
+
+	if(tab_oids.empty())
+		return columns;
+
+	try
+	{
+		std::vector<attribs_map> cols;
+		unsigned tab_oid = 0;
+
+		cols=getObjectsAttributes(ObjectType::Column, "", "", {}, {{ Attributes::ParentOids, createOidFilter(tab_oids) }});
+
+		for(auto &col : cols)
+		{
+			tab_oid = col[Attributes::Table].toUInt();
+
+			/* Since the query retrieves all the columns of the tables at once
+			 * the columns filtering per table is done here */
+			if(col_ids.count(tab_oid))
+			{
+				const std::vector<unsigned> &filter_cols = col_ids.at(tab_oid);
+
+				if(!filter_cols.empty() &&
+					 std::find(filter_cols.begin(), filter_cols.end(), col[Attributes::Oid].toUInt()) == filter_cols.end())
+					continue;
+			}
+
+			columns[tab_oid].push_back(col);
+		}
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+
+	return columns;
+}
+
 std::vector<attribs_map> Catalog::getMultipleAttributes(const QString &catalog_sch, attribs_map attribs)
 {
 	try
@@ -736,7 +844,7 @@ std::vector<attribs_map> Catalog::getMultipleAttributes(const QString &catalog_s
 		schparser.ignoreEmptyAttributes(true);
 
 		attribs[Attributes::PgSqlVersion]=schparser.getPgSQLVersion();
-		connection.executeDMLCommand(schparser.getCodeDefinition(attribs).simplified(), res);
+		getConnection().executeDMLCommand(schparser.getCodeDefinition(attribs).simplified(), res);
 
 		if(res.accessTuple(ResultSet::FirstTuple))
 		{
@@ -783,7 +891,7 @@ QString Catalog::getNotExtObjectQuery(const QString &oid_field)
 	try
 	{
 		attribs_map attribs={{Attributes::Oid, oid_field},
-												 {Attributes::ExtObjOids, ext_objs_oids}};
+												 {Attributes::ExtObjOids, db_context->ext_objs_oids}};
 
 
 		loadCatalogQuery(query_id);
@@ -921,7 +1029,7 @@ attribs_map Catalog::getServerAttributes()
 		schparser.ignoreUnkownAttributes(true);
 		schparser.ignoreEmptyAttributes(true);
 		sql = schparser.getCodeDefinition(attribs).simplified();
-		connection.executeDMLCommand(sql, res);
+		getConnection().executeDMLCommand(sql, res);
 
 		if(res.accessTuple(ResultSet::FirstTuple))
 		{
@@ -959,13 +1067,13 @@ unsigned Catalog::getObjectCount(bool incl_sys_objs)
 		attribs_map tuple, attribs;
 
 		if(!incl_sys_objs)
-			attribs[Attributes::LastSysOid]=QString::number(last_sys_oid);
+			attribs[Attributes::LastSysOid]=QString::number(db_context->last_sys_oid);
 
 		loadCatalogQuery(Attributes::ObjCount);
 		schparser.ignoreUnkownAttributes(true);
 		schparser.ignoreEmptyAttributes(true);
 		sql = schparser.getCodeDefinition(attribs).simplified();
-		connection.executeDMLCommand(sql, res);
+		getConnection().executeDMLCommand(sql, res);
 
 		if(res.accessTuple(ResultSet::FirstTuple))
 		{
@@ -982,119 +1090,153 @@ unsigned Catalog::getObjectCount(bool incl_sys_objs)
 	return count;
 }
 
+std::map<unsigned, std::vector<unsigned>> Catalog::getObjectsDependencies(const std::vector<unsigned> &oids)
+{
+	std::map<unsigned, std::vector<unsigned>> deps;
+
+	if(oids.empty())
+		return deps;
+
+	try
+	{
+		ResultSet res;
+		QString sql;
+		attribs_map tuple, attribs;
+
+		attribs[Attributes::FilterOids]=createOidFilter(oids);
+
+		loadCatalogQuery(Attributes::ObjDepends);
+		schparser.ignoreUnkownAttributes(true);
+		schparser.ignoreEmptyAttributes(true);
+		sql = schparser.getCodeDefinition(attribs).simplified();
+		getConnection().executeDMLCommand(sql, res);
+
+		if(res.accessTuple(ResultSet::FirstTuple))
+		{
+			do
+			{
+				tuple = res.getTupleValues();
+				std::vector<unsigned> &ref_oids = deps[tuple[Attributes::Oid].toUInt()];
+
+				for(auto &ref_oid : parseArrayValues(tuple[Attributes::RefOids]))
+					ref_oids.push_back(ref_oid.toUInt());
+			}
+			while(res.accessTuple(ResultSet::NextTuple));
+		}
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+
+	return deps;
+}
+
 QStringList Catalog::parseArrayValues(const QString &array_val)
 {
 	QStringList list;
-	QRegularExpression regexp(QRegularExpression::anchoredPattern(ArrayPattern));
+	qsizetype start = 0, end = array_val.size() - 1;
 
-	if(regexp.match(array_val).hasMatch())
+	//Checking if the value is in the format [n:n]={a,b,c,d,...} or {a,b,c,d,...}
+	if(array_val.startsWith(QChar('[')))
 	{
-		//Detecting the position of { and }
-		int start=array_val.indexOf('{')+1,
-				end=array_val.lastIndexOf('}')-1;
-		QString value=array_val.mid(start, (end - start)+1);
+		qsizetype colon_idx = array_val.indexOf(QChar(':')),
+				close_idx = array_val.indexOf(QString("]="));
+		auto isDigits = [&array_val](qsizetype from, qsizetype to){
+			if(from >= to)
+				return false;
 
-		if(value.contains('"'))
-			list = parseDefaultValues(value, QString("\""), QString(","));
-		else
-			list = value.split(',', Qt::SkipEmptyParts);
+			for(qsizetype i = from; i < to; i++)
+			{
+				if(!array_val.at(i).isDigit() || array_val.at(i).unicode() > 0x7f)
+					return false;
+			}
+
+			return true;
+		};
+
+		if(colon_idx < 0 || close_idx < colon_idx ||
+			 !isDigits(1, colon_idx) || !isDigits(colon_idx + 1, close_idx))
+			return list;
+
+		start = close_idx + 2;
 	}
 
+	if(end - start < 1 || array_val.at(start) != QChar('{') || array_val.at(end) != QChar('}') ||
+		 array_val.indexOf(QChar('\n'), start) >= 0)
+		return list;
+
+	QString value = array_val.mid(start + 1, end - start - 1);
+
+	if(value.contains('"'))
+		list = parseDefaultValues(value, QString("\""), QString(","));
+	else
+		list = value.split(',', Qt::SkipEmptyParts);
+
 	return list;
 }
 
 QStringList Catalog::parseDefaultValues(const QString &def_values, const QString &str_delim, const QString &val_sep)
 {
-	int idx = 0, delim_start, delim_end, sep_idx, pos = -1;
 	QStringList values;
-	QString array_expr = "ARRAY[", aux_def_vals = def_values, array_val;
+	qsizetype pos = 0, idx = 0, size = def_values.size();
+	int brackets = 0;
+	bool in_str = false, bslash_escape = (str_delim == QString("\""));
+	QChar chr;
 
-	/* Special case for ARRAY[M, .. , N] values:
-	 *
-	 * We need to replace temporarily the element separators (generally comma)
-	 * by another character in order to avoid splitting the string in a vector
-	 * greater than the passed default values define. *
+	if(def_values.isEmpty() || val_sep.isEmpty())
+		return values;
+
+	/* Single pass tokenizer which splits the values on each separator found outside
+	 * strings (delimited by str_delim), brackets (e.g. ARRAY[0, 1, 2]) and parenthesis (e.g. func(1, 2)).
 	 *
 	 * Example:
 	 * Supposing the default value string "0, '*', ARRAY[0, 1, 2 ,3], 'foo', ARRAY['a', 'b', 'c']"
-	 * If the elements ARRAY[] are not treated properly, in the final result we'll have
-	 * a QStringList with 10 elements but the correct must be 5 since the commas inside ARRAY[]
-	 * must not be considered when splitting the provided string. */
-
-	do
+	 * the result will be a QStringList with 5 elements since the commas inside ARRAY[] and
+	 * strings are not considered when splitting the provided string. */
+	while(idx < size)
 	{
-		pos = aux_def_vals.indexOf(array_expr, pos + 1);
+		chr = def_values.at(idx);
 
-		if(pos >= 0)
+		if(in_str)
 		{
-			idx = aux_def_vals.indexOf(QString("], "), pos + 1);
-
-			if(idx < 0)
-				idx = aux_def_vals.indexOf(']', pos + 1);
+			// Array elements (delimited by ") can have the delimiter escaped by backslash
+			if(bslash_escape && chr == QChar('\\'))
+				idx++;
+			else if(QStringView(def_values).mid(idx).startsWith(str_delim))
+			{
+				in_str = false;
+				idx += str_delim.size() - 1;
+			}
 
-			array_val = aux_def_vals.mid(pos, (idx - pos) + 1);
-			array_val.replace(",", UtilsNs::DataSeparator);
-			aux_def_vals.replace(pos, array_val.size(), array_val);
+			idx++;
 		}
-	}
-	while(pos >= 0);
-
-	pos = idx = 0;
-	while(idx < aux_def_vals.size())
-	{
-		//Get the index of string delimiters (default: ')
-		delim_start = aux_def_vals.indexOf(str_delim, idx);
-		delim_end = aux_def_vals.indexOf(str_delim, delim_start + 1);
-
-		/* Get the index of value separator on default value string
-			 (by default the pg_get_expr separates values by comma and space (, ) */
-		sep_idx = aux_def_vals.indexOf(val_sep, idx);
-
-		/* If there is no separator on string (only one value) or the is
-			 beyond the string delimiters or even there is no string delimiter on string */
-		if(sep_idx < 0 ||
-				(sep_idx >=0 && delim_start >= 0 && delim_end >= 0 &&
-				(sep_idx < delim_start || sep_idx > delim_end)) ||
-				(sep_idx >= 0 && (delim_start < 0 || delim_end < 0)))
+		else if(!str_delim.isEmpty() && QStringView(def_values).mid(idx).startsWith(str_delim))
 		{
-			//Extract the value from the current position
-			values.push_back(aux_def_vals.mid(pos, sep_idx - pos).trimmed());
-
-			//If there is no separator on string indicates that it contains only one value
-			if(sep_idx < 0)
-				//Forcing the loop abort
-				idx = aux_def_vals.size();
-			else
-			{
-				//Passing to the next value right after the separator
-				pos = sep_idx+1;
-				idx = pos;
-			}
+			in_str = true;
+			idx += str_delim.size();
 		}
-		/* If the separator is between a string delimitation e.g.'abc, def' it will be ignored
-		and the current postion will be moved to the first char after string delimiter */
-		else if(delim_start >= 0 && delim_end >= 0 &&
-						sep_idx >= delim_start && sep_idx <= delim_end)
+		else if(chr == QChar('[') || chr == QChar('('))
 		{
-			idx = delim_end + 1;
-
-			/* If the index reaches the end of string but the cursor (pos) isn't at end
-			indicates that the last values wasn't retrieved, this way, the value will be
-			pushed to list of values */
-			if(idx >= aux_def_vals.size() && pos < aux_def_vals.size())
-				values.push_back(aux_def_vals.mid(pos, aux_def_vals.size()));
+			brackets++;
+			idx++;
+		}
+		else if((chr == QChar(']') || chr == QChar(')')) && brackets > 0)
+		{
+			brackets--;
+			idx++;
+		}
+		else if(brackets == 0 && QStringView(def_values).mid(idx).startsWith(val_sep))
+		{
+			values.push_back(QStringView(def_values).mid(pos, idx - pos).trimmed().toString());
+			idx += val_sep.size();
+			pos = idx;
 		}
 		else
 			idx++;
 	}
 
-	// Converting back the separators of elements in ARRAY[] values
-	for(auto &val : values)
-	{
-		if(val.contains(array_expr))
-			val.replace(UtilsNs::DataSeparator, ",");
-	}
-
+	values.push_back(QStringView(def_values).mid(pos).trimmed().toString());
 	return values;
 }
 
@@ -1216,10 +1358,11 @@ void Catalog::operator = (const Catalog &catalog)
 {
 	try
 	{
-		this->ext_objects=catalog.ext_objects;
-		this->ext_objs_oids=catalog.ext_objs_oids;
+		/* The database context is shared between the copies and the connection is
+		 * opened only when the copy executes its first query (see getConnection()) */
+		this->db_context=catalog.db_context;
+		this->connection.close();
 		this->connection.setConnectionParams(catalog.connection.getConnectionParams());
-		this->last_sys_oid=catalog.last_sys_oid;
 		this->filter=catalog.filter;
 		this->exclude_ext_objs=catalog.exclude_ext_objs;
 		this->exclude_sys_objs=catalog.exclude_sys_objs;
@@ -1227,7 +1370,6 @@ void Catalog::operator = (const Catalog &catalog)
 		this->list_only_sys_objs=catalog.list_only_sys_objs;
 		this->obj_filters=catalog.obj_filters;
 		this->extra_filter_conds=catalog.extra_filter_conds;
-		this->connection.connect();
 	}
 	catch(Exception &e)
 	{
@@ -31,6 +31,9 @@ This class is the basis for the reverse engineering feature.
 #include "tableobject.h"
 #include <QTextStream>
 #include <QApplication>
+#include <unordered_set>
+#include <QMutex>
+#include <memory>
 
 class Catalog {
 	private:
@@ -45,24 +48,43 @@ class Catalog {
 		//! \brief Query used to retrieve extension objects.
 		GetExtensionObjsSql,
 
-		//! \brief This pattern matches the PostgreSQL array values in format [n:n]={a,b,c,d,...} or {a,b,c,d,...}
-		ArrayPattern,
-
 		//! \brief Holds a constant string used to mark invalid filter patterns
 		InvFilterPattern,
 
 		AliasPlaceholder;
 
-		/*! \brief Stores the oid of objects that are created by extension.
-		 * The keys of this map are the names of the extensions that hold objects in the database,
-		 * The values of this map are the list of objects oids. This is used to speed up the checking
-		 * if an certain object is owned by a certain extension (see isExtensionObject()) */
-		std::map<QString, QStringList> ext_objects;
+		/*! \brief Stores the metadata of a database that is needed by the catalog queries. This data is retrieved
+		 * once per database (connection) and shared by all the catalogs connected to it as well as their copies */
+		struct DatabaseContext {
+			//! \brief Stores the server version (major only) used to generate the catalog queries
+			QString pgsql_version;
+
+			//! \brief Stores the last system object identifier. This is used to filter system objects
+			unsigned last_sys_oid = 0;
+
+			/*! \brief Stores the oid of objects that are created by extension.
+			 * The keys of this map are the names of the extensions that hold objects in the database,
+			 * The values of this map are the sets of objects oids. This is used to speed up the checking
+			 * if an certain object is owned by a certain extension (see isExtensionObject()) */
+			std::map<QString, std::unordered_set<unsigned>> ext_objects;
+
+			//! \brief Stores the oids of all objects created by extensions (see isExtensionObject())
+			std::unordered_set<unsigned> ext_obj_oids;
 
-		/*! \brief Stores in comma seperated way the oids of all objects created by extensions. This
-		 * 	attribute is use to create the catalog query that filters objects that are created or not
-		 *  by extensions. */
-		QString ext_objs_oids;
+			/*! \brief Stores in comma seperated way the oids of all objects created by extensions. This
+			 * 	attribute is use to create the catalog query that filters objects that are created or not
+			 *  by extensions. */
+			QString ext_objs_oids;
+		};
+
+		//! \brief Stores the contexts of the databases already read by catalogs. The keys are the connection strings
+		static std::map<QString, std::shared_ptr<const DatabaseContext>> db_contexts;
+
+		//! \brief Guards the access to the contexts cache since catalogs can be used in threads (e.g. during import)
+		static QMutex db_contexts_mutex;
+
+		//! \brief The context of the database in which the catalog is connected
+		std::shared_ptr<const DatabaseContext> db_context;
 
 		//! \brief Stores the name filters for each type of object. (See setObjectFilters())
 		std::map<ObjectType, QString> obj_filters;
@@ -94,10 +116,7 @@ class Catalog {
 		//! \brief Connection used to query the pg_catalog
 		Connection connection;
 
-		//! \brief Stores the last system object identifier. This is used to filter system objects
-		unsigned last_sys_oid,
-
-		filter;
+		unsigned filter;
 
 		//! \brief Indicates if the catalog must filter system objects
 		bool exclude_sys_objs,
@@ -114,6 +133,16 @@ class Catalog {
 		//! \brief Indicates that the name filtering should occur in the objects' signature instead of their names
 		match_signature;
 
+		/*! \brief Returns the connection of the catalog connecting it when needed. Catalogs only connect
+		 * to the server when the first query is executed so copies of them are cheap to create */
+		Connection &getConnection();
+
+		//! \brief Retrieves the last system oid, the extension objects and the server version of the connected database
+		std::shared_ptr<const DatabaseContext> loadDatabaseContext();
+
+		//! \brief Returns the server version (major only) stored in the database context or retrieved from the connection
+		QString getPgSQLVersion();
+
 		/*! \brief Load the schema parser buffer with the catalog query using identified by qry_id.
 		The method will cache the catalog query if it's not cached yet (only when use_cached_queries=true) */
 		void loadCatalogQuery(const QString &qry_id);
@@ -173,8 +202,13 @@ class Catalog {
 		//! \brief Shows all objects including system objects and extension object.
 		ListAllObjects=16;
 
-		//! \brief Changes the current connection used by the catalog
-		void setConnection(Connection &conn);
+		/*! \brief Changes the current connection used by the catalog. The database metadata (last system oid, extension objects
+		 * and server version) is retrieved from the server only the first time a catalog is connected to the database or
+		 * when refresh_context is true. Otherwise, the metadata cached by previous connections is reused */
+		void setConnection(Connection &conn, bool refresh_context = false);
+
+		//! \brief Removes all the cached databases metadata forcing the next connections to retrieve them again
+		static void clearDatabaseContexts();
 
 		/*! \brief Closes the connection used by the catalog.
 	Once this method is called the user must call setConnection() again or the
@@ -209,6 +243,15 @@ class Catalog {
 		 * in the second parameter. */
 		bool isExtensionObject(unsigned oid, const QString &ext_name = "");
 
+		/*! \brief Returns the oids of the objects created by the named extension or the oids of all
+		 * extension objects when no name is provided. These oids are retrieved in setConnection() */
+		const std::unordered_set<unsigned> &getExtensionObjectsOids(const QString &ext_name = "");
+
+		/*! \brief Defines the objects created by extensions. The keys of the map are the extensions names
+		 * and the values the oids of their objects. This method is called by setConnection() so it only needs to be
+		 * called directly when the extension objects are already known */
+		void setExtensionObjects(const std::map<QString, std::vector<unsigned>> &ext_objs);
+
 		/*! \brief Returns the count for the specified object type. A schema name can be specified
 		in order to filter only objects of the specifed schema */
 		unsigned getObjectCount(ObjectType obj_type, const QString &sch_name="", const QString &tab_name="", attribs_map extra_attribs=attribs_map());
@@ -237,6 +280,11 @@ class Catalog {
 		//! \brief Returns a set of multiple attributes (several tuples) for the specified object type
 		std::vector<attribs_map> getMultipleAttributes(ObjectType obj_type, attribs_map extra_attribs=attribs_map());
 
+		/*! \brief Returns the attributes of the columns of all the provided tables using a single catalog query.
+		 * The key of the returned map is the oid of a table and the value the attributes of its columns.
+		 * The col_ids map can be used to retrieve only the columns (attribute numbers) of each table in it */
+		std::map<unsigned, std::vector<attribs_map>> getTablesColumnsAttributes(const std::vector<unsigned> &tab_oids, const std::map<unsigned, std::vector<unsigned>> &col_ids = {});
+
 		/*! \brief Returns a set of multiple attributes (several tuples) for the specified catalog schema file.
 		 * This version of the method differs from the one in which the user need to provide the object type.
 		 * This one, the user is responsible to provide all attributes that will be parsed together with the
@@ -263,6 +311,11 @@ class Catalog {
 		 * The parameter incl_sys_objs will also count the system objects not only used created ones */
 		unsigned getObjectCount(bool incl_sys_objs);
 
+		/*! \brief Returns the dependencies registered in pg_depend between the objects in the provided list.
+		 * The key of the returned map is the oid of an object and the value the oids of the objects it depends on.
+		 * Objects that don't depend on any other object in the list are not present in the map */
+		std::map<unsigned, std::vector<unsigned>> getObjectsDependencies(const std::vector<unsigned> &oids);
+
 		//! \brief Parse a PostgreSQL array value and return the elements in a string list
 		static QStringList parseArrayValues(const QString &array_val);
 
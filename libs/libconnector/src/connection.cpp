@@ -54,7 +54,6 @@ const QString Connection::ServerVersion=QString("server-version");
 bool Connection::notice_enabled=false;
 bool Connection::print_sql=false;
 bool Connection::silence_conn_err=true;
-QStringList Connection::notices;
 
 Connection::Connection()
 {
@@ -165,9 +164,9 @@ void Connection::generateConnectionString()
 		connection_str.clear();
 }
 
-void Connection::noticeProcessor(void *, const char *message)
+void Connection::noticeProcessor(void *conn, const char *message)
 {
-	notices.push_back(QString(message));
+	static_cast<Connection *>(conn)->notices.push_back(QString(message));
 }
 
 void Connection::validateConnectionStatus()
@@ -262,7 +261,7 @@ void Connection::connect()
 		PQsetNoticeReceiver(connection, disableNoticeOutput, nullptr);
 	else
 		//Enable the notice/warnings in the connection by pushing them into the list of generated notices
-		PQsetNoticeProcessor(connection, noticeProcessor, nullptr);
+		PQsetNoticeProcessor(connection, noticeProcessor, this);
 }
 
 void Connection::close()
@@ -480,6 +479,148 @@ void Connection::executeDDLCommand(const QString &sql)
 	PQclear(sql_res);
 }
 
+void Connection::executeCopyFromCommand(const QString &copy_cmd, const QByteArray &data)
+{
+	PGresult *sql_res=nullptr;
+	QString error, field;
+
+	//Raise an error in case the user try to close a not opened connection
+	if(!connection)
+		throw Exception(ErrorCode::OprNotAllocatedConnection, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	validateConnectionStatus();
+	notices.clear();
+	sql_res=PQexec(connection, copy_cmd.toStdString().c_str());
+
+	//Prints the SQL to stdout when the flag is active
+	if(print_sql)
+	{
+		QTextStream out(stdout);
+		out << QString("\n---\n") << copy_cmd << Qt::endl;
+	}
+
+	//The server must be waiting for the data to be copied otherwise the command failed
+	if(PQresultStatus(sql_res) != PGRES_COPY_IN)
+	{
+		field = QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+		PQclear(sql_res);
+
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+						.arg(PQerrorMessage(connection)),
+						ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr,	field);
+	}
+
+	PQclear(sql_res);
+
+	//Sending the whole buffer at once and finishing the copy (aborting it in case of errors)
+	if(PQputCopyData(connection, data.constData(), static_cast<int>(data.size())) != 1)
+	{
+		error = PQerrorMessage(connection);
+		PQputCopyEnd(connection, error.toStdString().c_str());
+	}
+	else if(PQputCopyEnd(connection, nullptr) != 1)
+		error = PQerrorMessage(connection);
+
+	//Retrieving the final result of the copy
+	while((sql_res = PQgetResult(connection)))
+	{
+		if(PQresultStatus(sql_res) != PGRES_COMMAND_OK && field.isEmpty())
+		{
+			error = PQresultErrorMessage(sql_res);
+			field = QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+		}
+
+		PQclear(sql_res);
+	}
+
+	if(!error.isEmpty())
+	{
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted).arg(error),
+						ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr,	field);
+	}
+}
+
+unsigned Connection::executeCopyToCommand(const QString &copy_cmd, QIODevice &output, const std::function<void(qint64)> &written_fn)
+{
+	PGresult *sql_res=nullptr;
+	QString error, field;
+	char *buffer = nullptr;
+	int len = 0;
+	qint64 written = 0;
+	unsigned rows = 0;
+
+	//Raise an error in case the user try to close a not opened connection
+	if(!connection)
+		throw Exception(ErrorCode::OprNotAllocatedConnection, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+	validateConnectionStatus();
+	notices.clear();
+	sql_res=PQexec(connection, copy_cmd.toStdString().c_str());
+
+	//Prints the SQL to stdout when the flag is active
+	if(print_sql)
+	{
+		QTextStream out(stdout);
+		out << QString("\n---\n") << copy_cmd << Qt::endl;
+	}
+
+	//The server must be sending the data otherwise the command failed
+	if(PQresultStatus(sql_res) != PGRES_COPY_OUT)
+	{
+		field = QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+		PQclear(sql_res);
+
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted)
+						.arg(PQerrorMessage(connection)),
+						ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr,	field);
+	}
+
+	PQclear(sql_res);
+
+	/* Writing each chunk (a row, for text/csv formats) right away. In case the output can't be written
+	 * we keep consuming the data so the connection reaches a consistent state, since a COPY TO can't be
+	 * interrupted from the client side other than by a cancel request */
+	while((len = PQgetCopyData(connection, &buffer, 0)) > 0)
+	{
+		if(error.isEmpty() && output.write(buffer, len) != len)
+			error = output.errorString();
+
+		PQfreemem(buffer);
+		written += len;
+
+		if(error.isEmpty() && written_fn)
+			written_fn(written);
+	}
+
+	if(len == -2)
+		error = PQerrorMessage(connection);
+
+	//Retrieving the final result of the copy
+	while((sql_res = PQgetResult(connection)))
+	{
+		if(PQresultStatus(sql_res) != PGRES_COMMAND_OK)
+		{
+			if(field.isEmpty())
+			{
+				error = PQresultErrorMessage(sql_res);
+				field = QString(PQresultErrorField(sql_res, PG_DIAG_SQLSTATE));
+			}
+		}
+		else
+			rows = QString(PQcmdTuples(sql_res)).toUInt();
+
+		PQclear(sql_res);
+	}
+
+	if(!error.isEmpty())
+	{
+		throw Exception(Exception::getErrorMessage(ErrorCode::SQLCommandNotExecuted).arg(error),
+						ErrorCode::SQLCommandNotExecuted, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr,	field);
+	}
+
+	return rows;
+}
+
 void Connection::setDefaultForOperation(unsigned op_id, bool value)
 {
 	if(op_id > OpNone)
@@ -30,6 +30,8 @@
 #include "attribsmap.h"
 #include <QRegularExpression>
 #include <QDateTime>
+#include <QIODevice>
+#include <functional>
 
 class Connection {
 	private:
@@ -52,9 +54,9 @@ class Connection {
 		errors related to the exceeded timeout */
 		unsigned cmd_exec_timeout;
 
-		/*! \brief List of notices generated during the command execution
+		/*! \brief List of notices generated during the command execution in this connection.
 		The list is filled only if notice_enabled is true */
-		static QStringList notices;
+		QStringList notices;
 
 		//! \brief Generates the connection string based on the parameter map
 		void generateConnectionString();
@@ -67,9 +69,9 @@ class Connection {
 		static void disableNoticeOutput(void *, const PGresult *){}
 
 		/*! \brief This function overrides the default notice handler of the connections and
-		captures and stores all message in a string list that can be retrieved by the user
-		for later usage */
-		static void noticeProcessor(void *, const char *message);
+		captures and stores all message in the notices list of the connection passed in conn
+		so they can be retrieved by the user for later usage */
+		static void noticeProcessor(void *conn, const char *message);
 
 		//! \brief Indicates if notices are enabled
 		static bool notice_enabled,
@@ -204,9 +206,9 @@ class Connection {
 		If major_only is true only XX.YY portion is returned */
 		QString getPgSQLVersion(bool major_only=false);
 
-		/*! Returns all notices/warnings produced by the command executions.
+		/*! Returns all notices/warnings produced by the last command execution in this connection.
 		This method will return an empty list if notices/warnings are disabled in the connections */
-		static QStringList getNotices();
+		QStringList getNotices();
 
 		/*! \brief Change the current database to the specified db name using the parameters from the current
 		stablished connection causing the connection to be reset and moved to the new database.
@@ -232,6 +234,16 @@ class Connection {
 		 to be an data definition one  */
 		void executeDDLCommand(const QString &sql);
 
+		/*! \brief Executes a COPY ... FROM STDIN command sending the provided buffer as the data to be copied.
+		 The buffer must be formatted according to the format (text, csv, binary) specified in the command */
+		void executeCopyFromCommand(const QString &copy_cmd, const QByteArray &data);
+
+		/*! \brief Executes a COPY ... TO STDOUT command writing the data chunks to the output device as soon as they
+		 arrive from the server, so the copied data is never held entirely in memory. The optional function is called
+		 after each chunk is written with the total amount of bytes written so far. The copy can be aborted from another
+		 thread via requestCancel(). Returns the amount of rows copied */
+		unsigned executeCopyToCommand(const QString &copy_cmd, QIODevice &output, const std::function<void(qint64)> &written_fn = nullptr);
+
 		//! \brief Toggles the default status for the connect in the specified operation (OP_??? constants).
 		void setDefaultForOperation(unsigned op_id, bool value);
 
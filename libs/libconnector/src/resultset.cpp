@@ -81,6 +81,7 @@ void ResultSet::clearResultSet()
 	empty_result=false;
 	is_res_copied=false;
 	current_tuple=-1;
+	column_names.clear();
 }
 
 QString ResultSet::getColumnName(int column_idx)
@@ -207,8 +208,18 @@ attribs_map ResultSet::getTupleValues()
 	if(current_tuple < 0 || current_tuple >= getTupleCount())
 		throw Exception(ErrorCode::RefInvalidTuple, __PRETTY_FUNCTION__, __FILE__, __LINE__);
 
-	for(int col=0; col < getColumnCount(); col++)
-		tup_vals[getColumnName(col)]=getColumnValue(col);
+	int col_count = getColumnCount();
+
+	if(column_names.empty())
+	{
+		for(int col=0; col < col_count; col++)
+			column_names.push_back(getColumnName(col));
+	}
+
+	tup_vals.reserve(col_count);
+
+	for(int col=0; col < col_count; col++)
+		tup_vals[column_names[col]]=PQgetvalue(sql_result, current_tuple, col);
 
 	return tup_vals;
 }
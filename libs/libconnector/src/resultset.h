@@ -61,6 +61,10 @@ class ResultSet {
 		//! \brief Stores the result object of a SQL command
 		PGresult *sql_result;
 
+		/*! \brief Stores the names of the result's columns. The names are created once and shared
+		 * (implicitly) by the keys of the maps returned by getTupleValues() */
+		std::vector<QString> column_names;
+
 		/*! \brief This class may be constructed from a
 	 result of SQL command generated in DBConnection class */
 		ResultSet(PGresult *sql_result);
@@ -95,6 +95,7 @@ void BaseGraphicObject::setLayersAttribute()
 
 void BaseGraphicObject::setPositionAttribute()
 {
+	restoreAttributes();
 	attributes[Attributes::XPos]=QString("%1").arg(position.x());
 	attributes[Attributes::YPos]=QString("%1").arg(position.y());
 	attributes[Attributes::Position]=schparser.getCodeDefinition(Attributes::Position, attributes, SchemaParser::XmlDefinition);
@@ -73,18 +73,27 @@ const QString BaseObject::objs_sql[BaseObject::ObjectTypeCount]={
 	 starts at 4k because the id ranges 0, 1k, 2k, 3k, 4k
 	 are respectively assigned to objects of classes Role, Tablespace
 	 DatabaseModel, Schema, Tag */
-unsigned BaseObject::global_id=5000;
+std::atomic<unsigned> BaseObject::global_id(5000);
 
 QString BaseObject::pgsql_ver=PgSqlVersions::DefaulVersion;
-bool BaseObject::use_cached_code=true;
-bool BaseObject::escape_comments=true;
+std::atomic<unsigned> BaseObject::pgsql_ver_id(0);
+std::atomic<unsigned> BaseObject::pgsql_ver_seq(0);
+std::atomic<bool> BaseObject::use_cached_code(true);
+std::atomic<bool> BaseObject::escape_comments(true);
+QReadWriteLock BaseObject::settings_lock;
+thread_local BaseObject::CodeGenSettings *BaseObject::thread_settings=nullptr;
+
+thread_local SchemaParser BaseObject::schparser;
+QStringList BaseObject::attribs_names[BaseObject::ObjectTypeCount];
+QReadWriteLock BaseObject::attribs_names_lock;
 
 BaseObject::BaseObject()
 {
 	object_id=BaseObject::global_id++;
 	is_protected=system_obj=sql_disabled=false;
 	code_invalidated=true;
-	obj_type=ObjectType::BaseObject;
+	cached_code_ver_id=getPgSQLVersionId();
+	obj_type=fmt_name_type=ObjectType::BaseObject;
 	schema=nullptr;
 	owner=nullptr;
 	tablespace=nullptr;
@@ -114,12 +123,38 @@ unsigned BaseObject::getGlobalId()
 
 void BaseObject::setEscapeComments(bool value)
 {
-	escape_comments = value;
+	if(thread_settings)
+		thread_settings->escape_comments = value;
+	else
+		escape_comments = value;
 }
 
 bool BaseObject::isEscapeComments()
 {
-	return escape_comments;
+	return thread_settings ? thread_settings->escape_comments : escape_comments.load();
+}
+
+BaseObject::ScopedCodeGenSettings::ScopedCodeGenSettings()
+{
+	prev_settings = thread_settings;
+
+	if(prev_settings)
+		settings = *prev_settings;
+	else
+	{
+		QReadLocker locker(&settings_lock);
+		settings.pgsql_ver = pgsql_ver;
+		settings.pgsql_ver_id = pgsql_ver_id;
+		settings.use_cached_code = use_cached_code;
+		settings.escape_comments = escape_comments;
+	}
+
+	thread_settings = &settings;
+}
+
+BaseObject::ScopedCodeGenSettings::~ScopedCodeGenSettings()
+{
+	thread_settings = prev_settings;
 }
 
 QString BaseObject::getTypeName(ObjectType obj_type)
@@ -166,180 +201,80 @@ QString BaseObject::getSQLName(ObjectType obj_type)
 
 QString BaseObject::formatName(const QString &name, bool is_operator)
 {
-	bool is_formated=false;
-	QString frmt_name;
-	QByteArray raw_name;
-	unsigned char chr, chr1, chr2;
-	QRegularExpression fmt_name_regexp(QRegularExpression::anchoredPattern("(\")(.)+(\")"));
+	bool needs_fmt = false;
+	ushort chr = 0;
 
 	//Checking if the name is already formated enclosed by quotes
-	is_formated = fmt_name_regexp.match(name).hasMatch();
+	if(name.size() > 2 && name.front() == QChar('"') && name.back() == QChar('"'))
+		return name;
 
-	/* If the name is not formatted or it symbolizes the name of an operator
+	/* If the name is not formatted, it needs to symbolize the name of an operator
 		(which has characters invalid according to the rule and is the only exception
-		 to which its name is formatted even being invalid) or if the name is valid according
+		 to which its name is formatted even being invalid) or the name needs to be valid according
 		 with PostgreSQL rules for other types of objects */
-	if(!is_formated && (is_operator || isValidName(name)))
-	{
-		bool needs_fmt=false;
-		unsigned i = 0, qtd = 0;
-
-		raw_name.append(name.toUtf8());
-
-		/* Checks if the name has some upper case letter. If its the
-		 case the name will be enclosed in quotes */
-		needs_fmt = (!is_operator && name.contains(QRegularExpression("^[0-9]+")));
-
-		for(int idx = 0; idx < special_chars.size() && !needs_fmt; idx++)
-			needs_fmt = (!is_operator && special_chars.at(idx) != '_' && name.indexOf(special_chars.at(idx)) >= 0);
-
-		qtd=name.size();
-		i=0;
-		while(i < qtd && !needs_fmt)
-		{
-			chr=raw_name[i];
-
-			if(((i + 1) < (qtd-1)) &&
-					((chr >= 0xC2 && chr <= 0xDF) ||
-					 (chr >= 0xE0 && chr <= 0xEF)))
-				chr1=raw_name[i+1];
-			else
-				chr1=0;
-
-			if((i + 2) < (qtd-1) &&
-					chr >= 0xE0 && chr <= 0xEF)
-				chr2=raw_name[i+2];
-			else
-				chr2=0;
-
-			if(chr1!=0 && chr2!=0)
-				i+=3;
-			else if(chr1!=0 && chr2==0)
-				i+=2;
-			else
-				i++;
-
-			//2 bytes UTF-8 character
-			if((chr  >= 0xC2 && chr <= 0xDF &&
-				chr1 >= 0x80 && chr1 <= 0xBF) ||
-
-					//3 bytes UTF-8 character
-					(chr  >= 0xE0 && chr <= 0xEF &&
-					 chr1 >= 0x80 && chr1 <= 0xBF &&
-					 chr2 >= 0x80 && chr2 <= 0xBF) ||
-
-					QChar(chr).isUpper())
-			{
-				needs_fmt=true;
-			}
+	if(!is_operator && !isValidName(name))
+		return "";
 
-		}
+	/* Checks in a single pass if the name has some upper case letter, extended (non-ASCII) character,
+	 * starts with a number or has a special character. If its the case the name will be enclosed in quotes */
+	for(qsizetype i = 0; i < name.size() && !needs_fmt; i++)
+	{
+		chr = name.at(i).unicode();
 
-		if(needs_fmt || CoreUtilsNs::isReservedKeyword(name))
-			frmt_name=QString("\"%1\"").arg(name);
-		else
-			frmt_name=name;
+		if(chr >= 0x80 || (chr >= 'A' && chr <= 'Z'))
+			needs_fmt = true;
+		else if(!is_operator)
+			needs_fmt = (i == 0 && chr >= '0' && chr <= '9') ||
+									(chr != '_' && special_chars.contains(static_cast<char>(chr)));
 	}
-	else if(is_formated)
-		frmt_name=name;
 
-	return frmt_name;
+	if(needs_fmt || CoreUtilsNs::isReservedKeyword(name))
+		return QString("\"%1\"").arg(name);
+
+	return name;
 }
 
 bool BaseObject::isValidName(const QString &name)
 {
-	QString aux_name=name;
+	qsizetype i = 0, len = name.size();
+	ushort chr = 0;
 
-	if(aux_name.contains(QRegularExpression("^(\")(.)+(\")$")))
+	if(name.isEmpty())
+		return false;
+
+	//Checks if the name is enclosed in quotes, the quotes are ignored in the validation
+	if(len > 1 && name.front() == QChar('"') && name.back() == QChar('"'))
 	{
-		aux_name.remove(0,1);
-		aux_name.remove(aux_name.size()-1,1);
+		i++;
+		len--;
 	}
 
 	/* If the name is greater than the maximum size accepted
 	by PostgreSQL (currently 63 bytes) the name is invalid.
 	In this case the starting and ending quotes are discarded from
 	the name in order to validate the length. */
-	if(name.isEmpty() || aux_name.size() > ObjectNameMaxLength)
+	if((len - i) > ObjectNameMaxLength)
 		return false;
-	else
-	{
-		int i=0, len;
-		bool valid=true;
-		unsigned char chr='\0', chr1='\0', chr2='\0';
-		QByteArray raw_name;
 
-		raw_name.append(name.toUtf8());
-		len=raw_name.size();
-
-		chr=raw_name[0];
-		if(len > 1)
-			chr1=raw_name[len-1];
+	for(; i < len; i++)
+	{
+		chr = name.at(i).unicode();
 
-		//Checks if the name is enclosed in quotes
-		if(chr=='\"' && chr1=='\"')
+		/* Validation of simple ASCI characters.
+			Checks if the name has the characters in the set [ a-z A-Z 0-9 _ . @ $ - : space () <>] */
+		if(chr < 0x80)
 		{
-			/* Validates the name but the validation will continue until the
-			end of string (or the last quote) */
-			valid=true; i++; len--;
+			if(!((chr >= 'a' && chr <='z') || (chr >= 'A' && chr <='Z') ||
+					 (chr >= '0' && chr <='9') || special_chars.contains(static_cast<char>(chr))))
+				return false;
 		}
-
-		while(valid && i < len)
-		{
-			chr=raw_name[i];
-
-			/* Validation of simple ASCI characters.
-				Checks if the name has the characters in the set [ a-z A-Z 0-9 _ . @ $ - : space () <>] */
-			if((chr >= 'a' && chr <='z') || (chr >= 'A' && chr <='Z') ||
-					(chr >= '0' && chr <='9') || special_chars.contains(chr))
-			{
-				valid=true;
-				i++;
-			}
-			else valid=false;
-
-			/* Validation of UTF8 charactes (2 and 3 bytes long).
-			Reference: http://www.fileformat.info/info/unicode/utf8.htm
-								 http://en.wikipedia.org/wiki/UTF-8
-
-			Snippet extracted from the above url:
-
-			The value of each individual byte indicates its UTF-8 function, as follows:
-			00 to 7F hex (0 to 127): first and only byte of a sequence.
-			80 to BF hex (128 to 191): continuing byte in a multi-byte sequence.
-			C2 to DF hex (194 to 223): first byte of a two-byte sequence.
-			E0 to EF hex (224 to 239): first byte of a three-byte sequence.  */
-			if(!valid && (i < len-1))
-			{
-				chr1=raw_name[i+1];
-
-				if((i + 2) <= (len-1))
-					chr2=raw_name[i+2];
-				else
-					chr2=0;
-
-				//UTF-8 character with 2 bytes length
-				if((chr  >= 0xC2 && chr <= 0xDF &&
-					chr1 >= 0x80 && chr1 <= 0xBF) ||
-
-						//UTF-8 character with 3 bytes length
-						(chr  >= 0xE0 && chr <= 0xEF &&
-						 chr1 >= 0x80 && chr1 <= 0xBF &&
-						 chr2 >= 0x80 && chr2 <= 0xBF))
-					valid=true;
-
-				//Increments the counter in the size of the validated char
-				if(chr >= 0xC2 && chr <= 0xDF)
-					//2 bytes char
-					i+=2;
-				else
-					//3 bytes char
-					i+=3;
-			}
-		}
-
-		return valid;
+		/* Extended characters are accepted only when they are encoded in UTF-8
+		 * with 2 or 3 bytes, meaning that surrogate pairs (4 bytes chars) are rejected */
+		else if(QChar::isSurrogate(chr))
+			return false;
 	}
+
+	return true;
 }
 
 void BaseObject::setDatabase(BaseObject *db)
@@ -362,7 +297,7 @@ void BaseObject::setProtected(bool value)
 void BaseObject::setName(const QString &name)
 {
 	QString aux_name=name;
-	bool is_quoted=aux_name.contains(QRegularExpression("^(\")(.)+(\")$"));
+	bool is_quoted=(aux_name.size() > 2 && aux_name.front() == QChar('"') && aux_name.back() == QChar('"'));
 
 	//Raises an error if the passed name is invalid
 	if(!isValidName(aux_name))
@@ -379,6 +314,22 @@ void BaseObject::setName(const QString &name)
 	aux_name.remove('"');
 	setCodeInvalidated(this->obj_name!=aux_name);
 	this->obj_name=aux_name;
+	cacheFormattedName();
+}
+
+void BaseObject::cacheFormattedName()
+{
+	fmt_name_src = obj_name;
+	fmt_name_type = obj_type;
+	fmt_name = formatName(obj_name, obj_type == ObjectType::Operator);
+}
+
+QString BaseObject::getFormattedName()
+{
+	if(fmt_name_type == obj_type && fmt_name_src == obj_name)
+		return fmt_name;
+
+	return formatName(obj_name, obj_type == ObjectType::Operator);
 }
 
 void BaseObject::setAlias(const QString &alias)
@@ -587,11 +538,10 @@ QString BaseObject::getName(bool format, bool prepend_schema)
 {
 	if(format)
 	{
-		QString aux_name;
-		aux_name=formatName(this->obj_name, (obj_type==ObjectType::Operator));
+		QString aux_name = getFormattedName();
 
 		if(this->schema && prepend_schema)
-			aux_name=formatName(this->schema->getName(format)) + QChar('.') + aux_name;
+			aux_name = this->schema->getFormattedName() + QChar('.') + aux_name;
 
 		if(!aux_name.isEmpty())
 			return aux_name;
@@ -716,6 +666,8 @@ bool BaseObject::isSystemObject()
 
 void BaseObject::setBasicAttributes(bool format_name)
 {
+	restoreAttributes();
+
 	if(attributes[Attributes::Name].isEmpty())
 		attributes[Attributes::Name]=this->getName(format_name);
 
@@ -747,7 +699,8 @@ QString BaseObject::getCodeDefinition(unsigned def_type, bool reduced_form)
 	{
 		bool format=false;
 
-		schparser.setPgSQLVersion(BaseObject::pgsql_ver);
+		restoreAttributes();
+		schparser.setPgSQLVersion(BaseObject::getPgSQLVersion());
 		attributes[Attributes::SqlDisabled]=(sql_disabled ? Attributes::True : "");
 
 		//Formats the object's name in case the SQL definition is being generated
@@ -810,8 +763,8 @@ QString BaseObject::getCodeDefinition(unsigned def_type, bool reduced_form)
 		{
 			if(def_type==SchemaParser::SqlDefinition)
 			{
-				QString escape_comm = getEscapedComment(escape_comments);
-				attributes[Attributes::EscapeComment]=escape_comments ? Attributes::True : "";
+				QString escape_comm = getEscapedComment(isEscapeComments());
+				attributes[Attributes::EscapeComment]=isEscapeComments() ? Attributes::True : "";
 				attributes[Attributes::Comment]=escape_comm;
 			}
 			else
@@ -884,14 +837,8 @@ QString BaseObject::getCodeDefinition(unsigned def_type, bool reduced_form)
 			clearAttributes();
 
 			//Database object doesn't handles cached code.
-			if(use_cached_code && obj_type!=ObjectType::Database)
-			{
-				if(def_type==SchemaParser::SqlDefinition ||
-						(!reduced_form && def_type==SchemaParser::XmlDefinition))
-					cached_code[def_type]=code_def;
-				else if(reduced_form)
-					cached_reduced_code=code_def;
-			}
+			if(isCachedCodeEnabled() && obj_type!=ObjectType::Database)
+				setCachedCode(def_type, reduced_form, code_def);
 
 			code_invalidated=false;
 		}
@@ -920,15 +867,46 @@ void BaseObject::setAttribute(const QString &attrib, const QString &value)
 
 void BaseObject::clearAttributes()
 {
-	attribs_map::iterator itr, itr_end;
+	QStringList &names = attribs_names[enum_cast(obj_type)];
+	bool has_new_attribs = false;
+
+	attribs_names_lock.lockForRead();
+
+	for(auto &itr : attributes)
+	{
+		if(!names.contains(itr.first))
+		{
+			has_new_attribs = true;
+			break;
+		}
+	}
+
+	attribs_names_lock.unlock();
+
+	// Registering the names of the attributes not yet known for the object's type
+	if(has_new_attribs)
+	{
+		QWriteLocker locker(&attribs_names_lock);
+
+		for(auto &itr : attributes)
+		{
+			if(!names.contains(itr.first))
+				names.append(itr.first);
+		}
+	}
 
-	itr=attributes.begin();
-	itr_end=attributes.end();
+	// Swapping with an empty map so all the memory allocated by the attributes is released
+	attribs_map().swap(attributes);
+}
+
+void BaseObject::restoreAttributes()
+{
+	QReadLocker locker(&attribs_names_lock);
 
-	while(itr!=itr_end)
+	for(auto &name : attribs_names[enum_cast(obj_type)])
 	{
-		itr->second="";
-		itr++;
+		if(attributes.count(name) == 0)
+			attributes[name]="";
 	}
 }
 
@@ -1056,7 +1034,29 @@ void BaseObject::setPgSQLVersion(const QString &version)
 {
 	try
 	{
-		pgsql_ver = PgSqlVersions::parseString(version);
+		QString ver = PgSqlVersions::parseString(version);
+
+		/* Changing the version identifier so the cached SQL code of all objects is regenerated.
+		 * The identifiers are unique among all threads so the code cached by a thread using
+		 * another version is never taken as valid */
+		if(thread_settings)
+		{
+			if(ver != thread_settings->pgsql_ver)
+			{
+				thread_settings->pgsql_ver = ver;
+				thread_settings->pgsql_ver_id = ++pgsql_ver_seq;
+			}
+		}
+		else
+		{
+			QWriteLocker locker(&settings_lock);
+
+			if(ver != pgsql_ver)
+			{
+				pgsql_ver = ver;
+				pgsql_ver_id = ++pgsql_ver_seq;
+			}
+		}
 	}
 	catch(Exception &e)
 	{
@@ -1066,17 +1066,55 @@ void BaseObject::setPgSQLVersion(const QString &version)
 
 QString BaseObject::getPgSQLVersion()
 {
+	if(thread_settings)
+		return thread_settings->pgsql_ver;
+
+	QReadLocker locker(&settings_lock);
 	return pgsql_ver;
 }
 
+unsigned BaseObject::getPgSQLVersionId()
+{
+	return thread_settings ? thread_settings->pgsql_ver_id : pgsql_ver_id.load();
+}
+
 attribs_map BaseObject::getSearchAttributes()
 {
-	return search_attribs;
+	attribs_map attribs;
+
+	configureSearchAttributes();
+	attribs.swap(search_attribs);
+
+	return attribs;
+}
+
+size_t BaseObject::getMemoryUsage()
+{
+	size_t mem_usage = 0;
+
+	for(auto str : { &comment, &obj_name, &alias, &appended_sql, &prepended_sql, &fmt_name, &fmt_name_src })
+		mem_usage += str->capacity() * sizeof(QChar);
+
+	for(auto code : { &cached_code[0], &cached_code[1], &cached_reduced_code })
+		mem_usage += code->capacity();
+
+	for(auto &itr : attributes)
+		mem_usage += sizeof(itr) + sizeof(void *) + (itr.second.capacity() * sizeof(QChar));
+
+	return mem_usage;
 }
 
 void BaseObject::enableCachedCode(bool value)
 {
-	use_cached_code=value;
+	if(thread_settings)
+		thread_settings->use_cached_code=value;
+	else
+		use_cached_code=value;
+}
+
+bool BaseObject::isCachedCodeEnabled()
+{
+	return thread_settings ? thread_settings->use_cached_code : use_cached_code.load();
 }
 
 void BaseObject::operator = (BaseObject &obj)
@@ -1087,23 +1125,29 @@ void BaseObject::operator = (BaseObject &obj)
 	this->database=obj.database;
 	this->comment=obj.comment;
 	this->obj_name=obj.obj_name;
+	this->fmt_name=obj.fmt_name;
+	this->fmt_name_src=obj.fmt_name_src;
+	this->fmt_name_type=obj.fmt_name_type;
 	this->alias=obj.alias;
 	this->obj_type=obj.obj_type;
 	this->is_protected=obj.is_protected;
 	this->sql_disabled=obj.sql_disabled;
 	this->system_obj=obj.system_obj;
-	this->setCodeInvalidated(use_cached_code);
+	this->setCodeInvalidated(isCachedCodeEnabled());
 }
 
 void BaseObject::setCodeInvalidated(bool value)
 {
-	if(use_cached_code && value!=code_invalidated)
+	if(isCachedCodeEnabled() && value!=code_invalidated)
 	{
 		if(value)
 		{
 			cached_reduced_code.clear();
 			cached_code[0].clear();
 			cached_code[1].clear();
+			cached_reduced_code.squeeze();
+			cached_code[0].squeeze();
+			cached_code[1].squeeze();
 		}
 
 		code_invalidated=value;
@@ -1122,7 +1166,7 @@ void BaseObject::configureSearchAttributes()
 
 bool BaseObject::isCodeInvalidated()
 {
-	return (use_cached_code && code_invalidated);
+	return (isCachedCodeEnabled() && code_invalidated);
 }
 
 bool BaseObject::isCodeDiffersFrom(const QString &xml_def1, const QString &xml_def2, const QStringList &ignored_attribs, const QStringList &ignored_tags)
@@ -1191,7 +1235,7 @@ bool BaseObject::isCodeDiffersFrom(BaseObject *object, const QStringList &ignore
 
 QString BaseObject::getCachedCode(unsigned def_type, bool reduced_form)
 {
-	if(use_cached_code && def_type==SchemaParser::SqlDefinition && schparser.getPgSQLVersion()!=BaseObject::pgsql_ver)
+	if(isCachedCodeEnabled() && def_type==SchemaParser::SqlDefinition && cached_code_ver_id!=getPgSQLVersionId())
 		code_invalidated=true;
 
 	if(!code_invalidated &&
@@ -1199,14 +1243,49 @@ QString BaseObject::getCachedCode(unsigned def_type, bool reduced_form)
 			 (def_type==SchemaParser::XmlDefinition  && reduced_form && !cached_reduced_code.isEmpty())))
 	{
 		if(def_type==SchemaParser::XmlDefinition  && reduced_form)
-			return cached_reduced_code;
+			return unpackCode(cached_reduced_code);
 		else
-			return cached_code[def_type];
+			return unpackCode(cached_code[def_type]);
 	}
 	else
 		return "";
 }
 
+void BaseObject::setCachedCode(unsigned def_type, bool reduced_form, const QString &code)
+{
+	if(def_type==SchemaParser::SqlDefinition ||
+		 (!reduced_form && def_type==SchemaParser::XmlDefinition))
+		cached_code[def_type]=packCode(code);
+	else if(reduced_form)
+		cached_reduced_code=packCode(code);
+
+	if(def_type==SchemaParser::SqlDefinition)
+		cached_code_ver_id=getPgSQLVersionId();
+}
+
+QByteArray BaseObject::packCode(const QString &code)
+{
+	QByteArray buffer = code.toUtf8();
+
+	/* The first byte of the packed code indicates if the remaining bytes are
+	 * compressed (Z) or just the UTF-8 representation of the code (U) */
+	if(buffer.size() > CodeCompressThreshold)
+		return QByteArray(1, 'Z') + qCompress(buffer, 1);
+
+	return buffer.prepend('U');
+}
+
+QString BaseObject::unpackCode(const QByteArray &code)
+{
+	if(code.isEmpty())
+		return "";
+
+	if(code.at(0) == 'Z')
+		return QString::fromUtf8(qUncompress(reinterpret_cast<const uchar *>(code.constData()) + 1, code.size() - 1));
+
+	return QString::fromUtf8(code.constData() + 1, code.size() - 1);
+}
+
 QString BaseObject::getDropDefinition(bool cascade)
 {
 	try
@@ -1216,7 +1295,7 @@ QString BaseObject::getDropDefinition(bool cascade)
 			attribs_map attribs;
 
 			setBasicAttributes(true);
-			schparser.setPgSQLVersion(BaseObject::pgsql_ver);
+			schparser.setPgSQLVersion(BaseObject::getPgSQLVersion());
 			schparser.ignoreUnkownAttributes(true);
 			schparser.ignoreEmptyAttributes(true);
 
@@ -1247,7 +1326,7 @@ QString BaseObject::getAlterDefinition(QString sch_name, attribs_map &attribs, b
 		SchemaParser schparser;
 		QString alter_sch_file=GlobalAttributes::getSchemaFilePath(GlobalAttributes::AlterSchemaDir, sch_name);
 
-		schparser.setPgSQLVersion(BaseObject::pgsql_ver);
+		schparser.setPgSQLVersion(BaseObject::getPgSQLVersion());
 		schparser.ignoreEmptyAttributes(ignore_empty_attribs);
 		schparser.ignoreUnkownAttributes(ignore_ukn_attribs);
 		return schparser.getCodeDefinition(alter_sch_file, attribs);
@@ -1260,6 +1339,8 @@ QString BaseObject::getAlterDefinition(QString sch_name, attribs_map &attribs, b
 
 void BaseObject::copyAttributes(attribs_map &attribs)
 {
+	restoreAttributes();
+
 	if(!attribs.empty())
 	{
 		attributes[Attributes::HasChanges]=Attributes::True;
@@ -1326,8 +1407,8 @@ QString BaseObject::getAlterCommentDefinition(BaseObject *object, attribs_map at
 {
 	try
 	{
-		QString comm_this = this->getEscapedComment(escape_comments),
-				comm_obj = object->getEscapedComment(escape_comments);
+		QString comm_this = this->getEscapedComment(isEscapeComments()),
+				comm_obj = object->getEscapedComment(isEscapeComments());
 
 		if(comm_this != comm_obj)
 		{
@@ -1335,7 +1416,7 @@ QString BaseObject::getAlterCommentDefinition(BaseObject *object, attribs_map at
 				attributes[Attributes::Comment]=Attributes::Unset;
 			else
 			{
-				attributes[Attributes::EscapeComment] = escape_comments ? Attributes::True : "";
+				attributes[Attributes::EscapeComment] = isEscapeComments() ? Attributes::True : "";
 				attributes[Attributes::Comment]=comm_obj;
 			}
 
@@ -33,7 +33,9 @@
 #include <QRegularExpression>
 #include <QStringList>
 #include <QTextStream>
+#include <QReadWriteLock>
 #include <type_traits>
+#include <atomic>
 
 enum class ObjectType: unsigned {
 	Column,
@@ -81,29 +83,99 @@ enum class ObjectType: unsigned {
 };
 
 class BaseObject {
+	public:
+		//! \brief Stores the settings that affect the code generation of all objects
+		struct CodeGenSettings {
+			//! \brief PostgreSQL version used in SQL code generation
+			QString pgsql_ver;
+
+			/*! \brief Identifies the PostgreSQL version. This value changes every time the version changes
+			 * so the cached SQL code generated for another version can be detected */
+			unsigned pgsql_ver_id;
+
+			//! \brief Indicates the the cached code enabled.
+			bool use_cached_code,
+
+			escape_comments;
+		};
+
+		/*! \brief Overrides the code generation settings in the current thread during its lifetime. The scoped settings start
+		 * as a copy of the settings in use by the thread and the static setters (setPgSQLVersion(), enableCachedCode(), setEscapeComments())
+		 * change only them while the scope is alive, leaving the settings of other threads untouched. This way several models can
+		 * be loaded, exported or compared concurrently, each one using its own PostgreSQL version. Scopes can be nested */
+		class ScopedCodeGenSettings {
+			private:
+				CodeGenSettings settings;
+
+				//! \brief The settings in use by the thread before the scope creation (nullptr means the global ones)
+				CodeGenSettings *prev_settings;
+
+			public:
+				ScopedCodeGenSettings();
+				~ScopedCodeGenSettings();
+		};
+
 	private:
-		//! \brief Current PostgreSQL version used in SQL code generation
+		//! \brief Current PostgreSQL version used in SQL code generation (global settings)
 		static QString pgsql_ver;
 
-		//! \brief Indicates the the cached code enabled.
-		static bool use_cached_code;
+		//! \brief Indicates the the cached code enabled (global settings)
+		static std::atomic<bool> use_cached_code;
+
+		static std::atomic<bool> escape_comments;
+
+		//! \brief Guards the global PostgreSQL version
+		static QReadWriteLock settings_lock;
+
+		//! \brief The settings overridden in the current thread by a ScopedCodeGenSettings (nullptr means the global ones)
+		static thread_local CodeGenSettings *thread_settings;
 
-		static bool escape_comments;
+		//! \brief Generates the PostgreSQL version identifiers, being unique among all the threads' settings
+		static std::atomic<unsigned> pgsql_ver_seq;
 
 		//! \brief Stores the set of special (valid) chars that forces the object's name quoting
 		static const QByteArray special_chars;
 
+		/*! \brief Identifies the current PostgreSQL version used in SQL code generation (global settings). This value changes
+		 * every time the version changes so the cached SQL code generated for another version can be detected */
+		static std::atomic<unsigned> pgsql_ver_id;
+
+		//! \brief Returns the identifier of the PostgreSQL version in use by the current thread
+		static unsigned getPgSQLVersionId();
+
 		//! \brief Stores the database wich the object belongs
 		BaseObject *database;
 
+		//! \brief Cached codes larger than this amount of bytes are stored compressed (see packCode())
+		static constexpr int CodeCompressThreshold=512;
+
+		/*! \brief Stores the names of the attributes used by each object type (registered by clearAttributes()).
+		 * Since the objects' attributes are discarded after each code generation, these names are used to recreate
+		 * the attributes (with empty values) the next time the code is generated. See restoreAttributes() */
+		static QStringList attribs_names[];
+
+		//! \brief Guards the attributes names registry since the code can be generated by several threads
+		static QReadWriteLock attribs_names_lock;
+
+		/*! \brief Converts the provided code to the format in which it is stored in the cache (UTF-8 encoded and compressed
+		 * when its size exceeds CodeCompressThreshold) */
+		static QByteArray packCode(const QString &code);
+
+		//! \brief Converts the code stored in the cache (see packCode()) back to a string
+		static QString unpackCode(const QByteArray &code);
+
 	protected:
-		SchemaParser schparser;
+		/*! \brief The parser used to generate the objects' code definition. It's shared by all the objects
+		 * (one instance per thread) instead of each object having its own parser, which used to keep the last
+		 * loaded schema file and attributes in memory for every object in the model */
+		static thread_local SchemaParser schparser;
 
 		/*! \brief This static attribute is used to generate the unique identifier for objects.
 		 As object instances are created this value ​​are incremented. In some classes
 		 like Schema, DatabaseModel, Tablespace, Role, Type and Function id generators are
-		 used each with a custom different numbering range (see cited classes declaration). */
-		static unsigned global_id;
+		 used each with a custom different numbering range (see cited classes declaration).
+		 The counter is atomic so objects can be created by several threads at once */
+		static std::atomic<unsigned> global_id;
 
 		/*! \brief Stores the unique identifier for the object. This id is nothing else
 		 than the current value of global_id. This identifier is used
@@ -137,12 +209,16 @@ class BaseObject {
 				generate it again */
 		code_invalidated;
 
-		//! \brief Stores the cached xml and sql code
-		QString cached_code[2],
+		/*! \brief Stores the cached xml and sql code (in the format returned by packCode()).
+		 * The cached codes must be accessed through getCachedCode() and setCachedCode() */
+		QByteArray cached_code[2],
 
 		//! \brief Stores the xml code in reduced form
 		cached_reduced_code;
 
+		//! \brief The identifier of the PostgreSQL version used to generate the cached sql code (see pgsql_ver_id)
+		unsigned cached_code_ver_id;
+
 		/*! \brief This map stores the name of each object type associated to a schema file
 		 that generates the object's code definition */
 		static const QString objs_schemas[ObjectTypeCount];
@@ -186,13 +262,21 @@ class BaseObject {
 		//! \brief The set of SQL commands prepended on the objectc's definition
 		prepended_sql;
 
+		/*! \brief Stores the object's name formatted by formatName() as well as the raw name and object type
+		 * used to generate it. The formatted name is only reused while the raw name and type are the same */
+		QString fmt_name, fmt_name_src;
+
+		ObjectType fmt_name_type;
+
 		/*! \brief Stores the attributes and their values ​​shaped in strings to be used
 		 by SchemaParser on the object's code definition creation. The attribute
-		 name related to model objects are defined in ParsersAttributes namespace. */
+		 name related to model objects are defined in ParsersAttributes namespace.
+		 This map is only filled during the code generation, being discarded by clearAttributes() */
 		attribs_map attributes,
 
 		/*! \brief Stores the attributes and their vales which can be used by the
-		 * searching mechanism to match patters */
+		 * searching mechanism to match patters. This map is filled by configureSearchAttributes()
+		 * and discarded when getSearchAttributes() is called */
 		search_attribs;
 
 		/*! \brief Type of object, may have one of the values ​​of the enum ObjectType
@@ -217,13 +301,22 @@ class BaseObject {
 		//! \brief Changes the current object id to the most recent global id value.
 		static void updateObjectId(BaseObject *obj);
 
-		//! \brief Clears all the attributes used by the SchemaParser
+		/*! \brief Discards all the attributes used by the SchemaParser releasing their memory.
+		 * The names of the attributes are registered so they can be recreated by restoreAttributes() */
 		void clearAttributes();
 
+		/*! \brief Recreates, with empty values, the attributes registered for the object's type that are not
+		 * currently defined. This way the schema files find all the attributes they reference even though the
+		 * attributes map is discarded after each code generation. The values already set are left untouched */
+		void restoreAttributes();
+
 		/*! \brief Returns the cached code for the specified code type. This method returns an empty
 		 string in case of no code is cached */
 		QString getCachedCode(unsigned def_type, bool reduced_form);
 
+		//! \brief Stores the code in the cache for the specified code type
+		void setCachedCode(unsigned def_type, bool reduced_form, const QString &code);
+
 		/*! \brief Configures the DIF_SQL attribute depending on the type of the object. This attribute is used to know how
 		ALTER, COMMENT and DROP commands must be generated. Refer to schema files for comments, drop and alter. */
 		void setBasicAttributes(bool format_name);
@@ -242,6 +335,13 @@ class BaseObject {
 
 		QString getAlterCommentDefinition(BaseObject *object, attribs_map attributes);
 
+		//! \brief Stores the formatted form of the current object's name avoiding formatting it again in further calls to getName()
+		void cacheFormattedName();
+
+		/*! \brief Returns the object's name formatted without the schema name. If the cached formatted name
+		 * is outdated the name is formatted again but the cache is left untouched, so concurrent reads are safe */
+		QString getFormattedName();
+
 	public:
 		//! \brief Maximum number of characters that an object name on PostgreSQL can have
 		static constexpr int ObjectNameMaxLength=63;
@@ -492,6 +592,9 @@ class BaseObject {
 				performance compared to non cached code, even with the drawback of using more memory. */
 		static void enableCachedCode(bool value);
 
+		//! \brief Returns if the cached code is enabled in the current thread
+		static bool isCachedCodeEnabled();
+
 		/*! \brief Returns the valid object types in a vector. The types
 		ObjectType::ObjBaseObject, TYPE_ATTRIBUTE and ObjectType::ObjBaseTable aren't included in return vector.
 		By default table objects (columns, trigger, constraints, etc) are included. To
@@ -507,15 +610,21 @@ class BaseObject {
 		//! \brief Returns true when the child_type is in the list of children types of the parent_type
 		static bool isChildObjectType(ObjectType parent_type, ObjectType child_type);
 
-		//! \brief Sets the default version when generating the SQL code. This affects all instances of classes that is based upon this one
+		/*! \brief Sets the default version when generating the SQL code. This affects all instances of classes that is based upon this one
+		 * or, if the current thread has a ScopedCodeGenSettings alive, the objects which code is generated by that thread */
 		static void setPgSQLVersion(const QString &version);
 
 		//! \brief Returns the current version for SQL code generation
 		static QString getPgSQLVersion();
 
-		//! \brief Returns the set of attributes used by the search mechanism
+		/*! \brief Returns the set of attributes used by the search mechanism. The attributes are configured
+		 * (see configureSearchAttributes()) at each call and are not kept in the object */
 		attribs_map getSearchAttributes();
 
+		/*! \brief Returns an estimate of the amount of heap memory (in bytes) used by the object's own data
+		 * (names, comments, custom SQL, cached code and attributes). The size of the instance itself is not included */
+		size_t getMemoryUsage();
+
 		friend class DatabaseModel;
 		friend class ModelValidationHelper;
 		friend class DatabaseImportHelper;
@@ -389,12 +389,7 @@ QString BaseRelationship::getCachedCode(unsigned def_type)
 	if(!code_invalidated &&
 			((!cached_code[def_type].isEmpty()) ||
 			 (def_type==SchemaParser::XmlDefinition  && !cached_reduced_code.isEmpty())))
-	{
-		if(def_type==SchemaParser::XmlDefinition  && !cached_reduced_code.isEmpty())
-			return cached_reduced_code;
-		else
-			return cached_code[def_type];
-	}
+		return BaseObject::getCachedCode(def_type, def_type==SchemaParser::XmlDefinition && !cached_reduced_code.isEmpty());
 	else
 		return "";
 }
@@ -464,8 +459,9 @@ QString BaseRelationship::getCodeDefinition(unsigned def_type)
 			return "";
 		else
 		{
-			cached_code[def_type] = reference_fk->getCodeDefinition(SchemaParser::SqlDefinition);
-			return cached_code[def_type];
+			code_def = reference_fk->getCodeDefinition(SchemaParser::SqlDefinition);
+			setCachedCode(def_type, false, code_def);
+			return code_def;
 		}
 	}
 	else
@@ -23,8 +23,14 @@
 #include <QtDebug>
 #include <random>
 #include "utilsns.h"
+#include <QCryptographicHash>
+#include <QMutex>
+#include <QThreadPool>
+#include <atomic>
+#include <set>
 
-unsigned DatabaseModel::dbmodel_id=2000;
+std::atomic<unsigned> DatabaseModel::dbmodel_id(2000);
+bool DatabaseModel::trust_saved_models=false;
 
 DatabaseModel::DatabaseModel()
 {
@@ -742,6 +748,11 @@ void DatabaseModel::destroyObjects()
 	ritr = objects.rbegin();
 	ritr_end = objects.rend();
 
+	/* Unregistering the user types before freeing the objects so another model (possibly being
+	 * loaded in a different thread) can't have an object allocated in the same address of a
+	 * destroyed one while it is still referenced in the user types registry */
+	PgSqlType::removeUserTypes(this);
+
 	while(ritr != ritr_end)
 	{
 		object = ritr->second;
@@ -770,8 +781,6 @@ void DatabaseModel::destroyObjects()
 		delete object;
 	}
 
-	PgSqlType::removeUserTypes(this);
-
 	for(auto &perm : 	permissions)
 		delete perm;
 
@@ -3163,6 +3172,8 @@ void DatabaseModel::loadModel(const QString &filename)
 
 		try
 		{
+			ProgressReporter::ScopedPhase load_phase(progress_rep, QString("Load model"));
+
 			loading_model=true;
 			xmlparser.restartParser();
 
@@ -3171,8 +3182,13 @@ void DatabaseModel::loadModel(const QString &filename)
 								 GlobalAttributes::ObjectDTDExt,
 								 GlobalAttributes::RootDTD);
 
-			//Loads the file validating it against the root DTD
-			xmlparser.loadXMLFile(filename);
+			/* Files saved by pgModeler which weren't changed since then don't
+			 * need to be validated against the root DTD */
+			xmlparser.setDTDValidation(!trust_saved_models || !isTrustedModel(filename));
+
+			/* Opens the file in streaming mode so only the element being
+			 * loaded (and its children) are kept in memory */
+			xmlparser.openXMLFileStream(filename);
 
 			//Gets the basic model information
 			xmlparser.getElementAttributes(attribs);
@@ -3266,77 +3282,76 @@ void DatabaseModel::loadModel(const QString &filename)
 			def_objs[ObjectType::Collation]=attribs[Attributes::DefaultCollation];
 			def_objs[ObjectType::Tablespace]=attribs[Attributes::DefaultTablespace];
 
-			if(xmlparser.accessElement(XmlParser::ChildElement))
+			while(xmlparser.readNextStreamElement())
 			{
-				do
+				if(xmlparser.getElementType()==XML_ELEMENT_NODE)
 				{
-					if(xmlparser.getElementType()==XML_ELEMENT_NODE)
-					{
-						elem_name=xmlparser.getElementName();
+					elem_name=xmlparser.getElementName();
 
-						//Indentifies the object type to be load according to the current element on the parser
-						obj_type=getObjectType(elem_name);
+					//Indentifies the object type to be load according to the current element on the parser
+					obj_type=getObjectType(elem_name);
 
-						if(elem_name == Attributes::Changelog)
-						{
-							attribs_map entry_attr;
-							xmlparser.savePosition();
+					if(elem_name == Attributes::Changelog)
+					{
+						attribs_map entry_attr;
+						xmlparser.savePosition();
 
-							if(xmlparser.accessElement(XmlParser::ChildElement))
+						if(xmlparser.accessElement(XmlParser::ChildElement))
+						{
+							do
 							{
-								do
-								{
-									xmlparser.getElementAttributes(entry_attr);
-									addChangelogEntry(entry_attr[Attributes::Signature], entry_attr[Attributes::Type],
-																		entry_attr[Attributes::Action], entry_attr[Attributes::Date]);
-								}
-								while(xmlparser.accessElement(XmlParser::NextElement));
+								xmlparser.getElementAttributes(entry_attr);
+								addChangelogEntry(entry_attr[Attributes::Signature], entry_attr[Attributes::Type],
+																	entry_attr[Attributes::Action], entry_attr[Attributes::Date]);
 							}
-
-							xmlparser.restorePosition();
-						}
-						else if(obj_type==ObjectType::Database)
-						{
-							xmlparser.getElementAttributes(attribs);
-							configureDatabase(attribs);
+							while(xmlparser.accessElement(XmlParser::NextElement));
 						}
-						else
+
+						xmlparser.restorePosition();
+					}
+					else if(obj_type==ObjectType::Database)
+					{
+						xmlparser.getElementAttributes(attribs);
+						configureDatabase(attribs);
+					}
+					else
+					{
+						try
 						{
-							try
-							{
-								//Saves the current position of the parser before create any object
-								xmlparser.savePosition();
-								object=createObject(obj_type);
+							//Saves the current position of the parser before create any object
+							xmlparser.savePosition();
+							object=createObject(obj_type);
 
-								if(object)
-								{
-									if(!dynamic_cast<TableObject *>(object) && obj_type!=ObjectType::Relationship && obj_type!=ObjectType::BaseRelationship)
-										addObject(object);
+							if(object)
+							{
+								if(!dynamic_cast<TableObject *>(object) && obj_type!=ObjectType::Relationship && obj_type!=ObjectType::BaseRelationship)
+									addObject(object);
 
-									/* If there is at least one inheritance relationship we need to flag this situation
-									 in order to do an addtional rel. validation in the end of loading */
-									/* if(!found_inh_rel && object->getObjectType()==ObjectType::Relationship &&
-											dynamic_cast<Relationship *>(object)->getRelationshipType()==BaseRelationship::RelationshipGen)
-										found_inh_rel=true; */
+								/* If there is at least one inheritance relationship we need to flag this situation
+								 in order to do an addtional rel. validation in the end of loading */
+								/* if(!found_inh_rel && object->getObjectType()==ObjectType::Relationship &&
+										dynamic_cast<Relationship *>(object)->getRelationshipType()==BaseRelationship::RelationshipGen)
+									found_inh_rel=true; */
 
-									emit s_objectLoaded((xmlparser.getCurrentBufferLine()/static_cast<double>(xmlparser.getBufferLineCount()))*100,
+								if(progress_rep.isReportDue(xmlparser.getStreamProgress()))
+								{
+									emit s_objectLoaded(xmlparser.getStreamProgress(),
 														tr("Loading: `%1' (%2)")
 														.arg(object->getName())
 														.arg(object->getTypeName()),
 														enum_cast(obj_type));
 								}
-
-								xmlparser.restorePosition();
-							}
-							catch(Exception &e)
-							{
-								QString info_adicional=QString(QObject::tr("%1 (line: %2)")).arg(xmlparser.getLoadedFilename()).arg(xmlparser.getCurrentElement()->line);
-								throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, info_adicional);
 							}
+
+							xmlparser.restorePosition();
+						}
+						catch(Exception &e)
+						{
+							QString info_adicional=QString(QObject::tr("%1 (line: %2)")).arg(xmlparser.getLoadedFilename()).arg(xmlparser.getCurrentElement()->line);
+							throw Exception(e.getErrorMessage(),e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e, info_adicional);
 						}
 					}
 				}
-				while(xmlparser.accessElement(XmlParser::NextElement));
 			}
 
 			this->BaseObject::setProtected(protected_model);
@@ -3367,6 +3382,8 @@ void DatabaseModel::loadModel(const QString &filename)
 			//If there are relationship make a relationship validation to recreate any special object left behind
 			if(!relationships.empty())
 			{
+				ProgressReporter::ScopedPhase rel_phase(progress_rep, QString("Validate relationships"));
+
 				emit s_objectLoaded(100, tr("Validating relationships..."), enum_cast(ObjectType::Relationship));
 				storeSpecialObjectsXML();
 				disconnectRelationships();
@@ -3657,6 +3674,81 @@ QString DatabaseModel::getErrorExtraInfo()
 	return extra_info;
 }
 
+void DatabaseModel::setTrustSavedModels(bool value)
+{
+	trust_saved_models = value;
+}
+
+QByteArray DatabaseModel::getModelContentHash(const char *data, qint64 size)
+{
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+
+	/* The pgModeler version is part of the hash so models saved by other versions
+	 * (which may use a different DTD) are never considered trusted */
+	hash.addData(GlobalAttributes::PgModelerVersion.toUtf8());
+	hash.addData(QByteArrayView(data, size));
+
+	return hash.result().toHex();
+}
+
+void DatabaseModel::registerTrustedModel(const QByteArray &buffer)
+{
+	static QMutex mutex;
+	QMutexLocker locker(&mutex);
+	QFile file(GlobalAttributes::getConfigurationsDir() + GlobalAttributes::DirSeparator + GlobalAttributes::TrustedModelsFile);
+	QByteArrayList hashes;
+	QByteArray hash = getModelContentHash(buffer.constData(), buffer.size());
+
+	if(file.open(QFile::ReadOnly))
+	{
+		hashes = file.readAll().split('\n');
+		file.close();
+	}
+
+	hashes.removeAll(QByteArray());
+	hashes.removeAll(hash);
+	hashes.append(hash);
+
+	// Only the most recent hashes are kept
+	while(hashes.size() > MaxTrustedModels)
+		hashes.removeFirst();
+
+	// Failing to write the file only causes the next loading to be validated
+	if(file.open(QFile::WriteOnly | QFile::Truncate))
+	{
+		file.write(hashes.join('\n'));
+		file.close();
+	}
+}
+
+bool DatabaseModel::isTrustedModel(const QString &filename)
+{
+	QFile trusted_file(GlobalAttributes::getConfigurationsDir() + GlobalAttributes::DirSeparator + GlobalAttributes::TrustedModelsFile),
+			model_file(filename);
+	QByteArrayList hashes;
+	QByteArray hash;
+	uchar *data = nullptr;
+
+	if(!trusted_file.open(QFile::ReadOnly))
+		return false;
+
+	hashes = trusted_file.readAll().split('\n');
+	trusted_file.close();
+
+	if(!model_file.open(QFile::ReadOnly) || model_file.size() == 0)
+		return false;
+
+	data = model_file.map(0, model_file.size());
+
+	if(!data)
+		return false;
+
+	hash = getModelContentHash(reinterpret_cast<const char *>(data), model_file.size());
+	model_file.unmap(data);
+
+	return hashes.contains(hash);
+}
+
 void DatabaseModel::setLoadingModel(bool value)
 {
 	loading_model = value;
@@ -4317,7 +4409,7 @@ PgSqlType DatabaseModel::createPgSQLType()
 		if(PgSqlType::getUserTypeIndex(name,nullptr,this) == BaseType::Null)
 			throw Exception(ErrorCode::RefUserTypeInexistsModel,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
-		type_idx=PgSqlType::getUserTypeIndex(name, ptype);
+		type_idx=PgSqlType::getUserTypeIndex(name, ptype, this);
 		return PgSqlType(type_idx, dimension, length, precision, with_timezone, interv_type, spatial_type);
 	}
 }
@@ -5470,6 +5562,11 @@ XmlParser *DatabaseModel::getXMLParser()
 	return &xmlparser;
 }
 
+ProgressReporter &DatabaseModel::getProgressReporter()
+{
+	return progress_rep;
+}
+
 QString DatabaseModel::getAlterDefinition(BaseObject *object)
 {
 	DatabaseModel *db_aux=dynamic_cast<DatabaseModel *>(object);
@@ -7510,6 +7607,72 @@ QString DatabaseModel::configureShellTypes(bool reset_config)
 	return shell_types_def;
 }
 
+std::vector<std::pair<BaseObject *, QString>> DatabaseModel::getObjectsSQLDefinition(QStringList &session_cmds)
+{
+	std::vector<std::pair<BaseObject *, QString>> objs_code, schemas_code;
+	std::map<unsigned, BaseObject *> objects_map;
+	QString search_path=QString("pg_catalog,public"), shell_types;
+	BaseObject *object=nullptr;
+	ObjectType obj_type;
+
+	try
+	{
+		session_cmds.clear();
+		objects_map=getCreationOrder(SchemaParser::SqlDefinition);
+		shell_types=configureShellTypes(false);
+
+		for(auto &obj_itr : objects_map)
+		{
+			object=obj_itr.second;
+			obj_type=object->getObjectType();
+
+			//Database, roles and tablespaces are created separately (outside the database) in the export process
+			if(obj_type==ObjectType::Database || obj_type==ObjectType::Role ||
+				 obj_type==ObjectType::Tablespace || object->isSystemObject() ||
+				 (obj_type==ObjectType::Schema && (object->getName()==QString("public") || object->getName()==QString("pg_catalog"))))
+				continue;
+
+			if(obj_type==ObjectType::Schema)
+			{
+				search_path+=QString(",") + object->getName(true);
+				schemas_code.push_back({ object, object->getCodeDefinition(SchemaParser::SqlDefinition) });
+			}
+			else if(obj_type==ObjectType::Constraint)
+				objs_code.push_back({ object, dynamic_cast<Constraint *>(object)->getCodeDefinition(SchemaParser::SqlDefinition, true) });
+			else
+				objs_code.push_back({ object, object->getCodeDefinition(SchemaParser::SqlDefinition) });
+		}
+
+		configureShellTypes(true);
+
+		//The schemas and the shell types are placed before the other objects like in the full model code
+		if(!shell_types.isEmpty())
+			objs_code.insert(objs_code.begin(), { nullptr, shell_types });
+
+		objs_code.insert(objs_code.begin(), schemas_code.begin(), schemas_code.end());
+
+		/* The prepended and appended SQL are returned in entries with a null object placed, respectively,
+		 * at the beginning and at the end of the list, the same way they are placed in the full model code */
+		if(prepend_at_bod && !prepended_sql.trimmed().isEmpty())
+			objs_code.insert(objs_code.begin(), { nullptr, QString("-- Prepended SQL commands --\n") + prepended_sql + Attributes::DdlEndToken });
+
+		if(append_at_eod && !appended_sql.trimmed().isEmpty())
+			objs_code.push_back({ nullptr, QString("-- Appended SQL commands --\n") + appended_sql + QChar('\n') + Attributes::DdlEndToken });
+
+		if(!functions.empty())
+			session_cmds.append(QString("SET check_function_bodies = false;"));
+
+		session_cmds.append(QString("SET search_path TO %1;").arg(search_path));
+	}
+	catch(Exception &e)
+	{
+		configureShellTypes(true);
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+
+	return objs_code;
+}
+
 QString DatabaseModel::getCodeDefinition(unsigned def_type)
 {
 	return this->getCodeDefinition(def_type, true);
@@ -7530,6 +7693,8 @@ QString DatabaseModel::getCodeDefinition(unsigned def_type, bool export_file)
 
 	try
 	{
+		ProgressReporter::ScopedPhase gen_phase(progress_rep, QString("Generate %1 code").arg(def_type_str));
+
 		cancel_saving = false;
 		objects_map=getCreationOrder(def_type);
 		general_obj_cnt=objects_map.size();
@@ -7616,8 +7781,9 @@ QString DatabaseModel::getCodeDefinition(unsigned def_type, bool export_file)
 
 			gen_defs_count++;
 
-			if((def_type==SchemaParser::SqlDefinition && !object->isSQLDisabled()) ||
-					(def_type==SchemaParser::XmlDefinition && !object->isSystemObject()))
+			if(((def_type==SchemaParser::SqlDefinition && !object->isSQLDisabled()) ||
+					(def_type==SchemaParser::XmlDefinition && !object->isSystemObject())) &&
+				 progress_rep.isReportDue((gen_defs_count/static_cast<double>(general_obj_cnt)) * 100))
 			{
 				emit s_objectLoaded((gen_defs_count/static_cast<double>(general_obj_cnt)) * 100,
 									msg.arg(def_type_str)
@@ -8104,7 +8270,14 @@ void DatabaseModel::saveModel(const QString &filename, unsigned def_type)
 	try
 	{
 		if(!cancel_saving)
-			UtilsNs::saveFile(filename, this->getCodeDefinition(def_type).toUtf8());
+		{
+			QByteArray buffer = this->getCodeDefinition(def_type).toUtf8();
+
+			UtilsNs::saveFile(filename, buffer);
+
+			if(trust_saved_models && def_type == SchemaParser::XmlDefinition && !cancel_saving)
+				registerTrustedModel(buffer);
+		}
 	}
 	catch(Exception &e)
 	{
@@ -8167,6 +8340,8 @@ void DatabaseModel::saveSplitSQLDefinition(const QString &path)
 
 	try
 	{
+		ProgressReporter::ScopedPhase save_phase(progress_rep, QString("Save split SQL files"));
+
 		cancel_saving = false;
 		general_obj_cnt = objects.size();
 		shell_types = configureShellTypes(false);
@@ -8261,12 +8436,15 @@ void DatabaseModel::saveSplitSQLDefinition(const QString &path)
 								 .arg(obj->getSchemaName())
 								 .arg(obj->getObjectId());
 
-			emit s_objectLoaded((gen_defs_idx/static_cast<double>(general_obj_cnt)) * 100,
-								tr("Saving SQL of `%1' (%2) to file `%3'.")
-								.arg(obj->getName())
-								.arg(obj->getTypeName())
-								.arg(filename),
-								enum_cast(obj->getObjectType()));
+			if(progress_rep.isReportDue((gen_defs_idx/static_cast<double>(general_obj_cnt)) * 100))
+			{
+				emit s_objectLoaded((gen_defs_idx/static_cast<double>(general_obj_cnt)) * 100,
+									tr("Saving SQL of `%1' (%2) to file `%3'.")
+									.arg(obj->getName())
+									.arg(obj->getTypeName())
+									.arg(filename),
+									enum_cast(obj->getObjectType()));
+			}
 
 			UtilsNs::saveFile(path + GlobalAttributes::DirSeparator + filename, buffer);
 			buffer.clear();
@@ -10709,7 +10887,6 @@ std::vector<BaseObject *> DatabaseModel::findObjects(const QString &pattern, std
 	while(!objs.empty())
 	{
 		object = objs.back();
-		object->configureSearchAttributes();
 		srch_attribs = object->getSearchAttributes();
 
 		if(regexp.match(srch_attribs[search_attr]).hasMatch())
@@ -10736,6 +10913,11 @@ bool DatabaseModel::isInvalidated()
 	return invalidated;
 }
 
+bool DatabaseModel::isLoadingModel()
+{
+	return loading_model;
+}
+
 void  DatabaseModel::setAppendAtEOD(bool value)
 {
 	append_at_eod=value;
@@ -11604,11 +11786,9 @@ void DatabaseModel::addChangelogEntry(const QString &signature, const QString &t
 	changelog.push_back(std::make_tuple(date_time, signature, obj_type, action));
 }
 
-QStringList DatabaseModel::getFiltersFromChangelog(QDateTime start, QDateTime end)
+std::vector<std::tuple<QDateTime,QString,ObjectType,QString>> DatabaseModel::getChangelogEntries(QDateTime start, QDateTime end)
 {
-	QStringList filters;
-	QString signature, action;
-	ObjectType type;
+	std::vector<std::tuple<QDateTime,QString,ObjectType,QString>> entries;
 	QDateTime date;
 
 	// Inverting the date range if the start is greater than the end
@@ -11622,26 +11802,115 @@ QStringList DatabaseModel::getFiltersFromChangelog(QDateTime start, QDateTime en
 	for(auto &entry : changelog)
 	{
 		date = std::get<LogDate>(entry);
-		signature = std::get<LogSinature>(entry);
-		type = std::get<LogObjectType>(entry);
-		action = std::get<LogAction>(entry);
 
 		if(((start.isValid() && end.isValid() && date >= start && date <= end) ||
 				(start.isValid() && !end.isValid() && date >= start) ||
 				(!start.isValid() && end.isValid() && date <= end)))
-		{
-			filters.append(BaseObject::getSchemaName(type) +
-										 UtilsNs::FilterSeparator +
-										 signature +
-										 UtilsNs::FilterSeparator +
-										 UtilsNs::FilterWildcard);
-		}
+			entries.push_back(entry);
+	}
+
+	return entries;
+}
+
+QStringList DatabaseModel::getFiltersFromChangelog(QDateTime start, QDateTime end)
+{
+	QStringList filters;
+
+	for(auto &entry : getChangelogEntries(start, end))
+	{
+		filters.append(BaseObject::getSchemaName(std::get<LogObjectType>(entry)) +
+									 UtilsNs::FilterSeparator +
+									 std::get<LogSinature>(entry) +
+									 UtilsNs::FilterSeparator +
+									 UtilsNs::FilterWildcard);
 	}
 
 	filters.removeDuplicates();
 	return filters;
 }
 
+std::vector<BaseObject *> DatabaseModel::getObjectsFromChangelog(QDateTime start, QDateTime end, QStringList *missing_filters)
+{
+	std::vector<BaseObject *> objects, *obj_list = nullptr;
+	std::map<ObjectType, std::map<QString, BaseObject *>> sig_index;
+	std::set<BaseObject *> found_objs;
+	BaseObject *object = nullptr;
+	BaseTable *parent_tab = nullptr;
+	ObjectType type;
+	QString signature;
+	int dot_idx = -1;
+
+	/* Returns the object of the provided type using its signature (without quotes).
+	 * The signatures of each type are indexed in the first search so each entry costs a single lookup */
+	auto find_object = [&](ObjectType obj_type, const QString &sig) -> BaseObject * {
+		if(obj_type == ObjectType::Database)
+			return this;
+
+		if(!sig_index.count(obj_type))
+		{
+			std::map<QString, BaseObject *> &index = sig_index[obj_type];
+			obj_list = getObjectList(obj_type);
+
+			if(obj_list)
+			{
+				for(auto &obj : *obj_list)
+					index[obj->getSignature().remove('"')] = obj;
+			}
+		}
+
+		auto itr = sig_index[obj_type].find(QString(sig).remove('"'));
+		return itr != sig_index[obj_type].end() ? itr->second : nullptr;
+	};
+
+	for(auto &entry : getChangelogEntries(start, end))
+	{
+		type = std::get<LogObjectType>(entry);
+		signature = std::get<LogSinature>(entry);
+		object = nullptr;
+
+		/* Table children objects are registered using the parent's signature followed by their names
+		 * (see addChangelogEntry) so the parent is retrieved first and then the child object in it */
+		if(TableObject::isTableObject(type))
+		{
+			dot_idx = signature.lastIndexOf('.');
+			parent_tab = nullptr;
+
+			for(auto &tab_type : { ObjectType::Table, ObjectType::ForeignTable, ObjectType::View })
+			{
+				parent_tab = dynamic_cast<BaseTable *>(find_object(tab_type, signature.left(dot_idx)));
+				if(parent_tab) break;
+			}
+
+			if(parent_tab && dot_idx >= 0)
+				object = parent_tab->getObject(signature.mid(dot_idx + 1), type);
+		}
+		else
+			object = find_object(type, signature);
+
+		if(object)
+		{
+			if(!found_objs.count(object))
+			{
+				found_objs.insert(object);
+				objects.push_back(object);
+			}
+		}
+		else if(missing_filters)
+		{
+			missing_filters->append(BaseObject::getSchemaName(type) +
+															UtilsNs::FilterSeparator +
+															signature +
+															UtilsNs::FilterSeparator +
+															UtilsNs::FilterWildcard);
+		}
+	}
+
+	if(missing_filters)
+		missing_filters->removeDuplicates();
+
+	return objects;
+}
+
 void DatabaseModel::setPersistedChangelog(bool persist)
 {
 	persist_changelog = persist;
@@ -11824,19 +12093,13 @@ TableClass *DatabaseModel::createPhysicalTable()
 	return table;
 }
 
-void DatabaseModel::getDataDictionary(attribs_map &datadict, bool browsable, bool split)
+void DatabaseModel::getDataDictionaryObjects(std::map<QString, BaseObject *> &objs_map, QStringList &index_list)
 {
-	int idx = 0;
-	BaseObject *object = nullptr;
 	std::vector<BaseObject *> objects;
-	std::map<QString, BaseObject *> objs_map;
-	QString styles, id, index, items, buffer;
-	attribs_map attribs, aux_attribs;
-	QStringList index_list;
-	QString dict_sch_file = GlobalAttributes::getSchemaFilePath(GlobalAttributes::DataDictSchemaDir, GlobalAttributes::DataDictSchemaDir),
-			style_sch_file = GlobalAttributes::getSchemaFilePath(GlobalAttributes::DataDictSchemaDir, Attributes::Styles),
-			item_sch_file = GlobalAttributes::getSchemaFilePath(GlobalAttributes::DataDictSchemaDir, Attributes::Item),
-			index_sch_file = GlobalAttributes::getSchemaFilePath(GlobalAttributes::DataDictSchemaDir, Attributes::Index);
+	QString id;
+
+	objs_map.clear();
+	index_list.clear();
 
 	objects.assign(tables.begin(), tables.end());
 	objects.insert(objects.end(), foreign_tables.begin(), foreign_tables.end());
@@ -11863,6 +12126,46 @@ void DatabaseModel::getDataDictionary(attribs_map &datadict, bool browsable, boo
 	}
 
 	index_list.sort();
+}
+
+QString DatabaseModel::getDataDictionaryIndex(std::map<QString, BaseObject *> &objs_map, const QStringList &index_list, bool split)
+{
+	attribs_map idx_attribs, aux_attribs;
+	QString item_sch_file = GlobalAttributes::getSchemaFilePath(GlobalAttributes::DataDictSchemaDir, Attributes::Item),
+			index_sch_file = GlobalAttributes::getSchemaFilePath(GlobalAttributes::DataDictSchemaDir, Attributes::Index);
+
+	idx_attribs[BaseObject::getSchemaName(ObjectType::Table)] = "";
+	idx_attribs[BaseObject::getSchemaName(ObjectType::View)] = "";
+	idx_attribs[BaseObject::getSchemaName(ObjectType::ForeignTable)] = "";
+	idx_attribs[Attributes::Year] = QString::number(QDate::currentDate().year());
+
+	// Generating the index items
+	for(auto &item : index_list)
+	{
+		aux_attribs[Attributes::Split] = split ? Attributes::True : "";
+		aux_attribs[Attributes::Item] = item;
+		idx_attribs[objs_map[item]->getSchemaName()] += schparser.getCodeDefinition(item_sch_file, aux_attribs);
+	}
+
+	idx_attribs[Attributes::Name] = this->obj_name;
+	idx_attribs[Attributes::Split] = split ? Attributes::True : "";
+
+	schparser.ignoreEmptyAttributes(true);
+	return schparser.getCodeDefinition(index_sch_file, idx_attribs);
+}
+
+void DatabaseModel::getDataDictionary(attribs_map &datadict, bool browsable, bool split)
+{
+	int idx = 0;
+	BaseObject *object = nullptr;
+	std::map<QString, BaseObject *> objs_map;
+	QString styles, id, index;
+	attribs_map attribs, aux_attribs;
+	QStringList index_list;
+	QString dict_sch_file = GlobalAttributes::getSchemaFilePath(GlobalAttributes::DataDictSchemaDir, GlobalAttributes::DataDictSchemaDir),
+			style_sch_file = GlobalAttributes::getSchemaFilePath(GlobalAttributes::DataDictSchemaDir, Attributes::Styles);
+
+	getDataDictionaryObjects(objs_map, index_list);
 	datadict.clear();
 
 	// Generates the the stylesheet
@@ -11902,28 +12205,7 @@ void DatabaseModel::getDataDictionary(attribs_map &datadict, bool browsable, boo
 
 	// If the data dictionary is browsable we proceed with the index generation
 	if(browsable)
-	{
-		attribs_map idx_attribs;
-
-		idx_attribs[BaseObject::getSchemaName(ObjectType::Table)] = "";
-		idx_attribs[BaseObject::getSchemaName(ObjectType::View)] = "";
-		idx_attribs[BaseObject::getSchemaName(ObjectType::ForeignTable)] = "";
-		idx_attribs[Attributes::Year] = QString::number(QDate::currentDate().year());
-
-		// Generating the index items
-		for(auto &item : index_list)
-		{
-			aux_attribs[Attributes::Split] = attribs[Attributes::Split];
-			aux_attribs[Attributes::Item] = item;
-			idx_attribs[objs_map[item]->getSchemaName()] += schparser.getCodeDefinition(item_sch_file, aux_attribs);
-		}
-
-		idx_attribs[Attributes::Name] = this->obj_name;
-		idx_attribs[Attributes::Split] = attribs[Attributes::Split];
-
-		schparser.ignoreEmptyAttributes(true);
-		index = schparser.getCodeDefinition(index_sch_file, idx_attribs);
-	}
+		index = getDataDictionaryIndex(objs_map, index_list, split);
 
 	// If the data dictionary is browsable and splitted the index goes into a separated file
 	if(split && browsable)
@@ -11936,15 +12218,102 @@ void DatabaseModel::getDataDictionary(attribs_map &datadict, bool browsable, boo
 	}
 }
 
+void DatabaseModel::saveSplitDataDictionary(const QString &path, bool browsable)
+{
+	std::map<QString, BaseObject *> objs_map;
+	QStringList index_list;
+	QString dict_sch_file = GlobalAttributes::getSchemaFilePath(GlobalAttributes::DataDictSchemaDir, GlobalAttributes::DataDictSchemaDir),
+			style_sch_file = GlobalAttributes::getSchemaFilePath(GlobalAttributes::DataDictSchemaDir, Attributes::Styles),
+			year = QString::number(QDate::currentDate().year());
+	attribs_map attribs;
+	QThreadPool pool;
+	QMutex error_mutex;
+	std::vector<Exception> errors;
+	std::atomic<int> saved_count(0);
+	std::atomic<bool> abort_gen(false);
+	int idx = 0, total = 0;
+
+	getDataDictionaryObjects(objs_map, index_list);
+	total = index_list.size();
+
+	// The stylesheet is saved in a separated file
+	UtilsNs::saveFile(path + GlobalAttributes::DirSeparator + Attributes::Styles + QString(".css"),
+										schparser.getCodeDefinition(style_sch_file, attribs).toUtf8());
+
+	/* Each table/view has its data dictionary rendered and written to disk by a worker
+	 * instead of accumulating all of them in memory. The renders are independent from each other
+	 * since each object uses its own schema parser. The page wrapper is generated by a parser
+	 * local to the worker for the same reason */
+	for(auto &itr : objs_map)
+	{
+		BaseTable *table = dynamic_cast<BaseTable *>(itr.second);
+		QString filename = path + GlobalAttributes::DirSeparator + itr.first + QString(".html");
+		attribs_map aux_attribs;
+
+		aux_attribs[Attributes::Index] = browsable ? Attributes::True : "";
+		aux_attribs[Attributes::Previous] = idx - 1 >= 0 ? index_list.at(idx - 1) : "";
+		aux_attribs[Attributes::Next] = (++idx <= index_list.size() - 1) ? index_list.at(idx) : "";
+
+		pool.start([table, filename, aux_attribs, dict_sch_file, year, &error_mutex, &errors, &saved_count, &abort_gen](){
+			if(abort_gen)
+				return;
+
+			try
+			{
+				SchemaParser parser;
+				attribs_map page_attribs;
+
+				page_attribs[Attributes::Styles] = "";
+				page_attribs[Attributes::Index] = "";
+				page_attribs[Attributes::Split] = Attributes::True;
+				page_attribs[Attributes::Year] = year;
+				page_attribs[Attributes::Objects] = table->getDataDictionary(true, aux_attribs);
+
+				if(!page_attribs[Attributes::Objects].isEmpty())
+				{
+					parser.ignoreEmptyAttributes(true);
+					UtilsNs::saveFile(filename, parser.getCodeDefinition(dict_sch_file, page_attribs).toUtf8());
+				}
+
+				saved_count++;
+			}
+			catch(Exception &e)
+			{
+				QMutexLocker locker(&error_mutex);
+				abort_gen = true;
+				errors.push_back(Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e));
+			}
+		});
+	}
+
+	// Reporting the progress while the workers are running
+	while(!pool.waitForDone(100))
+	{
+		emit s_objectLoaded(total > 0 ? (saved_count * 100) / total : 100,
+												tr("Generating data dictionary files (%1/%2)...").arg(saved_count.load()).arg(total),
+												enum_cast(ObjectType::Table));
+	}
+
+	if(!errors.empty())
+		throw Exception(errors.front().getErrorMessage(), errors.front().getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, errors);
+
+	// The index is generated only after all the objects' files are written
+	if(browsable)
+	{
+		UtilsNs::saveFile(path + GlobalAttributes::DirSeparator + Attributes::Index + QString(".html"),
+											getDataDictionaryIndex(objs_map, index_list, true).toUtf8());
+	}
+}
+
 void DatabaseModel::saveDataDictionary(const QString &path, bool browsable, bool split)
 {
 	try
 	{
+		ProgressReporter::ScopedPhase dict_phase(progress_rep, QString("Save data dictionary"));
 		attribs_map datadict;
 		QByteArray buffer;
 		QFileInfo finfo(path);
 		QDir dir;
-		QString filename;
 
 		if(split)
 		{
@@ -11954,19 +12323,19 @@ void DatabaseModel::saveDataDictionary(const QString &path, bool browsable, bool
 
 			if(!finfo.exists())
 				dir.mkpath(path);
-		}
 
-		getDataDictionary(datadict, browsable, split);
-		filename = path;
-
-		for(auto &itr : datadict)
+			saveSplitDataDictionary(path, browsable);
+		}
+		else
 		{
-			if(split)
-				filename = path + GlobalAttributes::DirSeparator + itr.first;
+			getDataDictionary(datadict, browsable, split);
 
-			buffer.append(itr.second.toUtf8());
-			UtilsNs::saveFile(filename, buffer);
-			buffer.clear();
+			for(auto &itr : datadict)
+			{
+				buffer.append(itr.second.toUtf8());
+				UtilsNs::saveFile(path, buffer);
+				buffer.clear();
+			}
 		}
 	}
 	catch(Exception &e)
@@ -61,6 +61,7 @@ Additionally, this class, saves, loads and generates the XML/SQL definition of a
 #include "foreigntable.h"
 #include "transform.h"
 #include "procedure.h"
+#include "progressreporter.h"
 #include <algorithm>
 #include <locale.h>
 
@@ -79,7 +80,32 @@ class DatabaseModel:  public QObject, public BaseObject {
 		 * to return the list according to the provided type */
 		std::map<ObjectType, std::vector<BaseObject *> *> obj_lists;
 
-		static unsigned dbmodel_id;
+		static std::atomic<unsigned> dbmodel_id;
+
+		//! \brief Indicates if unchanged models saved by pgModeler must be loaded without DTD validation
+		static bool trust_saved_models;
+
+		//! \brief Maximum amount of content hashes kept in the trusted models file
+		static constexpr int MaxTrustedModels = 50;
+
+		//! \brief Returns the hash that identifies the provided model contents (saved by the current pgModeler version)
+		static QByteArray getModelContentHash(const char *data, qint64 size);
+
+		//! \brief Stores the hash of the provided (saved) model contents in the trusted models file
+		static void registerTrustedModel(const QByteArray &buffer);
+
+		//! \brief Returns true if the contents of the file matches one of the hashes in the trusted models file
+		static bool isTrustedModel(const QString &filename);
+
+		//! \brief Gathers the objects which have data dictionary (indexed by their signatures) as well as the sorted index of them
+		void getDataDictionaryObjects(std::map<QString, BaseObject *> &objs_map, QStringList &index_list);
+
+		//! \brief Returns the HTML code of the data dictionary index for the provided objects
+		QString getDataDictionaryIndex(std::map<QString, BaseObject *> &objs_map, const QStringList &index_list, bool split);
+
+		/*! \brief Saves the data dictionary in split mode by rendering and writing the file of each object in a worker pool,
+		 * so the dictionaries are never held in memory all at once. The index file is generated after all the objects' files */
+		void saveSplitDataDictionary(const QString &path, bool browsable);
 
 		//! \brief Constants used to access the tuple columns in the internal changelog
 		static constexpr unsigned LogDate = 0,
@@ -87,8 +113,14 @@ class DatabaseModel:  public QObject, public BaseObject {
 		LogObjectType = 2,
 		LogAction = 3;
 
+		//! \brief Returns the changelog entries registered in the provided date interval (invalid dates leave the interval open)
+		std::vector<std::tuple<QDateTime,QString,ObjectType,QString>> getChangelogEntries(QDateTime start, QDateTime end);
+
 		XmlParser xmlparser;
 
+		//! \brief Coalesces the s_objectLoaded signals and records the timings of the model operations
+		ProgressReporter progress_rep;
+
 		//! \brief Stores the layers names and active layer to write them on XML code
 		QStringList layers,
 
@@ -407,6 +439,11 @@ class DatabaseModel:  public QObject, public BaseObject {
 		destroyObjects() or delete the entire model */
 		void loadModel(const QString &filename);
 
+		/*! \brief Makes the models saved by pgModeler have their content hash registered so they can be loaded without
+		 * DTD validation (which is expensive in huge models) if they were not changed since then. Models changed
+		 * by other tools or saved by other pgModeler versions are always validated */
+		static void setTrustSavedModels(bool value);
+
 		//! \brief Sets the database encoding
 		void setEncoding(EncodingType encod);
 
@@ -481,6 +518,9 @@ class DatabaseModel:  public QObject, public BaseObject {
 		//! \brief Indicate if the model invalidated
 		void setInvalidated(bool value);
 
+		//! \brief Returns if the model is currently being loaded from a file or populated by the import process
+		bool isLoadingModel();
+
 		//! \brief Saves the specified code definition for the model on the specified filename
 		void saveModel(const QString &filename, unsigned def_type);
 
@@ -500,6 +540,14 @@ class DatabaseModel:  public QObject, public BaseObject {
 		//! \brief Returns the code definition only for the database (excluding the definition of the other objects)
 		QString __getCodeDefinition(unsigned def_type);
 
+		/*! \brief Returns the SQL code of the model split by object, in the creation order. This is the same code generated
+		 * by getCodeDefinition(SchemaParser::SqlDefinition, false) except for the roles, tablespaces and the database itself.
+		 * The shell types are returned in an entry with a null object placed right after the schemas and must be executed
+		 * before the entries that follow it. The prepended and appended SQL (when enabled) are also returned in entries with a
+		 * null object, respectively the first and the last ones. The commands that configure the session (search path, function bodies check)
+		 * and must be executed in each connection before the objects' code are returned in session_cmds */
+		std::vector<std::pair<BaseObject *, QString>> getObjectsSQLDefinition(QStringList &session_cmds);
+
 		/*! \brief Returns the creation order of objects in each definition type (SQL or XML).
 
 		The parameter incl_relnn_objs when 'true' includes the generated objects (table and constraint)
@@ -827,6 +875,10 @@ class DatabaseModel:  public QObject, public BaseObject {
 		\note: This is not the better approach and certainly will be changed in future releases */
 		XmlParser *getXMLParser();
 
+		/*! \brief Returns the reporter used to coalesce the progress signals emitted by the model.
+		 * It can be used to retrieve the timings of the operations performed (loading, code generation, etc) */
+		ProgressReporter &getProgressReporter();
+
 		//! \brief Returns the ALTER definition between the current model and the provided one
 		virtual QString getAlterDefinition(BaseObject *object) final;
 
@@ -848,6 +900,12 @@ class DatabaseModel:  public QObject, public BaseObject {
 		 * retrieved from changelog. */
 		QStringList getFiltersFromChangelog(QDateTime start, QDateTime end);
 
+		/*! \brief Returns the objects in the change log registered in the provided date interval.
+		 * Differently from getFiltersFromChangelog(), the entries are mapped directly to the model objects
+		 * so no pattern matching is needed to find them. The entries of objects that don't exist anymore in the
+		 * model (e.g. removed ones) are appended to missing_filters in the same format of getFiltersFromChangelog() */
+		std::vector<BaseObject *> getObjectsFromChangelog(QDateTime start, QDateTime end, QStringList *missing_filters = nullptr);
+
 		//! \brief Enable the persistence of the internal changelog
 		void setPersistedChangelog(bool persist);
 
@@ -18,6 +18,8 @@
 
 #include "element.h"
 
+thread_local SchemaParser Element::schparser;
+
 Element::Element()
 {
 	column=nullptr;
@@ -57,7 +57,8 @@ class Element {
 		bool isEqualsTo(Element &elem);
 
 	protected:
-		SchemaParser schparser;
+		//! \brief The parser used to generate the elements' code, shared by all elements (one instance per thread)
+		static thread_local SchemaParser schparser;
 
 		void configureAttributes(attribs_map &attributes, unsigned def_type);
 
@@ -87,6 +87,7 @@ void Operator::setName(const QString &name)
 		throw Exception(ErrorCode::AsgInvalidNameObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
 	this->obj_name=name;
+	cacheFormattedName();
 }
 
 void Operator::setFunction(Function *func, unsigned func_type)
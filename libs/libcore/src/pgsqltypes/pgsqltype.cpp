@@ -19,8 +19,14 @@
 #include "pgsqltype.h"
 #include "schemaparser.h"
 #include "attributes.h"
+#include <algorithm>
 
-std::vector<UserTypeConfig> PgSqlType::user_types;
+QReadWriteLock PgSqlType::user_types_lock;
+unsigned PgSqlType::next_user_type_id = PgSqlType::PseudoEnd + 1;
+std::unordered_map<unsigned, UserTypeConfig> PgSqlType::user_types;
+std::unordered_map<void *, unsigned> PgSqlType::user_types_refs;
+std::unordered_map<QString, std::set<unsigned>> PgSqlType::user_types_names;
+std::unordered_map<void *, PgSqlType::ModelUserTypes> PgSqlType::model_user_types;
 
 template<>
 QStringList PgSqlType::TemplateType<PgSqlType>::type_names =
@@ -127,78 +133,159 @@ PgSqlType::PgSqlType(unsigned type_id, unsigned dimension, unsigned length, int
 
 PgSqlType PgSqlType::parseString(const QString &str)
 {
-	QString type_str=str.toLower().simplified(), sptype, interv;
-	bool with_tz=false;
+	/* The interval qualifiers are checked from the last to the first one
+	 * so the compound ones (e.g. DAY TO SECOND) are matched before the simple ones */
+	static const QStringList interv_types = [](){
+		QStringList list = IntervalType::getTypes();
+		std::reverse(list.begin(), list.end());
+		return list;
+	}();
+
+	static const QString with_tz_str = "with time zone", without_tz_str = "without time zone";
+
+	QString fmt_str = str.simplified(), type_str, sptype, interv, params;
+	QStringView str_vw(fmt_str);
+	bool with_tz=false, quoted=false, has_params=false;
 	unsigned dim=0, srid=0;
 	int prec=-1, len = -1;
-	int start=-1, end=-1;
-	QStringList value, intervals;
+	qsizetype pos = 0, size = fmt_str.size(), end = -1;
+	QChar chr;
 	PgSqlType type;
 
-	//Checking if the string contains one of interval types
-	intervals = IntervalType::getTypes();
-	while(!intervals.isEmpty())
+	type_str.reserve(size);
+
+	/* Single pass over the string extracting the type name, the array dimension,
+	 * the time zone descriptor, the interval qualifier and the parameters between parenthesis */
+	while(pos < size)
 	{
-		interv=intervals.back();
-		intervals.pop_back();
+		chr = fmt_str.at(pos);
 
-		start=type_str.indexOf(QRegularExpression(QString("( )") + interv.toLower()));
-		if(start>=0)
+		// Quoted identifiers are copied as is
+		if(chr == QChar('"'))
+		{
+			quoted = !quoted;
+			type_str.append(chr);
+			pos++;
+		}
+		else if(quoted)
+		{
+			type_str.append(chr);
+			pos++;
+		}
+		// Array descriptor []
+		else if(chr == QChar('[') && pos + 1 < size && fmt_str.at(pos + 1) == QChar(']'))
 		{
-			type_str.remove(start, interv.size()+1);
-			break;
+			dim++;
+			pos += 2;
+		}
+		// Type parameters, only the first group is considered
+		else if(chr == QChar('(') && !has_params && !type_str.isEmpty() &&
+						(end = fmt_str.indexOf(QChar(')'), pos)) > 0)
+		{
+			params = str_vw.mid(pos + 1, end - pos - 1).trimmed().toString();
+			has_params = true;
+			pos = end + 1;
+		}
+		else if(chr == QChar(' '))
+		{
+			QStringView next_vw = str_vw.mid(pos + 1);
+			auto isKeyword = [&next_vw](const QString &kw){
+				return next_vw.startsWith(kw, Qt::CaseInsensitive) &&
+							 (next_vw.size() == kw.size() || next_vw.at(kw.size()) == QChar(' ') ||
+								next_vw.at(kw.size()) == QChar('(') || next_vw.at(kw.size()) == QChar('['));
+			};
+
+			if(isKeyword(with_tz_str))
+			{
+				with_tz = true;
+				pos += with_tz_str.size() + 1;
+				continue;
+			}
+
+			if(isKeyword(without_tz_str))
+			{
+				pos += without_tz_str.size() + 1;
+				continue;
+			}
+
+			if(interv.isEmpty())
+			{
+				for(auto &interv_tp : interv_types)
+				{
+					if(isKeyword(interv_tp))
+					{
+						interv = interv_tp;
+						pos += interv_tp.size() + 1;
+						break;
+					}
+				}
+
+				if(!interv.isEmpty())
+					continue;
+			}
+
+			type_str.append(chr);
+			pos++;
 		}
 		else
-			interv.clear();
+		{
+			type_str.append(chr);
+			pos++;
+		}
 	}
 
-	//Check if the type contains "with time zone" descriptor
-	with_tz = QRegularExpression(QRegularExpression::anchoredPattern("(.)*(with time zone)(.)*")).match(type_str).hasMatch();
+	/* Parsing the parameters of the type which can be a length, e.g varchar(200),
+	 * a length and a precision, e.g, numeric(10,2), or a spatial type (PostGiS), e.g, geography(POINTZ, 4296) */
+	if(has_params)
+	{
+		qsizetype comma_idx = params.indexOf(QChar(','));
+		QStringView param1 = QStringView(params).mid(0, comma_idx < 0 ? params.size() : comma_idx).trimmed(),
+				param2 = comma_idx < 0 ? QStringView() : QStringView(params).mid(comma_idx + 1).trimmed();
+		auto isDigits = [](QStringView value){
+			if(value.isEmpty())
+				return false;
+
+			for(auto &val_chr : value)
+			{
+				if(val_chr < QChar('0') || val_chr > QChar('9'))
+					return false;
+			}
 
-	//Removes the timezone descriptor
-	type_str.remove(QRegularExpression("(with)(out)*( time zone)"));
+			return true;
+		};
+		auto isLetters = [](QStringView value){
+			if(value.isEmpty())
+				return false;
 
-	//Count the dimension of the type and removes the array descriptor
-	dim=type_str.count("[]");
-	type_str.remove("[]");
+			for(auto &val_chr : value)
+			{
+				if(!((val_chr >= QChar('a') && val_chr <= QChar('z')) || (val_chr >= QChar('A') && val_chr <= QChar('Z'))))
+					return false;
+			}
 
-	//Check if the type is a variable length type, e.g varchar(200)
-	if(QRegularExpression("(.)+\\(( )*[0-9]+( )*\\)").match(type_str).hasMatch())
-	{
-		start=type_str.indexOf('(');
-		end=type_str.indexOf(')', start);
-		len=type_str.mid(start+1, end-start-1).toInt();
-	}
-	//Check if the type is a numeric type, e.g, numeric(10,2)
-	else if(QRegularExpression("(.)+\\(( )*[0-9]+( )*(,)( )*[0-9]+( )*\\)").match(type_str).hasMatch())
-	{
-		start=type_str.indexOf('(');
-		end=type_str.indexOf(')', start);
-		value=type_str.mid(start+1, end-start-1).split(',');
-		len=value[0].toInt();
-		prec=value[1].toUInt();
-	}
-	//Check if the type is a spatial type (PostGiS), e.g, geography(POINTZ, 4296)
-	else if(QRegularExpression("(.)+\\(( )*[a-z]+(( )*(,)( )*[0-9]+( )*)?\\)",
-														 QRegularExpression::CaseInsensitiveOption).match(type_str).hasMatch())
-	{
-		start=type_str.indexOf('(');
-		end=type_str.indexOf(')', start);
-		value=type_str.mid(start+1, end-start-1).split(',');
-		sptype=value[0].toUpper();
+			return true;
+		};
 
-		if(value.size() > 1)
-			srid=value[1].toUInt();
-	}
+		if(isDigits(param1) && comma_idx < 0)
+			len = param1.toInt();
+		else if(isDigits(param1) && isDigits(param2))
+		{
+			len = param1.toInt();
+			prec = param2.toInt();
+		}
+		else if(isLetters(param1) && (comma_idx < 0 || isDigits(param2)))
+		{
+			sptype = param1.toString().toUpper();
 
-	//If the string matches one of the regexp above remove the analyzed parts
-	if(start >=0 && end>=0)
-		type_str.remove(start, end-start+1);
+			if(comma_idx >= 0)
+				srid = param2.toUInt();
+		}
+		else
+			// Unknown parameters are kept in the type name so the type creation fails properly
+			type_str.append(QString("(%1)").arg(params));
+	}
 
-	/* The resultant string must be only the name of the type without [] and ().
-	NOTE: Since the string was converted to lower case at start it's necessary to get
-	it's original form from the input string in order to correctly create the type. */
-	type_str=str.mid(str.indexOf(type_str, 0, Qt::CaseInsensitive),type_str.length()).trimmed();
+	type_str = type_str.trimmed();
 
 	try
 	{
@@ -307,17 +394,18 @@ unsigned PgSqlType::operator = (const QString &type_name)
 void *PgSqlType::getUserTypeReference()
 {
 	if(this->isUserType())
-		return (user_types[this->type_idx - (PseudoEnd + 1)].ptype);
+		return getRegisteredUserType(type_idx).ptype;
 	else
 		return nullptr;
 }
 
 unsigned PgSqlType::getUserTypeConfig()
 {
-	if(this->isUserType())
-		return (user_types[this->type_idx - (PseudoEnd + 1)].type_conf);
-	else
+	if(!this->isUserType())
 		return PgSqlType::Null;
+
+	UserTypeConfig cfg = getRegisteredUserType(type_idx);
+	return cfg.ptype ? cfg.type_conf : PgSqlType::Null;
 }
 
 unsigned PgSqlType::getTypeId()
@@ -493,17 +581,13 @@ void PgSqlType::setWithTimezone(bool with_tz)
 
 unsigned PgSqlType::setUserType(unsigned type_id)
 {
-	unsigned lim1 = PseudoEnd + 1,
-			lim2 = lim1 + PgSqlType::user_types.size();
+	QReadLocker locker(&user_types_lock);
 
-	if(user_types.size() > 0 &&
-		(type_id >= lim1 && type_id < lim2))
-	{
-		type_idx = type_id;
-		return type_idx;
-	}
-	else
+	if(user_types.count(type_id) == 0)
 		throw Exception(ErrorCode::AsgInvalidTypeObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	type_idx = type_id;
+	return type_idx;
 }
 
 unsigned PgSqlType::setUserType(void *ptype)
@@ -526,88 +610,148 @@ void PgSqlType::addUserType(const QString &type_name, void *ptype, void *pmodel,
 			 type_conf==UserTypeConfig::ViewType ||
 			 type_conf==UserTypeConfig::ExtensionType ||
 			 type_conf==UserTypeConfig::ForeignTableType ||
-			 type_conf==UserTypeConfig::BaseType) &&
-			getUserTypeIndex(type_name,ptype,pmodel)==0)
+			 type_conf==UserTypeConfig::BaseType))
 	{
+		QWriteLocker locker(&user_types_lock);
+
+		if(user_types_refs.count(ptype) != 0 ||
+			 findUserType(type_name, ptype, pmodel) != BaseType::Null)
+			return;
+
 		UserTypeConfig cfg;
+		ModelUserTypes &model_types = model_user_types[pmodel];
+		unsigned type_id = next_user_type_id++;
 
 		cfg.name=type_name;
 		cfg.ptype=ptype;
 		cfg.pmodel=pmodel;
 		cfg.type_conf=type_conf;
-		PgSqlType::user_types.push_back(cfg);
+
+		user_types[type_id] = cfg;
+		user_types_refs[ptype] = type_id;
+		user_types_names[type_name].insert(type_id);
+		model_types.type_ids.insert(type_id);
+		model_types.type_names[type_name].insert(type_id);
 	}
 }
 
 void PgSqlType::removeUserType(const QString &type_name, void *ptype)
 {
-	if(PgSqlType::user_types.size() > 0 &&
-			!type_name.isEmpty() && ptype)
-	{
-		std::vector<UserTypeConfig>::iterator itr, itr_end;
+	if(type_name.isEmpty() || !ptype)
+		return;
 
-		itr=PgSqlType::user_types.begin();
-		itr_end=PgSqlType::user_types.end();
+	QWriteLocker locker(&user_types_lock);
+	auto ref_itr = user_types_refs.find(ptype);
 
-		while(itr!=itr_end)
-		{
-			if(itr->name==type_name && itr->ptype==ptype) break;
-			else itr++;
-		}
+	if(ref_itr == user_types_refs.end())
+		return;
 
-		if(itr!=itr_end)
-		{
-			itr->name=QString("__invalidated_type__");
-			itr->ptype=nullptr;
-			itr->invalidated=true;
-		}
+	unsigned type_id = ref_itr->second;
+	auto type_itr = user_types.find(type_id);
+
+	if(type_itr == user_types.end() || type_itr->second.name != type_name)
+		return;
+
+	auto unindex_name = [type_id](std::unordered_map<QString, std::set<unsigned>> &names, const QString &name) {
+		auto itr = names.find(name);
+
+		if(itr == names.end())
+			return;
+
+		itr->second.erase(type_id);
+
+		if(itr->second.empty())
+			names.erase(itr);
+	};
+
+	/* Instead of only invalidating the type (as done in previous versions) the entry is completely
+	 * removed from the registry. Since the ids are never reused, type instances still holding the
+	 * removed id will simply stop resolving it */
+	auto model_itr = model_user_types.find(type_itr->second.pmodel);
+
+	if(model_itr != model_user_types.end())
+	{
+		model_itr->second.type_ids.erase(type_id);
+		unindex_name(model_itr->second.type_names, type_name);
+
+		if(model_itr->second.type_ids.empty())
+			model_user_types.erase(model_itr);
 	}
+
+	unindex_name(user_types_names, type_name);
+	user_types_refs.erase(ref_itr);
+	user_types.erase(type_itr);
 }
 
 void PgSqlType::renameUserType(const QString &type_name, void *ptype,const QString &new_name)
 {
-	if(PgSqlType::user_types.size() > 0 &&
-			!type_name.isEmpty() && ptype && type_name!=new_name)
-	{
-		std::vector<UserTypeConfig>::iterator itr, itr_end;
+	if(type_name.isEmpty() || !ptype || type_name == new_name)
+		return;
+
+	QWriteLocker locker(&user_types_lock);
+	auto ref_itr = user_types_refs.find(ptype);
+
+	if(ref_itr == user_types_refs.end())
+		return;
+
+	unsigned type_id = ref_itr->second;
+	UserTypeConfig &cfg = user_types.at(type_id);
+
+	if(cfg.name != type_name)
+		return;
 
-		itr=PgSqlType::user_types.begin();
-		itr_end=PgSqlType::user_types.end();
+	auto reindex_name = [type_id, &type_name, &new_name](std::unordered_map<QString, std::set<unsigned>> &names) {
+		auto itr = names.find(type_name);
 
-		while(itr!=itr_end)
+		if(itr != names.end())
 		{
-			if(!itr->invalidated && itr->name==type_name && itr->ptype==ptype)
-			{
-				itr->name=new_name;
-				break;
-			}
-			itr++;
+			itr->second.erase(type_id);
+
+			if(itr->second.empty())
+				names.erase(itr);
 		}
-	}
+
+		names[new_name].insert(type_id);
+	};
+
+	reindex_name(user_types_names);
+	reindex_name(model_user_types[cfg.pmodel].type_names);
+	cfg.name = new_name;
 }
 
 void PgSqlType::removeUserTypes(void *pmodel)
 {
-	if(pmodel)
+	if(!pmodel)
+		return;
+
+	QWriteLocker locker(&user_types_lock);
+	auto model_itr = model_user_types.find(pmodel);
+
+	if(model_itr == model_user_types.end())
+		return;
+
+	for(auto &type_id : model_itr->second.type_ids)
 	{
-		std::vector<UserTypeConfig>::iterator itr;
-		unsigned idx=0;
+		auto type_itr = user_types.find(type_id);
+
+		if(type_itr == user_types.end())
+			continue;
+
+		auto name_itr = user_types_names.find(type_itr->second.name);
 
-		itr=user_types.begin();
-		while(itr!=user_types.end())
+		if(name_itr != user_types_names.end())
 		{
-			if(itr->pmodel==pmodel)
-			{
-				user_types.erase(itr);
-				itr=user_types.begin() + idx;
-			}
-			else
-			{
-				idx++;
-				itr++;
-			}
+			name_itr->second.erase(type_id);
+
+			if(name_itr->second.empty())
+				user_types_names.erase(name_itr);
 		}
+
+		user_types_refs.erase(type_itr->second.ptype);
+		user_types.erase(type_itr);
 	}
+
+	model_user_types.erase(model_itr);
 }
 
 unsigned PgSqlType::getBaseTypeIndex(const QString &type_name)
@@ -622,84 +766,107 @@ unsigned PgSqlType::getBaseTypeIndex(const QString &type_name)
 
 unsigned PgSqlType::getUserTypeIndex(const QString &type_name, void *ptype, void *pmodel)
 {
-	if(user_types.size() > 0 && (!type_name.isEmpty() || ptype))
+	if(type_name.isEmpty() && !ptype)
+		return BaseType::Null;
+
+	QReadLocker locker(&user_types_lock);
+	return findUserType(type_name, ptype, pmodel);
+}
+
+unsigned PgSqlType::findUserType(const QString &type_name, void *ptype, void *pmodel)
+{
+	if(ptype)
 	{
-		std::vector<UserTypeConfig>::iterator itr, itr_end;
-		int idx=0;
+		auto itr = user_types_refs.find(ptype);
 
-		itr=user_types.begin();
-		itr_end=user_types.end();
+		if(itr != user_types_refs.end() &&
+			 (!pmodel || user_types.at(itr->second).pmodel == pmodel))
+			return itr->second;
+	}
 
-		while(itr!=itr_end)
+	if(!type_name.isEmpty())
+	{
+		std::unordered_map<QString, std::set<unsigned>> *names = &user_types_names;
+
+		if(pmodel)
 		{
-			if(!itr->invalidated &&
-					(((!type_name.isEmpty() && itr->name==type_name) || (ptype && itr->ptype==ptype)) &&
-					 ((pmodel && itr->pmodel==pmodel) || !pmodel)))
-				break;
+			auto model_itr = model_user_types.find(pmodel);
+
+			if(model_itr == model_user_types.end())
+				return BaseType::Null;
 
-			idx++;
-			itr++;
+			names = &model_itr->second.type_names;
 		}
 
-		if(itr!=itr_end)
-			return (PseudoEnd + 1 + idx);
-		else
-			return BaseType::Null;
+		auto itr = names->find(type_name);
+
+		if(itr != names->end() && !itr->second.empty())
+			return *itr->second.begin();
 	}
-	else return BaseType::Null;
+
+	return BaseType::Null;
 }
 
-QString PgSqlType::getUserTypeName(unsigned type_id)
+UserTypeConfig PgSqlType::getRegisteredUserType(unsigned type_id)
 {
-	unsigned lim1, lim2;
+	QReadLocker locker(&user_types_lock);
+	auto itr = user_types.find(type_id);
 
-	lim1=PseudoEnd + 1;
-	lim2=lim1 + user_types.size();
+	if(itr == user_types.end())
+		return UserTypeConfig();
 
+	return itr->second;
+}
 
-	if(user_types.size() > 0 &&
-			(type_id >= lim1 && type_id < lim2))
-		return (user_types[type_id - lim1].name);
-	else
-		return "";
+QString PgSqlType::getUserTypeName(unsigned type_id)
+{
+	return getRegisteredUserType(type_id).name;
 }
 
 void PgSqlType::getUserTypes(QStringList &type_list, void *pmodel, unsigned inc_usr_types)
 {
-	unsigned idx,total;
+	QReadLocker locker(&user_types_lock);
+	auto model_itr = model_user_types.find(pmodel);
 
 	type_list.clear();
-	total=user_types.size();
 
-	for(idx=0; idx < total; idx++)
+	if(model_itr == model_user_types.end())
+		return;
+
+	//Only the user defined types of the specified model are retrieved
+	for(auto &type_id : model_itr->second.type_ids)
 	{
-		//Only the user defined types of the specified model are retrieved
-		if(!user_types[idx].invalidated && user_types[idx].pmodel==pmodel &&
-				((inc_usr_types & user_types[idx].type_conf) == user_types[idx].type_conf))
-			type_list.push_back(user_types[idx].name);
+		UserTypeConfig &cfg = user_types.at(type_id);
+
+		if((inc_usr_types & cfg.type_conf) == cfg.type_conf)
+			type_list.push_back(cfg.name);
 	}
 }
 
 void PgSqlType::getUserTypes(std::vector<void *> &ptypes, void *pmodel, unsigned inc_usr_types)
 {
-	unsigned idx, total;
+	QReadLocker locker(&user_types_lock);
+	auto model_itr = model_user_types.find(pmodel);
 
 	ptypes.clear();
-	total=user_types.size();
 
-	for(idx=0; idx < total; idx++)
+	if(model_itr == model_user_types.end())
+		return;
+
+	//Only the user defined types of the specified model are retrieved
+	for(auto &type_id : model_itr->second.type_ids)
 	{
-		//Only the user defined types of the specified model are retrieved
-		if(!user_types[idx].invalidated && user_types[idx].pmodel==pmodel &&
-				((inc_usr_types & user_types[idx].type_conf) == user_types[idx].type_conf))
-			ptypes.push_back(user_types[idx].ptype);
+		UserTypeConfig &cfg = user_types.at(type_id);
+
+		if((inc_usr_types & cfg.type_conf) == cfg.type_conf)
+			ptypes.push_back(cfg.ptype);
 	}
 }
 
 QString PgSqlType::operator ~ ()
 {
 	if(type_idx >= PseudoEnd + 1)
-		return (user_types[type_idx - (PseudoEnd + 1)].name);
+		return getUserTypeName(type_idx);
 	else
 	{
 		QString name = type_names[type_idx];
@@ -970,13 +1137,9 @@ PgSqlType PgSqlType::getAliasType()
 
 void PgSqlType::setDimension(unsigned dim)
 {
-	if(dim > 0 && this->isUserType())
-	{
-		int idx=getUserTypeIndex(~(*this), nullptr) - (PseudoEnd + 1);
-		if(static_cast<unsigned>(idx) < user_types.size() &&
-				user_types[idx].type_conf==UserTypeConfig::SequenceType)
-			throw Exception(ErrorCode::AsgInvalidSequenceTypeArray,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-	}
+	if(dim > 0 && this->isUserType() &&
+		 getUserTypeConfig() == UserTypeConfig::SequenceType)
+		throw Exception(ErrorCode::AsgInvalidSequenceTypeArray,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
 	dimension=dim;
 }
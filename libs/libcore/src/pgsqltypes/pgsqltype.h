@@ -30,6 +30,9 @@
 #include "intervaltype.h"
 #include "spatialtype.h"
 #include "templatetype.h"
+#include <QReadWriteLock>
+#include <unordered_map>
+#include <set>
 
 class PgSqlType: public TemplateType<PgSqlType>{
 	private:
@@ -45,8 +48,35 @@ class PgSqlType: public TemplateType<PgSqlType>{
 		static constexpr unsigned PseudoStart = 104,
 		PseudoEnd = 118;
 
-		//! \brief Configuration for user defined types
-		static std::vector<UserTypeConfig> user_types;
+		//! \brief Stores the user defined types registered by a single database model
+		struct ModelUserTypes {
+			//! \brief Ids of the model's user types in registration order
+			std::set<unsigned> type_ids;
+
+			//! \brief Maps the types names to their ids (the lowest id wins on name clashes)
+			std::unordered_map<QString, std::set<unsigned>> type_names;
+		};
+
+		/*! \brief Guards the user defined types registry. Lookups (the vast majority of the accesses)
+		 * acquire a read lock while registering, renaming and removing types acquire a write lock,
+		 * so several models can be loaded/exported concurrently in the same process */
+		static QReadWriteLock user_types_lock;
+
+		/*! \brief The next id to be assigned to a user defined type. Ids are never reused so
+		 * a type instance referencing a removed user type can't silently point to another one */
+		static unsigned next_user_type_id;
+
+		//! \brief Configuration for user defined types indexed by their ids
+		static std::unordered_map<unsigned, UserTypeConfig> user_types;
+
+		//! \brief Maps the user defined types objects (ptype) to their ids
+		static std::unordered_map<void *, unsigned> user_types_refs;
+
+		//! \brief Maps the user defined types names to their ids (used when searching types without a model)
+		static std::unordered_map<QString, std::set<unsigned>> user_types_names;
+
+		//! \brief Stores the user types per model (pmodel)
+		static std::unordered_map<void *, ModelUserTypes> model_user_types;
 
 		//! \brief Dimension of the type if it's configured as array
 		unsigned dimension,
@@ -84,19 +114,27 @@ class PgSqlType: public TemplateType<PgSqlType>{
 		//! \brief Returns the name of the type using its id
 		static QString getUserTypeName(unsigned type_id);
 
+		/*! \brief Returns the id of the user type matching the name or reference (ptype) in the specified model.
+		 * This method doesn't lock the registry so the caller must hold user_types_lock */
+		static unsigned findUserType(const QString &type_name, void *ptype, void *pmodel);
+
+		/*! \brief Returns a copy of the configuration of the user type with the provided id.
+		 * If the id is not registered the returned config has a null ptype */
+		static UserTypeConfig getRegisteredUserType(unsigned type_id);
+
 		/*! \brief Sets the type based on the user defined type id. This
-		 * method searches exclusively on the user_types vector */
+		 * method searches exclusively on the user types registry */
 		unsigned setUserType(unsigned type_id);
 
 		/*! \brief Sets the type based on the object (user defined type) address. This
-		 * method searches exclusively on the user_types vector */
+		 * method searches exclusively on the user types registry */
 		unsigned setUserType(void *ptype);
 
-		/*! \brief Sets the type based on the id. This version also looks into the user_types vector
+		/*! \brief Sets the type based on the id. This version also looks into the user types registry
 		 * in order to check if the type id being assigend belongs to an user defined type */
 		unsigned setType(unsigned type_id);
 
-		/*! \brief Sets the type based on the name. This version also looks into the user_types vector
+		/*! \brief Sets the type based on the name. This version also looks into the user types registry
 		 * in order to check if the name being assigend belongs to an user defined type */
 		unsigned setType(const QString &type_name);
 
@@ -45,11 +45,6 @@ class UserTypeConfig {
 		//! \brief Type configuration id (refer to ???_TYPE constants)
 		unsigned type_conf;
 
-		/*! \brief Indicates that the type is invalidated after being removed from database model.
-		This wll cause the type not to be listed or referenced. Actually the type is not removed from
-		user type list but deactivated to avoid messing around with other user types */
-		bool invalidated;
-
 	public:
 		static constexpr unsigned BaseType=1, //! \brief The type refers to a user-defined base type (class Type)
 		DomainType=2, //! \brief The type refers to a domain
@@ -67,7 +62,6 @@ class UserTypeConfig {
 			name="";
 			ptype=nullptr;
 			pmodel=nullptr;
-			invalidated=false;
 			type_conf=BaseType;
 		}
 
@@ -19,6 +19,7 @@
 #include "relationship.h"
 #include "coreutilsns.h"
 #include <QApplication>
+#include <new>
 
 const QString Relationship::SuffixSeparator("_");
 const QString Relationship::SrcTabToken("{st}");
@@ -315,6 +316,56 @@ std::vector<unsigned> Relationship::getSpecialPrimaryKeyCols()
 	return this->column_ids_pk_rel;
 }
 
+Relationship::~Relationship()
+{
+	destroyRecycledObjects();
+}
+
+template<class Class>
+Class *Relationship::allocateObject(unsigned role)
+{
+	std::deque<TableObject *> &objs = recycled_objs[role];
+	Class *object = nullptr;
+
+	if(objs.empty())
+		return new Class;
+
+	object = dynamic_cast<Class *>(objs.front());
+	objs.pop_front();
+
+	/* The object is constructed again in the same memory so it gets a new id and the
+	 * same state of a newly allocated one, since the callers only configure the
+	 * attributes that differ from the defaults */
+	object->~Class();
+	return new (object) Class;
+}
+
+void Relationship::recycleObject(TableObject *object, unsigned role)
+{
+	Constraint *constr = dynamic_cast<Constraint *>(object);
+
+	if(!object)
+		return;
+
+	// Removing the references to the columns that may be destroyed before the constraint is reused
+	if(constr)
+		constr->removeColumns();
+
+	object->setParentTable(nullptr);
+	recycled_objs[role].push_back(object);
+}
+
+void Relationship::destroyRecycledObjects()
+{
+	for(auto &itr : recycled_objs)
+	{
+		for(auto &obj : itr.second)
+			delete obj;
+	}
+
+	recycled_objs.clear();
+}
+
 void Relationship::addGeneratedColsToSpecialPk()
 {
 	if(!pk_special)
@@ -354,7 +405,7 @@ void Relationship::createSpecialPrimaryKey()
 				on internal operations of the relationship
 
 		 2) Use the same tablespace as the receiver table */
-		pk_special=new Constraint;
+		pk_special=allocateObject<Constraint>(RecycledPkSpecial);
 		pk_special->setName(generateObjectName(PkPattern));
 		pk_special->setAlias(generateObjectName(PkPattern, nullptr, true));
 		pk_special->setConstraintType(ConstraintType::PrimaryKey);
@@ -1085,7 +1136,7 @@ void Relationship::addColumnsRelGenPart(bool missing_only)
 
 
 					//Creates a new column making the initial configurations
-					column=new Column;
+					column=allocateObject<Column>(RecycledColumn);
 
 					(*column)=(*dst_col);
 
@@ -1217,7 +1268,7 @@ void Relationship::addCheckConstrsRelGenPart()
 
 				if(!aux_constr)
 				{
-					ck_constr=new Constraint;
+					ck_constr=allocateObject<Constraint>(RecycledCheck);
 					(*ck_constr)=(*constr);
 					ck_constr->setParentTable(nullptr);
 					ck_constr->setAddedByGeneralization(true);
@@ -1420,7 +1471,7 @@ void Relationship::configureIndentifierRel(PhysicalTable *recv_tab)
 			//Creates the primary key for the weak entity
 			if(!pk_relident)
 			{
-				pk=new Constraint;
+				pk=allocateObject<Constraint>(RecycledPkIdentifier);
 				pk->setConstraintType(ConstraintType::PrimaryKey);
 				pk->setAddedByLinking(true);
 				pk->setDeferrable(this->deferrable);
@@ -1478,7 +1529,7 @@ void Relationship::addUniqueKey(PhysicalTable *recv_tab)
 		//Alocates the unique key
 		if(!uq_rel11)
 		{
-			uq=new Constraint;
+			uq=allocateObject<Constraint>(RecycledUniqueKey);
 			uq->setDeferrable(this->deferrable);
 			uq->setDeferralType(this->deferral_type);
 			uq->setConstraintType(ConstraintType::Unique);
@@ -1537,7 +1588,7 @@ void Relationship::addForeignKey(PhysicalTable *ref_tab, PhysicalTable *recv_tab
 		if((rel_type==RelationshipNn) ||
 				(!fk_rel1n && (rel_type==Relationship11 || rel_type==Relationship1n)))
 		{
-			fk=new Constraint;
+			fk=(rel_type==RelationshipNn ? new Constraint : allocateObject<Constraint>(RecycledForeignKey));
 			fk->setDeferrable(this->deferrable);
 			fk->setDeferralType(this->deferral_type);
 			fk->setConstraintType(ConstraintType::ForeignKey);
@@ -1726,7 +1777,7 @@ void Relationship::copyColumns(PhysicalTable *ref_tab, PhysicalTable *recv_tab,
 
 			pk_columns.push_back(column_aux);
 
-			column=new Column;
+			column=allocateObject<Column>(RecycledColumn);
 			gen_columns.push_back(column);
 
 			(*column)=(*column_aux);
@@ -1803,6 +1854,7 @@ void Relationship::copyColumns(PhysicalTable *ref_tab, PhysicalTable *recv_tab,
 		while(!gen_columns.empty())
 		{
 			recv_tab->removeObject(gen_columns.back());
+			recycleObject(gen_columns.back(), RecycledColumn);
 			gen_columns.pop_back();
 		}
 
@@ -2279,7 +2331,7 @@ void Relationship::disconnectRelationship(bool rem_tab_objs)
 					while(!ck_constraints.empty())
 					{
 						table->removeObject(ck_constraints.back());
-						delete ck_constraints.back();
+						recycleObject(ck_constraints.back(), RecycledCheck);
 						ck_constraints.pop_back();
 					}
 				}
@@ -2322,9 +2374,8 @@ void Relationship::disconnectRelationship(bool rem_tab_objs)
 
 					if(fk_rel1n)
 					{
-						//Destroy the foreign key
-						fk_rel1n->removeColumns();
-						delete fk_rel1n;
+						//Stores the foreign key to be reused in the next connection
+						recycleObject(fk_rel1n, RecycledForeignKey);
 						fk_rel1n=nullptr;
 					}
 
@@ -2332,8 +2383,7 @@ void Relationship::disconnectRelationship(bool rem_tab_objs)
 					if(uq_rel11)
 					{
 						table->removeConstraint(uq_rel11->getName());
-						uq_rel11->removeColumns();
-						delete uq_rel11;
+						recycleObject(uq_rel11, RecycledUniqueKey);
 						uq_rel11=nullptr;
 					}
 
@@ -2348,8 +2398,8 @@ void Relationship::disconnectRelationship(bool rem_tab_objs)
 						if(table)
 							table->removeConstraint(pk_relident->getName());
 
-						//Destroy the primary key
-						delete pk;
+						//Stores the primary key to be reused in the next connection
+						recycleObject(pk, RecycledPkIdentifier);
 						pk_relident=nullptr;
 					}
 					else if(pk_special && table->getObjectIndex(pk_special) >= 0)
@@ -2406,26 +2456,26 @@ void Relationship::disconnectRelationship(bool rem_tab_objs)
 				list_idx++;
 			}
 
-			//Destroy the special pk before the generated columns to avoid crashes
+			//Recycles the special pk before the generated columns so its references to them are removed
 			if(pk_special)
 			{
-				delete pk_special;
+				recycleObject(pk_special, RecycledPkSpecial);
 				pk_special=nullptr;
 			}
 
 			itr=gen_columns.begin();
 			itr_end=gen_columns.end();
 
-			//Destroy the columns created by the relationship
+			//Recycles the columns created by the relationship so they can be reused in the next connection
 			while(itr!=itr_end)
 			{
 				column=(*itr);
 
-				//Before the destruction the column is removed from table
+				//Before recycling the column is removed from table
 				table->removeColumn(column->getName());
 				itr++;
 
-				delete column;
+				recycleObject(column, RecycledColumn);
 			}
 
 			gen_columns.clear();
@@ -2873,6 +2923,7 @@ QString Relationship::getAlterRelationshipDefinition(bool undo_inh_part)
 	if(rel_type != RelationshipGen && rel_type != RelationshipPart)
 		return "";
 
+	restoreAttributes();
 	attributes[Attributes::Inherit]="";
 	attributes[Attributes::AncestorTable]="";
 	attributes[Attributes::PartitionedTable]="";
@@ -284,6 +284,31 @@ class Relationship: public BaseRelationship {
 		//! \brief Adds the generated columns and relationshp attributes to the special primary key (if in use)
 		void addGeneratedColsToSpecialPk();
 
+		//! \brief Roles of the generated objects that are recycled when the relationship is disconnected (see recycled_objs)
+		static constexpr unsigned RecycledColumn = 0,
+		RecycledForeignKey = 1,
+		RecycledUniqueKey = 2,
+		RecycledPkIdentifier = 3,
+		RecycledPkSpecial = 4,
+		RecycledCheck = 5;
+
+		/*! \brief Stores (per role) the generated columns and constraints released by the last disconnection.
+		 * Since the model validation disconnects and reconnects all the relationships, the next connection reuses
+		 * these objects in the same order instead of destroying and allocating them again */
+		std::map<unsigned, std::deque<TableObject *>> recycled_objs;
+
+		/*! \brief Returns the first recycled object of the provided role or allocates a new one if there's none.
+		 * The reused object receives a new id so it's handled as a newly allocated one in the creation order */
+		template<class Class>
+		Class *allocateObject(unsigned role);
+
+		/*! \brief Stores the object so it can be reused by the next connection. The object must be already removed
+		 * from its parent table. Constraints have their columns removed before being stored */
+		void recycleObject(TableObject *object, unsigned role);
+
+		//! \brief Destroys all the recycled objects
+		void destroyRecycledObjects();
+
 	protected:
 		//! \brief Destroy all the relationship attributes and constraints
 		void destroyObjects();
@@ -329,6 +354,8 @@ class Relationship: public BaseRelationship {
 					 ActionType fk_upd_act=ActionType::Null,
 					 CopyOptions copy_op = CopyOptions(0,0));
 
+		virtual ~Relationship();
+
 		//! \brief  Connects the relationship making the configuration according to its type
 		void connectRelationship();
 
@@ -30,7 +30,7 @@
 
 class Role: public BaseObject {
 	private:
-		static unsigned role_id;
+		static std::atomic<unsigned> role_id;
 
 		/*! \brief Options for the role (SUPERUSER, CREATEDB, CREATEROLE,
 		 INHERIT, LOGIN, ENCRYPTED, REPLICATION, BYPASSRLS) */
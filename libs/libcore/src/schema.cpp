@@ -18,7 +18,7 @@
 
 #include "schema.h"
 
-unsigned Schema::schema_id = 3000;
+std::atomic<unsigned> Schema::schema_id(3000);
 
 Schema::Schema()
 {
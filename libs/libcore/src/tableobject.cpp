@@ -28,6 +28,11 @@ TableObject::TableObject()
 void TableObject::setParentTable(BaseTable *table)
 {
 	parent_table=table;
+
+	/* Releasing the attributes configured during the object's construction
+	 * since they are only needed (and recreated) when generating the code */
+	if(table)
+		clearAttributes();
 }
 
 BaseTable *TableObject::getParentTable()
@@ -74,6 +74,7 @@ src/tools/datamanipulationform.cpp \
 src/tools/modelexportform.cpp \
 src/tools/modelrestorationform.cpp \
 src/tools/sqlexecutionhelper.cpp \
+src/tools/bulkdatahelper.cpp \
 src/tools/databaseimportform.cpp \
 src/tools/metadatahandlingform.cpp \
 src/tools/modelexporthelper.cpp \
@@ -190,6 +191,7 @@ src/tools/datamanipulationform.h \
 src/tools/modelexportform.h \
 src/tools/modelrestorationform.h \
 src/tools/sqlexecutionhelper.h \
+src/tools/bulkdatahelper.h \
 src/tools/databaseimportform.h \
 src/tools/metadatahandlingform.h \
 src/tools/modelexporthelper.h \
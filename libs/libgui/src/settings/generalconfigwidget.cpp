@@ -102,6 +102,8 @@ GeneralConfigWidget::GeneralConfigWidget(QWidget * parent) : BaseConfigWidget(pa
 	config_params[Attributes::Configuration][Attributes::ShowMainMenu]="";
 	config_params[Attributes::Configuration][Attributes::CodeCompletion]="";
 	config_params[Attributes::Configuration][Attributes::UsePlaceholders]="";
+	config_params[Attributes::Configuration][Attributes::LazyRendering]="";
+	config_params[Attributes::Configuration][Attributes::TrustSavedModels]="";
 	config_params[Attributes::Configuration][Attributes::HistoryMaxLength]="";
 	config_params[Attributes::Configuration][Attributes::SourceEditorApp]="";
 	config_params[Attributes::Configuration][Attributes::UiLanguage]="";
@@ -212,6 +214,8 @@ void GeneralConfigWidget::loadConfiguration()
 		confirm_validation_chk->setChecked(config_params[Attributes::Configuration][Attributes::ConfirmValidation]==Attributes::True);
 		code_completion_chk->setChecked(config_params[Attributes::Configuration][Attributes::CodeCompletion]==Attributes::True);
 		use_placeholders_chk->setChecked(config_params[Attributes::Configuration][Attributes::UsePlaceholders]==Attributes::True);
+		lazy_rendering_chk->setChecked(config_params[Attributes::Configuration][Attributes::LazyRendering]==Attributes::True);
+		trust_saved_models_chk->setChecked(config_params[Attributes::Configuration][Attributes::TrustSavedModels]==Attributes::True);
 		use_curved_lines_chk->setChecked(config_params[Attributes::Configuration][Attributes::UseCurvedLines]==Attributes::True);
 
 		print_grid_chk->setChecked(config_params[Attributes::Configuration][Attributes::PrintGrid]==Attributes::True);
@@ -401,6 +405,8 @@ void GeneralConfigWidget::saveConfiguration()
 		config_params[Attributes::Configuration][Attributes::ConfirmValidation]=(confirm_validation_chk->isChecked() ? Attributes::True : "");
 		config_params[Attributes::Configuration][Attributes::CodeCompletion]=(code_completion_chk->isChecked() ? Attributes::True : "");
 		config_params[Attributes::Configuration][Attributes::UsePlaceholders]=(use_placeholders_chk->isChecked() ? Attributes::True : "");
+		config_params[Attributes::Configuration][Attributes::LazyRendering]=(lazy_rendering_chk->isChecked() ? Attributes::True : "");
+		config_params[Attributes::Configuration][Attributes::TrustSavedModels]=(trust_saved_models_chk->isChecked() ? Attributes::True : "");
 		config_params[Attributes::Configuration][Attributes::HistoryMaxLength]=QString::number(history_max_length_spb->value());
 		config_params[Attributes::Configuration][Attributes::UseCurvedLines]=(use_curved_lines_chk->isChecked() ? Attributes::True : "");
 
@@ -546,6 +552,8 @@ void GeneralConfigWidget::applyConfiguration()
 	OperationList::setMaximumSize(oplist_size_spb->value());
 	BaseTableView::setHideExtAttributes(hide_ext_attribs_chk->isChecked());
 	BaseTableView::setHideTags(hide_table_tags_chk->isChecked());
+	BaseTableView::setLazyRendering(lazy_rendering_chk->isChecked());
+	DatabaseModel::setTrustSavedModels(trust_saved_models_chk->isChecked());
 
 	NumberedTextEditor::setSourceEditorApp(source_editor_sel->getSelectedFile());
 	NumberedTextEditor::setSourceEditorAppArgs(source_editor_args_edt->text());
@@ -0,0 +1,619 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2022 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "bulkdatahelper.h"
+#include "utilsns.h"
+#include <QRegularExpression>
+
+const QString BulkDataHelper::SavepointName("pgmodeler_bulk_batch");
+
+BulkDataHelper::BulkDataHelper(QObject *parent) : QObject(parent)
+{
+	is_primary_key = canceled = false;
+	batch_size = DefaultBatchSize;
+	processed_rows = total_rows = 0;
+	failed_row = -1;
+}
+
+void BulkDataHelper::setTable(const QString &schema, const QString &table, const QStringList &columns, const QStringList &key_columns, bool is_pk)
+{
+	this->schema = schema;
+	this->table = table;
+	this->columns = columns;
+	this->key_columns = key_columns;
+	is_primary_key = is_pk;
+	col_types.clear();
+	clearRows();
+}
+
+void BulkDataHelper::setBatchSize(unsigned size)
+{
+	batch_size = (size == 0 ? DefaultBatchSize : size);
+}
+
+void BulkDataHelper::setColumnTypes(const attribs_map &types)
+{
+	col_types = types;
+}
+
+void BulkDataHelper::retrieveColumnTypes(Connection &conn)
+{
+	try
+	{
+		ResultSet res;
+		QString tab_name = getTableName();
+
+		/* The types are retrieved without their modifiers (typmod -1) since casting to them would truncate the values
+		 * silently (e.g. varchar(n)) while the assignment to the column raises an error for invalid values.
+		 * Using -1 instead of NULL also avoids types like bpchar and bit being returned as character(1) and bit(1) */
+		conn.executeDMLCommand(QString("SELECT attname, format_type(atttypid, -1) AS type FROM pg_attribute "
+																	 "WHERE attrelid = '%1'::regclass AND attnum > 0 AND NOT attisdropped")
+													 .arg(tab_name.replace("'", "''")), res);
+
+		col_types.clear();
+
+		if(res.accessTuple(ResultSet::FirstTuple))
+		{
+			do
+			{
+				col_types[res.getColumnValue("attname")] = res.getColumnValue("type");
+			}
+			while(res.accessTuple(ResultSet::NextTuple));
+		}
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void BulkDataHelper::addInsertedRow(int row_id, const QStringList &values)
+{
+	ins_rows.push_back({ row_id, {}, values, {} });
+}
+
+void BulkDataHelper::addUpdatedRow(int row_id, const QStringList &key_values, const QStringList &values, const std::vector<bool> &changed)
+{
+	upd_rows.push_back({ row_id, key_values, values, changed });
+}
+
+void BulkDataHelper::addDeletedRow(int row_id, const QStringList &key_values)
+{
+	del_rows.push_back({ row_id, key_values, {}, {} });
+}
+
+void BulkDataHelper::clearRows()
+{
+	ins_rows.clear();
+	upd_rows.clear();
+	del_rows.clear();
+}
+
+unsigned BulkDataHelper::getRowCount()
+{
+	return ins_rows.size() + upd_rows.size() + del_rows.size();
+}
+
+int BulkDataHelper::getFailedRow()
+{
+	return failed_row;
+}
+
+bool BulkDataHelper::isCanceled()
+{
+	return canceled;
+}
+
+void BulkDataHelper::cancelSaving()
+{
+	canceled = true;
+}
+
+QString BulkDataHelper::getTableName()
+{
+	return QString("\"%1\".\"%2\"").arg(schema, table);
+}
+
+bool BulkDataHelper::isExpressionValue(const QString &value)
+{
+	return value.startsWith(UtilsNs::UnescValueStart) && value.endsWith(UtilsNs::UnescValueEnd);
+}
+
+QString BulkDataHelper::formatValue(const QString &value, int row_id, const QString &col_name)
+{
+	QString fmt_value = value;
+
+	//Checking if the value is a malformed unescaped value, e.g., /value, value/, /value\/
+	if((value.startsWith(UtilsNs::UnescValueStart) && value.endsWith(QString("\\") + UtilsNs::UnescValueEnd)) ||
+		 (value.startsWith(UtilsNs::UnescValueStart) && !value.endsWith(UtilsNs::UnescValueEnd)) ||
+		 (!value.startsWith(UtilsNs::UnescValueStart) && !value.endsWith(QString("\\") + UtilsNs::UnescValueEnd) && value.endsWith(UtilsNs::UnescValueEnd)))
+		throw Exception(Exception::getErrorMessage(ErrorCode::MalformedUnescapedValue)
+										.arg(row_id + 1).arg(col_name),
+										ErrorCode::MalformedUnescapedValue,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	//Empty values as considered as DEFAULT
+	if(fmt_value.isEmpty())
+		return QString("DEFAULT");
+
+	//Unescaped values will not be enclosed in quotes
+	if(isExpressionValue(fmt_value))
+	{
+		fmt_value.remove(0,1);
+		fmt_value.remove(fmt_value.length()-1, 1);
+		return fmt_value;
+	}
+
+	//Quoting value
+	fmt_value.replace(QString("\\") + UtilsNs::UnescValueStart, UtilsNs::UnescValueStart);
+	fmt_value.replace(QString("\\") + UtilsNs::UnescValueEnd, UtilsNs::UnescValueEnd);
+	fmt_value.replace("\'","''");
+	return QString("E'") + fmt_value + QString("'");
+}
+
+QString BulkDataHelper::formatCopyValue(const QString &value)
+{
+	static const QRegularExpression hex_regexp("^[0-9a-fA-F]+$");
+	QString fmt_value = value, copy_value, hex, chr;
+	int len = 0;
+	char32_t code = 0;
+
+	fmt_value.replace(QString("\\") + UtilsNs::UnescValueStart, UtilsNs::UnescValueStart);
+	fmt_value.replace(QString("\\") + UtilsNs::UnescValueEnd, UtilsNs::UnescValueEnd);
+
+	// \N is the NULL marker in COPY while in escaped strings it's just the letter N
+	if(fmt_value == QString("\\N"))
+		return QString("N");
+
+	/* The COPY text format handles most of the backslash sequences the same way escaped strings (E'') do,
+	 * except the unicode ones (\uXXXX and \UXXXXXXXX) which would be read as the letters u/U followed by the digits.
+	 * So those sequences are replaced by the characters they represent, while the other ones are kept as is */
+	for(int pos = 0; pos < fmt_value.size(); pos++)
+	{
+		if(fmt_value[pos] != QChar('\\') || pos + 1 >= fmt_value.size())
+		{
+			copy_value.append(fmt_value[pos]);
+			continue;
+		}
+
+		len = (fmt_value[pos + 1] == QChar('u') ? 4 : (fmt_value[pos + 1] == QChar('U') ? 8 : 0));
+		hex = fmt_value.mid(pos + 2, len);
+
+		// Other sequences (including escaped backslashes) are copied entirely so their second char isn't handled again
+		if(len == 0 || hex.size() != len || !hex_regexp.match(hex).hasMatch())
+		{
+			copy_value.append(fmt_value.mid(pos, 2));
+			pos++;
+			continue;
+		}
+
+		/* A \u sequence is an UTF-16 code unit, so the surrogate pairs written as two sequences
+		 * result in a valid pair when appended one after the other */
+		code = hex.toUInt(nullptr, 16);
+		chr = (len == 4 ? QString(QChar(static_cast<char16_t>(code))) : QString::fromUcs4(&code, 1));
+		copy_value.append(chr == QString("\\") ? QString("\\\\") : chr);
+		pos += len + 1;
+	}
+
+	// Only the chars used as delimiters in the buffer need to be escaped
+	copy_value.replace(QChar('\t'), QString("\\t"));
+	copy_value.replace(QChar('\n'), QString("\\n"));
+	copy_value.replace(QChar('\r'), QString("\\r"));
+
+	return copy_value;
+}
+
+QString BulkDataHelper::getTypedValue(const QString &fmt_value, const QString &col_name, bool is_expr)
+{
+	if(!col_types.count(col_name))
+		return fmt_value;
+
+	return QString(is_expr ? "(%1)::%2" : "%1::%2").arg(fmt_value, col_types.at(col_name));
+}
+
+QString BulkDataHelper::getKeysCondition(const QString &tab_alias, const QString &vals_alias)
+{
+	QStringList conds;
+	QString oper = is_primary_key ? QString("=") : QString("IS NOT DISTINCT FROM");
+
+	for(int idx = 0; idx < key_columns.size(); idx++)
+		conds.append(QString("%1.\"%2\" %3 %4._k%5").arg(tab_alias, key_columns[idx], oper, vals_alias).arg(idx));
+
+	return conds.join(" AND ");
+}
+
+QString BulkDataHelper::getKeysCondition(const RowData &row)
+{
+	QStringList conds;
+	QString value;
+
+	for(int idx = 0; idx < key_columns.size(); idx++)
+	{
+		if(row.key_values.at(idx).isNull())
+			conds.append(QString("\"%1\" IS NULL").arg(key_columns[idx]));
+		else
+		{
+			value = row.key_values.at(idx);
+			conds.append(QString("\"%1\"='%2'").arg(key_columns[idx], value.replace("\'","''")));
+		}
+	}
+
+	return conds.join(" AND ");
+}
+
+QString BulkDataHelper::getKeyValuesRow(const RowData &row)
+{
+	QStringList values;
+	QString value;
+
+	for(int idx = 0; idx < row.key_values.size(); idx++)
+	{
+		if(row.key_values.at(idx).isNull())
+			value = QString("NULL");
+		else
+		{
+			value = row.key_values.at(idx);
+			value = QString("'%1'").arg(value.replace("\'","''"));
+		}
+
+		values.append(getTypedValue(value, key_columns.at(idx)));
+	}
+
+	return values.join(", ");
+}
+
+QString BulkDataHelper::getInsertCommand(const std::vector<const RowData *> &rows, bool use_copy, QByteArray *copy_buffer)
+{
+	if(rows.empty())
+		return "";
+
+	QStringList col_list, val_list, rows_list;
+	std::vector<int> col_ids;
+
+	for(int col = 0; col < columns.size(); col++)
+	{
+		/* In the COPY all the rows have values for the same columns (see saveInsertedRows())
+		 * so the columns without values are ignored and receive their default values */
+		if(use_copy && rows[0]->values.at(col).isEmpty())
+			continue;
+
+		col_ids.push_back(col);
+		col_list.append(QString("\"%1\"").arg(columns[col]));
+	}
+
+	if(use_copy)
+	{
+		if(copy_buffer)
+		{
+			copy_buffer->clear();
+
+			for(auto &row : rows)
+			{
+				val_list.clear();
+
+				for(auto &col : col_ids)
+					val_list.append(formatCopyValue(row->values.at(col)));
+
+				copy_buffer->append(val_list.join(QChar('\t')).toUtf8());
+				copy_buffer->append('\n');
+			}
+		}
+
+		return QString("COPY %1(%2) FROM STDIN").arg(getTableName(), col_list.join(", "));
+	}
+
+	for(auto &row : rows)
+	{
+		val_list.clear();
+
+		for(auto &col : col_ids)
+			val_list.append(formatValue(row->values.at(col), row->row_id, columns[col]));
+
+		rows_list.append(QString("(%1)").arg(val_list.join(", ")));
+	}
+
+	return QString("INSERT INTO %1(%2) VALUES %3").arg(getTableName(), col_list.join(", "), rows_list.join(", "));
+}
+
+QString BulkDataHelper::getUpdateCommand(const std::vector<const RowData *> &rows)
+{
+	if(rows.empty())
+		return "";
+
+	QStringList set_list, col_aliases, rows_list, val_list;
+	std::vector<int> col_ids;
+
+	for(int col = 0; col < columns.size(); col++)
+	{
+		if(rows[0]->changed.at(col))
+			col_ids.push_back(col);
+	}
+
+	if(col_ids.empty())
+		return "";
+
+	// A single row is updated using its values directly (this form also accepts DEFAULT as value)
+	if(rows.size() == 1)
+	{
+		for(auto &col : col_ids)
+			set_list.append(QString("\"%1\"=%2").arg(columns[col], formatValue(rows[0]->values.at(col), rows[0]->row_id, columns[col])));
+
+		return QString("UPDATE %1 SET %2 WHERE %3").arg(getTableName(), set_list.join(", "), getKeysCondition(*rows[0]));
+	}
+
+	for(int idx = 0; idx < key_columns.size(); idx++)
+		col_aliases.append(QString("_k%1").arg(idx));
+
+	for(auto &col : col_ids)
+	{
+		col_aliases.append(QString("_c%1").arg(col));
+		set_list.append(QString("\"%1\"=_v._c%2").arg(columns[col]).arg(col));
+	}
+
+	for(auto &row : rows)
+	{
+		val_list.clear();
+		val_list.append(getKeyValuesRow(*row));
+
+		for(auto &col : col_ids)
+		{
+			val_list.append(getTypedValue(formatValue(row->values.at(col), row->row_id, columns[col]),
+																		columns[col], isExpressionValue(row->values.at(col))));
+		}
+
+		rows_list.append(QString("(%1)").arg(val_list.join(", ")));
+	}
+
+	return QString("UPDATE %1 AS _t SET %2 FROM (VALUES %3) AS _v(%4) WHERE %5")
+			.arg(getTableName(), set_list.join(", "), rows_list.join(", "),
+					 col_aliases.join(", "), getKeysCondition("_t", "_v"));
+}
+
+QString BulkDataHelper::getDeleteCommand(const std::vector<const RowData *> &rows)
+{
+	if(rows.empty())
+		return "";
+
+	QStringList col_aliases, rows_list;
+
+	// A single row is deleted using its key values directly
+	if(rows.size() == 1)
+		return QString("DELETE FROM %1 WHERE %2").arg(getTableName(), getKeysCondition(*rows[0]));
+
+	for(int idx = 0; idx < key_columns.size(); idx++)
+		col_aliases.append(QString("_k%1").arg(idx));
+
+	for(auto &row : rows)
+		rows_list.append(QString("(%1)").arg(getKeyValuesRow(*row)));
+
+	return QString("DELETE FROM %1 AS _t USING (VALUES %2) AS _v(%3) WHERE %4")
+			.arg(getTableName(), rows_list.join(", "), col_aliases.join(", "), getKeysCondition("_t", "_v"));
+}
+
+void BulkDataHelper::executeBatches(Connection &conn, const std::vector<const RowData *> &rows, unsigned max_rows,
+																		const std::function<void(const std::vector<const RowData *> &)> &exec_batch)
+{
+	std::vector<const RowData *> batch;
+
+	for(size_t idx = 0; idx < rows.size(); idx += max_rows)
+	{
+		if(canceled)
+			throw Exception(tr("The saving of the changes was canceled by the user!"), __PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+		batch.assign(rows.begin() + idx, rows.begin() + std::min(rows.size(), idx + max_rows));
+
+		try
+		{
+			if(batch.size() > 1)
+				conn.executeDDLCommand(QString("SAVEPOINT %1").arg(SavepointName));
+
+			exec_batch(batch);
+
+			if(batch.size() > 1)
+				conn.executeDDLCommand(QString("RELEASE SAVEPOINT %1").arg(SavepointName));
+		}
+		catch(Exception &e)
+		{
+			if(batch.size() == 1)
+			{
+				failed_row = batch[0]->row_id;
+				throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+			}
+
+			/* Undoing the failed batch and running its rows one by one in order to determine
+			 * which one caused the error. If all of them succeed the saving proceeds normally */
+			conn.executeDDLCommand(QString("ROLLBACK TO SAVEPOINT %1").arg(SavepointName));
+
+			for(auto &row : batch)
+			{
+				try
+				{
+					exec_batch({ row });
+				}
+				catch(Exception &row_e)
+				{
+					failed_row = row->row_id;
+					throw Exception(row_e.getErrorMessage(), row_e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &row_e);
+				}
+			}
+		}
+
+		processed_rows += batch.size();
+		emit s_progressUpdated((processed_rows * 100) / total_rows,
+													 tr("Saving changes: %1 of %2 row(s) processed...").arg(processed_rows).arg(total_rows));
+	}
+}
+
+void BulkDataHelper::saveDeletedRows(Connection &conn)
+{
+	std::vector<const RowData *> rows;
+
+	for(auto &row : del_rows)
+		rows.push_back(&row);
+
+	executeBatches(conn, rows, batch_size, [&](const std::vector<const RowData *> &batch) {
+		conn.executeDDLCommand(getDeleteCommand(batch));
+	});
+}
+
+void BulkDataHelper::saveUpdatedRows(Connection &conn)
+{
+	std::map<std::vector<bool>, std::vector<const RowData *>> groups;
+	std::vector<const RowData *> single_rows;
+	bool has_default = false;
+
+	/* The rows are grouped by the columns they change since each batch updates the same set of columns.
+	 * Rows that change a column to DEFAULT are updated one at a time because DEFAULT isn't accepted in VALUES lists */
+	for(auto &row : upd_rows)
+	{
+		has_default = false;
+
+		for(int col = 0; col < columns.size() && !has_default; col++)
+			has_default = row.changed.at(col) && row.values.at(col).isEmpty();
+
+		if(std::find(row.changed.begin(), row.changed.end(), true) == row.changed.end())
+			processed_rows++;
+		else if(has_default)
+			single_rows.push_back(&row);
+		else
+			groups[row.changed].push_back(&row);
+	}
+
+	auto exec_update = [&](const std::vector<const RowData *> &batch) {
+		conn.executeDDLCommand(getUpdateCommand(batch));
+	};
+
+	for(auto &itr : groups)
+		executeBatches(conn, itr.second, batch_size, exec_update);
+
+	executeBatches(conn, single_rows, 1, exec_update);
+}
+
+void BulkDataHelper::saveInsertedRows(Connection &conn)
+{
+	std::map<QString, std::vector<const RowData *>> copy_groups;
+	std::vector<const RowData *> expr_rows;
+	QString cols_mask;
+	bool has_expr = false;
+
+	/* The rows are grouped by the columns that have values so each group is sent in a COPY command.
+	 * Rows with expressions or without values at all are inserted via multi-row INSERT commands */
+	for(auto &row : ins_rows)
+	{
+		cols_mask.clear();
+		has_expr = false;
+
+		for(int col = 0; col < columns.size(); col++)
+		{
+			// Validating the value (malformed unescaped values raise errors)
+			formatValue(row.values.at(col), row.row_id, columns[col]);
+
+			has_expr = has_expr || isExpressionValue(row.values.at(col));
+			cols_mask += row.values.at(col).isEmpty() ? QChar('0') : QChar('1');
+		}
+
+		if(has_expr || !cols_mask.contains(QChar('1')))
+			expr_rows.push_back(&row);
+		else
+			copy_groups[cols_mask].push_back(&row);
+	}
+
+	for(auto &itr : copy_groups)
+	{
+		executeBatches(conn, itr.second, batch_size, [&](const std::vector<const RowData *> &batch) {
+			QByteArray buffer;
+			QString cmd = getInsertCommand(batch, true, &buffer);
+			conn.executeCopyFromCommand(cmd, buffer);
+		});
+	}
+
+	executeBatches(conn, expr_rows, batch_size, [&](const std::vector<const RowData *> &batch) {
+		conn.executeDDLCommand(getInsertCommand(batch, false));
+	});
+}
+
+void BulkDataHelper::rollbackSaving(Connection &conn)
+{
+	try
+	{
+		if(conn.isStablished())
+			conn.executeDDLCommand(QString("ROLLBACK"));
+	}
+	catch(Exception &)
+	{}
+}
+
+void BulkDataHelper::beginSaving(Connection &conn)
+{
+	canceled = false;
+	failed_row = -1;
+	processed_rows = total_rows = 0;
+	retrieveColumnTypes(conn);
+	conn.executeDDLCommand(QString("START TRANSACTION"));
+}
+
+void BulkDataHelper::saveRows(Connection &conn)
+{
+	try
+	{
+		// When saving in several steps the total only considers the rows added so far
+		total_rows = processed_rows + getRowCount();
+
+		saveDeletedRows(conn);
+		saveUpdatedRows(conn);
+		saveInsertedRows(conn);
+		clearRows();
+	}
+	catch(Exception &e)
+	{
+		rollbackSaving(conn);
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void BulkDataHelper::finishSaving(Connection &conn)
+{
+	try
+	{
+		conn.executeDDLCommand(QString("COMMIT"));
+	}
+	catch(Exception &e)
+	{
+		rollbackSaving(conn);
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
+void BulkDataHelper::saveChanges(Connection &conn)
+{
+	unsigned row_cnt = getRowCount();
+
+	if(row_cnt == 0)
+		return;
+
+	try
+	{
+		beginSaving(conn);
+		emit s_progressUpdated(0, tr("Saving changes: %1 row(s) to be processed...").arg(row_cnt));
+		saveRows(conn);
+		finishSaving(conn);
+	}
+	catch(Exception &e)
+	{
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
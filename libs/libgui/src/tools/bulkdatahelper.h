@@ -0,0 +1,209 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2022 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libgui
+\class BulkDataHelper
+\brief Implements the bulk insertion, update and deletion of table rows used by the data manipulation form
+*/
+
+#ifndef BULK_DATA_HELPER_H
+#define BULK_DATA_HELPER_H
+
+#include <QObject>
+#include <functional>
+#include <map>
+#include <algorithm>
+#include "connection.h"
+
+/*! \brief Instead of running one command per changed row, this helper sends the rows to the server in batches:
+ * inserts are done via COPY ... FROM STDIN (or multi-row INSERT when the values contain expressions),
+ * updates via UPDATE ... FROM (VALUES ...) and deletes via DELETE ... USING (VALUES ...). The values in
+ * the VALUES lists are cast to the types of the columns, which are retrieved when the saving starts.
+ * All the commands run in a single transaction. When a batch fails its rows are retried one by one
+ * (inside a savepoint) so the row that caused the error can be reported.
+ *
+ * The values follow the same rules of the data manipulation grid: empty values are replaced by DEFAULT,
+ * unescaped values (between UtilsNs::UnescValueStart and UtilsNs::UnescValueEnd) are used as SQL expressions
+ * and the other ones are used as escaped string literals. */
+class BulkDataHelper: public QObject {
+	Q_OBJECT
+
+	public:
+		//! \brief Stores the values of a row to be inserted, updated or deleted
+		struct RowData {
+			//! \brief The row identifier used to report errors (e.g. the row index in a grid)
+			int row_id;
+
+			//! \brief The original values of the key columns. Null strings are handled as NULL
+			QStringList key_values;
+
+			//! \brief The values of the columns (not used by deletes)
+			QStringList values;
+
+			//! \brief Indicates the columns in which values were changed (used only by updates)
+			std::vector<bool> changed;
+		};
+
+	private:
+		//! \brief The schema and name of the table being handled
+		QString schema, table;
+
+		//! \brief The columns that can be inserted/updated and the ones used to identify the rows in updates/deletes
+		QStringList columns, key_columns;
+
+		//! \brief The data types of the table's columns (without modifiers) used to cast the values in the VALUES lists
+		attribs_map col_types;
+
+		//! \brief Indicates that the key columns form a primary key (otherwise, NULL values are compared too)
+		bool is_primary_key,
+
+		//! \brief Indicates that the current saving must be aborted
+		canceled;
+
+		//! \brief The maximum amount of rows sent to the server in each command
+		unsigned batch_size;
+
+		//! \brief The amount of rows processed by the current saving and the total of rows to be saved
+		unsigned processed_rows, total_rows;
+
+		//! \brief The identifier of the row that caused the last saving to fail (-1 if unknown)
+		int failed_row;
+
+		std::vector<RowData> ins_rows, upd_rows, del_rows;
+
+		//! \brief Returns the table's name formatted to be used in the commands
+		QString getTableName();
+
+		/*! \brief Returns the formatted value cast to the type of the column. Without the casts the values
+		 * in a VALUES list would be handled as text and fail to be compared/assigned to other types.
+		 * The is_expr indicates that the value is an SQL expression, which is enclosed in parenthesis before the cast */
+		QString getTypedValue(const QString &fmt_value, const QString &col_name, bool is_expr = false);
+
+		//! \brief Returns the condition that compares the table's keys to the ones in the values subquery
+		QString getKeysCondition(const QString &tab_alias, const QString &vals_alias);
+
+		//! \brief Returns the condition that compares the table's keys to the key values of a single row
+		QString getKeysCondition(const RowData &row);
+
+		//! \brief Returns the values of the row key columns formatted as a VALUES row
+		QString getKeyValuesRow(const RowData &row);
+
+		/*! \brief Executes the rows in batches of at most max_rows using the provided function to run each batch.
+		 * When a batch fails its rows are executed one by one to determine the row that caused the error */
+		void executeBatches(Connection &conn, const std::vector<const RowData *> &rows, unsigned max_rows,
+												const std::function<void(const std::vector<const RowData *> &)> &exec_batch);
+
+		void saveDeletedRows(Connection &conn);
+		void saveUpdatedRows(Connection &conn);
+		void saveInsertedRows(Connection &conn);
+
+		//! \brief Rolls back the transaction started by beginSaving() ignoring any error
+		void rollbackSaving(Connection &conn);
+
+	public:
+		//! \brief Default amount of rows sent to the server per command
+		static constexpr unsigned DefaultBatchSize = 1000;
+
+		//! \brief Name of the savepoint created before each batch
+		static const QString SavepointName;
+
+		BulkDataHelper(QObject *parent = nullptr);
+
+		/*! \brief Configures the table to be handled. The columns are the ones that will receive values and the key columns
+		 * the ones used to identify the rows being updated/deleted. When is_pk is false, the key columns are compared
+		 * using IS NOT DISTINCT FROM so rows with NULL values can be identified as well. This method clears all the rows */
+		void setTable(const QString &schema, const QString &table, const QStringList &columns, const QStringList &key_columns, bool is_pk);
+
+		//! \brief Defines the maximum amount of rows sent to the server in each command
+		void setBatchSize(unsigned size);
+
+		/*! \brief Defines the data types of the table's columns (column name as key). The types are retrieved
+		 * from the server by beginSaving(), so this method is only needed to generate the commands without saving them */
+		void setColumnTypes(const attribs_map &types);
+
+		//! \brief Retrieves the data types of the table's columns from the server using the provided connection
+		void retrieveColumnTypes(Connection &conn);
+
+		//! \brief Adds a row to be inserted. The values must be in the same order of the configured columns
+		void addInsertedRow(int row_id, const QStringList &values);
+
+		//! \brief Adds a row to be updated. Only the values in which the changed flags are set are updated
+		void addUpdatedRow(int row_id, const QStringList &key_values, const QStringList &values, const std::vector<bool> &changed);
+
+		//! \brief Adds a row to be deleted
+		void addDeletedRow(int row_id, const QStringList &key_values);
+
+		//! \brief Removes all the rows added to the helper
+		void clearRows();
+
+		//! \brief Returns the amount of rows added to the helper
+		unsigned getRowCount();
+
+		//! \brief Returns the identifier of the row that caused the last saving to fail (-1 if the row is unknown)
+		int getFailedRow();
+
+		bool isCanceled();
+
+		/*! \brief Formats a value according to the data manipulation grid rules. This method raises an error
+		 * if the value is a malformed unescaped value, e.g., /value, value/, /value\/ */
+		static QString formatValue(const QString &value, int row_id, const QString &col_name);
+
+		/*! \brief Formats a value to be sent in the COPY ... FROM STDIN text format buffer. Since that format
+		 * doesn't support the unicode escapes (\uXXXX and \UXXXXXXXX) they are replaced by the characters they represent */
+		static QString formatCopyValue(const QString &value);
+
+		//! \brief Returns if the value is used as an SQL expression (unescaped value)
+		static bool isExpressionValue(const QString &value);
+
+		/*! \brief Returns the command that inserts the provided rows. When use_copy is true a COPY command
+		 * is returned and the rows data is written in copy_buffer */
+		QString getInsertCommand(const std::vector<const RowData *> &rows, bool use_copy, QByteArray *copy_buffer = nullptr);
+
+		//! \brief Returns the command that updates the changed columns of the provided rows (all must have the same changed columns)
+		QString getUpdateCommand(const std::vector<const RowData *> &rows);
+
+		//! \brief Returns the command that deletes the provided rows
+		QString getDeleteCommand(const std::vector<const RowData *> &rows);
+
+		/*! \brief Saves all the rows (deleting, updating and inserting them, in this order) in a single transaction.
+		 * In case of errors the transaction is rolled back and the error is raised. The saved rows are removed from the helper */
+		void saveChanges(Connection &conn);
+
+		/*! \brief Starts a saving that is done in several steps (retrieving the columns' data types first). This is used when the rows can't be held in memory at once,
+		 * e.g., when inserting the rows of a huge csv file: the consumer adds a batch of rows, calls saveRows() and repeats
+		 * the process until all the rows are saved, finally calling finishSaving(). Everything runs in a single transaction */
+		void beginSaving(Connection &conn);
+
+		/*! \brief Saves the rows added since the last call and removes them from the helper.
+		 * In case of errors the transaction is rolled back and the error is raised */
+		void saveRows(Connection &conn);
+
+		//! \brief Commits the saving started by beginSaving()
+		void finishSaving(Connection &conn);
+
+	public slots:
+		//! \brief Aborts the current saving. The changes are rolled back once the running batch finishes
+		void cancelSaving();
+
+	signals:
+		//! \brief This signal is emitted after each batch is sent to the server
+		void s_progressUpdated(int progress, QString msg);
+};
+
+#endif
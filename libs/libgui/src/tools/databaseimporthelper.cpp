@@ -20,6 +20,7 @@
 #include "defaultlanguages.h"
 #include "utilsns.h"
 #include "coreutilsns.h"
+#include <queue>
 
 const QString DatabaseImportHelper::UnkownObjectOidXml("\t<!--[ unknown object OID=%1 ]-->\n");
 
@@ -29,7 +30,7 @@ DatabaseImportHelper::DatabaseImportHelper(QObject *parent) : QObject(parent)
 	rand_num_engine.seed(rand_seed());
 
 	import_canceled=ignore_errors=import_sys_objs=import_ext_objs=rand_rel_colors=update_fk_rels=false;
-	auto_resolve_deps=true;
+	auto_resolve_deps=sort_by_deps=true;
 	import_filter=Catalog::ListAllObjects | Catalog::ExclExtensionObjs | Catalog::ExclSystemObjs;
 	xmlparser=nullptr;
 	dbmodel=nullptr;
@@ -40,7 +41,9 @@ void DatabaseImportHelper::setConnection(Connection &conn)
 	try
 	{
 		connection.setConnectionParams(conn.getConnectionParams());
-		catalog.setConnection(connection);
+
+		//The database metadata is always retrieved again since the import must reflect the current state of the database
+		catalog.setConnection(connection, true);
 	}
 	catch(Exception &e)
 	{
@@ -59,7 +62,7 @@ void DatabaseImportHelper::setCurrentDatabase(const QString &dbname)
 	try
 	{
 		connection.switchToDatabase(dbname);
-		catalog.setConnection(connection);
+		catalog.setConnection(connection, true);
 	}
 	catch(Exception &e)
 	{
@@ -112,6 +115,11 @@ void DatabaseImportHelper::setImportOptions(bool import_sys_objs, bool import_ex
 		import_filter=Catalog::ListAllObjects | Catalog::ExclBuiltinArrayTypes | Catalog::ExclExtensionObjs | Catalog::ExclSystemObjs;
 }
 
+void DatabaseImportHelper::setSortByDependencies(bool value)
+{
+	sort_by_deps = value;
+}
+
 unsigned DatabaseImportHelper::getLastSystemOID()
 {
 	return catalog.getLastSysObjectOID();
@@ -226,8 +234,6 @@ void DatabaseImportHelper::retrieveUserObjects()
 	std::vector<attribs_map>::iterator itr;
 	std::vector<attribs_map> objects;
 	unsigned i=0, oid=0;
-	std::map<unsigned, std::vector<unsigned>>::iterator col_itr;
-	QStringList names;
 
 	i=0;
 	catalog.setQueryFilter(import_filter);
@@ -254,22 +260,22 @@ void DatabaseImportHelper::retrieveUserObjects()
 		oid_itr++; i++;
 	}
 
-	//Retrieving all selected table columns
-	i=0;
-	col_itr=column_oids.begin();
-	while(col_itr!=column_oids.end())
+	/* Retrieving all selected table columns. The columns of all tables
+	 * are retrieved in a single query instead of one query per table */
+	if(!column_oids.empty() && !import_canceled)
 	{
-		names=getObjectName(QString::number(col_itr->first)).split(".");
+		std::vector<unsigned> tab_oids;
 
-		emit s_progressUpdated(progress,
-								 tr("Retrieving columns of table `%1.%2', oid `%3'...").arg(names[0]).arg(names[1]).arg(col_itr->first),
-							   ObjectType::Column);
+		emit s_progressUpdated(progress, tr("Retrieving columns of %1 table(s)...").arg(column_oids.size()), ObjectType::Column);
 
-		if(names.size() > 1)
-			retrieveTableColumns(names[0], names[1], col_itr->second);
+		for(auto &col_itr : column_oids)
+			tab_oids.push_back(col_itr.first);
 
-		progress=(i/static_cast<double>(column_oids.size()))*100;
-		col_itr++; i++;
+		for(auto &tab_itr : catalog.getTablesColumnsAttributes(tab_oids, column_oids))
+		{
+			for(auto &col : tab_itr.second)
+				columns[tab_itr.first][col[Attributes::Oid].toUInt()]=col;
+		}
 	}
 }
 
@@ -295,6 +301,84 @@ void DatabaseImportHelper::retrieveTableColumns(const QString &sch_name, const Q
 	}
 }
 
+void DatabaseImportHelper::sortObjectsByDependencies()
+{
+	std::map<unsigned, std::vector<unsigned>> deps, dependents;
+	std::map<unsigned, unsigned> pending_deps;
+	std::priority_queue<unsigned, std::vector<unsigned>, std::greater<unsigned>> ready_oids;
+	std::vector<unsigned> sorted_oids;
+
+	creation_order.clear();
+
+	for(auto &itr : user_objs)
+		creation_order.push_back(itr.first);
+
+	if(!sort_by_deps || creation_order.size() < 2 || import_canceled)
+		return;
+
+	emit s_progressUpdated(0, tr("Retrieving objects dependencies..."), ObjectType::BaseObject);
+
+	try
+	{
+		deps = catalog.getObjectsDependencies(creation_order);
+	}
+	catch(Exception &e)
+	{
+		/* If the dependencies can't be retrieved the objects are created in OID order
+		 * and the missing dependencies are handled by the retry mechanism in createObjects() */
+		if(debug_mode)
+			QTextStream(stdout) << e.getExceptionsText() << Qt::endl;
+
+		return;
+	}
+
+	for(auto &oid : creation_order)
+		pending_deps[oid] = 0;
+
+	for(auto &itr : deps)
+	{
+		for(auto &ref_oid : itr.second)
+		{
+			if(pending_deps.count(ref_oid) == 0 || pending_deps.count(itr.first) == 0)
+				continue;
+
+			dependents[ref_oid].push_back(itr.first);
+			pending_deps[itr.first]++;
+		}
+	}
+
+	for(auto &itr : pending_deps)
+	{
+		if(itr.second == 0)
+			ready_oids.push(itr.first);
+	}
+
+	sorted_oids.reserve(creation_order.size());
+
+	while(!ready_oids.empty())
+	{
+		unsigned oid = ready_oids.top();
+
+		ready_oids.pop();
+		sorted_oids.push_back(oid);
+
+		for(auto &dep_oid : dependents[oid])
+		{
+			if(--pending_deps[dep_oid] == 0)
+				ready_oids.push(dep_oid);
+		}
+	}
+
+	// Objects involved in dependency cycles are appended in OID order
+	for(auto &itr : pending_deps)
+	{
+		if(itr.second > 0)
+			sorted_oids.push_back(itr.first);
+	}
+
+	creation_order = sorted_oids;
+}
+
 void DatabaseImportHelper::createObjects()
 {
 	int progress=0;
@@ -304,19 +388,18 @@ void DatabaseImportHelper::createObjects()
 	std::vector<unsigned> not_created_objs, oids;
 	std::vector<unsigned>::iterator itr, itr_end;
 	std::vector<Exception> aux_errors;
-	std::map<unsigned, attribs_map>::iterator itr_objs, itr_objs_end;
 
 	created_objs.reserve(creation_order.size());
-	itr_objs = user_objs.begin();
-	itr_objs_end = user_objs.end();
+	itr = creation_order.begin();
+	itr_end = creation_order.end();
 
-	while(itr_objs != itr_objs_end && !import_canceled)
+	while(itr != itr_end && !import_canceled)
 	{
-		oid = itr_objs->first;
-		attribs = itr_objs->second;
+		oid = *itr;
+		attribs = user_objs[oid];
 		obj_type=static_cast<ObjectType>(attribs[Attributes::ObjectType].toUInt());
 		i++;
-		itr_objs++;
+		itr++;
 
 		try
 		{
@@ -324,6 +407,7 @@ void DatabaseImportHelper::createObjects()
 				 in order to be created later */
 			if(obj_type != ObjectType::Constraint)
 			{
+				progress_rep.registerItem();
 				emit s_progressUpdated(progress, tr("Creating object `%1' (%2), oid `%3'...")
 															.arg(attribs[Attributes::Name])
 															.arg(BaseObject::getTypeName(obj_type))
@@ -369,10 +453,12 @@ void DatabaseImportHelper::createObjects()
 			//Scan the oid list recreating the objects
 			while(itr!=itr_end && !import_canceled)
 			{
-				attribs=user_objs[*itr];
+				oid=*itr;
+				attribs=user_objs[oid];
 				obj_type=static_cast<ObjectType>(attribs[Attributes::ObjectType].toUInt());
 				itr++;
 
+				progress_rep.registerItem();
 				emit s_progressUpdated(progress,
 										 tr("Trying to recreate object `%1' (%2), oid `%3'...")
 										.arg(attribs[Attributes::Name])
@@ -387,7 +473,7 @@ void DatabaseImportHelper::createObjects()
 				catch(Exception &e)
 				{
 					//In case of some error store the oid and the error in separated lists
-					not_created_objs.push_back(*itr);
+					not_created_objs.push_back(oid);
 					aux_errors.push_back(Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__,__FILE__,__LINE__, &e, dumpObjectAttributes(attribs)));
 				}
 
@@ -442,6 +528,7 @@ void DatabaseImportHelper::createConstraints()
 					(attribs[Attributes::Type]==Attributes::CkConstr &&
 					 attribs[Attributes::Inherited]!=Attributes::True))
 			{
+				progress_rep.registerItem();
 				emit s_progressUpdated(progress,
 										 tr("Creating object `%1' (%2)...")
 										 .arg(attribs[Attributes::Name])
@@ -480,6 +567,7 @@ void DatabaseImportHelper::createPermissions()
 		{
 			attribs = getObjectAttributes(*itr_obj);
 			obj_type=static_cast<ObjectType>(attribs[Attributes::ObjectType].toUInt());
+			progress_rep.registerItem();
 			emit s_progressUpdated(progress,
 														 msg.arg(getObjectName(attribs[Attributes::Oid]))
 														.arg(BaseObject::getTypeName(obj_type)), ObjectType::Permission);
@@ -503,6 +591,7 @@ void DatabaseImportHelper::createPermissions()
 			{
 				attribs=columns[itr_cols->first][*itr];
 				obj_type=static_cast<ObjectType>(attribs[Attributes::ObjectType].toUInt());
+				progress_rep.registerItem();
 				emit s_progressUpdated(progress,
 									   msg.arg(getObjectName(attribs[Attributes::Oid]))
 						.arg(BaseObject::getTypeName(obj_type)), ObjectType::Permission);
@@ -542,6 +631,7 @@ void DatabaseImportHelper::updateFKRelationships()
 		{
 			tab=dynamic_cast<Table *>(*itr_tab);
 
+			progress_rep.registerItem();
 			emit s_progressUpdated(progress,
 									 tr("Updating relationships of `%1' (%2)...")
 								   .arg(tab->getName())
@@ -567,26 +657,41 @@ void DatabaseImportHelper::importDatabase()
 		if(!dbmodel)
 			throw Exception(ErrorCode::OprNotAllocatedObject ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
+		progress_rep.reset();
+		ProgressReporter::ScopedPhase import_phase(progress_rep, QString("Import database"));
+
 		dbmodel->setLoadingModel(true);
 		dbmodel->setObjectListsCapacity(creation_order.size());
 
-		retrieveSystemObjects();
-		retrieveUserObjects();
-		createObjects();
-		createTableInheritances();
-		createTablePartitionings();
-		createConstraints();
-		destroyDetachedColumns();
-		createPermissions();
+		{
+			ProgressReporter::ScopedPhase phase(progress_rep, QString("Retrieve objects"));
+			retrieveSystemObjects();
+			retrieveUserObjects();
+			sortObjectsByDependencies();
+		}
 
-		if(update_fk_rels)
-			updateFKRelationships();
+		{
+			ProgressReporter::ScopedPhase phase(progress_rep, QString("Create objects"));
+			createObjects();
+			createTableInheritances();
+			createTablePartitionings();
+			createConstraints();
+			destroyDetachedColumns();
+			createPermissions();
+		}
 
-		if(!inherited_cols.empty())
 		{
-			emit s_progressUpdated(100, tr("Validating relationships..."), ObjectType::Relationship);
-			dbmodel->setLoadingModel(false);
-			dbmodel->validateRelationships();
+			ProgressReporter::ScopedPhase phase(progress_rep, QString("Update relationships"));
+
+			if(update_fk_rels)
+				updateFKRelationships();
+
+			if(!inherited_cols.empty())
+			{
+				emit s_progressUpdated(100, tr("Validating relationships..."), ObjectType::Relationship);
+				dbmodel->setLoadingModel(false);
+				dbmodel->validateRelationships();
+			}
 		}
 
 		if(!import_canceled)
@@ -2891,6 +2996,7 @@ void DatabaseImportHelper::assignSequencesToColumns()
 
 				if(seq)
 				{
+					progress_rep.registerItem();
 					emit s_progressUpdated(progress,
 											 tr("Assigning sequence `%1' to column `%2'...").arg(seq->getSignature()).arg(col->getSignature()),
 											 ObjectType::Sequence);
@@ -3307,3 +3413,8 @@ QStringList DatabaseImportHelper::getTypes(const QString &oid_vect, bool generat
 
 	return list;
 }
+
+ProgressReporter &DatabaseImportHelper::getProgressReporter()
+{
+	return progress_rep;
+}
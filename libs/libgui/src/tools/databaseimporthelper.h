@@ -78,7 +78,11 @@ class DatabaseImportHelper: public QObject {
 		rand_rel_colors,
 		
 		//! \brief Indicates to the importer that the relationship update step must be executed
-		update_fk_rels;
+		update_fk_rels,
+
+		/*! \brief Indicates that the objects must be created in the order determined by their dependencies
+		 * registered in pg_depend instead of the plain OID order. The retry of failed objects is kept as fallback */
+		sort_by_deps;
 		
 		//! \brief Stores the selected objects oids to be imported
 		std::map<ObjectType, std::vector<unsigned>> object_oids;
@@ -87,7 +91,7 @@ class DatabaseImportHelper: public QObject {
 		it the oid of parent table */
 		std::map<unsigned, std::vector<unsigned>> column_oids;
 		
-		//! \brief Stores the selected objects oids to be imported
+		//! \brief Stores the oids of the objects to be imported in the order they must be created
 		std::vector<unsigned> creation_order;
 			
 		//! \brief Stores the user defined objects attributes
@@ -225,6 +229,9 @@ class DatabaseImportHelper: public QObject {
 		//! \brief Return a string containing all attributes and their values in a formatted way
 		QString dumpObjectAttributes(attribs_map &attribs);
 
+		//! \brief Records the timings of the import phases and the amount of items processed in them
+		ProgressReporter progress_rep;
+
 	public:
 		DatabaseImportHelper(QObject *parent = nullptr);
 		
@@ -244,6 +251,9 @@ class DatabaseImportHelper: public QObject {
 		//! \brief Configures the import parameters
 		void setImportOptions(bool import_sys_objs, bool import_ext_objs, bool auto_resolve_deps, bool ignore_errors, bool debug_mode, bool rand_rel_colors, bool update_fk_rels);
 		
+		//! \brief Enables/disables the creation of the objects in the order determined by their dependencies in pg_depend
+		void setSortByDependencies(bool value);
+
 		//! \brief Returns the last system OID value for the current database
 		unsigned getLastSystemOID();
 		
@@ -276,6 +286,11 @@ class DatabaseImportHelper: public QObject {
 		void retrieveSystemObjects();
 		void retrieveUserObjects();
 		void retrieveTableColumns(const QString &sch_name, const QString &tab_name, std::vector<unsigned> col_ids={});
+
+		/*! \brief Sorts the creation order of the retrieved user objects topologically using the dependencies registered
+		 * in pg_depend. Objects with no pending dependency are created in OID order and the ones involved in
+		 * dependency cycles are placed at the end of the list so they can be handled by the retry mechanism */
+		void sortObjectsByDependencies();
 		void createObjects();
 		void createConstraints();
 		void createPermissions();
@@ -285,6 +300,9 @@ class DatabaseImportHelper: public QObject {
 		//! \brief Returns the currently configured object filters in the internal catalog instance
 		std::map<ObjectType, QString> getObjectFilters();
 
+		//! \brief Returns the reporter that records the timings of the import phases
+		ProgressReporter &getProgressReporter();
+
 	signals:
 		//! \brief This singal is emitted whenever the export progress changes
 		void s_progressUpdated(int progress, QString msg, ObjectType obj_type=ObjectType::BaseObject);
@@ -26,6 +26,7 @@
 #include "widgets/objectstablewidget.h"
 #include "databaseexplorerwidget.h"
 #include "settings/generalconfigwidget.h"
+#include "widgets/taskprogresswidget.h"
 
 constexpr unsigned DataManipulationForm::NoOperation;
 constexpr unsigned DataManipulationForm::OpInsert;
@@ -98,6 +99,16 @@ DataManipulationForm::DataManipulationForm(QWidget * parent, Qt::WindowFlags f):
 	truncate_menu.addAction(QIcon(GuiUtilsNs::getIconPath("trunccascade")), tr("Truncate cascade"), this, SLOT(truncateTable()), QKeySequence("Ctrl+Shift+Del"))->setData(QVariant::fromValue<bool>(true));
 
 	copy_tb->setMenu(&copy_menu);
+
+	action_export_results=export_menu.addAction(QIcon(GuiUtilsNs::getIconPath("exportdata")), tr("Export results"));
+	action_export_results->setToolTip(tr("Export the rows in the grid to a CSV file"));
+
+	action_export_query=export_menu.addAction(QIcon(GuiUtilsNs::getIconPath("table")), tr("Export table data to file"));
+	action_export_query->setToolTip(tr("Export all the rows matching the filter (ignoring the limit) to a CSV file without loading them in the grid"));
+
+	export_menu.setToolTipsVisible(true);
+	export_tb->setMenu(&export_menu);
+	export_tb->setPopupMode(QToolButton::InstantPopup);
 	refresh_tb->setToolTip(refresh_tb->toolTip() + QString(" (%1)").arg(refresh_tb->shortcut().toString()));
 	save_tb->setToolTip(save_tb->toolTip() + QString(" (%1)").arg(save_tb->shortcut().toString()));
 	paste_tb->setToolTip(paste_tb->toolTip() + QString(" (%1)").arg(paste_tb->shortcut().toString()));
@@ -119,6 +130,7 @@ DataManipulationForm::DataManipulationForm(QWidget * parent, Qt::WindowFlags f):
 	csv_load_parent->setVisible(false);
 
 	csv_load_wgt = new CsvLoadWidget(this, false);
+	csv_load_wgt->setMaxLoadedRows(DirectCsvInsertRows);
 	QVBoxLayout *layout = new QVBoxLayout;
 
 	layout->addWidget(csv_load_wgt);
@@ -192,9 +204,12 @@ DataManipulationForm::DataManipulationForm(QWidget * parent, Qt::WindowFlags f):
 
 	connect(results_tbw, SIGNAL(itemPressed(QTableWidgetItem *)), this, SLOT(showPopupMenu()));
 
-	connect(export_tb, &QToolButton::clicked,
+	connect(action_export_results, &QAction::triggered,
 			[&](){ SQLExecutionWidget::exportResults(results_tbw); });
 
+	connect(action_export_query, &QAction::triggered,
+			[&](){ SQLExecutionWidget::exportQueryResults(tmpl_conn_params, getSelectCommand(false)); });
+
 	connect(results_tbw, SIGNAL(itemSelectionChanged()), this, SLOT(enableRowControlButtons()));
 	connect(csv_load_wgt, SIGNAL(s_csvFileLoaded()), this, SLOT(loadDataFromCsv()));
 
@@ -350,6 +365,38 @@ void DataManipulationForm::listColumns()
 
 }
 
+QString DataManipulationForm::getSelectCommand(bool use_limit)
+{
+	QString query=QString("SELECT * FROM \"%1\".\"%2\"").arg(schema_cmb->currentText()).arg(table_cmb->currentText());
+	unsigned limit=limit_spb->value();
+
+	//Building the where clause
+	if(!filter_txt->toPlainText().trimmed().isEmpty())
+		query+=QString(" WHERE ") + filter_txt->toPlainText();
+
+	//Building the order by clause
+	if(ord_columns_lst->count() > 0)
+	{
+		QStringList ord_cols, col;
+
+		query+=QString("\n ORDER BY ");
+
+		for(int idx=0; idx < ord_columns_lst->count(); idx++)
+		{
+			col=ord_columns_lst->item(idx)->text().split(" ");
+			ord_cols.push_back(QString("\"") + col[0] + QString("\" ") + col[1]);
+		}
+
+		query+=ord_cols.join(QString(", "));
+	}
+
+	//Building the limit clause
+	if(use_limit && limit > 0)
+		query+=QString(" LIMIT %1").arg(limit);
+
+	return query;
+}
+
 void DataManipulationForm::retrieveData()
 {
 	if(table_cmb->currentIndex() <= 0)
@@ -371,10 +418,8 @@ void DataManipulationForm::retrieveData()
 				return;
 		}
 
-		QString query=QString("SELECT * FROM \"%1\".\"%2\"").arg(schema_cmb->currentText()).arg(table_cmb->currentText()),
-				prev_tab_name;
+		QString query=getSelectCommand(true), prev_tab_name;
 		ResultSet res;
-		unsigned limit=limit_spb->value();
 		ObjectType obj_type = static_cast<ObjectType>(table_cmb->currentData(Qt::UserRole).toUInt());
 		std::vector<int> curr_hidden_cols;
 		int col_cnt = results_tbw->horizontalHeader()->count();
@@ -390,30 +435,6 @@ void DataManipulationForm::retrieveData()
 				curr_hidden_cols.push_back(idx);
 		}
 
-		//Building the where clause
-		if(!filter_txt->toPlainText().trimmed().isEmpty())
-			query+=QString(" WHERE ") + filter_txt->toPlainText();
-
-		//Building the order by clause
-		if(ord_columns_lst->count() > 0)
-		{
-			QStringList ord_cols, col;
-
-			query+=QString("\n ORDER BY ");
-
-			for(int idx=0; idx < ord_columns_lst->count(); idx++)
-			{
-				col=ord_columns_lst->item(idx)->text().split(" ");
-				ord_cols.push_back(QString("\"") + col[0] + QString("\" ") + col[1]);
-			}
-
-			query+=ord_cols.join(QString(", "));
-		}
-
-		//Building the limit clause
-		if(limit > 0)
-			query+=QString(" LIMIT %1").arg(limit);
-
 		QApplication::setOverrideCursor(Qt::WaitCursor);
 
 		catalog.setConnection(conn_cat);
@@ -424,7 +445,8 @@ void DataManipulationForm::retrieveData()
 		retrieveFKColumns(schema_cmb->currentText(), table_cmb->currentText());
 		SQLExecutionWidget::fillResultsTable(catalog, res, results_tbw, true);
 
-		export_tb->setEnabled(results_tbw->rowCount() > 0);
+		export_tb->setEnabled(true);
+		action_export_results->setEnabled(results_tbw->rowCount() > 0);
 		result_info_wgt->setVisible(results_tbw->rowCount() > 0);
 		result_info_lbl->setText(QString("<em>[%1]</em> ").arg(QTime::currentTime().toString(QString("hh:mm:ss.zzz"))) +
 								 tr("Rows returned: <strong>%1</strong>&nbsp;&nbsp;&nbsp;").arg(results_tbw->rowCount()) +
@@ -515,6 +537,7 @@ void DataManipulationForm::disableControlButtons()
 	add_tb->setEnabled(false);
 	duplicate_tb->setEnabled(false);
 	export_tb->setEnabled(false);
+	action_export_results->setEnabled(false);
 	paste_tb->setEnabled(false);
 	truncate_tb->setEnabled(false);
 	csv_load_tb->setEnabled(false);
@@ -610,6 +633,8 @@ void DataManipulationForm::loadDataFromCsv(bool load_from_clipboard, bool force_
 {
 	QList<QStringList> rows;
 	QStringList cols;
+	CsvReader reader;
+	bool is_large_csv = false, use_col_names = false;
 	int row_id = 0, col_id = 0;
 
 	if(load_from_clipboard)
@@ -633,11 +658,48 @@ void DataManipulationForm::loadDataFromCsv(bool load_from_clipboard, bool force_
 		}
 
 		rows = CsvLoadWidget::loadCsvFromBuffer(text, separator, delimiter, false, cols);
+		is_large_csv = rows.size() > DirectCsvInsertRows;
+
+		if(is_large_csv)
+		{
+			CsvLoadWidget::configureCsvReader(reader, separator, delimiter, false);
+			reader.setBuffer(text);
+		}
 	}
 	else
 	{
+		/* The csv widget loads at most DirectCsvInsertRows rows from the file,
+		 * the remaining ones are only read when needed via the csv reader */
 		rows = csv_load_wgt->getCsvRows();
 		cols = csv_load_wgt->getCsvColumns();
+		is_large_csv = csv_load_wgt->hasUnloadedRows();
+
+		if(is_large_csv)
+			csv_load_wgt->configureCsvReader(reader);
+	}
+
+	use_col_names = (!load_from_clipboard && csv_load_wgt->isColumnsInFirstRow()) ||
+									(load_from_clipboard && !cols.isEmpty());
+
+	/* Loading a huge amount of rows in the grid is slow and the saving would send them
+	 * back to the server anyway, so the user can choose to insert them directly in the table */
+	if(is_large_csv)
+	{
+		Messagebox msg_box;
+
+		msg_box.show(tr("The loaded CSV data has more than <strong>%1</strong> rows. Do you want to insert them directly in the table <strong>%2.%3</strong> instead of loading them in the grid? <br/><br/><strong>WARNING:</strong> Once commited its not possible to undo the changes!")
+								 .arg(DirectCsvInsertRows).arg(schema_cmb->currentText()).arg(table_cmb->currentText()),
+								 Messagebox::ConfirmIcon, Messagebox::YesNoButtons);
+
+		if(msg_box.result()==QDialog::Accepted)
+		{
+			insertCsvRows(reader, cols, use_col_names);
+			return;
+		}
+
+		// The user opted to load all the rows in the grid so the ones not loaded by the csv widget are read now
+		if(!load_from_clipboard)
+			rows = reader.readRows();
 	}
 
 	/* If there is only one empty row in the grid, this one will
@@ -669,8 +731,7 @@ void DataManipulationForm::loadDataFromCsv(bool load_from_clipboard, bool force_
 			if(i > values.count())
 				break;
 
-			if((!load_from_clipboard && csv_load_wgt->isColumnsInFirstRow()) ||
-				 (load_from_clipboard && !cols.isEmpty()))
+			if(use_col_names)
 			{
 				//First we need to get the index of the column by its name
 				col_id=col_names.indexOf(cols[i]);
@@ -691,6 +752,99 @@ void DataManipulationForm::loadDataFromCsv(bool load_from_clipboard, bool force_
 	}
 }
 
+void DataManipulationForm::insertCsvRows(CsvReader &reader, const QStringList &cols, bool use_col_names)
+{
+	Connection conn=Connection(tmpl_conn_params);
+	BulkDataHelper bulk_helper;
+	TaskProgressWidget task_prog_wgt;
+	QList<QStringList> rows;
+	QStringList columns, values;
+	int row_id=0, col_id=0;
+	qint64 total_bytes = reader.getTotalBytes();
+
+	try
+	{
+		configureBulkDataHelper(bulk_helper);
+
+		for(int col=0; col < results_tbw->columnCount(); col++)
+		{
+			if(results_tbw->horizontalHeaderItem(col)->data(Qt::UserRole)!=QString("bytea"))
+				columns.push_back(results_tbw->horizontalHeaderItem(col)->text());
+		}
+
+		task_prog_wgt.setWindowTitle(tr("Inserting CSV data..."));
+		connect(&task_prog_wgt, SIGNAL(rejected()), &bulk_helper, SLOT(cancelSaving()));
+		task_prog_wgt.show();
+
+		conn.connect();
+		bulk_helper.beginSaving(conn);
+
+		/* The csv data is read and sent to the server in batches (in a single transaction),
+		 * this way only the rows of the current batch are held in memory */
+		while(!reader.atEnd())
+		{
+			rows = reader.readRows(CsvInsertBatchRows);
+
+			for(auto &csv_row : rows)
+			{
+				//Columns without values in the csv receive their default values
+				values.clear();
+
+				for(int i=0; i < columns.size(); i++)
+					values.append(QString());
+
+				for(int i = 0; i < csv_row.count(); i++)
+				{
+					col_id=i;
+
+					//If a matching column is not found we add the value at the current position
+					if(use_col_names && i < cols.size() && col_names.indexOf(cols[i]) >= 0)
+						col_id=col_names.indexOf(cols[i]);
+
+					if(col_id < col_names.size())
+						col_id=columns.indexOf(col_names[col_id]);
+					else
+						col_id=-1;
+
+					if(col_id >= 0)
+						values[col_id]=csv_row.at(i);
+				}
+
+				bulk_helper.addInsertedRow(row_id++, values);
+			}
+
+			bulk_helper.saveRows(conn);
+
+			task_prog_wgt.updateProgress(total_bytes > 0 ? (reader.getBytesRead() * 100) / total_bytes : 0,
+																	 tr("Inserting CSV data: %1 row(s) inserted...").arg(row_id),
+																	 enum_cast(ObjectType::Table));
+			qApp->processEvents();
+		}
+
+		bulk_helper.finishSaving(conn);
+		conn.close();
+		task_prog_wgt.close();
+
+		retrieveData();
+	}
+	catch(Exception &e)
+	{
+		task_prog_wgt.close();
+		conn.close();
+
+		if(bulk_helper.isCanceled())
+			return;
+
+		if(bulk_helper.getFailedRow() < 0)
+			throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+
+		throw Exception(Exception::getErrorMessage(ErrorCode::RowDataNotManipulated)
+										.arg(tr("insert")).arg(QString("%1.%2").arg(schema_cmb->currentText(), table_cmb->currentText()))
+										.arg(bulk_helper.getFailedRow() + 1).arg(e.getErrorMessage()),
+										ErrorCode::RowDataNotManipulated,__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
 void DataManipulationForm::removeSortColumnFromList()
 {
 	if(qApp->mouseButtons()==Qt::NoButton || qApp->mouseButtons()==Qt::LeftButton)
@@ -1360,12 +1514,13 @@ void DataManipulationForm::saveChanges()
 				 tr("You're running a demonstration version! The save feature of the data manipulation form is available only in the full version!"),
 				 Messagebox::AlertIcon, Messagebox::OkButton);
 #else
-	int row=0;
+	int row=-1;
 	Connection conn=Connection(tmpl_conn_params);
+	BulkDataHelper bulk_helper;
+	TaskProgressWidget task_prog_wgt;
 
 	try
 	{
-		QString cmd;
 		Messagebox msg_box;
 
 		msg_box.show(tr("<strong>WARNING:</strong> Once commited its not possible to undo the changes! Proceed with saving?"),
@@ -1374,22 +1529,68 @@ void DataManipulationForm::saveChanges()
 
 		if(msg_box.result()==QDialog::Accepted)
 		{
+			QStringList key_values, values;
+			std::vector<bool> changed;
+			QTableWidgetItem *item=nullptr;
+			QVariant data;
+			QStringList key_cols;
+			unsigned op_type=0;
 
 			//Forcing the cell editor to be closed by selecting an unexistent cell and clearing the selection
 			results_tbw->setCurrentCell(-1,-1, QItemSelectionModel::Clear);
+			key_cols=configureBulkDataHelper(bulk_helper);
 
-			conn.connect();
-			conn.executeDDLCommand(QString("START TRANSACTION"));
-
-			for(unsigned idx=0; idx < changed_rows.size(); idx++)
+			for(auto &row_id : changed_rows)
 			{
-				row=changed_rows[idx];
-				cmd=getDMLCommand(row);
-				conn.executeDDLCommand(cmd);
+				op_type=results_tbw->verticalHeaderItem(row_id)->data(Qt::UserRole).toUInt();
+				key_values.clear();
+				values.clear();
+				changed.clear();
+
+				if(op_type==OpDelete || op_type==OpUpdate)
+				{
+					//Retrieving the original values of the key columns in order to identify the row
+					for(auto &key_col : key_cols)
+					{
+						data=results_tbw->item(row_id, col_names.indexOf(key_col))->data(Qt::UserRole);
+						key_values.append(data.toString() == SQLExecutionWidget::ColumnNullValue ? QString() : data.toString());
+					}
+				}
+
+				if(op_type==OpUpdate || op_type==OpInsert)
+				{
+					for(int col=0; col < results_tbw->columnCount(); col++)
+					{
+						//bytea columns are ignored
+						if(results_tbw->horizontalHeaderItem(col)->data(Qt::UserRole)==QString("bytea"))
+							continue;
+
+						item=results_tbw->item(row_id, col);
+						values.append(item->text());
+						changed.push_back(item->text()!=item->data(Qt::UserRole));
+					}
+				}
+
+				if(op_type==OpDelete)
+					bulk_helper.addDeletedRow(row_id, key_values);
+				else if(op_type==OpUpdate)
+					bulk_helper.addUpdatedRow(row_id, key_values, values, changed);
+				else
+					bulk_helper.addInsertedRow(row_id, values);
 			}
 
-			conn.executeDDLCommand(QString("COMMIT"));
+			task_prog_wgt.setWindowTitle(tr("Saving changes..."));
+			connect(&bulk_helper, &BulkDataHelper::s_progressUpdated, &task_prog_wgt, [&task_prog_wgt](int progress, QString msg){
+				task_prog_wgt.updateProgress(progress, msg, enum_cast(ObjectType::Table));
+				qApp->processEvents();
+			});
+			connect(&task_prog_wgt, SIGNAL(rejected()), &bulk_helper, SLOT(cancelSaving()));
+			task_prog_wgt.show();
+
+			conn.connect();
+			bulk_helper.saveChanges(conn);
 			conn.close();
+			task_prog_wgt.close();
 
 			changed_rows.clear();
 			retrieveData();
@@ -1407,13 +1608,19 @@ void DataManipulationForm::saveChanges()
 						 .arg(schema_cmb->currentText())
 						 .arg(table_cmb->currentText());
 
-		unsigned op_type=results_tbw->verticalHeaderItem(row)->data(Qt::UserRole).toUInt();
+		task_prog_wgt.close();
+		conn.close();
 
-		if(conn.isStablished())
-		{
-			conn.executeDDLCommand(QString("ROLLBACK"));
-			conn.close();
-		}
+		// The rollback was done by the helper, if the user aborted the saving the changes are kept in the grid
+		if(bulk_helper.isCanceled())
+			return;
+
+		row=bulk_helper.getFailedRow();
+
+		if(row < 0 || row >= results_tbw->rowCount())
+			throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+
+		unsigned op_type=results_tbw->verticalHeaderItem(row)->data(Qt::UserRole).toUInt();
 
 		results_tbw->selectRow(row);
 		results_tbw->scrollToItem(results_tbw->item(row, 0));
@@ -1425,116 +1632,21 @@ void DataManipulationForm::saveChanges()
 #endif
 }
 
-QString DataManipulationForm::getDMLCommand(int row)
+QStringList DataManipulationForm::configureBulkDataHelper(BulkDataHelper &bulk_helper)
 {
-	if(row < 0 || row >= results_tbw->rowCount())
-		return "";
-
-	QString tab_name=QString("\"%1\".\"%2\"").arg(schema_cmb->currentText()).arg(table_cmb->currentText()),
-			upd_cmd=QString("UPDATE %1 SET %2 WHERE %3"),
-			del_cmd=QString("DELETE FROM %1 WHERE %2"),
-			ins_cmd=QString("INSERT INTO %1(%2) VALUES (%3)"),
-			fmt_cmd;
-	QTableWidgetItem *item=nullptr;
-	unsigned op_type=results_tbw->verticalHeaderItem(row)->data(Qt::UserRole).toUInt();
-	QStringList val_list, col_list, flt_list;
-	QString col_name, value;
-	QVariant data;
+	QStringList columns, key_cols;
 
-	if(op_type==OpDelete || op_type==OpUpdate)
-	{
-		if(pk_col_names.isEmpty())
-		{
-			//Considering all columns as pk when the tables doesn't has one (except bytea columns)
-			for(int col=0; col < results_tbw->columnCount(); col++)
-			{
-				if(results_tbw->horizontalHeaderItem(col)->data(Qt::UserRole)!=QString("bytea"))
-					pk_col_names.push_back(results_tbw->horizontalHeaderItem(col)->text());
-			}
-		}
-
-		//Creating the where clause with original column's values
-		for(QString pk_col : pk_col_names)
-		{
-			data = results_tbw->item(row,  col_names.indexOf(pk_col))->data(Qt::UserRole);
-
-			if(data.toString() == SQLExecutionWidget::ColumnNullValue)
-				flt_list.push_back(QString("\"%1\" IS NULL").arg(pk_col));
-			else
-				flt_list.push_back(QString("\"%1\"='%2'").arg(pk_col).arg(data.toString().replace("\'","''")));
-		}
-	}
-
-	if(op_type==OpDelete)
+	for(int col=0; col < results_tbw->columnCount(); col++)
 	{
-		fmt_cmd=QString(del_cmd).arg(tab_name).arg(flt_list.join(QString(" AND ")));
+		if(results_tbw->horizontalHeaderItem(col)->data(Qt::UserRole)!=QString("bytea"))
+			columns.push_back(results_tbw->horizontalHeaderItem(col)->text());
 	}
-	else if(op_type==OpUpdate || op_type==OpInsert)
-	{
-		fmt_cmd=(op_type==OpUpdate ? upd_cmd : ins_cmd);
-
-		for(int col=0; col < results_tbw->columnCount(); col++)
-		{
-			item=results_tbw->item(row, col);
-
-			//bytea columns are ignored
-			if(results_tbw->horizontalHeaderItem(col)->data(Qt::UserRole)!=QString("bytea"))
-			{
-				value=item->text();
-				col_name=results_tbw->horizontalHeaderItem(col)->text();
 
-				if(op_type==OpInsert || (op_type==OpUpdate && value!=item->data(Qt::UserRole)))
-				{
-					//Checking if the value is a malformed unescaped value, e.g., {value, value}, {value\}
-					if((value.startsWith(UtilsNs::UnescValueStart) && value.endsWith(QString("\\") + UtilsNs::UnescValueEnd)) ||
-							(value.startsWith(UtilsNs::UnescValueStart) && !value.endsWith(UtilsNs::UnescValueEnd)) ||
-							(!value.startsWith(UtilsNs::UnescValueStart) && !value.endsWith(QString("\\") + UtilsNs::UnescValueEnd) && value.endsWith(UtilsNs::UnescValueEnd)))
-						throw Exception(Exception::getErrorMessage(ErrorCode::MalformedUnescapedValue)
-										.arg(row + 1).arg(col_name),
-										ErrorCode::MalformedUnescapedValue,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-
-					col_list.push_back(QString("\"%1\"").arg(col_name));
-
-					//Empty values as considered as DEFAULT
-					if(value.isEmpty())
-					{
-						value=QString("DEFAULT");
-					}
-					//Unescaped values will not be enclosed in quotes
-					else if(value.startsWith(UtilsNs::UnescValueStart) && value.endsWith(UtilsNs::UnescValueEnd))
-					{
-						value.remove(0,1);
-						value.remove(value.length()-1, 1);
-					}
-					//Quoting value
-					else
-					{
-						value.replace(QString("\\") + UtilsNs::UnescValueStart, UtilsNs::UnescValueStart);
-						value.replace(QString("\\") + UtilsNs::UnescValueEnd, UtilsNs::UnescValueEnd);
-						value.replace("\'","''");
-						value=QString("E'") + value + QString("'");
-					}
-
-					if(op_type==OpInsert)
-						val_list.push_back(value);
-					else
-						val_list.push_back(QString("\"%1\"=%2").arg(col_name).arg(value));
-				}
-			}
-		}
-
-		if(col_list.isEmpty())
-			return "";
-		else
-		{
-			if(op_type==OpUpdate)
-				fmt_cmd=fmt_cmd.arg(tab_name).arg(val_list.join(QString(", "))).arg(flt_list.join(QString(" AND ")));
-			else
-				fmt_cmd=fmt_cmd.arg(tab_name).arg(col_list.join(QString(", "))).arg(val_list.join(QString(", ")));
-		}
-	}
+	//Considering all columns as pk when the tables doesn't has one (except bytea columns)
+	key_cols=(pk_col_names.isEmpty() ? columns : pk_col_names);
+	bulk_helper.setTable(schema_cmb->currentText(), table_cmb->currentText(), columns, key_cols, !pk_col_names.isEmpty());
 
-	return fmt_cmd;
+	return key_cols;
 }
 
 void DataManipulationForm::resizeEvent(QResizeEvent *event)
@@ -30,6 +30,7 @@
 #include "utils/syntaxhighlighter.h"
 #include "widgets/codecompletionwidget.h"
 #include "widgets/csvloadwidget.h"
+#include "bulkdatahelper.h"
 
 class DataManipulationForm: public QDialog, public Ui::DataManipulationForm {
 	private:
@@ -41,13 +42,22 @@ class DataManipulationForm: public QDialog, public Ui::DataManipulationForm {
 		OpUpdate=2,
 		OpDelete=3;
 
+		/*! \brief The amount of csv rows from which the user is asked to insert them directly in the table
+		 * instead of loading them in the grid */
+		static constexpr int DirectCsvInsertRows=10000;
+
+		//! \brief The amount of csv rows read and sent to the server at once when inserting them directly in the table
+		static constexpr int CsvInsertBatchRows=5000;
+
 		CsvLoadWidget *csv_load_wgt;
 
 		SyntaxHighlighter *filter_hl;
 		
 		CodeCompletionWidget *code_compl_wgt;
 
-		QMenu fks_menu, copy_menu, truncate_menu, paste_menu;
+		QMenu fks_menu, copy_menu, truncate_menu, paste_menu, export_menu;
+
+		QAction *action_export_results, *action_export_query;
 
 		//! \brief Store the template connection params to be used by catalogs and command execution connections
 		attribs_map tmpl_conn_params;
@@ -93,8 +103,18 @@ class DataManipulationForm: public QDialog, public Ui::DataManipulationForm {
 				when user call saveChanged() */
 		void markOperationOnRow(unsigned operation, int row);
 		
-		//! \brief Generates a DML command for the row depending on the it's operation type
-		QString getDMLCommand(int row);
+		/*! \brief Configures the bulk data helper with the current table's columns (except bytea ones) and returns
+		 * the columns used to identify the rows (the primary key or all the configured columns when the table doesn't have one) */
+		QStringList configureBulkDataHelper(BulkDataHelper &bulk_helper);
+
+		/*! \brief Returns the command that retrieves the rows of the current table according to the filter and ordering
+		 * configured in the form. When use_limit is false the limit of rows is not applied */
+		QString getSelectCommand(bool use_limit);
+
+		/*! \brief Inserts the rows read by the csv reader directly in the table (without loading them in the grid).
+		 * The rows are read and sent to the server in batches, so the csv data is never entirely held in memory.
+		 * When use_col_names is true the csv columns are matched against the table's columns by their names */
+		void insertCsvRows(CsvReader &reader, const QStringList &cols, bool use_col_names);
 		
 		//! \brief Remove the rows marked as OP_INSERT which ids are specified on the parameter vector
 		void removeNewRows(std::vector<int> ins_rows);
@@ -194,6 +194,9 @@ void ModelExportForm::exportModel()
 		//Export to png
 		if(export_to_img_rb->isChecked())
 		{
+			/* Objects with pending geometry (see BaseTableView::setLazyRendering()) are configured
+			 * here since the export runs in a separated thread and they must be fully rendered */
+			model->scene->configurePendingGeometries();
 			viewp=new QGraphicsView(model->scene);
 
 			if(png_rb->isChecked())
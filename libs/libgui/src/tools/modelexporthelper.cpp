@@ -1,9 +1,13 @@
 #include "modelexporthelper.h"
 #include <QSvgGenerator>
+#include <QThreadPool>
+#include <QSemaphore>
 #include "guiutilsns.h"
+#include <set>
 
 ModelExportHelper::ModelExportHelper(QObject *parent) : QObject(parent)
 {
+	valid_conn_count=1;
 	resetExportParams();
 }
 
@@ -17,6 +21,7 @@ void ModelExportHelper::resetExportParams()
 	connection=nullptr;
 	scene=nullptr;
 	zoom=100;
+	tile_size=0;
 	show_grid=show_delim=page_by_page=split=browsable=false;
 	viewp=nullptr;
 }
@@ -45,6 +50,11 @@ void ModelExportHelper::handleSQLError(Exception &e, const QString &sql_cmd, boo
 		errors.push_back(e);
 }
 
+void ModelExportHelper::setValidationConnections(unsigned count)
+{
+	valid_conn_count=std::max<unsigned>(1, std::min(count, MaxValidationConnections));
+}
+
 void ModelExportHelper::setIgnoredErrors(const QStringList &err_codes)
 {
 	QRegularExpression valid_code = QRegularExpression(QRegularExpression::anchoredPattern("([a-z]|[A-Z]|[0-9])+"));
@@ -69,6 +79,9 @@ void ModelExportHelper::exportToSQL(DatabaseModel *db_model, const QString &file
 
 	try
 	{
+		progress_rep.reset();
+		ProgressReporter::ScopedPhase export_phase(progress_rep, QString("Export to SQL"));
+
 		progress=sql_gen_progress=0;
 		BaseObject::setPgSQLVersion(pgsql_ver);
 		emit s_progressUpdated(progress,
@@ -101,21 +114,91 @@ void ModelExportHelper::exportToSQL(DatabaseModel *db_model, const QString &file
 	disconnect(db_model, nullptr, this, nullptr);
 }
 
-void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename, double zoom, bool show_grid, bool show_delim, bool page_by_page, QGraphicsView *viewp)
+QImage ModelExportHelper::renderImage(QGraphicsView *view, const QRect &view_rect)
+{
+	QImage img(view_rect.size(), QImage::Format_ARGB32_Premultiplied);
+	QPainter painter;
+
+	if(img.isNull())
+	{
+		throw Exception(tr("Failed to allocate an image of %1 x %2 pixels! Try to reduce the zoom factor or to export the image in tiles.")
+										.arg(view_rect.width()).arg(view_rect.height()),
+										ErrorCode::Custom,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+	}
+
+	img.fill(Qt::white);
+
+	//Setting optimizations on the painter
+	painter.begin(&img);
+	painter.setRenderHint(QPainter::Antialiasing, true);
+	painter.setRenderHint(QPainter::TextAntialiasing, true);
+	painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
+
+	//Render the viewport area onto the image
+	view->render(&painter, QRectF(QPointF(0,0), img.size()), view_rect);
+	painter.end();
+
+	return img;
+}
+
+std::vector<QRect> ModelExportHelper::getImageTiles(const QRect &view_rect, unsigned tile_size)
+{
+	std::vector<QRect> tiles;
+
+	if(tile_size == 0)
+	{
+		tiles.push_back(view_rect);
+		return tiles;
+	}
+
+	int tl_size = static_cast<int>(tile_size);
+
+	for(int y = view_rect.top(); y <= view_rect.bottom(); y += tl_size)
+	{
+		for(int x = view_rect.left(); x <= view_rect.right(); x += tl_size)
+			tiles.push_back(QRect(QPoint(x, y), QSize(tl_size, tl_size)).intersected(view_rect));
+	}
+
+	return tiles;
+}
+
+void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename, double zoom, bool show_grid, bool show_delim, bool page_by_page, QGraphicsView *viewp, unsigned tile_size)
 {
 	if(!scene)
 		throw Exception(ErrorCode::AsgNotAllocattedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
+	progress_rep.reset();
+	ProgressReporter::ScopedPhase export_phase(progress_rep, QString("Export to PNG"));
+	bool shw_grd, shw_dlm, align_objs;
+	QGraphicsView *view=nullptr;
+	QThreadPool save_pool;
+	QSemaphore pending_imgs;
+	QMutex save_mutex;
+	QStringList failed_files;
+
+	//Make a backup of the current scene options
+	shw_grd = ObjectsScene::isShowGrid();
+	align_objs = ObjectsScene::isAlignObjectsToGrid();
+	shw_dlm = ObjectsScene::isShowPageDelimiters();
+
+	/* The images are encoded and written by the pool while the next ones are rendered. The
+	 * semaphore limits the amount of rendered images waiting to be saved so the memory usage
+	 * is bounded to a few tiles/pages no matter the size of the scene */
+	pending_imgs.release(save_pool.maxThreadCount() * 2);
+
 	try
 	{
-		QPixmap pix;
-		bool shw_grd, shw_dlm, align_objs;
-		QGraphicsView *view=nullptr;
 		QRect retv;
 		QPolygon pol;
 		std::vector<QRectF> pages;
+		std::vector<QRect> tiles;
 		unsigned v_cnt=0, h_cnt=0, page_idx=1;
-		QString tmpl_filename, file;
+		int tile_row = 0, tile_col = 0;
+		QString tmpl_filename, page_file, file;
+		QFileInfo fi(filename);
+
+		if(tile_size > 0 && tile_size < MinimumTileSize)
+			tile_size = MinimumTileSize;
 
 		/* If an external view is specified it will be used instead of creating a local one,
 	   this is a workaround to the error below when running the helper in a separated thread
@@ -126,21 +209,17 @@ void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename
 		else
 			view=new QGraphicsView(scene);
 
+		//Objects with pending geometry (lazy rendering) need to be configured before being rendered
+		scene->configurePendingGeometries();
+
 		//Clear the object scene selection to avoid drawing the selectoin rectangle of the objects
 		scene->clearSelection();
 
-		//Make a backup of the current scene options
-		shw_grd = ObjectsScene::isShowGrid();
-		align_objs = ObjectsScene::isAlignObjectsToGrid();
-		shw_dlm = ObjectsScene::isShowPageDelimiters();
-
 		//Sets the options passed by the user
 		ObjectsScene::setGridOptions(show_grid, false, show_delim);
 
 		if(page_by_page)
 		{
-			QFileInfo fi(filename);
-
 			//Calculates the page count to be exported
 			pages=scene->getPagesForPrinting(h_cnt, v_cnt);
 
@@ -157,7 +236,7 @@ void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename
 			rect.setSize(rect.size() + margin);
 
 			pages.push_back(rect);
-			file=filename;
+			page_file=filename;
 		}
 
 		//Updates the scene to apply the change on grid and delimiter
@@ -171,12 +250,11 @@ void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename
 		view->centerOn(0,0);
 		view->scale(zoom, zoom);
 
-		QPainter painter;
 		std::vector<QRectF>::iterator itr=pages.begin(), itr_end=pages.end();
 
 		while(itr!=itr_end && !export_canceled)
 		{
-			//Convert the objects bounding rect to viewport coordinates to correctly draw them onto pixmap
+			//Convert the objects bounding rect to viewport coordinates to correctly draw them onto the image
 			pol = view->mapFromScene(*itr);
 			itr++;
 
@@ -186,34 +264,51 @@ void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename
 			retv.setBottomRight(pol.at(2));
 			retv.setBottomLeft(pol.at(3));
 
-			//Creates the output pixmap
-			pix=QPixmap(retv.size());
-			pix.fill();
-
-			//Setting optimizations on the painter
-			painter.begin(&pix);
-			painter.setRenderHint(QPainter::Antialiasing, true);
-			painter.setRenderHint(QPainter::TextAntialiasing, true);
-			painter.setRenderHint(QPainter::SmoothPixmapTransform, true);
-
 			emit s_progressUpdated((page_idx/static_cast<double>(pages.size())) * 90,
 														 tr("Rendering objects to page %1/%2.").arg(page_idx).arg(pages.size()), ObjectType::BaseObject);
 
-			//Render the entire viewport onto the pixmap
-			view->render(&painter, QRectF(QPointF(0,0), pix.size()), retv);
-			painter.end();
-
 			if(page_by_page)
-				file=tmpl_filename.arg(page_idx++);
+				page_file=tmpl_filename.arg(page_idx++);
 
-			//If the pixmap is not saved raises an error
-			if(!pix.save(file))
+			tiles = getImageTiles(retv, tile_size);
+
+			for(auto &tile : tiles)
 			{
-				//Restoring the scene settings before throw error
-				ObjectsScene::setGridOptions(shw_grd, align_objs, shw_dlm);
-				scene->update();
+				if(export_canceled)
+					break;
+
+				if(tiles.size() > 1)
+				{
+					QFileInfo page_fi(page_file);
+
+					tile_row = (tile.top() - retv.top()) / static_cast<int>(tile_size);
+					tile_col = (tile.left() - retv.left()) / static_cast<int>(tile_size);
+					file = page_fi.absolutePath() + GlobalAttributes::DirSeparator + page_fi.baseName() +
+								 QString("_r%1_c%2.").arg(tile_row).arg(tile_col) + page_fi.completeSuffix();
+				}
+				else
+					file = page_file;
+
+				QImage img = renderImage(view, tile);
+
+				pending_imgs.acquire();
+				save_pool.start([img, file, &pending_imgs, &save_mutex, &failed_files](){
+					if(!img.save(file, "PNG"))
+					{
+						QMutexLocker locker(&save_mutex);
+						failed_files.append(file);
+					}
+
+					pending_imgs.release();
+				});
+			}
+
+			save_pool.waitForDone();
 
-				throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(file),
+			//If an image is not saved raises an error
+			if(!failed_files.isEmpty())
+			{
+				throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(failed_files.front()),
 												ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 			}
 		}
@@ -235,6 +330,15 @@ void ModelExportHelper::exportToPNG(ObjectsScene *scene, const QString &filename
 	}
 	catch(Exception &e)
 	{
+		save_pool.waitForDone();
+
+		//Restoring the scene settings before throw error
+		ObjectsScene::setGridOptions(shw_grd, align_objs, shw_dlm);
+		scene->update();
+
+		if(view!=viewp)
+			delete view;
+
 		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
 	}
 }
@@ -244,11 +348,17 @@ void ModelExportHelper::exportToSVG(ObjectsScene *scene, const QString &filename
 	if(!scene)
 		throw Exception(ErrorCode::AsgNotAllocattedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
+	progress_rep.reset();
+	ProgressReporter::ScopedPhase export_phase(progress_rep, QString("Export to SVG"));
 	bool shw_dlm=false, shw_grd=false, align_objs=false;
 	QSvgGenerator svg_gen;
-	QRectF scene_rect=scene->itemsBoundingRect(true, false, true), svg_rect;
+	QRectF scene_rect, svg_rect;
 	QFileInfo fi(filename);
 
+	//Objects with pending geometry (lazy rendering) need to be configured before being rendered
+	scene->configurePendingGeometries();
+	scene_rect=scene->itemsBoundingRect(true, false, true);
+
 	emit s_progressUpdated(0, tr("Exporting model to SVG file."));
 
 	//Give some margin to the resulting image
@@ -284,27 +394,42 @@ void ModelExportHelper::exportToSVG(ObjectsScene *scene, const QString &filename
 	 * painter responsible to draw elements in the SVG output.
 	 * It seems that the QSvgGenerator doesn't render for itself the
 	 * scene's brackground brush when this one is composed by a
-	 * texture image (grid + delimiter lines). */
+	 * texture image (grid + delimiter lines).
+	 *
+	 * The background is rendered in tiles so huge scenes don't require
+	 * a single image with the same dimensions of the whole SVG. */
 	if(show_grid || show_delim)
 	{
-		QPixmap bg_img = QPixmap(svg_rect.size().toSize());
-		QPainter *bg_painter = new QPainter(&bg_img);
 		QStringList act_layers = scene->getActiveLayers();
+		QImage bg_img;
+		QPainter bg_painter;
+		QRectF src_rect;
 
 		/* In order to make a background clip we first hide all objects
 		 * by deactivating the layers the draw the background in the
 		 * bg painter in the dimensions defined by the scene rect,
 		 * this will clip the background in the right position and size.
-		 * After getting the bg pixmap we restore the active layers. */
+		 * After getting the bg tiles we restore the active layers. */
 		scene->blockSignals(true);
 		scene->setActiveLayers(QStringList());
-		scene->render(bg_painter, svg_rect, scene_rect);
+
+		for(auto &tile : getImageTiles(svg_rect.toAlignedRect(), DefaultTileSize))
+		{
+			bg_img = QImage(tile.size(), QImage::Format_ARGB32_Premultiplied);
+			bg_img.fill(Qt::white);
+
+			src_rect = QRectF(scene_rect.topLeft() + tile.topLeft(), tile.size());
+
+			bg_painter.begin(&bg_img);
+			scene->render(&bg_painter, QRectF(QPointF(0, 0), tile.size()), src_rect);
+			bg_painter.end();
+
+			// Drawing the bg tile in the svg painter
+			svg_painter->drawImage(tile.topLeft(), bg_img);
+		}
+
 		scene->setActiveLayers(act_layers);
 		scene->blockSignals(false);
-
-		// Drawing the bg pixmap in the svg painter
-		svg_painter->drawPixmap(svg_rect, bg_img, svg_rect);
-		delete bg_painter;
 	}
 
 	// Rendering the objects in the svg painter
@@ -353,6 +478,8 @@ void ModelExportHelper::exportToDBMS(DatabaseModel *db_model, Connection conn, c
 
 		connect(db_model, SIGNAL(s_objectLoaded(int,QString,uint)), this, SLOT(updateProgress(int,QString,uint)), Qt::DirectConnection);
 
+		progress_rep.reset();
+		ProgressReporter::ScopedPhase export_phase(progress_rep, QString("Export to DBMS"));
 		export_canceled=false;
 		db_created=false;
 		progress=sql_gen_progress=0;
@@ -531,10 +658,23 @@ void ModelExportHelper::exportToDBMS(DatabaseModel *db_model, Connection conn, c
 			//Creating the other object types
 			emit s_progressUpdated(progress, tr("Generating SQL for `%1' objects...").arg(db_model->getObjectCount()));
 
-			//Exporting the database model definition using the opened connection
-			buf=db_model->getCodeDefinition(SchemaParser::SqlDefinition, false);
-			progress=40;
-			exportBufferToDBMS(buf, new_db_conn, drop_objs);
+			/* When validating the model with more than one connection the objects are created
+			 * concurrently in waves instead of running the whole model code at once */
+			if(simulate && valid_conn_count > 1)
+			{
+				progress=40;
+				ProgressReporter::ScopedPhase exec_phase(progress_rep, QString("Execute SQL commands in waves"));
+				exportObjectsInWaves(db_model, new_db_conn);
+			}
+			else
+			{
+				//Exporting the database model definition using the opened connection
+				buf=db_model->getCodeDefinition(SchemaParser::SqlDefinition, false);
+				progress=40;
+
+				ProgressReporter::ScopedPhase exec_phase(progress_rep, QString("Execute SQL commands"));
+				exportBufferToDBMS(buf, new_db_conn, drop_objs);
+			}
 		}
 
 		disconnect(db_model, nullptr, this, nullptr);
@@ -606,6 +746,9 @@ void ModelExportHelper::exportToDataDict(DatabaseModel *db_model, const QString
 
 	try
 	{
+		progress_rep.reset();
+		ProgressReporter::ScopedPhase export_phase(progress_rep, QString("Export to data dictionary"));
+
 		progress=0;
 		emit s_progressUpdated(progress,
 													 tr("Starting data dictionary generation..."),
@@ -760,6 +903,7 @@ void ModelExportHelper::generateTempObjectNames(DatabaseModel *db_model)
 		obj.first->setName(tmp_name.mid(0,15));
 		tmp_name.clear();
 
+		progress_rep.registerItem();
 		emit s_progressUpdated(progress, tr("Renaming `%1' (%2) to `%3'")
 							   .arg(old_name)
 							   .arg(obj.first->getTypeName())
@@ -802,6 +946,365 @@ bool ModelExportHelper::isDuplicationError(const QString &error_code)
 	return err_codes.contains(error_code);
 }
 
+bool ModelExportHelper::isMissingObjectError(const QString &error_code)
+{
+	/* Error codes treated in this method
+	  3F000 	invalid_schema_name
+	  42P01 	undefined_table
+	  42703 	undefined_column
+	  42704 	undefined_object
+	  42883 	undefined_function
+
+	 Reference:
+	  http://www.postgresql.org/docs/current/static/errcodes-appendix.html*/
+	static QStringList err_codes = {QString("3F000"), QString("42P01"), QString("42703"),
+									QString("42704"), QString("42883")};
+
+	return err_codes.contains(error_code);
+}
+
+bool ModelExportHelper::isConcurrencyError(const QString &error_code)
+{
+	/* Error codes treated in this method
+	  40001 	serialization_failure
+	  40P01 	deadlock_detected
+	  XX000 	internal_error (raised as "tuple concurrently updated")
+
+	 Reference:
+	  http://www.postgresql.org/docs/current/static/errcodes-appendix.html*/
+	static QStringList err_codes = {QString("40001"), QString("40P01"), QString("XX000")};
+
+	return err_codes.contains(error_code);
+}
+
+QStringList ModelExportHelper::getSQLCommands(const QString &sql_code)
+{
+	QStringList cmds;
+	QString sql_buf = sql_code, lin, sql_cmd;
+	QTextStream ts(&sql_buf);
+	bool ddl_tk_found = false;
+
+	while(!ts.atEnd())
+	{
+		lin = ts.readLine();
+		ddl_tk_found = (lin.indexOf(Attributes::DdlEndToken) >= 0);
+		lin.remove(QRegularExpression("^(--)+(.)+$"));
+
+		if(!lin.isEmpty())
+			sql_cmd += lin + "\n";
+
+		if((ddl_tk_found || ts.atEnd()) && !sql_cmd.trimmed().isEmpty())
+		{
+			cmds.append(sql_cmd);
+			sql_cmd.clear();
+		}
+	}
+
+	return cmds;
+}
+
+std::vector<std::vector<unsigned>> ModelExportHelper::getCreationWaves(DatabaseModel *db_model, const std::vector<std::pair<BaseObject *, QString>> &objs_code)
+{
+	std::vector<std::vector<unsigned>> waves;
+	std::map<BaseObject *, unsigned> obj_waves;
+	std::map<BaseObject *, std::set<unsigned>> target_waves;
+	std::vector<BaseObject *> deps, targets;
+	BaseObject *object = nullptr;
+	TableObject *tab_obj = nullptr;
+	BaseRelationship *rel = nullptr;
+	Constraint *constr = nullptr;
+	Permission *perm = nullptr;
+	PhysicalTable *table = nullptr;
+	unsigned wave = 0, min_wave = 0;
+
+	// Returns if one of the targets of the current object is changed by another object in the wave
+	auto has_conflict = [&](unsigned wave_idx) {
+		for(auto &target : targets)
+		{
+			if(target_waves[target].count(wave_idx))
+				return true;
+		}
+
+		return false;
+	};
+
+	for(unsigned idx = 0; idx < objs_code.size(); idx++)
+	{
+		object = objs_code[idx].first;
+
+		// Entries without object run alone, after all the previous entries and before the next ones
+		if(!object)
+		{
+			wave = waves.size();
+			min_wave = wave + 1;
+		}
+		else
+		{
+			deps.clear();
+			targets.clear();
+			db_model->getObjectDependecies(object, deps);
+
+			tab_obj = dynamic_cast<TableObject *>(object);
+			rel = dynamic_cast<BaseRelationship *>(object);
+			constr = dynamic_cast<Constraint *>(object);
+			perm = dynamic_cast<Permission *>(object);
+			table = dynamic_cast<PhysicalTable *>(object);
+
+			/* Besides being dependencies, the tables changed by the object (and the object which privileges
+			 * are changed by a permission) are stored as targets that can't be shared by objects of the same wave */
+			if(tab_obj && tab_obj->getParentTable())
+				targets.push_back(tab_obj->getParentTable());
+
+			if(constr && constr->getReferencedTable())
+				targets.push_back(constr->getReferencedTable());
+
+			if(rel)
+			{
+				targets.push_back(rel->getTable(BaseRelationship::SrcTable));
+				targets.push_back(rel->getTable(BaseRelationship::DstTable));
+			}
+
+			if(perm)
+			{
+				tab_obj = dynamic_cast<TableObject *>(perm->getObject());
+				targets.push_back(tab_obj ? tab_obj->getParentTable() : perm->getObject());
+			}
+
+			// Creating inherited tables and partitions changes their parent tables too
+			if(table)
+			{
+				if(table->getPartitionedTable())
+					targets.push_back(table->getPartitionedTable());
+
+				for(unsigned anc_idx = 0; anc_idx < table->getAncestorTableCount(); anc_idx++)
+					targets.push_back(table->getAncestorTable(anc_idx));
+			}
+
+			deps.insert(deps.end(), targets.begin(), targets.end());
+
+			/* Only the dependencies placed before the object in the creation order are considered,
+			 * the other ones (if any) aren't needed to create the object since the creation order works serially */
+			wave = min_wave;
+
+			for(auto &dep : deps)
+			{
+				if(dep != object && obj_waves.count(dep))
+					wave = std::max(wave, obj_waves[dep] + 1);
+			}
+
+			while(has_conflict(wave))
+				wave++;
+
+			for(auto &target : targets)
+				target_waves[target].insert(wave);
+
+			obj_waves[object] = wave;
+		}
+
+		if(wave >= waves.size())
+			waves.resize(wave + 1);
+
+		waves[wave].push_back(idx);
+	}
+
+	return waves;
+}
+
+void ModelExportHelper::exportObjectsInWaves(DatabaseModel *db_model, Connection &conn)
+{
+	std::vector<std::pair<BaseObject *, QString>> objs_code;
+	std::vector<std::vector<unsigned>> waves;
+	std::vector<Connection> conns;
+	std::vector<unsigned> wave_objs, deferred;
+	std::map<unsigned, std::pair<Exception, QString>> failures;
+	QStringList session_cmds;
+	QThreadPool pool;
+	QMutex result_mutex;
+	std::atomic<unsigned> next_obj(0), created_cnt(0);
+	unsigned wave_idx = 0, total = 0;
+	BaseObject *object = nullptr;
+
+	/* Creates the object of the provided entry in the connection, running its commands one by one.
+	 * Returns true if the object was created, false if it was deferred. Errors are stored in the failures map */
+	auto create_object = [&](Connection &obj_conn, unsigned obj_idx, bool allow_defer) -> bool {
+		QStringList cmds = getSQLCommands(objs_code[obj_idx].second);
+		BaseObject *obj = objs_code[obj_idx].first;
+
+		for(int cmd_idx = 0; cmd_idx < cmds.size() && !export_canceled; cmd_idx++)
+		{
+			try
+			{
+				if(cmd_idx == 0 && obj)
+				{
+					progress_rep.registerItem();
+					emit s_progressUpdated(progress, tr("Creating object `%1' (%2)").arg(obj->getName()).arg(obj->getTypeName()),
+																 obj->getObjectType(), cmds[cmd_idx]);
+				}
+
+				obj_conn.executeDDLCommand(cmds[cmd_idx]);
+			}
+			catch(Exception &e)
+			{
+				QMutexLocker locker(&result_mutex);
+
+				/* If the first command of the object fails because something is missing, nothing was created so far
+				 * and the object is retried later, when the objects that it uses (not listed as dependencies) are created.
+				 * The same is done when the command conflicts with another one running concurrently */
+				if(allow_defer && cmd_idx == 0 &&
+					 (isMissingObjectError(e.getExtraInfo()) || isConcurrencyError(e.getExtraInfo())))
+				{
+					deferred.push_back(obj_idx);
+					return false;
+				}
+
+				failures.emplace(obj_idx, std::make_pair(e, cmds[cmd_idx]));
+				return false;
+			}
+		}
+
+		created_cnt++;
+		return true;
+	};
+
+	/* Handles the errors of the objects in the creation order. Ignored errors are only registered,
+	 * the other ones abort the process being raised in the name of the object */
+	auto handle_failures = [&](){
+		for(auto &itr : failures)
+		{
+			try
+			{
+				handleSQLError(itr.second.first, itr.second.second, false);
+			}
+			catch(Exception &e)
+			{
+				object = objs_code[itr.first].first;
+
+				// The prepended and appended SQL are placed in the first and last entries and belong to the database
+				if(!object &&
+					 ((itr.first == 0 && db_model->isPrependedAtBOD() && !db_model->getPrependedSQL().trimmed().isEmpty()) ||
+						(itr.first == objs_code.size() - 1 && db_model->isAppendAtEOD() && !db_model->getAppendedSQL().trimmed().isEmpty())))
+					object = db_model;
+
+				throw Exception(Exception::getErrorMessage(ErrorCode::ObjectSQLValidationFailure)
+												.arg(object ? object->getSignature() : tr("shell types"))
+												.arg(object ? object->getTypeName() : BaseObject::getTypeName(ObjectType::Type)),
+												ErrorCode::ObjectSQLValidationFailure, __PRETTY_FUNCTION__, __FILE__, __LINE__, &e);
+			}
+		}
+
+		failures.clear();
+	};
+
+	try
+	{
+		objs_code = db_model->getObjectsSQLDefinition(session_cmds);
+		waves = getCreationWaves(db_model, objs_code);
+		total = objs_code.size();
+
+		emit s_progressUpdated(progress, tr("Creating `%1' objects in `%2' waves using `%3' connections.")
+													 .arg(total).arg(waves.size()).arg(valid_conn_count));
+
+		/* Opening the connections used by the workers. The copies of the provided connection
+		 * have the same parameters (pointing to the new database) but aren't connected yet */
+		conns.assign(std::min<unsigned>(valid_conn_count, std::max(pool.maxThreadCount(), 1)), conn);
+
+		for(auto &wk_conn : conns)
+		{
+			wk_conn.connect();
+
+			for(auto &cmd : session_cmds)
+				wk_conn.executeDDLCommand(cmd);
+		}
+
+		pool.setMaxThreadCount(conns.size());
+
+		for(wave_idx = 0; wave_idx < waves.size() && !export_canceled; wave_idx++)
+		{
+			/* The entries without object (shell types, prepended and appended SQL) must run after all the previous
+			 * entries, so the objects still deferred are created serially, in the creation order, before them */
+			if(!objs_code[waves[wave_idx].front()].first && !deferred.empty())
+			{
+				std::sort(deferred.begin(), deferred.end());
+
+				for(auto &obj_idx : deferred)
+				{
+					if(export_canceled)
+						break;
+
+					create_object(conns.front(), obj_idx, false);
+					handle_failures();
+				}
+
+				deferred.clear();
+			}
+
+			// The objects deferred in the previous wave are retried in this one
+			wave_objs = deferred;
+			wave_objs.insert(wave_objs.end(), waves[wave_idx].begin(), waves[wave_idx].end());
+			deferred.clear();
+			next_obj = 0;
+			std::sort(wave_objs.begin(), wave_objs.end());
+
+			for(auto &wk_conn : conns)
+			{
+				Connection *wk_conn_ptr = &wk_conn;
+
+				pool.start([&, wk_conn_ptr](){
+					unsigned pos = 0;
+
+					while(!export_canceled && (pos = next_obj++) < wave_objs.size())
+					{
+						create_object(*wk_conn_ptr, wave_objs[pos], true);
+
+						QMutexLocker locker(&result_mutex);
+						if(!failures.empty())
+							break;
+					}
+				});
+			}
+
+			pool.waitForDone();
+			progress = 40 + ((created_cnt / static_cast<double>(total)) * 55);
+			handle_failures();
+		}
+
+		/* The objects still deferred are created serially in the creation order so the missing objects,
+		 * if they are really part of the model, are created before the objects that need them */
+		for(auto &wk_conn : conns)
+			wk_conn.close();
+
+		std::sort(deferred.begin(), deferred.end());
+		wave_objs = deferred;
+		deferred.clear();
+
+		if(!wave_objs.empty() && !export_canceled)
+		{
+			for(auto &cmd : session_cmds)
+				conn.executeDDLCommand(cmd);
+		}
+
+		for(auto &obj_idx : wave_objs)
+		{
+			if(export_canceled)
+				break;
+
+			create_object(conn, obj_idx, false);
+			handle_failures();
+		}
+
+		progress = 95;
+	}
+	catch(Exception &e)
+	{
+		pool.waitForDone();
+
+		for(auto &wk_conn : conns)
+			wk_conn.close();
+
+		throw Exception(e.getErrorMessage(), e.getErrorCode(),__PRETTY_FUNCTION__,__FILE__,__LINE__, &e);
+	}
+}
+
 void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &conn, bool drop_objs)
 {
 	Connection aux_conn;
@@ -894,6 +1397,7 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 					aux_cmd.remove('"');
 					aux_cmd.remove("IF EXISTS ");
 					obj_type=(aux_cmd.contains("COLUMN") ? ObjectType::Column : ObjectType::Constraint);
+
 					reg_aux.setPattern("(COLUMN|CONSTRAINT)( )+");
 
 					//Extracting the table name
@@ -924,6 +1428,7 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 					else
 						msg=tr("Creating object `%1' (%2)").arg(obj_name).arg(BaseObject::getTypeName(obj_type));
 
+					progress_rep.registerItem();
 					emit s_progressUpdated(aux_prog, msg, obj_type, sql_cmd);
 					is_drop=false;
 				}
@@ -1041,6 +1546,7 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 						}
 					}
 
+					progress_rep.registerItem();
 					emit s_progressUpdated(aux_prog, msg, obj_type, sql_cmd);
 					is_create=is_drop=false;
 					msg.clear();
@@ -1048,6 +1554,7 @@ void ModelExportHelper::exportBufferToDBMS(const QString &buffer, Connection &co
 				else if(!sql_cmd.trimmed().isEmpty())
 				{
 					//General commands like grant, revoke or set aren't explicitly shown
+					progress_rep.registerItem();
 					emit s_progressUpdated(aux_prog, tr("Running auxiliary command."), ObjectType::BaseObject, sql_cmd);
 				}
 
@@ -1135,7 +1642,7 @@ void ModelExportHelper::setExportToSQLParams(DatabaseModel *db_model, const QStr
 	this->split=split;
 }
 
-void ModelExportHelper::setExportToPNGParams(ObjectsScene *scene, QGraphicsView *viewp, const QString &filename, double zoom, bool show_grid, bool show_delim, bool page_by_page)
+void ModelExportHelper::setExportToPNGParams(ObjectsScene *scene, QGraphicsView *viewp, const QString &filename, double zoom, bool show_grid, bool show_delim, bool page_by_page, unsigned tile_size)
 {
 	this->scene=scene;
 	this->viewp=viewp;
@@ -1144,6 +1651,7 @@ void ModelExportHelper::setExportToPNGParams(ObjectsScene *scene, QGraphicsView
 	this->show_grid=show_grid;
 	this->show_delim=show_delim;
 	this->page_by_page=page_by_page;
+	this->tile_size=tile_size;
 }
 
 void ModelExportHelper::setExportToSVGParams(ObjectsScene *scene, const QString &filename, bool show_grid, bool show_delim)
@@ -1192,7 +1700,7 @@ void ModelExportHelper::exportToPNG()
 {
 	try
 	{
-		exportToPNG(scene, filename, zoom, show_grid, show_delim, page_by_page, viewp);
+		exportToPNG(scene, filename, zoom, show_grid, show_delim, page_by_page, viewp, tile_size);
 		resetExportParams();
 	}
 	catch(Exception &e)
@@ -1247,3 +1755,8 @@ void ModelExportHelper::cancelExport()
 
 	export_canceled = true;
 }
+
+ProgressReporter &ModelExportHelper::getProgressReporter()
+{
+	return progress_rep;
+}
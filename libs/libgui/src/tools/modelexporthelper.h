@@ -111,6 +111,20 @@ class ModelExportHelper: public QObject {
 
 		double zoom;
 
+		//! \brief Size (in pixels) of the tiles in which the PNG output is split (only in thread mode)
+		unsigned tile_size,
+
+		//! \brief Amount of connections used to create the objects in simulation mode (see setValidationConnections())
+		valid_conn_count;
+
+		/*! \brief Renders the provided viewport area (in viewport coordinates) onto a new image. Images are used
+		 * instead of pixmaps because they can be safely handled (saved) outside the thread that created them */
+		QImage renderImage(QGraphicsView *view, const QRect &view_rect);
+
+		/*! \brief Splits the provided viewport area in tiles of tile_size x tile_size pixels. The returned rects are
+		 * in viewport coordinates and are ordered row by row. If tile_size is 0 the area is returned as a single tile */
+		std::vector<QRect> getImageTiles(const QRect &view_rect, unsigned tile_size);
+
 		//! \brief Saves the current state of ALTER command generaton for table columns/constraints
 		void saveGenAtlerCmdsStatus(DatabaseModel *db_model);
 
@@ -134,6 +148,31 @@ class ModelExportHelper: public QObject {
 		//! \brief Returns if the error code is one of the treated by the export process as object duplication error
 		bool isDuplicationError(const QString &error_code);
 
+		/*! \brief Returns if the error code indicates that an object used by the command doesn't exist (yet).
+		 * When validating the objects in waves, these errors cause the object to be retried in a later wave */
+		bool isMissingObjectError(const QString &error_code);
+
+		/*! \brief Returns if the error code indicates a conflict with a concurrent command (e.g. deadlocks).
+		 * When validating the objects in waves, these errors cause the object to be retried in a later wave */
+		bool isConcurrencyError(const QString &error_code);
+
+		//! \brief Splits the SQL code of an object in the commands delimited by the ddl end token, removing the comment lines
+		QStringList getSQLCommands(const QString &sql_code);
+
+		/*! \brief Distributes the objects in waves of creation. The objects of a wave depend only on objects
+		 * of the previous waves, so the objects in the same wave can be created concurrently. Objects that change the same
+		 * table or privileges target (e.g. foreign keys between two tables, permissions on the same table) are placed in
+		 * different waves since running them together causes deadlocks and concurrent update errors. Entries with a null object
+		 * (the shell types and the prepended and appended SQL) are placed alone in a wave that runs after all the previous entries and before the next ones.
+		 * The returned waves contain the indexes of the entries in objs_code */
+		std::vector<std::vector<unsigned>> getCreationWaves(DatabaseModel *db_model, const std::vector<std::pair<BaseObject *, QString>> &objs_code);
+
+		/*! \brief Creates the model objects in the database which conn is connected to, using valid_conn_count connections
+		 * at the same time. The objects are created wave by wave (see getCreationWaves()). The objects that fail because
+		 * of a missing object or a concurrent command are retried in the next wave and, in the end, the remaining ones are created serially. Errors are
+		 * raised in the name of the object that caused them */
+		void exportObjectsInWaves(DatabaseModel *db_model, Connection &conn);
+
 		//! \brief Restore the export parameters to their default values
 		void resetExportParams();
 
@@ -147,7 +186,18 @@ class ModelExportHelper: public QObject {
 		3) abort the export by immediatelly redirecting the error to the user */
 		void handleSQLError(Exception &e, const QString &sql_cmd, bool ignore_dup);
 
+		//! \brief Records the timings of the export phases and the amount of items processed in them
+		ProgressReporter progress_rep;
+
 	public:
+		/*! \brief Default size (in pixels) of the tiles used to render large images in chunks
+		 * and minimum tile size accepted when exporting tiled PNG images */
+		static constexpr unsigned DefaultTileSize=2048,
+		MinimumTileSize=256;
+
+		//! \brief Maximum amount of connections used to validate the SQL code of a model
+		static constexpr unsigned MaxValidationConnections=16;
+
 		ModelExportHelper(QObject *parent = nullptr);
 
 		/*! \brief Determines which error codes must be ignored during the export process.
@@ -163,9 +213,15 @@ class ModelExportHelper: public QObject {
 		as well the page delimiters on the output image. The zoom parameter controls the zoom applied to the viewport
 		before draw it on the pixmap. It is possible to specified an viewport (QGraphicsView instance) previously allocated
 		and the method will use it instead of allocate a local one. This is a workaround to error raised by QCoreApplication::sendPostedEvents
-		when running the helper in a thread */
+		when running the helper in a thread.
+
+		When tile_size is greater than zero, the image (or each page when page_by_page is true) is rendered in tiles
+		of tile_size x tile_size pixels, each one saved in a separated file named [basename]_r[row]_c[col].[ext]
+		(or [basename]_p[page]_r[row]_c[col].[ext] in page by page mode). This way, huge scenes can be exported without
+		allocating a single image for the whole model. The encoding of the images is done in a worker pool while the
+		next tiles are rendered, and the amount of pending images is bounded by the pool size. */
 		void exportToPNG(ObjectsScene *scene, const QString &filename, double zoom, bool show_grid, bool show_delim,
-										 bool page_by_page, QGraphicsView *viewp=nullptr);
+										 bool page_by_page, QGraphicsView *viewp=nullptr, unsigned tile_size=0);
 
 		//! \brief Exports the model to a named SVG file.
 		void exportToSVG(ObjectsScene *scene, const QString &filename, bool show_grid, bool show_delim);
@@ -199,7 +255,7 @@ class ModelExportHelper: public QObject {
 		/*! \brief Configures the PNG export params before start the export thread (when in thread mode).
 		This form receive the objects scene, a viewport, the output filename, zoom factor, grid options and page by page export options */
 		void setExportToPNGParams(ObjectsScene *scene, QGraphicsView *viewp, const QString &filename, double zoom,
-															bool show_grid, bool show_delim, bool page_by_page);
+															bool show_grid, bool show_delim, bool page_by_page, unsigned tile_size=0);
 
 		/*! \brief Configures the SVG export params before start the export thread (when in thread mode).
 		This form receive the objects scene, the output filename, grid options. */
@@ -209,6 +265,14 @@ class ModelExportHelper: public QObject {
 		This form receive the database model, the output path and browsabe and split options. */
 		void setExportToDataDictParams(DatabaseModel *db_model, const QString &path, bool browsable, bool split);
 
+		/*! \brief Configures the amount of connections used to create the objects when exporting in simulation mode (SQL validation).
+		 * When more than one connection is used, the objects are created concurrently in waves of independent objects
+		 * instead of running the whole model code in a single connection. The value is limited to MaxValidationConnections */
+		void setValidationConnections(unsigned count);
+
+		//! \brief Returns the reporter that records the timings of the export phases
+		ProgressReporter &getProgressReporter();
+
 	signals:
 		//! \brief This singal is emitted whenever the export progress changes
 		void s_progressUpdated(int progress, QString msg, ObjectType obj_type=ObjectType::BaseObject, QString cmd="", bool is_code_gen = false);
@@ -240,6 +304,7 @@ class ModelExportHelper: public QObject {
 		friend class ModelValidationHelper;
 		friend class ModelExportForm;
 		friend class ModelDatabaseDiffForm;
+		friend class ModelExportHelperTest;
 };
 
 #endif
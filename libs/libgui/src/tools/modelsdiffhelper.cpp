@@ -172,50 +172,46 @@ void ModelsDiffHelper::setFilteredObjects(const std::vector<BaseObject *> &objec
 
 QStringList ModelsDiffHelper::getRelationshipFilters(const std::vector<BaseObject *> &objects, bool use_signature)
 {
-	Relationship *rel = nullptr;
 	QStringList filters;
 
+	for(auto &tab : getRelationshipTables(objects))
+	{
+		filters.append(BaseObject::getSchemaName(ObjectType::Table) +
+									 UtilsNs::FilterSeparator +
+									 (use_signature ? tab->getSignature() : tab->getName()) +
+									 UtilsNs::FilterSeparator +
+									 UtilsNs::FilterWildcard);
+	}
+
+	return filters;
+}
+
+std::vector<BaseTable *> ModelsDiffHelper::getRelationshipTables(const std::vector<BaseObject *> &objects)
+{
+	Relationship *rel = nullptr;
+	std::vector<BaseTable *> tables;
+
 	for(auto &obj : objects)
 	{
 		rel = dynamic_cast<Relationship *>(obj);
 
 		if(rel)
 		{
-			// Creating a filter to force the retrieval of the generated table (relationship n:n)
+			// Forcing the retrieval of the generated table (relationship n:n)
 			if(rel->getRelationshipType() == Relationship::RelationshipNn && rel->getGeneratedTable())
-			{
-				filters.append(BaseObject::getSchemaName(ObjectType::Table) +
-													UtilsNs::FilterSeparator +
-													(use_signature ?
-														 rel->getGeneratedTable()->getSignature() :
-														 rel->getGeneratedTable()->getName()) +
-													UtilsNs::FilterSeparator +
-													UtilsNs::FilterWildcard);
-			}
-			// Creating a filter to force the retrieval of the peer tables (inheritance and partitioning)
+				tables.push_back(rel->getGeneratedTable());
+
+			// Forcing the retrieval of the peer tables (inheritance and partitioning)
 			else if(rel->getRelationshipType() == Relationship::RelationshipGen ||
 							rel->getRelationshipType() == Relationship::RelationshipPart)
 			{
-				filters.append(BaseObject::getSchemaName(ObjectType::Table) +
-													UtilsNs::FilterSeparator +
-													(use_signature ?
-														 rel->getReceiverTable()->getSignature() :
-														 rel->getReceiverTable()->getName()) +
-													UtilsNs::FilterSeparator +
-													UtilsNs::FilterWildcard);
-
-				filters.append(BaseObject::getSchemaName(ObjectType::Table) +
-													UtilsNs::FilterSeparator +
-													(use_signature ?
-														 rel->getReferenceTable()->getSignature() :
-														 rel->getReferenceTable()->getName()) +
-													UtilsNs::FilterSeparator +
-													UtilsNs::FilterWildcard);
+				tables.push_back(rel->getReceiverTable());
+				tables.push_back(rel->getReferenceTable());
 			}
 		}
 	}
 
-	return filters;
+	return tables;
 }
 
 unsigned ModelsDiffHelper::getDiffTypeCount(unsigned diff_type)
@@ -233,15 +229,26 @@ void ModelsDiffHelper::diffModels()
 		if(!source_model || !imported_model)
 			throw Exception(ErrorCode::OprNotAllocatedObject ,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
+		progress_rep.reset();
+		ProgressReporter::ScopedPhase diff_phase(progress_rep, QString("Compare models"));
+
 		//First, we need to detect the objects to be dropped
-		diffModels(ObjectsDiffInfo::DropObject);
+		{
+			ProgressReporter::ScopedPhase phase(progress_rep, QString("Detect dropped objects"));
+			diffModels(ObjectsDiffInfo::DropObject);
+		}
+
 		//Second, we will check the objects to be created or modified
-		diffModels(ObjectsDiffInfo::CreateObject);
+		{
+			ProgressReporter::ScopedPhase phase(progress_rep, QString("Detect created/modified objects"));
+			diffModels(ObjectsDiffInfo::CreateObject);
+		}
 
 		if(diff_canceled)
 			emit s_diffCanceled();
 		else
 		{
+			ProgressReporter::ScopedPhase phase(progress_rep, QString("Process diff infos"));
 			processDiffInfos();
 			emit s_diffFinished();
 		}
@@ -418,6 +425,7 @@ void ModelsDiffHelper::diffModels(unsigned diff_type)
 					((diff_type==ObjectsDiffInfo::DropObject && (!diff_opts[OptKeepClusterObjs] || (diff_opts[OptKeepClusterObjs] && obj_type!=ObjectType::Role && obj_type!=ObjectType::Tablespace))) ||
 					 (diff_type!=ObjectsDiffInfo::DropObject)))
 			{
+				progress_rep.registerItem();
 				emit s_progressUpdated(prog + ((idx/static_cast<double>(obj_order.size())) * factor),
 															 tr("Processing object `%1' (%2)...").arg(object->getSignature()).arg(object->getTypeName()),
 															 object->getObjectType());
@@ -544,6 +552,8 @@ void ModelsDiffHelper::diffModels(unsigned diff_type)
 			else
 			{
 				generateDiffInfo(ObjectsDiffInfo::IgnoreObject, object);
+
+				progress_rep.registerItem();
 				emit s_progressUpdated(prog + ((idx/static_cast<double>(obj_order.size())) * factor),
 									   tr("Skipping object `%1' (%2)...").arg(object->getSignature()).arg(object->getTypeName()),
 									   object->getObjectType());
@@ -851,11 +861,14 @@ void ModelsDiffHelper::processDiffInfos()
 			constr=dynamic_cast<Constraint *>(object);
 			col=dynamic_cast<Column *>(object);
 
-			emit s_progressUpdated((idx++/static_cast<double>(diff_infos.size())) * 100,
+			progress_rep.registerItem();
+			emit s_progressUpdated((idx/static_cast<double>(diff_infos.size())) * 100,
 								   tr("Processing `%1' info for object `%2' (%3)...")
 								   .arg(diff.getDiffTypeString()).arg(object->getSignature()).arg(object->getTypeName()),
 								   obj_type);
 
+			idx++;
+
 			/* Preliminary verification for check constraints: there is the need to
 		 check if the constraint is added by generalization or if this is not the case
 		 if it already exists in a ancestor table of its parent, this avoid the generation
@@ -1233,3 +1246,8 @@ void ModelsDiffHelper::recreateObject(BaseObject *object, std::vector<BaseObject
 			recreateObject(obj, drop_objs, create_objs);
 	}
 }
+
+ProgressReporter &ModelsDiffHelper::getProgressReporter()
+{
+	return progress_rep;
+}
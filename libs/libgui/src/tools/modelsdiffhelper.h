@@ -119,6 +119,9 @@ class ModelsDiffHelper: public QObject {
 
 		BaseObject *getRelNNTable(const QString &obj_name, DatabaseModel *model);
 
+		//! \brief Records the timings of the diff phases and the amount of items processed in them
+		ProgressReporter progress_rep;
+
 	public:
 		static constexpr unsigned OptKeepClusterObjs=0,
 
@@ -177,6 +180,11 @@ class ModelsDiffHelper: public QObject {
 		 * perform partial diffs between a database model and a database. */
 		static QStringList getRelationshipFilters(const std::vector<BaseObject *> &objects, bool use_signature);
 
+		/*! \brief Returns the peer tables related to inheritance/partitioning or the generated tables of many-to-many
+		 * relationships in the provided list of objects. These are the tables from which the filters of
+		 * getRelationshipFilters() are created */
+		static std::vector<BaseTable *> getRelationshipTables(const std::vector<BaseObject *> &objects);
+
 		//! \brief Toggles a diff option throught the OPT_xxx constants
 		void setDiffOption(unsigned opt_id, bool value);
 
@@ -192,6 +200,9 @@ class ModelsDiffHelper: public QObject {
 		//! \brief Returns the diff containing all the SQL commands needed to synchronize the model and database
 		QString getDiffDefinition();
 
+		//! \brief Returns the reporter that records the timings of the diff phases
+		ProgressReporter &getProgressReporter();
+
 	public slots:
 		void diffModels();
 		void cancelDiff();
@@ -17,6 +17,7 @@
 */
 
 #include "modelvalidationhelper.h"
+#include <QThreadPool>
 
 ModelValidationHelper::ModelValidationHelper()
 {
@@ -233,7 +234,7 @@ void ModelValidationHelper::redirectExportProgress(int prog, QString msg, Object
 	emit s_progressUpdated(progress, msg, obj_type, cmd, is_code_gen);
 }
 
-void ModelValidationHelper::setValidationParams(DatabaseModel *model, Connection *conn, const QString &pgsql_ver, bool use_tmp_names)
+void ModelValidationHelper::setValidationParams(DatabaseModel *model, Connection *conn, const QString &pgsql_ver, bool use_tmp_names, unsigned conn_count)
 {
 	if(!model)
 		throw Exception(ErrorCode::AsgNotAllocattedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
@@ -247,6 +248,7 @@ void ModelValidationHelper::setValidationParams(DatabaseModel *model, Connection
 	this->pgsql_ver=pgsql_ver;
 	this->use_tmp_names=use_tmp_names;
 	export_helper.setExportToDBMSParams(this->db_model, conn, pgsql_ver, false, false, false, true, use_tmp_names);
+	export_helper.setValidationConnections(conn_count);
 }
 
 void ModelValidationHelper::switchToFixMode(bool value)
@@ -259,277 +261,369 @@ bool ModelValidationHelper::isInFixMode()
 	return fix_mode;
 }
 
-void ModelValidationHelper::validateModel()
+void ModelValidationHelper::appendValidationInfo(std::vector<ValidationInfo> &infos, unsigned val_type, BaseObject *object, const std::vector<BaseObject *> &refs)
 {
-	if(!db_model)
-		throw Exception(ErrorCode::OprNotAllocatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+	if(!refs.empty() || val_type==ValidationInfo::MissingExtension || val_type==ValidationInfo::BrokenRelConfig)
+		infos.push_back(ValidationInfo(val_type, object, refs));
+}
 
-	try
+template<class Result>
+void ModelValidationHelper::runValidationPhase(const QString &phase_name, const std::vector<BaseObject *> &objects, int start_prog, int end_prog,
+																							 const std::function<void(BaseObject *, std::vector<Result> &)> &check, std::vector<Result> &results)
+{
+	ProgressReporter::ScopedPhase phase(progress_rep, phase_name);
+	QThreadPool pool;
+	QMutex error_mutex;
+	std::vector<Exception> errors;
+	std::vector<std::vector<Result>> buffers;
+	std::atomic<unsigned> processed(0);
+	std::atomic<bool> abort_phase(false);
+	unsigned chunk_cnt = 0, chunk_size = 0, total = objects.size();
+	QString signal_msg = QString("`%1' (%2)");
+
+	/* The tasks use a snapshot of the progress when asking the reporter if the signal is due,
+	 * since the member is updated by this thread while they run */
+	int prog_snapshot = progress;
+
+	if(objects.empty())
+		return;
+
+	/* More chunks than threads are created so the threads that finish earlier (handling lighter objects)
+	 * can help with the remaining ones. The chunks are contiguous so merging them keeps the objects order */
+	chunk_cnt = std::min<unsigned>(total, pool.maxThreadCount() * 4);
+	chunk_size = (total / chunk_cnt) + (total % chunk_cnt != 0 ? 1 : 0);
+	chunk_cnt = (total / chunk_size) + (total % chunk_size != 0 ? 1 : 0);
+	buffers.resize(chunk_cnt);
+
+	for(unsigned chunk = 0; chunk < chunk_cnt; chunk++)
 	{
-		std::vector<ObjectType> types = { ObjectType::Role, ObjectType::Tablespace, ObjectType::Schema, ObjectType::Language, ObjectType::Function,
-																 ObjectType::Type, ObjectType::Domain, ObjectType::Sequence, ObjectType::Operator, ObjectType::OpFamily,
-																 ObjectType::OpClass, ObjectType::Collation, ObjectType::Table, ObjectType::Extension, ObjectType::View,
-																 ObjectType::Relationship, ObjectType::ForeignDataWrapper, ObjectType::ForeignServer, ObjectType::GenericSql,
-																 ObjectType::ForeignTable, ObjectType::Procedure, ObjectType::Transform },
-				aux_types = { ObjectType::Table, ObjectType::ForeignTable, ObjectType::View },
-				tab_obj_types = { ObjectType::Constraint, ObjectType::Index };
-
-		ObjectType	obj_type;
-		unsigned i = 0, i1 = 0, cnt = 0, aux_cnt = 0,	count = 0, count1 = 0;
-		BaseObject *object=nullptr, *refer_obj=nullptr;
-		std::vector<BaseObject *> refs, refs_aux, *obj_list=nullptr, aux_tables;
-		std::vector<BaseObject *>::iterator itr;
-		TableObject *tab_obj=nullptr;
-		PhysicalTable *table=nullptr, *ref_tab=nullptr, *recv_tab=nullptr;
-		BaseTable *base_tab = nullptr;
-		Constraint *constr=nullptr;
-		Column *col=nullptr;
-		Relationship *rel=nullptr;
-		std::map<QString, std::vector<BaseObject *> > dup_objects;
-		std::map<QString, std::vector<BaseObject *> >::iterator mitr;
-		QString name, signal_msg=QString("`%1' (%2)");
-		bool postgis_exists = db_model->getObjectIndex(QString("postgis"), ObjectType::Extension) >= 0;
+		unsigned start = chunk * chunk_size, end = std::min(start + chunk_size, total);
+		std::vector<Result> *buffer = &buffers[chunk];
 
-		warn_count=error_count=progress=0;
-		val_infos.clear();
-		valid_canceled=false;
+		pool.start([this, start, end, buffer, signal_msg, prog_snapshot, &objects, &check, &processed, &abort_phase, &error_mutex, &errors](){
+			BaseObject *object = nullptr;
 
-		aux_cnt = aux_types.size();
-		count = types.size();
-		count1 = tab_obj_types.size();
+			try
+			{
+				for(unsigned idx = start; idx < end && !valid_canceled && !abort_phase; idx++)
+				{
+					object = objects[idx];
+					check(object, *buffer);
+					processed++;
 
-		/* Step 1: Validating broken references. This situation happens when a object references another
-		 which id is smaller than the id of the first one. */
-		for(i=0; i < count && !valid_canceled; i++)
+					if(progress_rep.isReportDue(prog_snapshot))
+						emit s_objectProcessed(signal_msg.arg(object->getName()).arg(object->getTypeName()), object->getObjectType());
+				}
+			}
+			catch(Exception &e)
+			{
+				QMutexLocker locker(&error_mutex);
+				abort_phase = true;
+				errors.push_back(Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e));
+			}
+		});
+	}
+
+	// Updating the progress while the tasks are running
+	while(!pool.waitForDone(100))
+	{
+		progress = start_prog + ((processed / static_cast<double>(total)) * (end_prog - start_prog));
+		emit s_progressUpdated(progress, "");
+	}
+
+	if(!errors.empty())
+		throw Exception(errors.front().getErrorMessage(), errors.front().getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &errors.front());
+
+	for(auto &buffer : buffers)
+		results.insert(results.end(), buffer.begin(), buffer.end());
+
+	progress = end_prog;
+	emit s_progressUpdated(progress, "");
+}
+
+void ModelValidationHelper::validateReferences(BaseObject *object, std::vector<ValidationInfo> &infos)
+{
+	ObjectType obj_type = object->getObjectType();
+	BaseObject *refer_obj = nullptr;
+	std::vector<BaseObject *> refs, refs_aux;
+	TableObject *tab_obj = nullptr;
+	PhysicalTable *ref_tab = nullptr, *recv_tab = nullptr;
+	Constraint *constr = nullptr;
+	Column *col = nullptr;
+	Relationship *rel = nullptr;
+
+	/* Special validation case: For generalization and copy relationships validates the ids of participant tables.
+		 Reference table cannot own an id greater thant receiver table */
+	if(obj_type==ObjectType::Relationship)
+	{
+		rel=dynamic_cast<Relationship *>(object);
+		if(rel->getRelationshipType()==Relationship::RelationshipGen ||
+				rel->getRelationshipType()==Relationship::RelationshipDep ||
+			 rel->getRelationshipType()==Relationship::RelationshipPart)
 		{
-			obj_list=db_model->getObjectList(types[i]);
-			itr=obj_list->begin();
+			recv_tab=rel->getReceiverTable();
+			ref_tab=rel->getReferenceTable();
 
-			while(itr!=obj_list->end() && !valid_canceled)
+			if(ref_tab->getObjectId() > recv_tab->getObjectId())
 			{
-				object=(*itr);
-				obj_type=object->getObjectType();
-				refs_aux.clear();
-				itr++;
+				object=ref_tab;
+				refs_aux.push_back(recv_tab);
+			}
+		}
+	}
+	else
+	{
+		db_model->getObjectReferences(object, refs);
 
-				//Excluding the validation of system objects (created automatically)
-				if(!object->isSystemObject())
-				{
-					emit s_objectProcessed(signal_msg.arg(object->getName()).arg(object->getTypeName()), object->getObjectType());
+		while(!refs.empty() && !valid_canceled)
+		{
+			//Checking if the referrer object is a table object. In this case its parent table is considered
+			tab_obj=dynamic_cast<TableObject *>(refs.back());
+			constr=dynamic_cast<Constraint *>(tab_obj);
+			col=dynamic_cast<Column *>(tab_obj);
+
+			/*
+			 * If the current referrer object has an id less than reference object's id
+			 * then it will be pushed into the list of invalid references.
+			 * There's an exception which is that foreign keys are completely discarded from any validation
+			 * since they are always created at end of code definition being free of any reference breaking.
+			 */
+			if(object != refs.back() &&
+				 (
+					 ((col || (constr && constr->getConstraintType() != ConstraintType::ForeignKey)) &&
+						(tab_obj->getParentTable()->getObjectId() <= object->getObjectId())) ||
+					 (!constr && !col && refs.back()->getObjectId() <= object->getObjectId()))
+				 )
+			{
+				if(col || constr)
+					refer_obj=tab_obj->getParentTable();
+				else
+					refer_obj=refs.back();
 
-					/* Special validation case: For generalization and copy relationships validates the ids of participant tables.
-						 Reference table cannot own an id greater thant receiver table */
-					if(obj_type==ObjectType::Relationship)
-					{
-						rel=dynamic_cast<Relationship *>(object);
-						if(rel->getRelationshipType()==Relationship::RelationshipGen ||
-								rel->getRelationshipType()==Relationship::RelationshipDep ||
-							 rel->getRelationshipType()==Relationship::RelationshipPart)
-						{
-							recv_tab=rel->getReceiverTable();
-							ref_tab=rel->getReferenceTable();
+				refs_aux.push_back(refer_obj);
+			}
 
-							if(ref_tab->getObjectId() > recv_tab->getObjectId())
-							{
-								object=ref_tab;
-								refs_aux.push_back(recv_tab);
-							}
-						}
-					}
-					else
+			refs.pop_back();
+		}
+
+		/* Validating a special object. The validation made here is to check if the special object
+		 * (constraint/index/trigger/view) references a column added by a relationship and
+		 *  that relationship is being created after the creation of the special object */
+		if(BaseTable::isBaseTable(obj_type) || obj_type == ObjectType::GenericSql)
+		{
+			std::vector<ObjectType> tab_aux_types={ ObjectType::Constraint, ObjectType::Trigger, ObjectType::Index };
+			std::vector<TableObject *> *tab_objs;
+			std::vector<Column *> ref_cols;
+			std::vector<BaseObject *> rels;
+			BaseObject *rel=nullptr;
+			PhysicalTable *table=nullptr;
+			View *view=nullptr;
+			GenericSQL *gen_sql=nullptr;
+			Constraint *constr=nullptr;
+
+			table=dynamic_cast<PhysicalTable *>(object);
+			view=dynamic_cast<View *>(object);
+			gen_sql = dynamic_cast<GenericSQL *>(object);
+
+			if(table)
+			{
+				/* Checking the table children objects if they references some columns added by relationship.
+				 * If so, the id of the relationships are swapped with the child object if the first is created
+				 * after the latter. */
+				for(auto &obj_tp : tab_aux_types)
+				{
+					tab_objs = table->getObjectList(obj_tp);
+					if(!tab_objs) continue;
+
+					for(auto &tab_obj : (*tab_objs))
 					{
-						db_model->getObjectReferences(object, refs);
+						ref_cols.clear();
+						rels.clear();
 
-						while(!refs.empty() && !valid_canceled)
+						if(!tab_obj->isAddedByRelationship())
 						{
-							//Checking if the referrer object is a table object. In this case its parent table is considered
-							tab_obj=dynamic_cast<TableObject *>(refs.back());
-							constr=dynamic_cast<Constraint *>(tab_obj);
-							col=dynamic_cast<Column *>(tab_obj);
-
-							/*
-							 * If the current referrer object has an id less than reference object's id
-							 * then it will be pushed into the list of invalid references.
-							 * There's an exception which is that foreign keys are completely discarded from any validation
-							 * since they are always created at end of code definition being free of any reference breaking.
-							 */
-							if(object != refs.back() &&
-								 (
-									 ((col || (constr && constr->getConstraintType() != ConstraintType::ForeignKey)) &&
-										(tab_obj->getParentTable()->getObjectId() <= object->getObjectId())) ||
-									 (!constr && !col && refs.back()->getObjectId() <= object->getObjectId()))
-								 )
+							if(obj_tp==ObjectType::Constraint)
 							{
-								if(col || constr)
-									refer_obj=tab_obj->getParentTable();
-								else
-									refer_obj=refs.back();
+								constr=dynamic_cast<Constraint *>(tab_obj);
 
-								refs_aux.push_back(refer_obj);
+								if(constr->getConstraintType()!=ConstraintType::PrimaryKey)
+									ref_cols=constr->getRelationshipAddedColumns();
 							}
-
-							refs.pop_back();
+							else if(obj_tp==ObjectType::Trigger)
+								ref_cols=dynamic_cast<Trigger *>(tab_obj)->getRelationshipAddedColumns();
+							else
+								ref_cols=dynamic_cast<Index *>(tab_obj)->getRelationshipAddedColumns();
 						}
 
-						/* Validating a special object. The validation made here is to check if the special object
-						 * (constraint/index/trigger/view) references a column added by a relationship and
-						 *  that relationship is being created after the creation of the special object */
-						if(BaseTable::isBaseTable(obj_type) || obj_type == ObjectType::GenericSql)
+						//Getting the relationships that owns the columns
+						for(auto &ref_col : ref_cols)
 						{
-							std::vector<ObjectType> tab_aux_types={ ObjectType::Constraint, ObjectType::Trigger, ObjectType::Index };
-							std::vector<TableObject *> *tab_objs;
-							std::vector<Column *> ref_cols;
-							std::vector<BaseObject *> rels;
-							BaseObject *rel=nullptr;
-							View *view=nullptr;
-							GenericSQL *gen_sql=nullptr;
-							Constraint *constr=nullptr;
-
-							table=dynamic_cast<PhysicalTable *>(object);
-							view=dynamic_cast<View *>(object);
-							gen_sql = dynamic_cast<GenericSQL *>(object);
-
-							if(table)
-							{
-								/* Checking the table children objects if they references some columns added by relationship.
-								 * If so, the id of the relationships are swapped with the child object if the first is created
-								 * after the latter. */
-								for(auto &obj_tp : tab_aux_types)
-								{
-									tab_objs = table->getObjectList(obj_tp);
-									if(!tab_objs) continue;
-
-									for(auto &tab_obj : (*tab_objs))
-									{
-										ref_cols.clear();
-										rels.clear();
-
-										if(!tab_obj->isAddedByRelationship())
-										{
-											if(obj_tp==ObjectType::Constraint)
-											{
-												constr=dynamic_cast<Constraint *>(tab_obj);
-
-												if(constr->getConstraintType()!=ConstraintType::PrimaryKey)
-													ref_cols=constr->getRelationshipAddedColumns();
-											}
-											else if(obj_tp==ObjectType::Trigger)
-												ref_cols=dynamic_cast<Trigger *>(tab_obj)->getRelationshipAddedColumns();
-											else
-												ref_cols=dynamic_cast<Index *>(tab_obj)->getRelationshipAddedColumns();
-										}
-
-										//Getting the relationships that owns the columns
-										for(auto &ref_col : ref_cols)
-										{
-											rel=ref_col->getParentRelationship();
-											if(rel->getObjectId() > tab_obj->getObjectId() && std::find(rels.begin(), rels.end(), rel)==rels.end())
-												rels.push_back(rel);
-										}
-
-										generateValidationInfo(ValidationInfo::SpObjBrokenReference, tab_obj, rels);
-									}
-								}
-							}
-							else if(view)
-							{
-								ref_cols=view->getRelationshipAddedColumns();
+							rel=ref_col->getParentRelationship();
+							if(rel->getObjectId() > tab_obj->getObjectId() && std::find(rels.begin(), rels.end(), rel)==rels.end())
+								rels.push_back(rel);
+						}
 
-								//Getting the relationships that owns the columns
-								for(auto &ref_col : ref_cols)
-								{
-									rel=ref_col->getParentRelationship();
-									if(rel->getObjectId() > object->getObjectId() && std::find(rels.begin(), rels.end(), rel)==rels.end())
-										rels.push_back(rel);
-								}
+						appendValidationInfo(infos, ValidationInfo::SpObjBrokenReference, tab_obj, rels);
+					}
+				}
+			}
+			else if(view)
+			{
+				ref_cols=view->getRelationshipAddedColumns();
 
-								generateValidationInfo(ValidationInfo::SpObjBrokenReference, object, rels);
-							}
-							else
-							{
-								Column *col = nullptr;
+				//Getting the relationships that owns the columns
+				for(auto &ref_col : ref_cols)
+				{
+					rel=ref_col->getParentRelationship();
+					if(rel->getObjectId() > object->getObjectId() && std::find(rels.begin(), rels.end(), rel)==rels.end())
+						rels.push_back(rel);
+				}
 
-								for(auto &ref_obj : gen_sql->getReferencedObjects())
-								{
-									col = dynamic_cast<Column *>(ref_obj);
-									if(!col || !col->isAddedByRelationship()) continue;
+				appendValidationInfo(infos, ValidationInfo::SpObjBrokenReference, object, rels);
+			}
+			else
+			{
+				Column *col = nullptr;
 
-									rel = col->getParentRelationship();
+				for(auto &ref_obj : gen_sql->getReferencedObjects())
+				{
+					col = dynamic_cast<Column *>(ref_obj);
+					if(!col || !col->isAddedByRelationship()) continue;
 
-									if(rel->getObjectId() > object->getObjectId() && std::find(rels.begin(), rels.end(), rel) == rels.end())
-										rels.push_back(rel);
-								}
+					rel = col->getParentRelationship();
 
-								generateValidationInfo(ValidationInfo::SpObjBrokenReference, object, rels);
-							}
-						}
-					}
-
-					generateValidationInfo(ValidationInfo::BrokenReference, object, refs_aux);
+					if(rel->getObjectId() > object->getObjectId() && std::find(rels.begin(), rels.end(), rel) == rels.end())
+						rels.push_back(rel);
 				}
-			}
 
-			//Emit a signal containing the validation progress
-			progress=((i+1)/static_cast<double>(count))*20;
-			emit s_progressUpdated(progress, "");
+				appendValidationInfo(infos, ValidationInfo::SpObjBrokenReference, object, rels);
+			}
 		}
+	}
 
+	appendValidationInfo(infos, ValidationInfo::BrokenReference, object, refs_aux);
+}
 
-		/* Step 2: Validating name conflitcs between primary keys, unique keys, exclude constraints
-		and indexs of all tables/foreign talbes/views. The tables/views names are checked too. */
-		aux_tables = *db_model->getObjectList(ObjectType::Table);
-		aux_tables.insert(aux_tables.end(),
-											db_model->getObjectList(ObjectType::View)->begin(),
-											db_model->getObjectList(ObjectType::View)->end());
-		itr = aux_tables.begin();
-
-		//Searching the model's tables and gathering all the constraints and index
-		while(itr != aux_tables.end() && !valid_canceled)
+void ModelValidationHelper::getUniqueNameObjects(BaseObject *object, std::vector<std::pair<QString, BaseObject *>> &objects)
+{
+	std::vector<ObjectType> tab_obj_types = { ObjectType::Constraint, ObjectType::Index };
+	BaseTable *base_tab = dynamic_cast<BaseTable *>(object);
+	TableObject *tab_obj = nullptr;
+	Constraint *constr = nullptr;
+	unsigned cnt = 0;
+	QString name;
+
+	for(auto &obj_tp : tab_obj_types)
+	{
+		cnt=base_tab->getObjectCount(obj_tp);
+
+		for(unsigned idx=0; idx < cnt; idx++)
 		{
-			base_tab = dynamic_cast<BaseTable *>(*itr);
-			emit s_objectProcessed(signal_msg.arg(base_tab->getName()).arg(base_tab->getTypeName()), base_tab->getObjectType());
+			//Get the table object (constraint or index)
+			tab_obj=dynamic_cast<TableObject *>(base_tab->getObject(idx, obj_tp));
+
+			//Configures the full name of the object including the parent name
+			name=tab_obj->getParentTable()->getSchema()->getName(true) + QString(".") + tab_obj->getName(true);
+			name.remove('"');
+
+			//Trying to convert the object to constraint
+			constr=dynamic_cast<Constraint *>(tab_obj);
+
+			/* If the object is an index or	a primary key, unique or exclude constraint,
+			 * insert the object on duplicated	objects list */
+			if((!constr ||
+				(constr && (constr->getConstraintType()==ConstraintType::PrimaryKey ||
+										constr->getConstraintType()==ConstraintType::Unique ||
+										constr->getConstraintType()==ConstraintType::Exclude))))
+				objects.push_back({ name, tab_obj });
+		}
+	}
+}
 
-			itr++;
+void ModelValidationHelper::validatePostGiSColumns(BaseObject *object, std::vector<ValidationInfo> &infos)
+{
+	PhysicalTable *table = dynamic_cast<PhysicalTable *>(object);
+	Column *col = nullptr;
 
-			for(i=0; i < count1 && !valid_canceled; i++)
-			{
-				cnt=base_tab->getObjectCount(tab_obj_types[i]);
+	for(auto &obj : *table->getObjectList(ObjectType::Column))
+	{
+		col = dynamic_cast<Column *>(obj);
 
-				for(i1=0; i1 < cnt && !valid_canceled; i1++)
-				{
-					//Get the table object (constraint or index)
-					tab_obj=dynamic_cast<TableObject *>(base_tab->getObject(i1, tab_obj_types[i]));
-
-					//Configures the full name of the object including the parent name
-					name=tab_obj->getParentTable()->getSchema()->getName(true) + QString(".") + tab_obj->getName(true);
-					//name=tab_obj->TableObject::getSignature(true);
-					name.remove('"');
-
-					//Trying to convert the object to constraint
-					constr=dynamic_cast<Constraint *>(tab_obj);
-
-					/* If the object is an index or	a primary key, unique or exclude constraint,
-					 * insert the object on duplicated	objects map */
-					if((!constr ||
-						(constr && (constr->getConstraintType()==ConstraintType::PrimaryKey ||
-												constr->getConstraintType()==ConstraintType::Unique ||
-												constr->getConstraintType()==ConstraintType::Exclude))))
-						dup_objects[name].push_back(tab_obj);
-				}
+		if(col->getType().isPostGiSType())
+			appendValidationInfo(infos, ValidationInfo::MissingExtension, col, {});
+	}
+}
+
+void ModelValidationHelper::validateModel()
+{
+	if(!db_model)
+		throw Exception(ErrorCode::OprNotAllocatedObject,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	try
+	{
+		std::vector<ObjectType> types = { ObjectType::Role, ObjectType::Tablespace, ObjectType::Schema, ObjectType::Language, ObjectType::Function,
+																 ObjectType::Type, ObjectType::Domain, ObjectType::Sequence, ObjectType::Operator, ObjectType::OpFamily,
+																 ObjectType::OpClass, ObjectType::Collation, ObjectType::Table, ObjectType::Extension, ObjectType::View,
+																 ObjectType::Relationship, ObjectType::ForeignDataWrapper, ObjectType::ForeignServer, ObjectType::GenericSql,
+																 ObjectType::ForeignTable, ObjectType::Procedure, ObjectType::Transform },
+				aux_types = { ObjectType::Table, ObjectType::ForeignTable, ObjectType::View };
+
+		unsigned i = 0;
+		std::vector<BaseObject *> refs, *obj_list=nullptr, objects;
+		std::vector<ValidationInfo> infos;
+		std::vector<std::pair<QString, BaseObject *>> uq_name_objs;
+		std::map<QString, std::vector<BaseObject *> > dup_objects;
+		std::map<QString, std::vector<BaseObject *> >::iterator mitr;
+		bool postgis_exists = db_model->getObjectIndex(QString("postgis"), ObjectType::Extension) >= 0;
+
+		progress_rep.reset();
+		ProgressReporter::ScopedPhase valid_phase(progress_rep, QString("Validate model"));
+
+		warn_count=error_count=progress=0;
+		val_infos.clear();
+		valid_canceled=false;
+
+		/* Step 1: Validating broken references. This situation happens when a object references another
+		 which id is smaller than the id of the first one. The system objects (created automatically) are not validated */
+		for(auto &type : types)
+		{
+			obj_list=db_model->getObjectList(type);
+
+			for(auto &obj : *obj_list)
+			{
+				if(!obj->isSystemObject())
+					objects.push_back(obj);
 			}
 		}
 
+		runValidationPhase<ValidationInfo>(QString("Broken references"), objects, 0, 20,
+																			 [this](BaseObject *object, std::vector<ValidationInfo> &infos){
+																				 validateReferences(object, infos);
+																			 }, infos);
+
+		for(auto &info : infos)
+			generateValidationInfo(info.getValidationType(), info.getObject(), info.getReferences());
+
+		/* Step 2: Validating name conflitcs between primary keys, unique keys, exclude constraints
+		and indexs of all tables/foreign talbes/views. The tables/views names are checked too. */
+		objects = *db_model->getObjectList(ObjectType::Table);
+		objects.insert(objects.end(),
+									 db_model->getObjectList(ObjectType::View)->begin(),
+									 db_model->getObjectList(ObjectType::View)->end());
+
+		//Gathering all the constraints and index of the tables
+		runValidationPhase<std::pair<QString, BaseObject *>>(QString("Unique names"), objects, 20, 30,
+																												 &ModelValidationHelper::getUniqueNameObjects, uq_name_objs);
+
+		for(auto &itr : uq_name_objs)
+			dup_objects[itr.first].push_back(itr.second);
+
 		/* Inserting the tables and views to the map in order to check if there are
 		 * other table objects that conflicts with them */
-		for(i=0; i < aux_cnt && !valid_canceled; i++)
+		for(auto &type : aux_types)
 		{
-			obj_list=db_model->getObjectList(aux_types[i]);
-			itr=obj_list->begin();
-			while(itr!=obj_list->end() && !valid_canceled)
-			{
-				dup_objects[(*itr)->getSignature(true).remove('"')].push_back(*itr);
-				itr++;
-			}
+			for(auto &obj : *db_model->getObjectList(type))
+				dup_objects[obj->getSignature(true).remove('"')].push_back(obj);
 		}
 
 		//Checking the map of duplicated objects
@@ -547,61 +641,46 @@ void ModelValidationHelper::validateModel()
 			}
 
 			//Emit a signal containing the validation progress
-			progress=20 + ((i/static_cast<double>(dup_objects.size()))*20);
-			emit s_progressUpdated(progress, "");
+			progress=30 + ((i/static_cast<double>(dup_objects.size()))*5);
+
+			if(progress_rep.isReportDue(progress))
+				emit s_progressUpdated(progress, "");
 
 			i++; mitr++;
 		}
 
 		// Step 3: Checking if columns of any table is using GiS data types and the postgis extension is not created.
-		if(!postgis_exists)
+		if(!postgis_exists && !valid_canceled)
 		{
-			std::vector<BaseObject *> tabs;
-
-			tabs.assign(db_model->getObjectList(ObjectType::Table)->begin(),
-									db_model->getObjectList(ObjectType::Table)->end());
-			tabs.insert(tabs.end(),
-									db_model->getObjectList(ObjectType::ForeignTable)->begin(),
-									db_model->getObjectList(ObjectType::ForeignTable)->end());
-
-			itr=tabs.begin();
-			i=0;
-
-			while(itr!=tabs.end() && !valid_canceled)
-			{
-				table = dynamic_cast<PhysicalTable *>(*itr);
-				itr++;
-
-				for(auto &obj : *table->getObjectList(ObjectType::Column))
-				{
-					col = dynamic_cast<Column *>(obj);
-
-					if(col->getType().isPostGiSType())
-						generateValidationInfo(ValidationInfo::MissingExtension, col, {});
-				}
-
-				progress=30 + ((i/static_cast<double>(obj_list->size()))*20);
-			}
+			objects.assign(db_model->getObjectList(ObjectType::Table)->begin(),
+										 db_model->getObjectList(ObjectType::Table)->end());
+			objects.insert(objects.end(),
+										 db_model->getObjectList(ObjectType::ForeignTable)->begin(),
+										 db_model->getObjectList(ObjectType::ForeignTable)->end());
+
+			infos.clear();
+			runValidationPhase<ValidationInfo>(QString("PostGiS types"), objects, 35, 40,
+																				 &ModelValidationHelper::validatePostGiSColumns, infos);
+
+			for(auto &info : infos)
+				generateValidationInfo(info.getValidationType(), info.getObject(), info.getReferences());
 		}
 
 		/* Step 4: Checking if there are some invalidated relationship. In some cases, specially with identifier and generalization relationships,
 	   the columns aren't correctly propagated due to creation order and special behavior of those objects. Thus, in order to
 	   keep all columns synchonized it is need to make this step and change the relationship creation order if needed. This step is executed
 	   only when there is no validation infos generated because for each broken relationship there is the need to do a revalidation of all relationships */
-		if(val_infos.empty())
+		if(val_infos.empty() && !valid_canceled)
 		{
-			obj_list=db_model->getObjectList(ObjectType::Relationship);
-			itr=db_model->getObjectList(ObjectType::Relationship)->begin();
-
-			while(itr!=obj_list->end() && !valid_canceled)
-			{
-				progress=40 + ((i/static_cast<double>(obj_list->size()))*20);
-
-				if(dynamic_cast<Relationship *>(*itr)->isInvalidated())
-					generateValidationInfo(ValidationInfo::BrokenRelConfig, *itr, {});
-
-				itr++;
-			}
+			infos.clear();
+			runValidationPhase<ValidationInfo>(QString("Invalidated relationships"), *db_model->getObjectList(ObjectType::Relationship), 40, 40,
+																				 [](BaseObject *object, std::vector<ValidationInfo> &infos){
+																					 if(dynamic_cast<Relationship *>(object)->isInvalidated())
+																						 appendValidationInfo(infos, ValidationInfo::BrokenRelConfig, object, {});
+																				 }, infos);
+
+			for(auto &info : infos)
+				generateValidationInfo(info.getValidationType(), info.getObject(), info.getReferences());
 		}
 
 		if(!valid_canceled && !fix_mode)
@@ -726,3 +805,8 @@ void ModelValidationHelper::emitValidationFinished()
 	progress=100;
 	emit s_progressUpdated(progress,"");
 }
+
+ProgressReporter &ModelValidationHelper::getProgressReporter()
+{
+	return progress_rep;
+}
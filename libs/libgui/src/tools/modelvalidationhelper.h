@@ -26,6 +26,8 @@
 #define MODEL_VALIDATION_HELPER_H
 
 #include <QObject>
+#include <functional>
+#include <atomic>
 #include "validationinfo.h"
 #include "databasemodel.h"
 #include "connection.h"
@@ -55,11 +57,12 @@ class ModelValidationHelper: public QObject {
 		//! \brief Validation progress
 		int progress;
 
-		//! \brief Indicates if the validation was canceled by the user
-		bool  valid_canceled,
+		/*! \brief Indicates if the validation was canceled by the user.
+		 * This flag is atomic since it's read by the tasks of the parallel validation phases */
+		std::atomic<bool> valid_canceled;
 
 		//! \brief Indicates if the validation is on fix mode.
-		fix_mode,
+		bool fix_mode,
 
 		use_tmp_names;
 
@@ -72,13 +75,41 @@ class ModelValidationHelper: public QObject {
 
 		void generateValidationInfo(unsigned val_type, BaseObject *object, std::vector<BaseObject *> refs);
 
+		/*! \brief Stores a validation info in the provided buffer if it describes an actual problem (the same rule of generateValidationInfo()).
+		 * This method is used by the validation tasks, which can't touch the helper's counters or emit the infos directly */
+		static void appendValidationInfo(std::vector<ValidationInfo> &infos, unsigned val_type, BaseObject *object, const std::vector<BaseObject *> &refs);
+
+		/*! \brief Runs the check function over the provided objects using a thread pool. The objects are split in contiguous chunks
+		 * and each chunk is handled by a task that stores the check results in its own buffer. When all tasks finish the buffers
+		 * are appended to results in the chunk order, so the results are the same (and in the same order) of a serial validation.
+		 * The check function must not change the model since several checks run at the same time. The phase is timed
+		 * by the progress reporter and the progress is updated from start_prog to end_prog while the tasks run */
+		template<class Result>
+		void runValidationPhase(const QString &phase_name, const std::vector<BaseObject *> &objects, int start_prog, int end_prog,
+														const std::function<void(BaseObject *, std::vector<Result> &)> &check, std::vector<Result> &results);
+
+		/*! \brief Checks if the object references other objects created after it (broken references) and, for tables, views and
+		 * generic SQL objects, if they reference columns of relationships created after them (special objects broken references) */
+		void validateReferences(BaseObject *object, std::vector<ValidationInfo> &infos);
+
+		/*! \brief Gathers the objects of a table or view that must have unique names (indexes, primary keys, unique keys and exclude
+		 * constraints) as pairs of [schema].[name] and object */
+		static void getUniqueNameObjects(BaseObject *object, std::vector<std::pair<QString, BaseObject *>> &objects);
+
+		//! \brief Checks if the table's columns use PostGiS data types
+		static void validatePostGiSColumns(BaseObject *object, std::vector<ValidationInfo> &infos);
+
+		//! \brief Coalesces the progress signals and records the timings of the validation phases
+		ProgressReporter progress_rep;
+
 	public:
 		ModelValidationHelper();
 		virtual ~ModelValidationHelper();
 
 		/*! \brief Validates the specified model. If a connection is specifies executes the
-		SQL validation directly on DBMS */
-		void setValidationParams(DatabaseModel *model, Connection *conn=nullptr, const QString &pgsql_ver="", bool use_tmp_names=false);
+		SQL validation directly on DBMS. When conn_count is greater than 1 the SQL validation
+		creates the independent objects concurrently using that amount of connections to the server */
+		void setValidationParams(DatabaseModel *model, Connection *conn=nullptr, const QString &pgsql_ver="", bool use_tmp_names=false, unsigned conn_count=1);
 
 		//! \brief Switch the validator to fix mode
 		void switchToFixMode(bool value);
@@ -97,6 +128,9 @@ class ModelValidationHelper: public QObject {
 
 		bool isValidationCanceled();
 
+		//! \brief Returns the reporter that coalesces the progress signals and records the timings of the validation phases
+		ProgressReporter &getProgressReporter();
+
 	private slots:
 		void redirectExportProgress(int prog, QString msg, ObjectType obj_type, QString cmd, bool is_code_gen);
 		void captureThreadError(Exception e);
@@ -35,6 +35,7 @@ ModelValidationWidget::ModelValidationWidget(QWidget *parent): QWidget(parent)
 
 		version_cmb->addItem(tr("Autodetect"));
 		version_cmb->addItems(PgSqlVersions::AllVersions);
+		sql_conns_sb->setMaximum(ModelExportHelper::MaxValidationConnections);
 
 		options_frm->setVisible(false);
 		curr_step=0;
@@ -48,6 +49,7 @@ ModelValidationWidget::ModelValidationWidget(QWidget *parent): QWidget(parent)
 		connect(sql_validation_chk, SIGNAL(toggled(bool)), connections_cmb, SLOT(setEnabled(bool)));
 		connect(sql_validation_chk, SIGNAL(toggled(bool)), version_cmb, SLOT(setEnabled(bool)));
 		connect(sql_validation_chk, SIGNAL(toggled(bool)), use_tmp_names_chk, SLOT(setEnabled(bool)));
+		connect(sql_validation_chk, SIGNAL(toggled(bool)), sql_conns_sb, SLOT(setEnabled(bool)));
 		connect(validate_btn, SIGNAL(clicked()), this, SLOT(validateModel()));
 		connect(fix_btn, SIGNAL(clicked()), this, SLOT(applyFixes()));
 		connect(cancel_btn, SIGNAL(clicked()), this, SLOT(cancelValidation()));
@@ -74,6 +76,10 @@ ModelValidationWidget::ModelValidationWidget(QWidget *parent): QWidget(parent)
 			clearOutput();
 		});
 
+		connect(sql_conns_sb, &QSpinBox::valueChanged, [&](){
+			configureValidation();
+		});
+
 		ConnectionsConfigWidget::fillConnectionsComboBox(connections_cmb, true);
 	}
 	catch(Exception &e)
@@ -559,7 +565,7 @@ void ModelValidationWidget::configureValidation()
 			ver=(version_cmb->currentIndex() > 0 ? version_cmb->currentText() : "");
 		}
 
-		validation_helper->setValidationParams(model_wgt->getDatabaseModel(), conn, ver, use_tmp_names_chk->isChecked());
+		validation_helper->setValidationParams(model_wgt->getDatabaseModel(), conn, ver, use_tmp_names_chk->isChecked(), sql_conns_sb->value());
 	}
 }
 
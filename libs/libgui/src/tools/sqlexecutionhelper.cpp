@@ -17,6 +17,8 @@
 */
 
 #include "sqlexecutionhelper.h"
+#include <QSaveFile>
+#include <QRegularExpression>
 
 SQLExecutionHelper::SQLExecutionHelper() : QObject(nullptr)
 {
@@ -34,6 +36,125 @@ void SQLExecutionHelper::setCommand(const QString &cmd)
 	command = cmd;
 }
 
+void SQLExecutionHelper::setExportFile(const QString &filename)
+{
+	export_file = filename;
+}
+
+QString SQLExecutionHelper::getCopyToCommand(const QString &query)
+{
+	static const QRegularExpression dollar_tag_regexp("\\$([A-Za-z_][A-Za-z0-9_]*)?\\$");
+	QRegularExpressionMatch match;
+	QString quote;
+	QChar chr, next_chr, prev_chr;
+	int pos = 0, len = query.size(), stmt_end = -1, nest_lvl = 0;
+	bool stmt_finished = false;
+
+	/* Scanning the query to find the end of the statement (the last char that isn't a semicolon, a comment or a space)
+	 * skipping the contents of quoted strings/identifiers, dollar quoted strings and comments. Since the query is
+	 * used as a subquery, everything after the statement end is discarded and any statement after a semicolon is rejected */
+	while(pos < len)
+	{
+		chr = query[pos];
+		next_chr = pos + 1 < len ? query[pos + 1] : QChar();
+
+		if(chr.isSpace())
+		{
+			pos++;
+			continue;
+		}
+
+		if(chr == QChar('-') && next_chr == QChar('-'))
+		{
+			while(pos < len && query[pos] != QChar('\n'))
+				pos++;
+
+			continue;
+		}
+
+		// Block comments can be nested in PostgreSQL
+		if(chr == QChar('/') && next_chr == QChar('*'))
+		{
+			nest_lvl = 0;
+
+			do
+			{
+				if(query.mid(pos, 2) == QString("/*"))
+				{
+					nest_lvl++;
+					pos += 2;
+				}
+				else if(query.mid(pos, 2) == QString("*/"))
+				{
+					nest_lvl--;
+					pos += 2;
+				}
+				else
+					pos++;
+			}
+			while(pos < len && nest_lvl > 0);
+
+			continue;
+		}
+
+		if(chr == QChar(';'))
+		{
+			stmt_finished = true;
+			pos++;
+			continue;
+		}
+
+		if(stmt_finished)
+			throw Exception(ErrorCode::MultipleStatementsExportQuery, __PRETTY_FUNCTION__, __FILE__, __LINE__);
+
+		prev_chr = pos > 0 ? query[pos - 1] : QChar();
+		match = QRegularExpressionMatch();
+
+		if(chr == QChar('$'))
+			match = dollar_tag_regexp.match(query, pos, QRegularExpression::NormalMatch, QRegularExpression::AnchorAtOffsetMatchOption);
+
+		if(chr == QChar('\'') || chr == QChar('"'))
+		{
+			// Escaped strings (E'') accept backslash escapes, including the ones for the quote char
+			bool esc_string = chr == QChar('\'') && (prev_chr == QChar('E') || prev_chr == QChar('e'));
+
+			for(pos++; pos < len; pos++)
+			{
+				if(esc_string && query[pos] == QChar('\\'))
+					pos++;
+				else if(query[pos] == chr)
+				{
+					// Doubled quotes are part of the quoted text
+					if(pos + 1 < len && query[pos + 1] == chr)
+						pos++;
+					else
+						break;
+				}
+			}
+
+			stmt_end = std::min(pos, len - 1);
+			pos++;
+			continue;
+		}
+
+		// A dollar sign after an identifier char is part of that identifier (e.g. a$b) instead of a dollar quote
+		if(match.hasMatch() && !prev_chr.isLetterOrNumber() && prev_chr != QChar('_'))
+		{
+			quote = match.captured();
+			pos = query.indexOf(quote, pos + quote.size());
+			pos = pos < 0 ? len : pos + quote.size();
+			stmt_end = pos - 1;
+			continue;
+		}
+
+		stmt_end = pos;
+		pos++;
+	}
+
+	return QString("COPY (%1\n) TO STDOUT WITH (FORMAT csv, HEADER true, DELIMITER ';', FORCE_QUOTE *)")
+			.arg(query.left(stmt_end + 1).trimmed());
+}
+
 ResultSetModel *SQLExecutionHelper::getResultSetModel()
 {
 	return result_model;
@@ -70,6 +191,12 @@ void SQLExecutionHelper::executeCommand()
 			connection.setSQLExecutionTimout(3600);
 		}
 
+		if(!export_file.isEmpty())
+		{
+			exportCommandResults();
+			return;
+		}
+
 		connection.executeDMLCommand(command, res);
 		notices = connection.getNotices();
 
@@ -85,6 +212,43 @@ void SQLExecutionHelper::executeCommand()
 	}
 }
 
+void SQLExecutionHelper::exportCommandResults()
+{
+	QSaveFile output(export_file);
+	unsigned rows = 0;
+	qint64 written = 0;
+
+	/* Using a QSaveFile so the destination file is only replaced when the whole data
+	 * is written, this way cancelled or failed exports don't leave partial files behind */
+	if(!output.open(QFile::WriteOnly | QFile::Truncate))
+	{
+		throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(export_file),
+										ErrorCode::FileDirectoryNotWritten, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr,
+										output.errorString());
+	}
+
+	progress_rep.reset();
+	rows = connection.executeCopyToCommand(getCopyToCommand(command), output,
+																				 [this, &written](qint64 bytes){
+		written = bytes;
+
+		if(progress_rep.isReportDue(0))
+			emit s_exportProgressUpdated(bytes);
+	});
+
+	notices = connection.getNotices();
+
+	if(!output.commit())
+	{
+		throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(export_file),
+										ErrorCode::FileDirectoryNotWritten, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr,
+										output.errorString());
+	}
+
+	emit s_exportProgressUpdated(written);
+	emit s_executionFinished(rows);
+}
+
 void SQLExecutionHelper::cancelCommand()
 {
 	if(connection.isStablished())
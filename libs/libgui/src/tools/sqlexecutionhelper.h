@@ -29,6 +29,7 @@
 #include <QTableWidget>
 #include "connection.h"
 #include "utils/resultsetmodel.h"
+#include "progressreporter.h"
 
 class SQLExecutionHelper : public QObject {
 	private:
@@ -46,6 +47,15 @@ class SQLExecutionHelper : public QObject {
 
 		QStringList notices;
 
+		//! \brief The file in which the results of the command are written when running in export mode
+		QString export_file;
+
+		//! \brief Coalesces the export progress updates
+		ProgressReporter progress_rep;
+
+		//! \brief Runs the command wrapped in a COPY ... TO STDOUT streaming the results to the export file
+		void exportCommandResults();
+
 	public:
 		SQLExecutionHelper();
 
@@ -53,6 +63,16 @@ class SQLExecutionHelper : public QObject {
 
 		void setCommand(const QString &cmd);
 
+		/*! \brief Configures the helper to write the results of the next executions in the provided file
+		 * (as CSV) instead of creating a result set model. Using an empty file name disables the export mode */
+		void setExportFile(const QString &filename);
+
+		/*! \brief Returns the COPY command that sends the results of the query to the client in the same
+		 * CSV format used by the results grid (semicolon separated values with the column names in the first line).
+		 * The trailing semicolons and comments of the query are removed. This method raises an error if the query
+		 * has more than one statement since only a single one can be used in the COPY command */
+		static QString getCopyToCommand(const QString &query);
+
 		//! \brief Returns the result set model created in the execution. This object is not deleted after the execution.
 		ResultSetModel *getResultSetModel();
 
@@ -68,6 +88,9 @@ class SQLExecutionHelper : public QObject {
 	signals:
 		void s_executionFinished(int rows_affected);
 		void s_executionAborted(Exception e);
+
+		//! \brief This signal is emitted periodically in export mode with the amount of bytes written to the file
+		void s_exportProgressUpdated(qint64 bytes);
 };
 
 #endif
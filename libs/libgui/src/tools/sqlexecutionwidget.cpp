@@ -24,6 +24,7 @@
 #include "utils/plaintextitemdelegate.h"
 #include "datamanipulationform.h"
 #include "utilsns.h"
+#include <QEventLoop>
 
 std::map<QString, QString> SQLExecutionWidget::cmd_history;
 
@@ -94,6 +95,17 @@ SQLExecutionWidget::SQLExecutionWidget(QWidget * parent) : QWidget(parent)
 	file_menu.addAction(action_save_as);
 	file_tb->setMenu(&file_menu);
 
+	action_export_results=export_menu.addAction(QIcon(GuiUtilsNs::getIconPath("exportdata")), tr("Export results"));
+	action_export_results->setToolTip(tr("Export the results in the grid to a CSV file"));
+	action_export_results->setEnabled(false);
+
+	action_export_query=export_menu.addAction(QIcon(GuiUtilsNs::getIconPath("sqlcode")), tr("Export query to file"));
+	action_export_query->setToolTip(tr("Run the command again streaming all of its results to a CSV file"));
+
+	export_menu.setToolTipsVisible(true);
+	export_tb->setMenu(&export_menu);
+	export_tb->setPopupMode(QToolButton::InstantPopup);
+
 	filter_wgt->setVisible(false);
 
 	connect(columns_cmb, SIGNAL(currentIndexChanged(int)), this, SLOT(filterResults()));
@@ -137,9 +149,12 @@ SQLExecutionWidget::SQLExecutionWidget(QWidget * parent) : QWidget(parent)
 	connect(results_tbw, &QTableView::pressed,
 			[&](){ SQLExecutionWidget::copySelection(results_tbw); });
 
-	connect(export_tb, &QToolButton::clicked,
+	connect(action_export_results, &QAction::triggered,
 			[&](){ SQLExecutionWidget::exportResults(results_tbw); });
 
+	connect(action_export_query, &QAction::triggered,
+			[&](){ SQLExecutionWidget::exportQueryResults(sql_cmd_conn.getConnectionParams(), getCurrentCommand()); });
+
 	connect(close_file_tb, &QToolButton::clicked,
 	[&](){
 			if(clearAll() == QDialog::Accepted)
@@ -228,6 +243,7 @@ void SQLExecutionWidget::enableCommandButtons()
 	run_sql_tb->setEnabled(!sql_cmd_txt->toPlainText().isEmpty());
 	find_tb->setEnabled(!sql_cmd_txt->toPlainText().isEmpty());
 	clear_btn->setEnabled(run_sql_tb->isEnabled());
+	export_tb->setEnabled(run_sql_tb->isEnabled() || action_export_results->isEnabled());
 }
 
 void SQLExecutionWidget::showEvent(QShowEvent *)
@@ -378,7 +394,7 @@ void SQLExecutionWidget::handleExecutionAborted(Exception e)
 
 	msgoutput_lst->setVisible(true);
 	results_parent->setVisible(false);
-	export_tb->setEnabled(false);
+	action_export_results->setEnabled(false);
 	filter_tb->setEnabled(false);
 	filter_tb->setChecked(false);
 
@@ -430,7 +446,7 @@ void SQLExecutionWidget::finishExecution(int rows_affected)
 		empty = (!res_model || res_model->rowCount() == 0);
 		output_tbw->setTabEnabled(0, !empty);
 		results_parent->setVisible(!empty);
-		export_tb->setEnabled(!empty);
+		action_export_results->setEnabled(!empty);
 		filter_tb->setEnabled(!empty);
 
 		if(!empty)
@@ -604,17 +620,23 @@ void SQLExecutionWidget::destroyResultModel()
 	}
 }
 
-void SQLExecutionWidget::runSQLCommand()
+QString SQLExecutionWidget::getCurrentCommand()
 {
 	QString cmd=sql_cmd_txt->textCursor().selectedText();
 
-	output_tb->setChecked(true);
-
 	if(cmd.isEmpty())
 		cmd=sql_cmd_txt->toPlainText();
 	else
 		cmd.replace(QChar::ParagraphSeparator, '\n');
 
+	return cmd;
+}
+
+void SQLExecutionWidget::runSQLCommand()
+{
+	QString cmd=getCurrentCommand();
+
+	output_tb->setChecked(true);
 	msgoutput_lst->clear();
 	sql_exec_hlp.setCommand(cmd);
 	start_exec=QDateTime::currentDateTime().toMSecsSinceEpoch();
@@ -711,6 +733,89 @@ void SQLExecutionWidget::exportResults(QTableView *results_tbw)
 	}
 }
 
+void SQLExecutionWidget::exportQueryResults(const attribs_map &conn_params, const QString &query)
+{
+	QFileDialog csv_file_dlg;
+
+	csv_file_dlg.setDefaultSuffix(QString("csv"));
+	csv_file_dlg.setFileMode(QFileDialog::AnyFile);
+	csv_file_dlg.setWindowTitle(tr("Export query to file"));
+	csv_file_dlg.setNameFilter(tr("Comma-separated values file (*.csv);;All files (*.*)"));
+	csv_file_dlg.setModal(true);
+	csv_file_dlg.setAcceptMode(QFileDialog::AcceptSave);
+
+	GuiUtilsNs::restoreFileDialogState(&csv_file_dlg);
+	csv_file_dlg.exec();
+	GuiUtilsNs::saveFileDialogState(&csv_file_dlg);
+
+	if(csv_file_dlg.result()!=QDialog::Accepted)
+		return;
+
+	QThread export_thread;
+	SQLExecutionHelper export_hlp;
+	TaskProgressWidget task_prog_wgt;
+	QEventLoop event_loop;
+	QString filename = csv_file_dlg.selectedFiles().at(0);
+	Messagebox msg_box;
+	Exception error;
+	bool failed = false;
+	unsigned exported_rows = 0;
+	qint64 start_time = QDateTime::currentMSecsSinceEpoch(), total_time = 0;
+
+	export_hlp.setConnection(Connection(conn_params));
+	export_hlp.setCommand(query);
+	export_hlp.setExportFile(filename);
+	export_hlp.moveToThread(&export_thread);
+
+	connect(&export_thread, SIGNAL(started()), &export_hlp, SLOT(executeCommand()));
+
+	connect(&export_hlp, &SQLExecutionHelper::s_exportProgressUpdated, &task_prog_wgt, [&task_prog_wgt](qint64 bytes){
+		task_prog_wgt.updateProgress(0, tr("Exporting query results: <strong>%1</strong> written...")
+																 .arg(QLocale().formattedDataSize(bytes)), enum_cast(ObjectType::Table));
+	});
+
+	connect(&export_hlp, &SQLExecutionHelper::s_executionFinished, &event_loop, [&](int rows){
+		exported_rows = rows;
+		event_loop.quit();
+	});
+
+	connect(&export_hlp, &SQLExecutionHelper::s_executionAborted, &event_loop, [&](Exception e){
+		error = e;
+		failed = true;
+		event_loop.quit();
+	});
+
+	// Closing the progress dialog requests the server to cancel the running COPY
+	connect(&task_prog_wgt, SIGNAL(rejected()), &export_hlp, SLOT(cancelCommand()), Qt::DirectConnection);
+
+	// The amount of data to be exported is unknown so the progress bar is used as a busy indicator
+	task_prog_wgt.progress_pb->setRange(0, 0);
+	task_prog_wgt.setWindowTitle(tr("Exporting query results..."));
+	task_prog_wgt.show();
+
+	export_thread.start();
+	event_loop.exec();
+	export_thread.quit();
+	export_thread.wait();
+	task_prog_wgt.close();
+
+	total_time = QDateTime::currentMSecsSinceEpoch() - start_time;
+
+	if(export_hlp.isCancelled())
+		return;
+
+	if(failed)
+	{
+		msg_box.show(error);
+		return;
+	}
+
+	msg_box.show(tr("The query results were successfully exported to <strong>%1</strong> in <em>%2</em>! Rows exported: <strong>%3</strong>.")
+							 .arg(filename)
+							 .arg(total_time >= 1000 ? QString("%1 s").arg(total_time/1000.0) : QString("%1 ms").arg(total_time))
+							 .arg(exported_rows), Messagebox::InfoIcon);
+}
+
 int SQLExecutionWidget::clearAll()
 {
 	Messagebox msg_box;
@@ -727,6 +832,7 @@ int SQLExecutionWidget::clearAll()
 		msgoutput_lst->clear();
 		msgoutput_lst->setVisible(true);
 		results_parent->setVisible(false);
+		action_export_results->setEnabled(false);
 		export_tb->setEnabled(false);
 	}
 
@@ -66,9 +66,13 @@ class SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget {
 
 		QMenu snippets_menu,
 
-		file_menu;
+		file_menu,
 
-		QAction *action_save, *action_save_as, *action_load;
+		export_menu;
+
+		QAction *action_save, *action_save_as, *action_load,
+
+		*action_export_results, *action_export_query;
 
 		FindReplaceWidget *find_replace_wgt;
 
@@ -89,6 +93,9 @@ class SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget {
 
 		void destroyResultModel();
 
+		//! \brief Returns the selected SQL command or the whole input field contents if there's no selection
+		QString getCurrentCommand();
+
 	protected:
 		//! \brief Widget that serves as SQL commands input
 		NumberedTextEditor *sql_cmd_txt,
@@ -130,6 +137,12 @@ class SQLExecutionWidget: public QWidget, public Ui::SQLExecutionWidget {
 		//! \brief Exports the results to csv file
 		static void exportResults(QTableView *results_tbw);
 
+		/*! \brief Exports the results of the query to a csv file selected by the user. Differently from exportResults(), the query
+		 * is executed again (in a separated thread) and its results are streamed straight to the file via COPY ... TO STDOUT
+		 * without being loaded in a results grid, so large result sets can be exported. The user can cancel the export
+		 * by closing the progress dialog. */
+		static void exportQueryResults(const attribs_map &conn_params, const QString &query);
+
 		//! \brief Save the history of all connections open in the SQL Execution to the sql-history.conf
 		static void saveSQLHistory();
 
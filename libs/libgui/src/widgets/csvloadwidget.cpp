@@ -19,8 +19,6 @@
 #include "csvloadwidget.h"
 #include <QFileDialog>
 #include "exception.h"
-#include <QTextStream>
-#include "utilsns.h"
 
 CsvLoadWidget::CsvLoadWidget(QWidget * parent, bool cols_in_first_row) : QWidget(parent)
 {
@@ -30,6 +28,8 @@ CsvLoadWidget::CsvLoadWidget(QWidget * parent, bool cols_in_first_row) : QWidget
 	file_sel->setFileMode(QFileDialog::ExistingFile);
 	file_sel->setFileDialogTitle(tr("Load CSV file"));
 	file_sel->setMimeTypeFilters({"text/csv", "application/octet-stream"});
+	max_loaded_rows = 0;
+	has_unloaded_rows = false;
 	load_csv_grid->addWidget(file_sel, 0, 1, 1, 8);
 
 	separator_edt->setVisible(false);
@@ -62,98 +62,54 @@ QList<QStringList> CsvLoadWidget::getCsvRows()
 
 QList<QStringList> CsvLoadWidget::loadCsvFromBuffer(const QString &csv_buffer, const QString &separator, const QString &text_delim, bool cols_in_first_row, QStringList &csv_cols)
 {
-	QList<QStringList> csv_rows;
+	CsvReader reader;
 
-	if(!csv_buffer.isEmpty())
-	{
-		QString	double_quote=QString("%1%1").arg(text_delim),
-				placeholder = QString(QChar::ReplacementCharacter),
-				escaped_delim = QString("\u2020"), //Unicode char to be used as a placeholder for escaped text delimiter, e.g., \"
-				escaped_sep = QString("\u2052"),  //Unicode char to be used as a placeholder for escaped value separator, e.g., \;
-				aux_buffer = csv_buffer,
-				win_line_break = QString("%1%2").arg(QChar(QChar::CarriageReturn)).arg(QChar(QChar::LineFeed)),
-				mac_line_break = QString("%1").arg(QChar(QChar::CarriageReturn));
-		QStringList values, rows;
-		QRegularExpression empty_val;
-
-		if(aux_buffer.contains(win_line_break))
-			aux_buffer.replace(win_line_break, QString(QChar::LineFeed));
-		else if(aux_buffer.contains(mac_line_break))
-			aux_buffer.replace(mac_line_break, QString(QChar::LineFeed));
-
-		/* In order to avoid wrong replacement of escapade both text delimiter and value separator
-		 * we replace them by their respective placeholders in order to revert them back to their
-		 * original representation on the final (formated) string */
-		aux_buffer.replace(QString("\\%1").arg(text_delim), escaped_delim);
-		aux_buffer.replace(QString("\\%1").arg(separator), escaped_sep);
-
-		if(cols_in_first_row)
-		{
-			int lf_idx = aux_buffer.indexOf(QChar::LineFeed);
-
-			if(lf_idx < 0)
-				lf_idx = aux_buffer.size();
-
-			csv_cols=aux_buffer.mid(0, lf_idx).split(separator);
-			csv_cols.replaceInStrings(text_delim, "");
-
-			//Replace the escaped separator and delimiter by their original form in the col names
-			csv_cols.replaceInStrings(escaped_sep, separator);
-			csv_cols.replaceInStrings(escaped_delim, text_delim);
-
-			aux_buffer.replace(0, lf_idx + 1, "");
-		}
-
-		aux_buffer.replace(QString("%1%2").arg(QChar(QChar::LineFeed)).arg(text_delim), placeholder);
-		rows = aux_buffer.split(placeholder, Qt::SkipEmptyParts);
-
-		//Configuring an regexp to remove empty quoted values, e.g, "",
-		if(!text_delim.isEmpty())
-			empty_val = QRegularExpression(QString("(\\%1\\%1)(\\%2)").arg(text_delim).arg(separator));
-
-		for(QString row : rows)
-		{
-			if(!empty_val.pattern().isEmpty())
-				row.replace(empty_val, separator);
-
-			/* In order to preserve double quotes (double delimiters) inside the values,
-			 * we first replace them by a placeholder, erase the delimiters and restore the previous value */
-			row.replace(double_quote, placeholder);
-			row.replace(text_delim, "");
-			row.replace(placeholder, double_quote);
-
-			values = row.split(separator);
-
-			for(int i =0; i < values.count(); i++)
-			{
-				//Replace the escaped separator and delimiter by their original form in the final value
-				values[i].replace(escaped_sep, separator);
-				values[i].replace(escaped_delim, text_delim);
-
-				values[i] = values[i].trimmed();
-			}
-
-			csv_rows.append(values);
-		}
-	}
+	if(csv_buffer.isEmpty())
+		return QList<QStringList>();
 
-	return csv_rows;
+	configureCsvReader(reader, separator, text_delim, cols_in_first_row);
+	reader.setBuffer(csv_buffer);
+
+	if(cols_in_first_row)
+		csv_cols = reader.getColumns();
+
+	return reader.readRows();
+}
+
+void CsvLoadWidget::configureCsvReader(CsvReader &reader, const QString &separator, const QString &text_delim, bool cols_in_first_row)
+{
+	reader.setFormat(separator.isEmpty() ? QChar(';') : separator.at(0),
+									 text_delim.isEmpty() ? QChar() : text_delim.at(0),
+									 cols_in_first_row);
+}
+
+void CsvLoadWidget::configureCsvReader(CsvReader &reader)
+{
+	configureCsvReader(reader, getSeparator(),
+										 txt_delim_chk->isChecked() ? txt_delim_edt->text() : "",
+										 col_names_chk->isChecked());
+
+	if(!csv_file.isEmpty())
+		reader.setFile(csv_file);
 }
 
 void CsvLoadWidget::loadCsvFile()
 {
-	QString csv_buffer;
+	CsvReader reader;
 
-	csv_buffer.append(UtilsNs::loadFile(file_sel->getSelectedFile()));
 	csv_columns.clear();
 	csv_rows.clear();
+	csv_file = file_sel->getSelectedFile();
 
-	if(!csv_buffer.isEmpty())
-	{
-		csv_rows = loadCsvFromBuffer(csv_buffer, getSeparator(),
-																 txt_delim_chk->isChecked() ? txt_delim_edt->text() : "",
-																 col_names_chk->isChecked(), csv_columns);
-	}
+	/* The file is parsed in chunks and only the rows to be used by the consumer are kept in memory,
+	 * so files bigger than the amount of rows to be loaded don't need to be entirely read here */
+	configureCsvReader(reader);
+
+	if(col_names_chk->isChecked())
+		csv_columns = reader.getColumns();
+
+	csv_rows = reader.readRows(max_loaded_rows);
+	has_unloaded_rows = max_loaded_rows > 0 && !reader.atEnd();
 
 	file_sel->clearSelector();
 	emit s_csvFileLoaded();
@@ -187,6 +143,16 @@ QString CsvLoadWidget::getCsvBuffer(QString separator, QString line_break)
 	return buffer;
 }
 
+void CsvLoadWidget::setMaxLoadedRows(int max_rows)
+{
+	max_loaded_rows = (max_rows < 0 ? 0 : max_rows);
+}
+
+bool CsvLoadWidget::hasUnloadedRows()
+{
+	return has_unloaded_rows;
+}
+
 bool CsvLoadWidget::isColumnsInFirstRow()
 {
 	return col_names_chk->isChecked();
@@ -196,6 +162,8 @@ void CsvLoadWidget::loadCsvBuffer(const QString csv_buffer, const QString &separ
 {
 	csv_columns.clear();
 	csv_rows.clear();
+	csv_file.clear();
+	has_unloaded_rows = false;
 	csv_rows = loadCsvFromBuffer(csv_buffer, separator, text_delim, cols_in_first_row, csv_columns);
 }
 
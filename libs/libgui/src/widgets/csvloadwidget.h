@@ -27,6 +27,7 @@
 
 #include "ui_csvloadwidget.h"
 #include "fileselectorwidget.h"
+#include "csvreader.h"
 
 class CsvLoadWidget : public QWidget, Ui::CsvLoadWidget {
 	private:
@@ -38,6 +39,15 @@ class CsvLoadWidget : public QWidget, Ui::CsvLoadWidget {
 		//! \brief Holds the rows extracted from the csv file
 		QList<QStringList> csv_rows;
 
+		//! \brief The last csv file loaded
+		QString csv_file;
+
+		//! \brief The maximum amount of rows loaded from the file (0 means all rows)
+		int max_loaded_rows;
+
+		//! \brief Indicates that the last loaded file has more rows than the ones in csv_rows
+		bool has_unloaded_rows;
+
 		FileSelectorWidget *file_sel;
 
 	public:
@@ -63,10 +73,24 @@ class CsvLoadWidget : public QWidget, Ui::CsvLoadWidget {
 
 		QString getSeparator();
 
+		/*! \brief Limits the amount of rows loaded in memory when the user loads a csv file. The remaining rows can
+		 * be read in batches by the consumer through a reader configured via configureCsvReader() */
+		void setMaxLoadedRows(int max_rows);
+
+		//! \brief Returns if the last loaded file has more rows than the ones returned by getCsvRows()
+		bool hasUnloadedRows();
+
+		/*! \brief Configures the reader to parse the last loaded file using the options in the widget.
+		 * This way, the consumers can stream all the rows of the file without loading them at once */
+		void configureCsvReader(CsvReader &reader);
+
 		/*! \brief Loads a csv document from a buffer. The user can specify the value separator, text delimiter and an object which will store the column names.
 		 *  In that case, the column names are only extracted from the first row if the cols_in_first_row is true */
 		static QList<QStringList> loadCsvFromBuffer(const QString &csv_buffer, const QString &separator, const QString &text_delim, bool cols_in_first_row, QStringList &csv_cols);
 
+		//! \brief Configures the format of the reader using the provided separator and text delimiter (only their first chars are used)
+		static void configureCsvReader(CsvReader &reader, const QString &separator, const QString &text_delim, bool cols_in_first_row);
+
 	private slots:
 		void loadCsvFile();
 
@@ -218,6 +218,9 @@ ModelWidget::ModelWidget(QWidget *parent) : QWidget(parent)
 	zoom_info_lbl->setVisible(false);
 	zoom_info_timer.setInterval(3000);
 
+	pending_geom_timer.setInterval(50);
+	pending_geom_timer.setSingleShot(true);
+
 	action_edit_data=new QAction(QIcon(GuiUtilsNs::getIconPath("editdata")), tr("Edit data"), this);
 
 	action_source_code=new QAction(QIcon(GuiUtilsNs::getIconPath("sourcecode")), tr("Source"), this);
@@ -520,6 +523,7 @@ ModelWidget::ModelWidget(QWidget *parent) : QWidget(parent)
 
 	connect(action_edit_data, SIGNAL(triggered(bool)), this, SLOT(editTableData()));
 	connect(&zoom_info_timer, SIGNAL(timeout()), zoom_info_lbl, SLOT(hide()));
+	connect(&pending_geom_timer, SIGNAL(timeout()), this, SLOT(updatePendingGeometries()));
 	connect(action_source_code, SIGNAL(triggered(bool)), this, SLOT(showSourceCode()));
 	connect(action_edit, SIGNAL(triggered(bool)),this,SLOT(editObject()));
 	connect(action_protect, SIGNAL(triggered(bool)),this,SLOT(protectObject()));
@@ -588,6 +592,11 @@ ModelWidget::ModelWidget(QWidget *parent) : QWidget(parent)
 	viewport->installEventFilter(this);
 	viewport->horizontalScrollBar()->installEventFilter(this);
 	viewport->verticalScrollBar()->installEventFilter(this);
+
+	/* Any change in the visible area of the canvas (scrolling, zooming, resizing)
+	 * may expose objects with pending geometry so we schedule their configuration */
+	connect(viewport->horizontalScrollBar(), SIGNAL(valueChanged(int)), &pending_geom_timer, SLOT(start()));
+	connect(viewport->verticalScrollBar(), SIGNAL(valueChanged(int)), &pending_geom_timer, SLOT(start()));
 }
 
 ModelWidget::~ModelWidget()
@@ -643,6 +652,7 @@ void ModelWidget::resizeEvent(QResizeEvent *)
 													 viewport->height() - magnifier_area_lbl->height());
 
 	adjustOverlayPosition();
+	pending_geom_timer.start();
 
 	emit s_modelResized();
 }
@@ -873,6 +883,10 @@ void ModelWidget::applyZoom(double zoom)
 	zoom_info_lbl->setVisible(true);
 	zoom_info_timer.start();
 
+	/* Zooming out may expose objects with pending geometry without changing
+	 * the scrollbars' values, so they need to be checked here as well */
+	pending_geom_timer.start();
+
 	emit s_zoomModified(zoom);
 }
 
@@ -923,10 +937,35 @@ void ModelWidget::handleObjectAddition(BaseObject *object)
 		{
 			scene->addItem(item);
 			setModified(true);
+
+			if(BaseTableView::isLazyRendering())
+			{
+				BaseTableView *tab_view = dynamic_cast<BaseTableView *>(item);
+
+				/* Objects created outside the model loading are configured immediately since they are usually
+				 * placed in the visible area of the canvas. Otherwise, the exposed objects are configured
+				 * only after the loading process ends */
+				if(tab_view && !db_model->isLoadingModel())
+					tab_view->configurePendingGeometry();
+				else
+					pending_geom_timer.start();
+			}
 		}
 	}
 }
 
+void ModelWidget::updatePendingGeometries()
+{
+	// While the model is being loaded we just postpone the configuration again
+	if(db_model->isLoadingModel())
+	{
+		pending_geom_timer.start();
+		return;
+	}
+
+	scene->configurePendingGeometries(viewport->mapToScene(viewport->viewport()->rect()).boundingRect());
+}
+
 void ModelWidget::addNewObject()
 {
 	QAction *action=dynamic_cast<QAction *>(sender());
@@ -1741,6 +1780,8 @@ void ModelWidget::printModel(QPrinter *printer, bool print_grid, bool print_page
 	//Reconfigure the grid options based upon the passed settings
 	ObjectsScene::setGridOptions(print_grid, align_objs, false);
 
+	//Objects outside the visible area could still have their geometry pending so we configure them before printing
+	scene->configurePendingGeometries();
 	scene->update();
 	scene->clearSelection();
 
@@ -169,7 +169,11 @@ class ModelWidget: public QWidget {
 		QFrame	*magnifier_frm;
 
 		//! \brief This timer controls the interval the zoom label is visible
-		QTimer zoom_info_timer;
+		QTimer zoom_info_timer,
+
+		/*! \brief This timer controls the configuration of the objects which had their geometry postponed
+		 * by the lazy rendering when they get exposed in the viewport (see updatePendingGeometries()) */
+		pending_geom_timer;
 
 		//! \brief Opens a editing form for objects at database level
 		template<class Class, class WidgetClass>
@@ -423,6 +427,10 @@ class ModelWidget: public QWidget {
 		//! \brief Handles the signals that indicates the object creation on the reference database model
 		void handleObjectAddition(BaseObject *object);
 
+		/*! \brief Configures the full geometry of the tables/views that are exposed in the viewport
+		 * and had their configuration postponed by the lazy rendering */
+		void updatePendingGeometries();
+
 		//! \brief Handles the signals that indicates the object removal on the reference database model
 		void handleObjectRemoval(BaseObject *object);
 
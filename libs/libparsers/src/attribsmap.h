@@ -20,13 +20,572 @@
 \ingroup libparsers
 \typedef attribs_map
 \brief This typedef is used to replace maps with the signature std::map<QString,QString> commonly used
-to store objects attributes and used by SchemaParser, XMLParser and several other classes
+to store objects attributes and used by SchemaParser, XMLParser and several other classes.
+
+The underlying container (FlatMap) keeps the same interface and ordering of std::map but stores the entries
+in a few contiguous blocks indexed by sorted chunks of pointers, avoiding one heap allocation per attribute and the
+pointer chasing of the red-black tree on lookups.
 */
 
 #ifndef ATTRIBSMAP_H
 #define ATTRIBSMAP_H
 
-#include <map>
 #include <QString>
-using attribs_map = std::map<QString, QString>;
+#include <vector>
+#include <algorithm>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <initializer_list>
+
+/*! \brief Compares two attribute keys returning a negative, zero or positive value like QString::compare().
+ * The keys are mostly copies of the constants in the Attributes namespace which, being implicitly shared,
+ * point to the same storage. In that case the keys are considered equal without comparing their characters */
+struct AttribsKeyCompare {
+	int operator()(const QString &key1, const QString &key2) const
+	{
+		if(key1.size() == key2.size() && key1.constData() == key2.constData())
+			return 0;
+
+		return QString::compare(key1, key2);
+	}
+};
+
+/*! \brief Associative container with the same interface and iteration order of std::map.
+ * The entries are stored in blocks that are never reallocated so references to the values
+ * remain valid after insertions (as in std::map). The slots of erased entries are reused by later insertions.
+ * The lookups are binary searches on sorted chunks of pointers to the entries. Since each chunk has a limited size,
+ * insertions in any order only move a few pointers. Differently from std::map, iterators are invalidated by insertions and removals */
+template<class Key, class Value, class KeyCompare = AttribsKeyCompare>
+class FlatMap {
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using value_type = std::pair<const Key, Value>;
+		using size_type = std::size_t;
+		using difference_type = std::ptrdiff_t;
+		using reference = value_type &;
+		using const_reference = const value_type &;
+
+	private:
+		//! \brief The amount of entries of the first storage block. Each new block doubles the size of the previous one
+		static constexpr size_type InitialBlockSize = 8;
+
+		//! \brief The maximum amount of entries in a chunk. When exceeded the chunk is split in two halves
+		static constexpr size_type MaxChunkSize = 512;
+
+		using Chunk = std::vector<value_type *>;
+
+		//! \brief Storage blocks of the entries. A block is never resized beyond its reserved capacity
+		std::vector<std::vector<value_type>> blocks;
+
+		//! \brief Pointers to the entries in the blocks sorted by key and split in chunks of at most MaxChunkSize elements
+		std::vector<Chunk> chunks;
+
+		//! \brief Storage slots of erased entries that are reused by the next insertions
+		std::vector<value_type *> free_slots;
+
+		//! \brief The amount of entries in the map
+		size_type entry_count = 0;
+
+		//! \brief Position of an entry (or insertion point) in the sorted chunks
+		struct Position {
+			size_type chunk, pos;
+		};
+
+		//! \brief Returns the first chunk which can contain the key. For keys greater than all the others returns the last chunk
+		size_type findChunk(const Key &key) const
+		{
+			KeyCompare comp;
+			auto itr = std::lower_bound(chunks.begin(), chunks.end(), key,
+																	[&comp](const Chunk &chunk, const Key &k){
+				return comp(chunk.back()->first, k) < 0;
+			});
+
+			if(itr == chunks.end())
+				return chunks.size() - 1;
+
+			return itr - chunks.begin();
+		}
+
+		//! \brief Returns the position in the chunks where the key is or should be inserted. The map must not be empty
+		Position lowerBound(const Key &key) const
+		{
+			KeyCompare comp;
+			size_type chunk = findChunk(key);
+			auto &entries = chunks[chunk];
+			auto itr = std::lower_bound(entries.begin(), entries.end(), key,
+																	[&comp](const value_type *entry, const Key &k){
+				return comp(entry->first, k) < 0;
+			});
+
+			return { chunk, static_cast<size_type>(itr - entries.begin()) };
+		}
+
+		//! \brief Returns the position of the entry with the provided key or the end position when it doesn't exist
+		Position positionOf(const Key &key) const
+		{
+			if(chunks.empty())
+				return { 0, 0 };
+
+			Position p = lowerBound(key);
+
+			if(p.pos < chunks[p.chunk].size() && KeyCompare()(chunks[p.chunk][p.pos]->first, key) == 0)
+				return p;
+
+			return { chunks.size(), 0 };
+		}
+
+		//! \brief Returns the entry in the provided position
+		value_type *entryAt(const Position &p) const
+		{
+			return chunks[p.chunk][p.pos];
+		}
+
+		//! \brief Stores a new entry in the blocks (reusing the slot of an erased entry if any) returning its address
+		template<class K, class V>
+		value_type *allocEntry(K &&key, V &&value)
+		{
+			if(!free_slots.empty())
+			{
+				value_type entry(std::forward<K>(key), std::forward<V>(value)), *slot = free_slots.back();
+
+				/* The slot holds an empty entry which is replaced by the new one. Since the key is const
+				 * the entry can't be assigned, so it is destroyed and constructed again in the same storage */
+				slot->~value_type();
+				slot = new (slot) value_type(std::move(entry));
+				free_slots.pop_back();
+				return slot;
+			}
+
+			if(blocks.empty() || blocks.back().size() == blocks.back().capacity())
+			{
+				size_type block_size = blocks.empty() ? InitialBlockSize : blocks.back().capacity() * 2;
+
+				blocks.emplace_back();
+				blocks.back().reserve(block_size);
+			}
+
+			blocks.back().emplace_back(std::forward<K>(key), std::forward<V>(value));
+			return &blocks.back().back();
+		}
+
+		//! \brief Releases the key and value of an erased entry and makes its slot available to the next insertions
+		void releaseEntry(value_type *entry)
+		{
+			entry->~value_type();
+			new (entry) value_type();
+			free_slots.push_back(entry);
+		}
+
+		//! \brief Splits the provided chunk in two halves if it exceeds the maximum size
+		void splitChunk(size_type chunk)
+		{
+			if(chunks[chunk].size() <= MaxChunkSize)
+				return;
+
+			size_type half = chunks[chunk].size() / 2;
+			Chunk second(chunks[chunk].begin() + half, chunks[chunk].end());
+
+			chunks[chunk].resize(half);
+			chunks.insert(chunks.begin() + chunk + 1, std::move(second));
+		}
+
+		/*! \brief Appends the entries already sorted by key (with no duplicated keys) to the end of the chunks.
+		 * All the keys must be greater than the ones in the map */
+		void appendSorted(const std::vector<value_type *> &sorted)
+		{
+			for(auto itr = sorted.begin(); itr != sorted.end();)
+			{
+				if(chunks.empty() || chunks.back().size() >= MaxChunkSize)
+				{
+					chunks.emplace_back();
+					chunks.back().reserve(std::min<size_type>(MaxChunkSize, sorted.end() - itr));
+				}
+
+				size_type count = std::min<size_type>(MaxChunkSize - chunks.back().size(), sorted.end() - itr);
+
+				chunks.back().insert(chunks.back().end(), itr, itr + count);
+				itr += count;
+			}
+
+			entry_count += sorted.size();
+		}
+
+		/*! \brief Inserts the entry in the sorted position if the key doesn't exist yet.
+		 * Returns the position of the entry and a flag indicating if it was inserted */
+		template<class K, class V>
+		std::pair<Position, bool> insertEntry(K &&key, V &&value)
+		{
+			KeyCompare comp;
+
+			// Fast path for entries inserted in ascending order of keys (e.g. when copying other maps)
+			if(chunks.empty() || comp(chunks.back().back()->first, key) < 0)
+			{
+				if(chunks.empty() || chunks.back().size() >= MaxChunkSize)
+					chunks.emplace_back();
+
+				chunks.back().push_back(allocEntry(std::forward<K>(key), std::forward<V>(value)));
+				entry_count++;
+				return {{ chunks.size() - 1, chunks.back().size() - 1 }, true };
+			}
+
+			Position p = lowerBound(key);
+			Chunk &entries = chunks[p.chunk];
+
+			if(p.pos < entries.size() && comp(entries[p.pos]->first, key) == 0)
+				return { p, false };
+
+			entries.insert(entries.begin() + p.pos, allocEntry(std::forward<K>(key), std::forward<V>(value)));
+			entry_count++;
+
+			if(entries.size() > MaxChunkSize)
+			{
+				size_type half = entries.size() / 2;
+
+				splitChunk(p.chunk);
+
+				if(p.pos >= half)
+				{
+					p.chunk++;
+					p.pos -= half;
+				}
+			}
+
+			return { p, true };
+		}
+
+		template<class Ref, class Ptr>
+		class Iterator {
+			private:
+				const std::vector<Chunk> *chunks = nullptr;
+
+				Position p = { 0, 0 };
+
+			public:
+				using iterator_category = std::bidirectional_iterator_tag;
+				using value_type = FlatMap::value_type;
+				using difference_type = std::ptrdiff_t;
+				using pointer = Ptr;
+				using reference = Ref;
+
+				Iterator() = default;
+				Iterator(const std::vector<Chunk> *chunks, Position p) : chunks(chunks), p(p) {}
+
+				//! \brief Allows the conversion from iterator to const_iterator
+				template<class OtherRef, class OtherPtr>
+				Iterator(const Iterator<OtherRef, OtherPtr> &other) : chunks(other.getChunks()), p(other.getPosition()) {}
+
+				const std::vector<Chunk> *getChunks() const { return chunks; }
+				Position getPosition() const { return p; }
+
+				Ref operator * () const { return *(*chunks)[p.chunk][p.pos]; }
+				Ptr operator -> () const { return (*chunks)[p.chunk][p.pos]; }
+
+				Iterator &operator ++ ()
+				{
+					if(++p.pos == (*chunks)[p.chunk].size())
+					{
+						p.chunk++;
+						p.pos = 0;
+					}
+
+					return *this;
+				}
+
+				Iterator &operator -- ()
+				{
+					if(p.pos == 0)
+						p.pos = (*chunks)[--p.chunk].size();
+
+					p.pos--;
+					return *this;
+				}
+
+				Iterator operator ++ (int) { Iterator aux = *this; ++(*this); return aux; }
+				Iterator operator -- (int) { Iterator aux = *this; --(*this); return aux; }
+
+				template<class OtherRef, class OtherPtr>
+				bool operator == (const Iterator<OtherRef, OtherPtr> &other) const
+				{
+					return p.chunk == other.getPosition().chunk && p.pos == other.getPosition().pos;
+				}
+
+				template<class OtherRef, class OtherPtr>
+				bool operator != (const Iterator<OtherRef, OtherPtr> &other) const { return !(*this == other); }
+		};
+
+	public:
+		using iterator = Iterator<value_type &, value_type *>;
+		using const_iterator = Iterator<const value_type &, const value_type *>;
+
+		FlatMap() = default;
+
+		FlatMap(std::initializer_list<value_type> values)
+		{
+			insert(values);
+		}
+
+		template<class InputItr>
+		FlatMap(InputItr first, InputItr last)
+		{
+			insert(first, last);
+		}
+
+		//! \brief Copies only the current entries of the other map in a single storage block
+		FlatMap(const FlatMap &other)
+		{
+			*this = other;
+		}
+
+		FlatMap(FlatMap &&other) noexcept = default;
+
+		FlatMap &operator = (const FlatMap &other)
+		{
+			if(this == &other)
+				return *this;
+
+			std::vector<value_type *> sorted;
+
+			clear();
+
+			if(other.empty())
+				return *this;
+
+			blocks.emplace_back();
+			blocks.back().reserve(std::max(other.size(), InitialBlockSize));
+			sorted.reserve(other.size());
+
+			for(auto &entry : other)
+			{
+				blocks.back().emplace_back(entry.first, entry.second);
+				sorted.push_back(&blocks.back().back());
+			}
+
+			appendSorted(sorted);
+			return *this;
+		}
+
+		FlatMap &operator = (FlatMap &&other) noexcept = default;
+
+		FlatMap &operator = (std::initializer_list<value_type> values)
+		{
+			clear();
+			insert(values);
+			return *this;
+		}
+
+		iterator begin() { return iterator(&chunks, { 0, 0 }); }
+		iterator end() { return iterator(&chunks, { chunks.size(), 0 }); }
+		const_iterator begin() const { return const_iterator(&chunks, { 0, 0 }); }
+		const_iterator end() const { return const_iterator(&chunks, { chunks.size(), 0 }); }
+		const_iterator cbegin() const { return begin(); }
+		const_iterator cend() const { return end(); }
+
+		bool empty() const { return entry_count == 0; }
+		size_type size() const { return entry_count; }
+
+		//! \brief Preallocates space for the provided amount of entries
+		void reserve(size_type count)
+		{
+			if(blocks.empty() && count > InitialBlockSize)
+			{
+				blocks.emplace_back();
+				blocks.back().reserve(count);
+			}
+		}
+
+		void clear()
+		{
+			chunks.clear();
+			free_slots.clear();
+			blocks.clear();
+			entry_count = 0;
+		}
+
+		void swap(FlatMap &other) noexcept
+		{
+			blocks.swap(other.blocks);
+			chunks.swap(other.chunks);
+			free_slots.swap(other.free_slots);
+			std::swap(entry_count, other.entry_count);
+		}
+
+		iterator find(const Key &key)
+		{
+			return iterator(&chunks, positionOf(key));
+		}
+
+		const_iterator find(const Key &key) const
+		{
+			return const_iterator(&chunks, positionOf(key));
+		}
+
+		size_type count(const Key &key) const
+		{
+			return contains(key) ? 1 : 0;
+		}
+
+		bool contains(const Key &key) const
+		{
+			return positionOf(key).chunk < chunks.size();
+		}
+
+		Value &operator [] (const Key &key)
+		{
+			return entryAt(insertEntry(key, Value()).first)->second;
+		}
+
+		Value &operator [] (Key &&key)
+		{
+			return entryAt(insertEntry(std::move(key), Value()).first)->second;
+		}
+
+		Value &at(const Key &key)
+		{
+			Position p = positionOf(key);
+
+			if(p.chunk == chunks.size())
+				throw std::out_of_range("FlatMap::at");
+
+			return entryAt(p)->second;
+		}
+
+		const Value &at(const Key &key) const
+		{
+			Position p = positionOf(key);
+
+			if(p.chunk == chunks.size())
+				throw std::out_of_range("FlatMap::at");
+
+			return entryAt(p)->second;
+		}
+
+		std::pair<iterator, bool> insert(const value_type &value)
+		{
+			auto res = insertEntry(value.first, value.second);
+			return { iterator(&chunks, res.first), res.second };
+		}
+
+		template<class K, class V>
+		std::pair<iterator, bool> insert(const std::pair<K, V> &value)
+		{
+			auto res = insertEntry(value.first, value.second);
+			return { iterator(&chunks, res.first), res.second };
+		}
+
+		template<class K, class V>
+		std::pair<iterator, bool> emplace(K &&key, V &&value)
+		{
+			auto res = insertEntry(std::forward<K>(key), std::forward<V>(value));
+			return { iterator(&chunks, res.first), res.second };
+		}
+
+		/*! \brief Inserts the values of the range whose keys don't exist in the map (same semantics of std::map::insert).
+		 * When the map is empty the values are stored unsorted and then sorted and deduplicated at once */
+		template<class InputItr>
+		void insert(InputItr first, InputItr last)
+		{
+			if(!empty())
+			{
+				for(; first != last; ++first)
+					insertEntry(first->first, first->second);
+
+				return;
+			}
+
+			KeyCompare comp;
+			std::vector<value_type *> sorted, uniq;
+
+			for(; first != last; ++first)
+				sorted.push_back(allocEntry(first->first, first->second));
+
+			// The stable sort keeps the first occurrence of a duplicated key in front of the others
+			std::stable_sort(sorted.begin(), sorted.end(), [&comp](const value_type *entry1, const value_type *entry2){
+				return comp(entry1->first, entry2->first) < 0;
+			});
+
+			for(auto &entry : sorted)
+			{
+				if(!uniq.empty() && comp(uniq.back()->first, entry->first) == 0)
+					releaseEntry(entry);
+				else
+					uniq.push_back(entry);
+			}
+
+			appendSorted(uniq);
+		}
+
+		void insert(std::initializer_list<value_type> values)
+		{
+			insert(values.begin(), values.end());
+		}
+
+		/*! \brief Removes the entry pointed by the iterator returning the iterator to the next entry.
+		 * The storage of the removed entry is reused by the next insertions */
+		iterator erase(const_iterator pos)
+		{
+			Position p = pos.getPosition();
+			Chunk &entries = chunks[p.chunk];
+
+			releaseEntry(entries[p.pos]);
+			entries.erase(entries.begin() + p.pos);
+			entry_count--;
+
+			if(entries.empty())
+				chunks.erase(chunks.begin() + p.chunk);
+			else if(p.pos == entries.size())
+			{
+				p.chunk++;
+				p.pos = 0;
+			}
+
+			return iterator(&chunks, p);
+		}
+
+		iterator erase(const_iterator first, const_iterator last)
+		{
+			difference_type count = std::distance(first, last);
+			iterator itr(first);
+
+			for(; count > 0; count--)
+				itr = erase(itr);
+
+			return itr;
+		}
+
+		size_type erase(const Key &key)
+		{
+			Position p = positionOf(key);
+
+			if(p.chunk == chunks.size())
+				return 0;
+
+			erase(const_iterator(&chunks, p));
+			return 1;
+		}
+
+		bool operator == (const FlatMap &other) const
+		{
+			if(size() != other.size())
+				return false;
+
+			for(auto itr = begin(), itr_other = other.begin(); itr != end(); ++itr, ++itr_other)
+			{
+				if(KeyCompare()(itr->first, itr_other->first) != 0 ||
+					 !(itr->second == itr_other->second))
+					return false;
+			}
+
+			return true;
+		}
+
+		bool operator != (const FlatMap &other) const
+		{
+			return !(*this == other);
+		}
+};
+
+using attribs_map = FlatMap<QString, QString>;
+
 #endif
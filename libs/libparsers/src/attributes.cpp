@@ -337,6 +337,7 @@ namespace Attributes {
 	LayerNameColors("layer-name-colors"),
 	LayerRectColors("layer-rect-colors"),
 	Layers("layers"),
+	LazyRendering("lazy-rendering"),
 	LcCollate("lc-collate"),
 	LcCtype("lc-ctype"),
 	LcCollateMod("lc-collate-mod"),
@@ -399,6 +400,7 @@ namespace Attributes {
 	Objects("objects"),
 	ObjectType("object-type"),
 	ObjCount("objcount"),
+	ObjDepends("objdepends"),
 	ObjSelection("obj-selection"),
 	ObjShadow("obj-shadow"),
 	Oid("oid"),
@@ -431,6 +433,7 @@ namespace Attributes {
 	ParamOut("out"),
 	ParamVariadic("variadic"),
 	Parent("parent"),
+	ParentOids("parent-oids"),
 	ParentType("parent-type"),
 	Parents("parents"),
 	Parsable("parsable"),
@@ -500,6 +503,7 @@ namespace Attributes {
 	ReferencesPriv("references"),
 	Referrers("referrers"),
 	RefName("ref-name"),
+	RefOids("refoids"),
 	RefTable("ref-table"),
 	RefTables("ref-tables"),
 	RefTableTag("reftable"),
@@ -639,6 +643,7 @@ namespace Attributes {
 	TruncatePriv("truncate"),
 	TruncEvent("trunc-event"),
 	Trusted("trusted"),
+	TrustSavedModels("trust-saved-models"),
 	TuplesDel("tuples-del"),
 	TuplesIns("tuples-ins"),
 	Type("type"),
@@ -354,6 +354,7 @@ namespace Attributes {
 	LayerNameColors,
 	LayerRectColors,
 	Layers,
+	LazyRendering,
 	LcCollate,
 	LcCollateMod,
 	LcCtype,
@@ -416,6 +417,7 @@ namespace Attributes {
 	Objects,
 	ObjectType,
 	ObjCount,
+	ObjDepends,
 	ObjSelection,
 	ObjShadow,
 	Oid,
@@ -448,6 +450,7 @@ namespace Attributes {
 	ParamOut,
 	ParamVariadic,
 	Parent,
+	ParentOids,
 	ParentType,
 	Parents,
 	Parsable,
@@ -517,6 +520,7 @@ namespace Attributes {
 	ReferencesPriv,
 	Referrers,
 	RefName,
+	RefOids,
 	RefTable,
 	RefTables,
 	RefTableTag,
@@ -656,6 +660,7 @@ namespace Attributes {
 	TruncatePriv,
 	TruncEvent,
 	Trusted,
+	TrustSavedModels,
 	TuplesDel,
 	TuplesIns,
 	Type,
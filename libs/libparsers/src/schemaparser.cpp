@@ -20,6 +20,11 @@
 #include "attributes.h"
 #include "utilsns.h"
 #include "xmlparser.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
 
 const char SchemaParser::CharComment='#';
 const char SchemaParser::CharLineEnd='\n';
@@ -67,13 +72,16 @@ const QString SchemaParser::TokenGtEqOper=QString(">=");
 const QString SchemaParser::TokenLtEqOper=QString("<=");
 
 // QRegularExpression::anchoredPattern is used to force the exact match
+QString SchemaParser::capture_file;
+QMutex SchemaParser::capture_mutex;
+
 const QRegularExpression SchemaParser::AttribRegExp(QRegularExpression::anchoredPattern("^([a-z])([a-z]*|(\\d)*|(\\-)*|(_)*)+"),
 																										QRegularExpression::CaseInsensitiveOption);
 
 SchemaParser::SchemaParser()
 {
 	line=column=comment_count=0;
-	ignore_unk_atribs=ignore_empty_atribs=false;
+	ignore_unk_atribs=ignore_empty_atribs=profiling=false;
 	pgsql_version=PgSqlVersions::DefaulVersion;
 }
 
@@ -140,6 +148,7 @@ void SchemaParser::restartParser()
 	/* Clears the buffer and resets the counters for line,
 		column and amount of comments */
 	buffer.clear();
+	src_lines.clear();
 	attributes.clear();
 	line=column=comment_count=0;
 }
@@ -150,7 +159,7 @@ void SchemaParser::loadBuffer(const QString &buf)
 			escaped_comm_chr=QString("\\%1").arg(CharComment),
 			placeholder = QString(QChar::ReplacementCharacter);
 	QTextStream ts(&buf_aux);
-	int pos=0;
+	int pos=0, src_line=0;
 	bool comm_holder_used = false;
 
 	//Prepares the parser to do new reading
@@ -163,6 +172,7 @@ void SchemaParser::loadBuffer(const QString &buf)
 	{
 		//Get one line from stream (until the last char before \n)
 		lin = ts.readLine();
+		src_line++;
 
 		/* Special treatment for escaped comment characters (e.g.: \#):
 		 * In order to avoid removing wrongly the # from the the line where it appear in the form \#
@@ -204,6 +214,9 @@ void SchemaParser::loadBuffer(const QString &buf)
 
 			//Add the treated line in the buffer
 			buffer.push_back(lin);
+
+			if(profiling)
+				src_lines.push_back(src_line);
 		}
 	}
 }
@@ -955,6 +968,17 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 	std::vector<QString>::iterator itr, itr_end;
 	std::vector<int> vet_prev_level;
 	std::vector<QString> *vet_aux;
+	LineProfile *line_prof = nullptr;
+	int prof_line = -1;
+	qint64 prof_start = 0;
+
+	//Stores a word in the intermediate buffers of the if/else blocks registering the allocation when profiling
+	auto store_word = [&line_prof](std::vector<QString> &words, const QString &word) {
+		words.push_back(word);
+
+		if(line_prof)
+			line_prof->alloc_count++;
+	};
 
 	//In case the file was successfuly loaded
 	if(buffer.size() > 0)
@@ -965,8 +989,26 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 		if_level=-1;
 		end_cnt=if_cnt=0;
 
+		//The profiling is done only if the lines were mapped when loading the buffer
+		if(profiling && src_lines.size() == static_cast<size_t>(buffer.size()))
+			profile_timer.start();
+		else
+			profile_timer.invalidate();
+
 		while(line < buffer.size())
 		{
+			if(profile_timer.isValid())
+			{
+				line_prof = &profile[src_lines[line]];
+				prof_start = profile_timer.nsecsElapsed();
+
+				if(prof_line != line)
+				{
+					prof_line = line;
+					line_prof->hits++;
+				}
+			}
+
 			chr=buffer[line][column].toLatin1();
 			switch(chr)
 			{
@@ -1011,12 +1053,12 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 							if(vet_tk_if[if_level] &&
 									vet_tk_then[if_level] &&
 									!vet_tk_else[if_level])
-								if_map[if_level].push_back(meta);
+								store_word(if_map[if_level], meta);
 
 							/* If the parser is in 'else' section,
 								 places the metacharacter on the word map of the current 'else'*/
 							else if(vet_tk_else[if_level])
-								else_map[if_level].push_back(meta);
+								store_word(else_map[if_level], meta);
 						}
 						else
 							/* If the parsers is not in a 'if / else', puts the metacharacter
@@ -1031,6 +1073,9 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 				case CharEndAttribute:
 					atrib=getAttribute();
 
+					if(line_prof)
+						line_prof->attrib_count++;
+
 					//Checks if the attribute extracted belongs to the passed list of attributes
 					if(attributes.count(atrib)==0)
 					{
@@ -1041,7 +1086,12 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 											ErrorCode::UnkownAttribute,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 						}
 						else
+						{
 							attributes[atrib]="";
+
+							if(line_prof)
+								line_prof->alloc_count++;
+						}
 					}
 
 					//If the parser is inside an 'if / else' extracting tokens
@@ -1061,10 +1111,10 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 									vet_tk_then[if_level] &&
 									!vet_tk_else[if_level])
 								//Inserts the attribute value in the map of the words of current the 'if' section
-								if_map[if_level].push_back(atrib);
+								store_word(if_map[if_level], atrib);
 							else if(vet_tk_else[if_level])
 								//Inserts the attribute value in the map of the words of current the 'else' section
-								else_map[if_level].push_back(atrib);
+								store_word(else_map[if_level], atrib);
 						}
 					}
 					else
@@ -1104,6 +1154,9 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 					{
 						bool extract=false;
 
+						if(line_prof)
+							line_prof->set_count++;
+
 						/* Extracts or unset the attribute only if the process is not in the middle of a 'if-then-else' or
 							if the parser is inside the 'if' part and the expression is evaluated as true, or in the 'else' part
 							and the related 'if' is false. Otherwise the line where %set is located will be completely ignored */
@@ -1129,7 +1182,12 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 						if(extract)
 						{
 							if(cond==TokenSet)
+							{
 								defineAttribute();
+
+								if(line_prof)
+									line_prof->alloc_count++;
+							}
 							else
 								unsetAttribute();
 						}
@@ -1154,6 +1212,9 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 						//If the toke is an 'if'
 						if(cond==TokenIf)
 						{
+							if(line_prof)
+								line_prof->if_count++;
+
 							//Evaluates the if expression storing the result on the vector
 							if_expr=true;
 							vet_expif.push_back(evaluateExpression());
@@ -1241,7 +1302,7 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 							{
 								//If the auxiliary vector is allocated, inserts the word on above 'if / else'
 								if(vet_aux)
-									vet_aux->push_back((*itr));
+									store_word(*vet_aux, *itr);
 								else
 								{
 									word=(*itr);
@@ -1253,6 +1314,9 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 										atrib=word.mid(1, word.size()-2);
 										word=attributes[atrib];
 
+										if(line_prof)
+											line_prof->attrib_count++;
+
 										/* If the attribute has no value set and parser must not ignore empty values
 										raises an exception */
 										if(word.isEmpty() && !ignore_empty_atribs)
@@ -1338,18 +1402,23 @@ QString SchemaParser::getCodeDefinition(const attribs_map &attribs)
 								vet_tk_then[if_level] &&
 								!vet_tk_else[if_level])
 							//Inserts the word on the words map extracted on 'if' section
-							if_map[if_level].push_back(word);
+							store_word(if_map[if_level], word);
 						else if(vet_tk_else[if_level])
 							//Inserts the word on the words map extracted on 'else' section
-							else_map[if_level].push_back(word);
+							store_word(else_map[if_level], word);
 					}
 					else
 						//Case the parser is not in 'if/else' concatenates the word/text directly on the object definition
 						object_def+=word;
 				break;
 			}
+
+			if(line_prof)
+				line_prof->elapsed += profile_timer.nsecsElapsed() - prof_start;
 		}
 
+		profile_timer.invalidate();
+
 		/* If has more 'if' toknes than  'end' tokens, this indicates that some 'if' in code
 		was not closed thus the parser returns an error */
 		if(if_cnt!=end_cnt)
@@ -1372,6 +1441,10 @@ QString SchemaParser::getCodeDefinition(const QString &filename, attribs_map &at
 	{
 		loadFile(filename);
 		attribs[Attributes::PgSqlVersion]=pgsql_version;
+
+		if(!capture_file.isEmpty())
+			captureAttributes(filename, attribs);
+
 		return getCodeDefinition(attribs);
 	}
 	catch(Exception &e)
@@ -1389,3 +1462,92 @@ bool SchemaParser::getExpressionResult(const QString &oper, const QVariant &left
 					(oper==TokenGtEqOper && (left_val.value<Type>() >= right_val.value<Type>())) ||
 					(oper==TokenLtEqOper && (left_val.value<Type>() <= right_val.value<Type>())));
 }
+
+void SchemaParser::setProfilingEnabled(bool value)
+{
+	profiling = value;
+}
+
+void SchemaParser::clearProfile()
+{
+	profile.clear();
+}
+
+std::map<int, SchemaParser::LineProfile> SchemaParser::getProfile()
+{
+	return profile;
+}
+
+void SchemaParser::setAttributesCaptureFile(const QString &filename)
+{
+	QMutexLocker locker(&capture_mutex);
+	capture_file = filename;
+}
+
+void SchemaParser::captureAttributes(const QString &filename, const attribs_map &attribs)
+{
+	QMutexLocker locker(&capture_mutex);
+	QFile output(capture_file);
+	QJsonObject set, attr_values;
+	QFileInfo fi(filename);
+
+	if(capture_file.isEmpty())
+		return;
+
+	if(!output.open(QFile::WriteOnly | QFile::Append))
+		throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotWritten).arg(capture_file),
+										ErrorCode::FileDirectoryNotWritten,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	for(auto &itr : attribs)
+		attr_values[itr.first] = itr.second;
+
+	// The schema is identified by its file name and the directory it is in (e.g.: sql/table.sch)
+	set["schema"] = fi.dir().dirName() + "/" + fi.fileName();
+	set["attributes"] = attr_values;
+
+	output.write(QJsonDocument(set).toJson(QJsonDocument::Compact));
+	output.write("\n");
+}
+
+std::vector<attribs_map> SchemaParser::loadCapturedAttributes(const QString &filename, const QString &schema)
+{
+	QFile input(filename);
+	QByteArray json_line;
+	QJsonObject set, attr_values;
+	QString set_schema;
+	std::vector<attribs_map> attr_sets;
+	attribs_map attribs;
+	bool cmp_file_names = !schema.contains('/');
+
+	if(!input.open(QFile::ReadOnly))
+		throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotAccessed).arg(filename),
+										ErrorCode::FileDirectoryNotAccessed,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	// Reading line by line since the capture files of big models can be huge
+	while(!input.atEnd())
+	{
+		json_line = input.readLine().trimmed();
+
+		if(json_line.isEmpty())
+			continue;
+
+		set = QJsonDocument::fromJson(json_line).object();
+		set_schema = set["schema"].toString();
+
+		if(cmp_file_names)
+			set_schema = set_schema.mid(set_schema.lastIndexOf('/') + 1);
+
+		if(set_schema != schema)
+			continue;
+
+		attribs.clear();
+		attr_values = set["attributes"].toObject();
+
+		for(auto itr = attr_values.begin(); itr != attr_values.end(); itr++)
+			attribs[itr.key()] = itr.value().toString();
+
+		attr_sets.push_back(attribs);
+	}
+
+	return attr_sets;
+}
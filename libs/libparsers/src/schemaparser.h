@@ -34,9 +34,49 @@
 #include "attribsmap.h"
 #include "pgsqlversions.h"
 #include <QRegularExpression>
+#include <QElapsedTimer>
+#include <QMutex>
 
 class SchemaParser {
+	public:
+		//! \brief Stores the profiling data of a single line of a schema file (see setProfilingEnabled())
+		struct LineProfile {
+			//! \brief Time (in nanoseconds) spent parsing the line
+			qint64 elapsed;
+
+			//! \brief Amount of times the line was parsed
+			unsigned hits;
+
+			//! \brief Amount of %if, %set/%unset and attributes evaluated in the line
+			unsigned if_count, set_count, attrib_count;
+
+			/*! \brief Amount of strings allocated while parsing the line: the words stored in the
+			 * intermediate buffers of the if/else blocks and the attributes created by the parser */
+			unsigned alloc_count;
+		};
+
 	private:
+		/*! \brief The file in which the attributes used by getCodeDefinition(filename, attribs) are
+		 * captured (see setAttributesCaptureFile()) */
+		static QString capture_file;
+
+		//! \brief Serializes the writing of the captured attributes since the parsers may run in different threads
+		static QMutex capture_mutex;
+
+		//! \brief Indicates that the parser is collecting profiling data
+		bool profiling;
+
+		//! \brief The original line (in the source file) of each line in the buffer. Filled only when profiling
+		std::vector<int> src_lines;
+
+		//! \brief The profiling data of each line of the source (the key is the line number starting from 1)
+		std::map<int, LineProfile> profile;
+
+		QElapsedTimer profile_timer;
+
+		//! \brief Appends the attributes used to generate the code from the provided file to the capture file
+		static void captureAttributes(const QString &filename, const attribs_map &attribs);
+
 		/*! \brief Indicates that the parser should ignore unknown
 		 attributes avoiding raising exceptions */
 		bool ignore_unk_atribs;
@@ -248,6 +288,26 @@ class SchemaParser {
 		//! \brief Returns the current columnm of the current line where the parser is reading
 		int getCurrentColumn();
 
+		/*! \brief Enables the collection of profiling data (time, evaluated instructions and allocations per line).
+		 * The data is accumulated over the calls to getCodeDefinition() until clearProfile() is called.
+		 * Since the buffer lines must be mapped to the source lines, this should be set before loading the buffer */
+		void setProfilingEnabled(bool value);
+
+		//! \brief Clears the collected profiling data
+		void clearProfile();
+
+		//! \brief Returns the collected profiling data per source line
+		std::map<int, LineProfile> getProfile();
+
+		/*! \brief Configures a file in which all the attribute sets used to generate code from schema files are
+		 * appended (one JSON object per line containing the schema file and the attributes). The captured sets can be
+		 * used to profile the schema files (see loadCapturedAttributes()). An empty file name disables the capture */
+		static void setAttributesCaptureFile(const QString &filename);
+
+		/*! \brief Returns the attribute sets captured for the provided schema file (e.g.: sql/table.sch). When the schema
+		 * has no parent directory in its name, only the file names are compared */
+		static std::vector<attribs_map> loadCapturedAttributes(const QString &filename, const QString &schema);
+
 };
 
 #endif
@@ -36,6 +36,11 @@ XmlParser::XmlParser()
 	root_elem=nullptr;
 	curr_elem=nullptr;
 	xml_doc=nullptr;
+	xml_reader=nullptr;
+	stream_map=nullptr;
+	stream_data=nullptr;
+	stream_size=stream_pos=0;
+	dtd_validation=true;
 	curr_line = 0;
 
 	if(parser_instances == 0)
@@ -148,11 +153,270 @@ void XmlParser::setDTDFile(const QString &dtd_file, const QString &dtd_name)
 			 fmt_dtd_file + QString("\">\n");
 }
 
+void XmlParser::setDTDValidation(bool value)
+{
+	dtd_validation = value;
+}
+
+void XmlParser::checkLibXMLError()
+{
+	QString msg, file;
+	xmlError *xml_error=xmlGetLastError();
+
+	//If some error is set
+	if(xml_error)
+	{
+		//Formats the error
+		msg=xml_error->message;
+		file=xml_error->file;
+		if(!file.isEmpty()) file=QString("(%1)").arg(file);
+		msg.replace("\n"," ");
+
+		int line = xml_error->line, column = xml_error->int2;
+
+		//Restarts the parser
+		if(xml_doc || xml_reader) restartParser();
+
+		//Raise an exception with the error massege from the parser xml
+		throw Exception(Exception::getErrorMessage(ErrorCode::LibXMLError)
+						.arg(line).arg(column).arg(msg).arg(file),
+						ErrorCode::LibXMLError,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+	}
+}
+
+int XmlParser::readStreamChunk(void *parser, char *buffer, int len)
+{
+	XmlParser *xmlparser = reinterpret_cast<XmlParser *>(parser);
+	qint64 prolog_size = xmlparser->stream_prolog.size(),
+			total = prolog_size + xmlparser->stream_size,
+			pos = xmlparser->stream_pos, count = 0, copied = 0;
+
+	if(pos >= total || len <= 0)
+		return 0;
+
+	//Serving the xml/dtd declarations first
+	if(pos < prolog_size)
+	{
+		count = qMin<qint64>(prolog_size - pos, len);
+		memcpy(buffer, xmlparser->stream_prolog.constData() + pos, count);
+		pos += count;
+		copied += count;
+	}
+
+	//Serving the mapped contents of the file
+	if(copied < len && pos >= prolog_size)
+	{
+		count = qMin<qint64>(total - pos, len - copied);
+		memcpy(buffer + copied, xmlparser->stream_data + (pos - prolog_size), count);
+		pos += count;
+		copied += count;
+	}
+
+	xmlparser->stream_pos = pos;
+	return static_cast<int>(copied);
+}
+
+void XmlParser::openXMLFileStream(const QString &filename)
+{
+	uchar *mapped = nullptr;
+	qint64 size = 0, start = 0, end = 0;
+	int parser_opt = 0;
+	const char *data = nullptr;
+	QByteArray xml_decl_data;
+
+	if(filename.isEmpty())
+		throw Exception(ErrorCode::AsgEmptyXMLBuffer,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	closeXMLFileStream();
+	stream_file.setFileName(filename);
+
+	if(!stream_file.open(QFile::ReadOnly))
+	{
+		throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotAccessed).arg(filename),
+										ErrorCode::FileDirectoryNotAccessed,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+	}
+
+	size = stream_file.size();
+	mapped = size > 0 ? stream_file.map(0, size) : nullptr;
+
+	if(!mapped)
+	{
+		stream_file.close();
+		throw Exception(ErrorCode::AsgEmptyXMLBuffer,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+	}
+
+	data = reinterpret_cast<const char *>(mapped);
+
+	/* Removing the original xml declaration and DTD from the contents served to the reader (see removeDTD()).
+	 * Both are searched only in the beginning of the file (before the root element) */
+	QByteArray head = QByteArray::fromRawData(data, qMin<qint64>(size, 4096));
+	qint64 decl_start = head.indexOf("<?xml"), decl_end = head.indexOf("?>");
+
+	if(decl_start >= 0 && decl_end > decl_start)
+	{
+		end = qMin<qint64>(decl_end + 3, size);
+		xml_decl_data = QByteArray(data + decl_start, end - decl_start);
+		start = end;
+	}
+	else
+		xml_decl_data = QByteArray("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+
+	qint64 dtd_start = head.indexOf("<!DOCTYPE", start);
+
+	if(dtd_start >= 0)
+	{
+		qint64 dtd_end = head.indexOf("]>\n", dtd_start);
+
+		if(dtd_end < 0)
+			dtd_end = head.indexOf("\">\n", dtd_start);
+
+		if(dtd_end >= 0)
+			start = dtd_end + 3;
+	}
+
+	stream_prolog = xml_decl_data + dtd_decl.toUtf8();
+	stream_map = mapped;
+	stream_data = data + start;
+	stream_size = size - start;
+	stream_pos = 0;
+
+	parser_opt=(XML_PARSE_NOBLANKS | XML_PARSE_NONET | XML_PARSE_NOENT | XML_PARSE_BIG_LINES);
+
+	if(!dtd_decl.isEmpty())
+	{
+		parser_opt=(parser_opt | XML_PARSE_DTDLOAD);
+
+		if(dtd_validation)
+			parser_opt=(parser_opt | XML_PARSE_DTDVALID);
+	}
+
+	xmlResetLastError();
+	xml_reader = xmlReaderForIO(&XmlParser::readStreamChunk, nullptr, this, nullptr, nullptr, parser_opt);
+
+	if(!xml_reader)
+	{
+		closeXMLFileStream();
+		throw Exception(ErrorCode::OprNotAllocatedElementTree,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+	}
+
+	xml_doc_filename = filename;
+
+	//Moving the reader to the root element
+	while(xmlTextReaderRead(xml_reader) == 1)
+	{
+		checkLibXMLError();
+
+		if(xmlTextReaderNodeType(xml_reader) == XML_READER_TYPE_ELEMENT)
+		{
+			root_elem = curr_elem = xmlTextReaderCurrentNode(xml_reader);
+			break;
+		}
+	}
+
+	checkLibXMLError();
+
+	if(!root_elem)
+	{
+		closeXMLFileStream();
+		throw Exception(ErrorCode::OprNotAllocatedElementTree,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+	}
+}
+
+bool XmlParser::readNextStreamElement()
+{
+	if(!xml_reader || !root_elem)
+		throw Exception(ErrorCode::OprNotAllocatedElementTree,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	int ret = 0, depth = 0;
+	xmlNode *node = nullptr;
+
+	while(!elems_stack.empty())
+		elems_stack.pop();
+
+	/* When positioned on the root element the reader needs to step into its children,
+	 * otherwise we skip the subtree of the current element going to the next sibling.
+	 * The reader's depth is used since the current element may have been changed by the navigation methods */
+	if(xmlTextReaderDepth(xml_reader) == 0)
+	{
+		// The root element is empty
+		if(xmlTextReaderIsEmptyElement(xml_reader) == 1)
+			ret = 0;
+		else
+			ret = xmlTextReaderRead(xml_reader);
+	}
+	else
+		ret = xmlTextReaderNext(xml_reader);
+
+	while(ret == 1)
+	{
+		checkLibXMLError();
+		depth = xmlTextReaderDepth(xml_reader);
+
+		// Reached the end of the root element
+		if(depth <= 0)
+			break;
+
+		if(depth == 1 && xmlTextReaderNodeType(xml_reader) == XML_READER_TYPE_ELEMENT)
+		{
+			node = xmlTextReaderExpand(xml_reader);
+			checkLibXMLError();
+
+			if(!node)
+				break;
+
+			curr_elem = node;
+
+			if(curr_elem->line > curr_line)
+				curr_line = curr_elem->line;
+
+			return true;
+		}
+
+		ret = xmlTextReaderNext(xml_reader);
+	}
+
+	checkLibXMLError();
+
+	//The whole document was read, so the stream and the element tree are discarded
+	restartParser();
+	return false;
+}
+
+int XmlParser::getStreamProgress()
+{
+	qint64 total = stream_prolog.size() + stream_size;
+
+	if(!xml_reader || total <= 0)
+		return 0;
+
+	return static_cast<int>((xmlTextReaderByteConsumed(xml_reader) / static_cast<double>(total)) * 100);
+}
+
+void XmlParser::closeXMLFileStream()
+{
+	if(xml_reader)
+	{
+		xmlFreeTextReader(xml_reader);
+		xml_reader = nullptr;
+	}
+
+	if(stream_file.isOpen())
+	{
+		if(stream_map)
+			stream_file.unmap(stream_map);
+
+		stream_file.close();
+	}
+
+	stream_prolog.clear();
+	stream_map = nullptr;
+	stream_data = nullptr;
+	stream_size = stream_pos = 0;
+}
+
 void XmlParser::readBuffer()
 {
 	QByteArray buffer;
-	QString msg, file;
-	xmlError *xml_error=nullptr;
 	int parser_opt;
 
 	if(!xml_buffer.isEmpty())
@@ -169,8 +433,12 @@ void XmlParser::readBuffer()
 			//Inserts the default software DTD declarion into XML buffer
 			buffer+=dtd_decl.toUtf8();
 
-			//Now configures the parser to validate the buffer against the DTD
-			parser_opt=(parser_opt | XML_PARSE_DTDLOAD | XML_PARSE_DTDVALID);
+			/* Now configures the parser to load the DTD and validate the buffer against it.
+			 * The DTD is always loaded so the default values of the attributes are applied */
+			parser_opt=(parser_opt | XML_PARSE_DTDLOAD);
+
+			if(dtd_validation)
+				parser_opt=(parser_opt | XML_PARSE_DTDVALID);
 		}
 
 		buffer+=xml_buffer.toUtf8();
@@ -179,25 +447,7 @@ void XmlParser::readBuffer()
 		xml_doc=xmlReadMemory(buffer.data(), buffer.size(),	nullptr, nullptr, parser_opt);
 
 		//In case the document criation fails, gets the last xml parser error
-		xml_error=xmlGetLastError();
-
-		//If some error is set
-		if(xml_error)
-		{
-			//Formats the error
-			msg=xml_error->message;
-			file=xml_error->file;
-			if(!file.isEmpty()) file=QString("(%1)").arg(file);
-			msg.replace("\n"," ");
-
-			//Restarts the parser
-			if(xml_doc) restartParser();
-
-			//Raise an exception with the error massege from the parser xml
-			throw Exception(Exception::getErrorMessage(ErrorCode::LibXMLError)
-							.arg(xml_error->line).arg(xml_error->int2).arg(msg).arg(file),
-							ErrorCode::LibXMLError,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-		}
+		checkLibXMLError();
 
 		//Gets the referênce to the root element on the document
 		root_elem=curr_elem=xmlDocGetRootElement(xml_doc);
@@ -230,7 +480,7 @@ void XmlParser::restorePosition(const xmlNode *elem)
 {
 	if(!elem)
 		throw Exception(ErrorCode::OprNotAllocatedElement,__PRETTY_FUNCTION__,__FILE__,__LINE__);
-	else if(elem->doc!=xml_doc)
+	else if(elem->doc!=(xml_doc ? xml_doc : (root_elem ? root_elem->doc : nullptr)))
 		throw Exception(ErrorCode::OprInexistentElement,__PRETTY_FUNCTION__,__FILE__,__LINE__);
 
 	restartNavigation();
@@ -252,6 +502,9 @@ void XmlParser::restartParser()
 {
 	root_elem=curr_elem=nullptr;
 	curr_line = 0;
+	dtd_validation = true;
+
+	closeXMLFileStream();
 
 	if(xml_doc)
 	{
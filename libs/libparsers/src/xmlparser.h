@@ -28,6 +28,7 @@
 
 #include <libxml/parser.h>
 #include <libxml/tree.h>
+#include <libxml/xmlreader.h>
 #include "schemaparser.h"
 #include "exception.h"
 #include <stack>
@@ -48,6 +49,29 @@ class XmlParser {
 		//! \brief Stores the xml document (element tree) generated after the buffer reading
 		xmlDoc *xml_doc;
 
+		//! \brief Reader used to parse a file element by element (see openXMLFileStream())
+		xmlTextReader *xml_reader;
+
+		//! \brief File being parsed in streaming mode. Its contents are memory-mapped instead of loaded in a buffer
+		QFile stream_file;
+
+		//! \brief Declarations (xml + dtd) served to the reader before the mapped contents of the file
+		QByteArray stream_prolog;
+
+		//! \brief Memory region where the file is mapped
+		uchar *stream_map;
+
+		//! \brief Contents of the mapped file after its original xml/dtd declarations
+		const char *stream_data;
+
+		//! \brief Size of the mapped contents and current read position in prolog + mapped contents
+		qint64 stream_size, stream_pos;
+
+		/*! \brief Indicates if the documents must be validated against the configured DTD (default).
+		 * When false the DTD is still loaded (so the default attributes values are applied) but
+		 * the elements are not validated, which is considerably faster on huge documents */
+		bool dtd_validation;
+
 		//! \brief Stores the approximated line position on the current parsed buffer
 		int curr_line;
 
@@ -81,6 +105,15 @@ class XmlParser {
 		 generated from the XML document read. */
 		void readBuffer();
 
+		//! \brief Raises an exception if libxml2 registered an error during the last parsing operation
+		void checkLibXMLError();
+
+		//! \brief Callback used by the reader to consume the prolog and the mapped file in chunks
+		static int readStreamChunk(void *parser, char *buffer, int len);
+
+		//! \brief Frees the reader and unmaps the file used in streaming mode
+		void closeXMLFileStream();
+
 	public:
 		//! \brief Constants used to referência the elements on the element tree
 		static constexpr unsigned RootElement=0,
@@ -110,6 +143,24 @@ class XmlParser {
 		//! \brief Informs the DTD file used to make element validations
 		void setDTDFile(const QString &dtd_file, const QString &dtd_name);
 
+		/*! \brief Enables/disables the validation of the documents against the DTD file.
+		 * This setting is reset to true when the parser is restarted */
+		void setDTDValidation(bool value);
+
+		/*! \brief Opens a file in streaming mode: the file is memory-mapped and parsed incrementally by a
+		 * xmlTextReader instead of having the whole element tree created at once. After opening, the current element
+		 * is the root one. The children of the root must be visited via readNextStreamElement() which makes the
+		 * complete subtree of the visited element available to the navigation methods. The subtrees already
+		 * visited are freed as the reading advances, so they must not be accessed anymore */
+		void openXMLFileStream(const QString &filename);
+
+		/*! \brief Moves the stream to the next child element of the root element. Returns false when
+		 * there are no more elements, in that case the stream is closed and the parser is reset */
+		bool readNextStreamElement();
+
+		//! \brief Returns the percentage of the file consumed by the stream
+		int getStreamProgress();
+
 		//! \brief Saves to stack the current navigation position on the element tree
 		void savePosition();
 
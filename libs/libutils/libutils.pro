@@ -9,13 +9,17 @@ HEADERS += src/exception.h \
            src/pgsqlversions.h \
 	   src/doublenan.h \
 	   src/application.h \
-	   src/utilsns.h
+	   src/utilsns.h \
+	   src/progressreporter.h \
+	   src/csvreader.h
 
 SOURCES += src/exception.cpp \
            src/globalattributes.cpp \
 	   src/pgsqlversions.cpp \
 	   src/application.cpp \
-	   src/utilsns.cpp
+	   src/utilsns.cpp \
+	   src/progressreporter.cpp \
+	   src/csvreader.cpp
 
 # Deployment settings
 target.path = $$PRIVATELIBDIR
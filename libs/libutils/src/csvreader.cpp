@@ -0,0 +1,297 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2022 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "csvreader.h"
+#include "exception.h"
+
+CsvReader::CsvReader(QChar separator, QChar text_delim, bool cols_in_first_row) : decoder(QStringConverter::Utf8)
+{
+	chunk_size = DefaultChunkSize;
+	setFormat(separator, text_delim, cols_in_first_row);
+}
+
+void CsvReader::setFormat(QChar separator, QChar text_delim, bool cols_in_first_row)
+{
+	this->separator = separator;
+	this->text_delim = text_delim;
+	this->cols_in_first_row = cols_in_first_row;
+	reset();
+
+	if(input.isOpen())
+		input.seek(0);
+}
+
+void CsvReader::setChunkSize(qint64 size)
+{
+	chunk_size = (size > 0 ? size : DefaultChunkSize);
+}
+
+void CsvReader::reset()
+{
+	state = FieldStart;
+	cols_read = finished = pending_escape = skip_lf = false;
+	columns.clear();
+	row.clear();
+	field.clear();
+	chunk.clear();
+	chunk_pos = 0;
+	bytes_read = 0;
+	decoder.resetState();
+}
+
+void CsvReader::setFile(const QString &filename)
+{
+	input.close();
+	input.setFileName(filename);
+
+	if(!input.open(QFile::ReadOnly))
+		throw Exception(Exception::getErrorMessage(ErrorCode::FileDirectoryNotAccessed).arg(filename),
+										ErrorCode::FileDirectoryNotAccessed,__PRETTY_FUNCTION__,__FILE__,__LINE__);
+
+	reset();
+}
+
+void CsvReader::setBuffer(const QString &buffer)
+{
+	input.close();
+	input.setFileName("");
+	reset();
+	chunk = buffer;
+}
+
+bool CsvReader::readChunk()
+{
+	QByteArray buffer;
+
+	if(!input.isOpen())
+		return false;
+
+	buffer = input.read(chunk_size);
+
+	if(buffer.isEmpty())
+	{
+		input.close();
+		return false;
+	}
+
+	bytes_read += buffer.size();
+	chunk = decoder.decode(buffer);
+	chunk_pos = 0;
+
+	/* The chunk may end in the middle of a multibyte character, in that case the
+	 * decoder holds its bytes and returns an empty string so we read the next chunk */
+	return !chunk.isEmpty() || readChunk();
+}
+
+void CsvReader::finishField()
+{
+	row.append(field.trimmed());
+	field.clear();
+	state = FieldStart;
+}
+
+bool CsvReader::parseRow(QStringList &values)
+{
+	QChar chr;
+
+	if(finished)
+		return false;
+
+	while(true)
+	{
+		if(chunk_pos >= chunk.size() && !readChunk())
+		{
+			finished = true;
+
+			if(pending_escape)
+			{
+				field += QChar('\\');
+				pending_escape = false;
+			}
+
+			// The data ended without a line break at the last row
+			if(row.isEmpty() && field.trimmed().isEmpty())
+				return false;
+
+			finishField();
+			values.swap(row);
+			row.clear();
+			return true;
+		}
+
+		chr = chunk.at(chunk_pos++);
+
+		if(skip_lf)
+		{
+			skip_lf = false;
+
+			if(chr == QChar::LineFeed)
+				continue;
+		}
+
+		if(pending_escape)
+		{
+			pending_escape = false;
+
+			// Escaped separators and delimiters are always part of the value
+			if(chr == separator || (!text_delim.isNull() && chr == text_delim))
+			{
+				field += chr;
+				continue;
+			}
+
+			field += QChar('\\');
+		}
+
+		if(chr == QChar('\\'))
+		{
+			if(state != QuotedField)
+				state = UnquotedField;
+
+			pending_escape = true;
+			continue;
+		}
+
+		// A delimiter right after another one inside a delimited value is a literal delimiter ("")
+		if(state == QuoteInQuotedField)
+		{
+			if(chr == text_delim)
+			{
+				field += chr;
+				state = QuotedField;
+				continue;
+			}
+
+			state = UnquotedField;
+		}
+
+		if(state == QuotedField)
+		{
+			if(chr == text_delim)
+				state = QuoteInQuotedField;
+			else
+				field += chr;
+
+			continue;
+		}
+
+		if(state == FieldStart)
+		{
+			// Starting a delimited value (the spaces before the opening delimiter are discarded)
+			if(!text_delim.isNull() && chr == text_delim)
+			{
+				field.clear();
+				state = QuotedField;
+				continue;
+			}
+
+			if(chr == QChar(' ') && separator != chr)
+			{
+				field += chr;
+				continue;
+			}
+
+			state = UnquotedField;
+		}
+
+		if(chr == separator)
+			finishField();
+		else if(chr == QChar::CarriageReturn || chr == QChar::LineFeed)
+		{
+			skip_lf = (chr == QChar::CarriageReturn);
+			finishField();
+
+			// Ignoring empty rows
+			if(row.size() == 1 && row.at(0).isEmpty())
+			{
+				row.clear();
+				continue;
+			}
+
+			values.swap(row);
+			row.clear();
+			return true;
+		}
+		// Stray delimiters in non delimited values are discarded
+		else if(text_delim.isNull() || chr != text_delim)
+			field += chr;
+	}
+}
+
+QStringList CsvReader::getColumns()
+{
+	if(cols_in_first_row && !cols_read)
+	{
+		parseRow(columns);
+		cols_read = true;
+	}
+
+	return columns;
+}
+
+QList<QStringList> CsvReader::readRows(int max_rows)
+{
+	QList<QStringList> rows;
+	QStringList values;
+
+	// Making sure the first row isn't returned as data when it contains the columns names
+	getColumns();
+
+	while((max_rows <= 0 || rows.size() < max_rows) && parseRow(values))
+	{
+		rows.append(values);
+		values.clear();
+	}
+
+	return rows;
+}
+
+bool CsvReader::atEnd()
+{
+	if(finished)
+		return true;
+
+	getColumns();
+
+	/* Since the data may end with empty rows, the reader is considered at
+	 * the end only when there are no more characters left to be parsed */
+	while(chunk_pos < chunk.size() || readChunk())
+	{
+		QChar chr = chunk.at(chunk_pos);
+
+		if(state != FieldStart || !row.isEmpty() || !field.isEmpty() ||
+			 (chr != QChar::LineFeed && chr != QChar::CarriageReturn))
+			return false;
+
+		skip_lf = false;
+		chunk_pos++;
+	}
+
+	finished = (state == FieldStart && row.isEmpty() && field.isEmpty() && !pending_escape);
+	return finished;
+}
+
+qint64 CsvReader::getBytesRead()
+{
+	return bytes_read;
+}
+
+qint64 CsvReader::getTotalBytes()
+{
+	return input.fileName().isEmpty() ? 0 : input.size();
+}
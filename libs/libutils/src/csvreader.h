@@ -0,0 +1,150 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2022 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libutils
+\class CsvReader
+\brief Implements an incremental csv parser that reads files in chunks and returns the rows in batches.
+*/
+
+#ifndef CSV_READER_H
+#define CSV_READER_H
+
+#include <QFile>
+#include <QStringList>
+#include <QStringDecoder>
+
+/*! \brief The reader parses the data character by character using a small state machine, so the whole
+ * file is never loaded in memory: only the current chunk (see setChunkSize()) and the rows returned
+ * by readRows() are kept. The parsing follows the RFC 4180 plus the rules used by pgModeler since its early versions:
+ *
+ * - Rows can be terminated by LF, CR+LF or CR. Empty rows are ignored;
+ * - Values enclosed by the text delimiter can contain separators and line breaks. A doubled text delimiter
+ *   inside a delimited value is read as a single delimiter;
+ * - The text delimiter and the separator can be escaped with a backslash (e.g. \" and \;) anywhere in the data;
+ * - Spaces around the values are removed.
+ *
+ * Example:
+ *
+ * CsvReader reader(';', '"', true);
+ * reader.setFile("data.csv");
+ * cols = reader.getColumns();
+ *
+ * while(!reader.atEnd())
+ *		rows = reader.readRows(1000); */
+class CsvReader {
+	public:
+		//! \brief Default amount of bytes read from the file at once
+		static constexpr qint64 DefaultChunkSize = 1048576;
+
+	private:
+		enum ParserState {
+			FieldStart,
+			UnquotedField,
+			QuotedField,
+			QuoteInQuotedField
+		};
+
+		QChar separator, text_delim;
+
+		//! \brief Indicates that the first row of the data contains the columns names
+		bool cols_in_first_row,
+
+		//! \brief Indicates that the columns names were already read
+		cols_read,
+
+		//! \brief Indicates that all the data was parsed
+		finished,
+
+		//! \brief Indicates that the last character was a backslash that may escape the next one
+		pending_escape,
+
+		//! \brief Indicates that the last character was a CR so a following LF must be ignored
+		skip_lf;
+
+		ParserState state;
+
+		QStringList columns,
+
+		//! \brief The values of the row being parsed
+		row;
+
+		//! \brief The value being parsed
+		QString field;
+
+		//! \brief The file being read (when the data comes from a file)
+		QFile input;
+
+		//! \brief Converts the chunks read from the file to text keeping the state of incomplete multibyte characters between them
+		QStringDecoder decoder;
+
+		//! \brief The decoded chunk being parsed
+		QString chunk;
+
+		//! \brief The position of the next character to be parsed in the chunk
+		qsizetype chunk_pos;
+
+		qint64 chunk_size, bytes_read;
+
+		//! \brief Reads the next chunk from the file. Returns false when there's no more data to be parsed
+		bool readChunk();
+
+		//! \brief Appends the current value to the row being parsed
+		void finishField();
+
+		//! \brief Parses the next non-empty row storing its values in the provided list. Returns false if there are no more rows
+		bool parseRow(QStringList &values);
+
+		//! \brief Resets the parser state
+		void reset();
+
+	public:
+		CsvReader(QChar separator = ';', QChar text_delim = '"', bool cols_in_first_row = false);
+
+		/*! \brief Configures the characters used to separate and delimit the values. A null text delimiter
+		 * disables the delimited values. Changing the format resets the reader */
+		void setFormat(QChar separator, QChar text_delim, bool cols_in_first_row);
+
+		//! \brief Defines the amount of bytes read from the file each time the reader needs more data
+		void setChunkSize(qint64 size);
+
+		//! \brief Configures the reader to parse the provided file (UTF-8 encoded)
+		void setFile(const QString &filename);
+
+		//! \brief Configures the reader to parse the provided buffer
+		void setBuffer(const QString &buffer);
+
+		/*! \brief Returns the columns names extracted from the first row of the data.
+		 * Returns an empty list if the reader is not configured to extract them */
+		QStringList getColumns();
+
+		/*! \brief Returns the next rows of the data. At most max_rows are returned,
+		 * when zero is used all the remaining rows are returned at once */
+		QList<QStringList> readRows(int max_rows = 0);
+
+		//! \brief Returns if all the rows were read
+		bool atEnd();
+
+		//! \brief Returns the amount of bytes read from the file so far (useful to compute the progress of the reading)
+		qint64 getBytesRead();
+
+		//! \brief Returns the size in bytes of the file being read (zero if reading a buffer)
+		qint64 getTotalBytes();
+};
+
+#endif
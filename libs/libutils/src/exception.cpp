@@ -17,6 +17,7 @@
 */
 #include "exception.h"
 #include <QApplication>
+#include <algorithm>
 
 QString Exception::messages[Exception::ErrorCount][2]={
 	{"Custom", QString(" ")},
@@ -276,7 +277,9 @@ QString Exception::messages[Exception::ErrorCount][2]={
 	{"ExportFailureDbSQLDisabled", QT_TR_NOOP("The SQL code of the database `%1' is disabled! The export process can't proceed. Please, enable the SQL code of the mentioned object and try again.")},
 	{"InvConfigParameterName", QT_TR_NOOP("Invalid configuration parameter `%1' assigned to the function `%2'!")},
 	{"EmptyConfigParameterValue", QT_TR_NOOP("Empty value assigned to the configuration parameter `%1' in the function `%2'!")},
-	{"InvGroupRegExpPattern", QT_TR_NOOP("Invalid regexp pattern detected in syntax highlighting group `%1' at file `%2'! Error detected: `%3'")}
+	{"InvGroupRegExpPattern", QT_TR_NOOP("Invalid regexp pattern detected in syntax highlighting group `%1' at file `%2'! Error detected: `%3'")},
+	{"ObjectSQLValidationFailure", QT_TR_NOOP("Failed to create the object `%1' (%2) while validating the SQL code of the model! Check the error(s) below for details.")},
+	{"MultipleStatementsExportQuery", QT_TR_NOOP("The results of the command can't be exported because it contains more than one statement! Only a single query can have its results saved to a file.")}
 };
 
 Exception::Exception()
@@ -284,13 +287,13 @@ Exception::Exception()
 	configureException("",ErrorCode::Custom,"","",-1,"");
 }
 
-Exception::Exception(const QString &msg, const QString &method, const QString &file, int line, Exception *exception, const QString &extra_info)
+Exception::Exception(const QString &msg, const char *method, const char *file, int line, Exception *exception, const QString &extra_info)
 {
 	configureException(msg,ErrorCode::Custom, method, file, line, extra_info);
 	if(exception) addException(*exception);
 }
 
-Exception::Exception(ErrorCode error_code, const QString &method, const QString &file, int line, Exception *exception, const QString &extra_info)
+Exception::Exception(ErrorCode error_code, const char *method, const char *file, int line, Exception *exception, const QString &extra_info)
 {
 	/* Because the Exception class is not derived from QObject the function tr() is inefficient to translate messages
 		so the translation method is called  directly from the application specifying the
@@ -301,60 +304,53 @@ Exception::Exception(ErrorCode error_code, const QString &method, const QString
 	if(exception) addException(*exception);
 }
 
-Exception::Exception(const QString &msg, ErrorCode error_code, const QString &method, const QString &file, int line, Exception *exception, const QString &extra_info)
+Exception::Exception(const QString &msg, ErrorCode error_code, const char *method, const char *file, int line, Exception *exception, const QString &extra_info)
 {
 	configureException(msg,error_code, method, file, line, extra_info);
 	if(exception) addException(*exception);
 }
 
-Exception::Exception(ErrorCode error_code, const QString &method, const QString &file, int line, std::vector<Exception> &exceptions, const QString &extra_info)
+Exception::Exception(ErrorCode error_code, const char *method, const char *file, int line, std::vector<Exception> &exceptions, const QString &extra_info)
 {
-	std::vector<Exception>::iterator itr, itr_end;
-
 	/* Because the Exception class is not derived from QObject the function tr() is inefficient to translate messages
 		so the translation method is called  directly from the application specifying the
 		context (Exception) in the ts file and the text to be translated */
 	configureException(QApplication::translate("Exception",messages[enum_cast(error_code)][ErrorMessage].toStdString().c_str(),"",-1),
 						 error_code, method, file, line, extra_info);
 
-	itr=exceptions.begin();
-	itr_end=exceptions.end();
-	while(itr!=itr_end)
-	{
-		addException((*itr));
-		itr++;
-	}
+	for(auto &ex : exceptions)
+		addException(ex);
 }
 
-Exception::Exception(const QString &msg, const QString &method, const QString &file, int line, std::vector<Exception> &exceptions, const QString &extra_info)
+Exception::Exception(const QString &msg, const char *method, const char *file, int line, std::vector<Exception> &exceptions, const QString &extra_info)
 {
-	std::vector<Exception>::iterator itr, itr_end;
-
 	configureException(msg,ErrorCode::Custom, method, file, line, extra_info);
 
-	itr=exceptions.begin();
-	itr_end=exceptions.end();
-	while(itr!=itr_end)
-	{
-		addException((*itr));
-		itr++;
-	}
+	for(auto &ex : exceptions)
+		addException(ex);
 }
 
-Exception::Exception(const QString &msg, ErrorCode error_code, const QString &method, const QString &file, int line, std::vector<Exception> &exceptions, const QString &extra_info)
+Exception::Exception(const QString &msg, ErrorCode error_code, const char *method, const char *file, int line, std::vector<Exception> &exceptions, const QString &extra_info)
 {
-	std::vector<Exception>::iterator itr=exceptions.begin();
-
 	configureException(msg,error_code, method, file, line, extra_info);
 
-	while(itr!=exceptions.end())
+	for(auto &ex : exceptions)
+		addException(ex);
+}
+
+Exception::~Exception(void)
+{
+	std::shared_ptr<const Exception> prev = std::move(prev_exception), next;
+
+	// While the previous exception is referenced only by this chain its own previous exception is detached before destroying it
+	while(prev && prev.use_count() == 1)
 	{
-		addException(*itr);
-		itr++;
+		next = prev->prev_exception;
+		prev = std::move(next);
 	}
 }
 
-void Exception::configureException(const QString &msg, ErrorCode error_code, const QString &method, const QString &file, int line, const QString &extra_info)
+void Exception::configureException(const QString &msg, ErrorCode error_code, const char *method, const char *file, int line, const QString &extra_info)
 {
 	this->error_code = error_code;
 	this->error_msg = msg;
@@ -390,12 +386,12 @@ QString Exception::getErrorCode(ErrorCode error_code)
 
 QString Exception::getMethod()
 {
-	return method;
+	return QString(method);
 }
 
 QString Exception::getFile()
 {
-	return file;
+	return QString(file);
 }
 
 QString Exception::getLine()
@@ -413,32 +409,52 @@ QString Exception::getExtraInfo()
 	return extra_info;
 }
 
-void Exception::addException(Exception &exception)
+void Exception::addException(const Exception &exception)
 {
-	std::vector<Exception>::iterator itr, itr_end;
+	std::vector<const Exception *> chain;
+	std::shared_ptr<const Exception> prev;
+
+	/* When there's no previous exception (the common case of rethrowing a single exception)
+	 * the provided one is only shared, which costs the same no matter the size of its chain */
+	if(!prev_exception)
+	{
+		prev_exception = std::make_shared<const Exception>(exception);
+		return;
+	}
 
-	itr=exception.exceptions.begin();
-	itr_end=exception.exceptions.end();
+	/* Otherwise (when several exceptions are added, see the constructors that receive a vector),
+	 * the exceptions in the provided chain are recreated on top of the current chain */
+	for(const Exception *ex = &exception; ex; ex = ex->prev_exception.get())
+		chain.push_back(ex);
 
-	for(auto &itr : exception.exceptions)
+	prev = prev_exception;
+
+	for(auto itr = chain.rbegin(); itr != chain.rend(); itr++)
 	{
-		this->exceptions.push_back(Exception(itr.error_msg,itr.error_code,
-																				 itr.method, itr.file, itr.line, nullptr,
-																				 itr.extra_info));
+		Exception ex = (*itr)->getDetached();
+		ex.prev_exception = prev;
+		prev = std::make_shared<const Exception>(ex);
 	}
 
-	exception.exceptions.clear();
+	prev_exception = prev;
+}
 
-	this->exceptions.push_back(Exception(exception.error_msg,exception.error_code,
-																			 exception.method,exception.file,exception.line,
-																			 nullptr,exception.extra_info));
+Exception Exception::getDetached() const
+{
+	Exception ex = *this;
+	ex.prev_exception.reset();
+	return ex;
 }
 
 void Exception::getExceptionsList(std::vector<Exception> &list)
 {
-	list.assign(this->exceptions.begin(), this->exceptions.end());
-	list.push_back(Exception(this->error_msg,this->error_code,
-							 this->method,this->file,this->line,nullptr,this->extra_info));
+	list.clear();
+
+	// The list starts with the first raised exception and ends with 'this'
+	for(const Exception *ex = this; ex; ex = ex->prev_exception.get())
+		list.push_back(ex->getDetached());
+
+	std::reverse(list.begin(), list.end());
 }
 
 QString Exception::getExceptionsText()
@@ -489,10 +505,10 @@ QString Exception::getExceptiosExtraInfo()
 {
 	QStringList list;
 
-	for(auto &ex : exceptions)
-		list.prepend(ex.extra_info);
+	// Walking from the last raised exception to the first one
+	for(const Exception *ex = this; ex; ex = ex->prev_exception.get())
+		list.append(ex->extra_info);
 
-	list.prepend(extra_info);
 	list.removeAll("");
 	list.removeDuplicates();
 
@@ -32,6 +32,7 @@
 #include <signal.h>
 #include <vector>
 #include <deque>
+#include <memory>
 #include <type_traits>
 
 //! \brief This function causes the provided enum to be converted to its underlying datatype
@@ -300,16 +301,20 @@ enum class ErrorCode: unsigned {
 	ExportFailureDbSQLDisabled,
 	InvConfigParameterName,
 	EmptyConfigParameterValue,
-	InvGroupRegExpPattern
+	InvGroupRegExpPattern,
+	ObjectSQLValidationFailure,
+	MultipleStatementsExportQuery
 };
 
 class Exception {
 	private:
-		static constexpr unsigned ErrorCount=258;
+		static constexpr unsigned ErrorCount=260;
 
-		/*! \brief Stores other exceptions before raise the 'this' exception.
-		 This structure can be used to simulate a stack trace to improve the debug */
-		std::vector<Exception> exceptions;
+		/*! \brief Stores the exception that was raised before the 'this' exception (which in turn references the
+		 ones raised before it). This structure can be used to simulate a stack trace to improve the debug.
+		 Since the exceptions in the chain are never changed they are shared between all the exceptions that
+		 wrap them, so rethrowing an exception (see the constructors) doesn't copy the whole chain */
+		std::shared_ptr<const Exception> prev_exception;
 
 		//! \brief Stores the error messages and codes (names of errors) in string format
 		static QString messages[ErrorCount][2];
@@ -322,40 +327,47 @@ class Exception {
 
 		//! \brief Formated error message
 		QString error_msg,
-		/*! \brief Holds the class name and method which was
-						triggered the exception. For this to be possible, at the time
-						instantiation of this class the  G++ macro __ PRETTY_FUNCTION__
-						must be passed. This macro contains the format [RETURN][CLASS]::[METHOD][PARAMS] */
-		method,
-
-		//! \brief File where the exception was generated (Macro __ FILE__)
-		file,
 
 		/*! \brief Additional information (optional) may store any other
 						type of information that is interesting on attempt to resolve the error */
 		extra_info;
 
+		/*! \brief Holds the class name and method which was
+						triggered the exception. For this to be possible, at the time
+						instantiation of this class the  G++ macro __ PRETTY_FUNCTION__
+						must be passed. This macro contains the format [RETURN][CLASS]::[METHOD][PARAMS].
+						Only the address of the string is stored so it must have static storage (as the macro has) */
+		const char *method,
+
+		//! \brief File where the exception was generated (Macro __ FILE__). The same storage rule of method applies
+		*file;
+
 		//! \brief Line of file where the exception were generated (Macro __LINE__)
 		int line;
 
 		//! \brief Configures the basic attributes of exception
-		void configureException(const QString &msg, ErrorCode error_code, const QString &method, const QString &file, int line, const QString &extra_info);
+		void configureException(const QString &msg, ErrorCode error_code, const char *method, const char *file, int line, const QString &extra_info);
+
+		//! \brief Makes the provided exception (and the ones raised before it) the previous exceptions of 'this'
+		void addException(const Exception &exception);
 
-		//! \brief Adds a exception to the list of exceptions
-		void addException(Exception &exception);
+		//! \brief Returns a copy of the exception without the previous exceptions chain
+		Exception getDetached() const;
 
 	public:
 		static unsigned constexpr MaximumStackSize = 50;
 
 		Exception();
-		Exception(const QString &msg, const QString &method, const QString &file, int line, Exception *exception=nullptr, const QString &extra_info="");
-		Exception(const QString &msg, const QString &method, const QString &file, int line, std::vector<Exception> &exceptions, const QString &extra_info="");
-		Exception(const QString &msg, ErrorCode error_code, const QString &method, const QString &file, int line, Exception *exception=nullptr, const QString &extra_info="");
-		Exception(const QString &msg, ErrorCode error_code, const QString &method, const QString &file, int line, std::vector<Exception> &exceptions, const QString &extra_info="");
-		Exception(ErrorCode error_code, const QString &method, const QString &file, int line, Exception *exception=nullptr, const QString &extra_info="");
-		Exception(ErrorCode error_code, const QString &method, const QString &file, int line, std::vector<Exception> &exceptions, const QString &extra_info="");
+		Exception(const QString &msg, const char *method, const char *file, int line, Exception *exception=nullptr, const QString &extra_info="");
+		Exception(const QString &msg, const char *method, const char *file, int line, std::vector<Exception> &exceptions, const QString &extra_info="");
+		Exception(const QString &msg, ErrorCode error_code, const char *method, const char *file, int line, Exception *exception=nullptr, const QString &extra_info="");
+		Exception(const QString &msg, ErrorCode error_code, const char *method, const char *file, int line, std::vector<Exception> &exceptions, const QString &extra_info="");
+		Exception(ErrorCode error_code, const char *method, const char *file, int line, Exception *exception=nullptr, const QString &extra_info="");
+		Exception(ErrorCode error_code, const char *method, const char *file, int line, std::vector<Exception> &exceptions, const QString &extra_info="");
 
-		~Exception(void){}
+		/*! \brief Releases the previous exceptions iteratively (instead of recursively through the
+		 shared pointers) so destroying long chains can't exhaust the stack */
+		~Exception(void);
 		QString getErrorMessage();
 		static QString getErrorMessage(ErrorCode error_code);
 		static QString getErrorCode(ErrorCode error_code);
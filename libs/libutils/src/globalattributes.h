@@ -95,6 +95,7 @@ class GlobalAttributes {
 		BugReportFile,
 		StacktraceFile,
 		LastModelFile,
+		TrustedModelsFile, //! \brief File that stores the content hashes of the models saved by pgModeler (see DatabaseModel::setTrustSavedModels())
 
 		DirSeparator,
 		DefaultConfsDir,
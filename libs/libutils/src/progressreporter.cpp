@@ -0,0 +1,155 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2022 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include "progressreporter.h"
+
+ProgressReporter::ScopedPhase::ScopedPhase(ProgressReporter &rep, const QString &name) : reporter(rep)
+{
+	reporter.beginPhase(name);
+}
+
+ProgressReporter::ScopedPhase::~ScopedPhase()
+{
+	reporter.endPhase();
+}
+
+ProgressReporter::ProgressReporter(unsigned max_updates)
+{
+	setMaxUpdatesPerSecond(max_updates);
+	reset();
+}
+
+void ProgressReporter::setMaxUpdatesPerSecond(unsigned max_updates)
+{
+	min_interval = (max_updates == 0 ? 0 : 1000 / max_updates);
+}
+
+void ProgressReporter::reset()
+{
+	QMutexLocker locker(&phase_mutex);
+
+	timer.start();
+	last_report = -1;
+	items_count = discarded_count = 0;
+	phases.clear();
+	running_phases.clear();
+	phases_start.clear();
+	phases_items.clear();
+}
+
+void ProgressReporter::beginPhase(const QString &name)
+{
+	QMutexLocker locker(&phase_mutex);
+
+	/* Objects that live for a long time (e.g. the database model) start phases on every operation
+	 * without being reset, so the oldest finished phases are discarded to keep the list bounded.
+	 * This is done only between top-level phases so the indexes of the running phases stay valid */
+	if(running_phases.empty() && phases.size() >= MaxStoredPhases)
+	{
+		auto itr = phases.begin() + (phases.size() - (MaxStoredPhases / 2));
+
+		while(itr != phases.end() && itr->depth != 0)
+			itr++;
+
+		phases.erase(phases.begin(), itr);
+	}
+
+	/* The phase is stored right away so the timings are listed in the order
+	 * the phases started (nested phases appear right after their parents) */
+	phases.push_back({ name, static_cast<unsigned>(running_phases.size()), 0, 0 });
+	running_phases.push_back(phases.size() - 1);
+	phases_start.push_back(timer.elapsed());
+	phases_items.push_back(items_count);
+
+	// Forcing the first update of the phase to be emitted
+	last_report = -1;
+}
+
+void ProgressReporter::endPhase()
+{
+	QMutexLocker locker(&phase_mutex);
+
+	if(running_phases.empty())
+		return;
+
+	PhaseTiming &phase = phases[running_phases.back()];
+
+	phase.elapsed = timer.elapsed() - phases_start.back();
+	phase.items = items_count - phases_items.back();
+
+	running_phases.pop_back();
+	phases_start.pop_back();
+	phases_items.pop_back();
+}
+
+bool ProgressReporter::isReportDue(int progress)
+{
+	qint64 now = 0, last = 0, interval = min_interval;
+
+	items_count++;
+
+	if(interval == 0 || progress >= 100)
+	{
+		last_report = timer.elapsed();
+		return true;
+	}
+
+	now = timer.elapsed();
+	last = last_report;
+
+	/* When several threads share the same reporter only the one
+	 * that succeeds in updating the last report time emits the update */
+	if((last < 0 || now - last >= interval) &&
+		 last_report.compare_exchange_strong(last, now))
+		return true;
+
+	discarded_count++;
+	return false;
+}
+
+void ProgressReporter::registerItem()
+{
+	items_count++;
+}
+
+unsigned ProgressReporter::getItemsCount()
+{
+	return items_count;
+}
+
+unsigned ProgressReporter::getDiscardedCount()
+{
+	return discarded_count;
+}
+
+std::vector<ProgressReporter::PhaseTiming> ProgressReporter::getPhaseTimings()
+{
+	QMutexLocker locker(&phase_mutex);
+	std::vector<PhaseTiming> timings;
+
+	// Phases still running are returned with the time elapsed so far
+	timings = phases;
+
+	for(unsigned idx = 0; idx < running_phases.size(); idx++)
+	{
+		timings[running_phases[idx]].elapsed = timer.elapsed() - phases_start[idx];
+		timings[running_phases[idx]].items = items_count - phases_items[idx];
+	}
+
+	return timings;
+}
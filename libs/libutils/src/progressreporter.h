@@ -0,0 +1,141 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2022 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+/**
+\ingroup libutils
+\class ProgressReporter
+\brief Coalesces the progress updates emitted by long-running operations and records the time spent in each phase of them.
+*/
+
+#ifndef PROGRESS_REPORTER_H
+#define PROGRESS_REPORTER_H
+
+#include <QString>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <atomic>
+#include <vector>
+
+/*! \brief The objects that emit progress signals for each processed item (DatabaseModel and the helpers in libgui)
+ * ask the reporter whether a progress update is due before building the message and emitting the signal.
+ * This way, at most N updates are emitted per second and the (translated) messages are built only when
+ * they are really going to be displayed. The items whose updates were discarded are counted so
+ * the totals of each phase are still available when the operation finishes.
+ *
+ * Example:
+ *
+ * ProgressReporter::ScopedPhase phase(progress_rep, "Load objects");
+ *
+ * if(progress_rep.isReportDue(progress))
+ *		emit s_objectLoaded(progress, tr("Loading: `%1' (%2)").arg(obj->getName()).arg(obj->getTypeName()), ...); */
+class ProgressReporter {
+	public:
+		//! \brief Stores the time spent in a phase of an operation
+		struct PhaseTiming {
+			//! \brief Name of the phase
+			QString name;
+
+			//! \brief Depth of the phase (phases can be nested)
+			unsigned depth;
+
+			//! \brief Elapsed time in milliseconds
+			qint64 elapsed;
+
+			//! \brief Amount of items processed (progress updates requested) during the phase
+			unsigned items;
+		};
+
+		//! \brief Starts a phase in the constructor and finishes it in the destructor (even if an exception is raised)
+		class ScopedPhase {
+			private:
+				ProgressReporter &reporter;
+
+			public:
+				ScopedPhase(ProgressReporter &rep, const QString &name);
+				~ScopedPhase();
+		};
+
+		//! \brief Default maximum amount of progress updates emitted per second
+		static constexpr unsigned DefaultMaxUpdates = 10;
+
+		/*! \brief Maximum amount of phase timings kept by the reporter. When a top-level phase starts and this
+		 * limit is reached, the oldest top-level phases (and their nested ones) are discarded */
+		static constexpr unsigned MaxStoredPhases = 256;
+
+	private:
+		//! \brief Measures the time since the reporter creation (or last reset)
+		QElapsedTimer timer;
+
+		//! \brief Minimum interval (in ms) between two progress updates (0 means no limit)
+		std::atomic<qint64> min_interval;
+
+		//! \brief The time (relative to the timer start) in which the last update was allowed (-1 means none)
+		std::atomic<qint64> last_report;
+
+		//! \brief Amount of items processed and updates discarded since the last reset
+		std::atomic<unsigned> items_count, discarded_count;
+
+		//! \brief Guards the phases related attributes
+		QMutex phase_mutex;
+
+		//! \brief Stores the timings of the phases in the order they started
+		std::vector<PhaseTiming> phases;
+
+		//! \brief Indexes (in phases) of the phases currently running
+		std::vector<unsigned> running_phases;
+
+		//! \brief Starting time and items count of the phases currently running
+		std::vector<qint64> phases_start;
+		std::vector<unsigned> phases_items;
+
+	public:
+		ProgressReporter(unsigned max_updates = DefaultMaxUpdates);
+
+		/*! \brief Configures the maximum amount of progress updates allowed per second.
+		 * Using zero disables the rate limit, making isReportDue() always return true */
+		void setMaxUpdatesPerSecond(unsigned max_updates);
+
+		//! \brief Clears the recorded phases and counters
+		void reset();
+
+		/*! \brief Starts a new phase. If there's another phase running the new one is nested in it.
+		 * Prefer the ScopedPhase helper so the phase is finished even when errors are raised */
+		void beginPhase(const QString &name);
+
+		//! \brief Finishes the last started phase
+		void endPhase();
+
+		/*! \brief Registers a processed item and returns true if a progress update can be emitted.
+		 * The updates in which progress reaches 100 are always allowed */
+		bool isReportDue(int progress);
+
+		/*! \brief Registers a processed item without checking the rate limit. Used by the updates that must
+		 * always be emitted (e.g. the ones carrying the object or command logged by the forms) */
+		void registerItem();
+
+		//! \brief Returns the amount of items processed since the last reset
+		unsigned getItemsCount();
+
+		//! \brief Returns the amount of discarded updates since the last reset
+		unsigned getDiscardedCount();
+
+		//! \brief Returns the timings of the recorded phases (the running ones have the time elapsed so far)
+		std::vector<PhaseTiming> getPhaseTimings();
+};
+
+#endif
@@ -0,0 +1,156 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2022 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "attribsmap.h"
+#include "attributes.h"
+
+class AttribsMapTest: public QObject {
+	private:
+		Q_OBJECT
+
+	private slots:
+		void iteratesInKeyOrder();
+		void keepsValueReferencesAfterInsertions();
+		void insertDoesNotOverwriteExistingKeys();
+		void eraseKeepsRemainingEntries();
+		void copiesOnlyCurrentEntries();
+		void keepsKeyOrderOnUnorderedInsertions();
+		void rangeInsertKeepsFirstDuplicatedKey();
+		void reusesErasedEntriesStorage();
+};
+
+void AttribsMapTest::iteratesInKeyOrder()
+{
+	attribs_map attribs = {{ Attributes::Schema, "public" }, { Attributes::Name, "table" }, { Attributes::Comment, "" }};
+	QStringList keys;
+
+	attribs[Attributes::Alias] = "alias";
+
+	for(auto &itr : attribs)
+		keys.append(itr.first);
+
+	QCOMPARE(keys, QStringList({ Attributes::Alias, Attributes::Comment, Attributes::Name, Attributes::Schema }));
+}
+
+void AttribsMapTest::keepsValueReferencesAfterInsertions()
+{
+	attribs_map attribs;
+	QString &value = attribs[Attributes::Name];
+
+	for(unsigned i = 0; i < 100; i++)
+		attribs[QString("attr-%1").arg(i)] = QString::number(i);
+
+	value = "table";
+	QCOMPARE(attribs.size(), static_cast<size_t>(101));
+	QCOMPARE(attribs.at(Attributes::Name), QString("table"));
+	QCOMPARE(attribs[QString("attr-50")], QString("50"));
+}
+
+void AttribsMapTest::insertDoesNotOverwriteExistingKeys()
+{
+	attribs_map attribs = {{ Attributes::Name, "table" }},
+			other = {{ Attributes::Name, "other" }, { Attributes::Schema, "public" }};
+
+	attribs.insert(other.begin(), other.end());
+
+	QCOMPARE(attribs.size(), static_cast<size_t>(2));
+	QCOMPARE(attribs[Attributes::Name], QString("table"));
+	QCOMPARE(attribs.insert({ Attributes::Schema, "foo" }).second, false);
+	QCOMPARE(attribs.count(Attributes::Schema), static_cast<size_t>(1));
+}
+
+void AttribsMapTest::eraseKeepsRemainingEntries()
+{
+	attribs_map attribs = {{ Attributes::Name, "table" }, { Attributes::Schema, "public" }, { Attributes::Comment, "" }};
+	attribs_map::iterator itr;
+
+	QCOMPARE(attribs.erase(Attributes::Name), static_cast<size_t>(1));
+	QCOMPARE(attribs.erase(Attributes::Name), static_cast<size_t>(0));
+	QVERIFY(attribs.find(Attributes::Name) == attribs.end());
+
+	itr = attribs.erase(attribs.find(Attributes::Comment));
+	QCOMPARE(itr->first, Attributes::Schema);
+	QCOMPARE(attribs.size(), static_cast<size_t>(1));
+}
+
+void AttribsMapTest::copiesOnlyCurrentEntries()
+{
+	attribs_map attribs, copy;
+
+	for(unsigned i = 0; i < 20; i++)
+		attribs[QString::number(i)] = QString::number(i);
+
+	for(unsigned i = 0; i < 20; i += 2)
+		attribs.erase(QString::number(i));
+
+	copy = attribs;
+	QVERIFY(copy == attribs);
+	QCOMPARE(copy.size(), static_cast<size_t>(10));
+	QCOMPARE(copy.at("11"), QString("11"));
+}
+
+void AttribsMapTest::keepsKeyOrderOnUnorderedInsertions()
+{
+	attribs_map attribs;
+	QStringList keys, sorted_keys;
+
+	// Oid-like keys inserted in descending numeric order, which isn't the lexical order of the strings
+	for(unsigned oid = 5000; oid > 0; oid--)
+		attribs[QString::number(oid * 7)] = QString::number(oid);
+
+	for(auto &itr : attribs)
+		keys.append(itr.first);
+
+	sorted_keys = keys;
+	sorted_keys.sort();
+
+	QCOMPARE(attribs.size(), static_cast<size_t>(5000));
+	QCOMPARE(keys, sorted_keys);
+	QCOMPARE(attribs.at("35"), QString("5"));
+	QCOMPARE((--attribs.end())->first, QString("9996"));
+}
+
+void AttribsMapTest::rangeInsertKeepsFirstDuplicatedKey()
+{
+	std::vector<std::pair<QString, QString>> values = {{ "b", "1" }, { "a", "2" }, { "b", "3" }, { "c", "4" }, { "a", "5" }};
+	attribs_map attribs(values.begin(), values.end());
+
+	QCOMPARE(attribs.size(), static_cast<size_t>(3));
+	QCOMPARE(attribs.begin()->first, QString("a"));
+	QCOMPARE(attribs.at("a"), QString("2"));
+	QCOMPARE(attribs.at("b"), QString("1"));
+	QCOMPARE(attribs.at("c"), QString("4"));
+}
+
+void AttribsMapTest::reusesErasedEntriesStorage()
+{
+	attribs_map attribs;
+	QString *value = &attribs[Attributes::Name];
+
+	attribs[Attributes::Schema] = "public";
+	attribs.erase(Attributes::Name);
+
+	QCOMPARE(&attribs[Attributes::Comment], value);
+	QCOMPARE(attribs.size(), static_cast<size_t>(2));
+	QVERIFY(attribs.at(Attributes::Comment).isEmpty());
+	QCOMPARE(attribs.at(Attributes::Schema), QString("public"));
+}
+
+QTEST_MAIN(AttribsMapTest)
+#include "attribsmaptest.moc"
@@ -19,6 +19,13 @@
 #include <QtTest/QtTest>
 #include "coreutilsns.h"
 #include "table.h"
+#include "schema.h"
+#include "tag.h"
+#include "role.h"
+#include "tablespace.h"
+#include <thread>
+#include <set>
+#include <map>
 
 class BaseObjectTest: public QObject {
   private:
@@ -28,6 +35,12 @@ class BaseObjectTest: public QObject {
     void quoteNameIfKeyword();
     void nameIsInvalidIfStartsWithNumber();
 		void dontFormatNameIfAlreadyQuoted();
+		void quoteNameWithUpperCaseOrExtendedChars();
+		void formattedNameFollowsRenaming();
+		void codeIsRegeneratedAfterAttributesRelease();
+		void searchAttributesAreBuiltOnDemand();
+		void objectIdsAreUniqueAcrossThreads();
+		void scopedSettingsDontLeakToOtherThreads();
 };
 
 void BaseObjectTest::quoteNameIfKeyword()
@@ -49,5 +62,143 @@ void BaseObjectTest::dontFormatNameIfAlreadyQuoted()
 	QCOMPARE(BaseObject::formatName(name), name);
 }
 
+void BaseObjectTest::quoteNameWithUpperCaseOrExtendedChars()
+{
+	QCOMPARE(BaseObject::formatName("SomeName"), QString("\"SomeName\""));
+	QCOMPARE(BaseObject::formatName("name_é"), QString("\"name_é\""));
+	QCOMPARE(BaseObject::formatName("1name"), QString("\"1name\""));
+	QCOMPARE(BaseObject::formatName("some name"), QString("\"some name\""));
+	QCOMPARE(BaseObject::formatName("some_name"), QString("some_name"));
+	QCOMPARE(BaseObject::formatName("<>", true), QString("<>"));
+	QCOMPARE(BaseObject::formatName("invalid\"name"), QString());
+}
+
+void BaseObjectTest::formattedNameFollowsRenaming()
+{
+	Schema schema;
+	Table table;
+
+	schema.setName("public");
+	table.setName("table");
+	table.setSchema(&schema);
+	QCOMPARE(table.getName(true), QString("public.\"table\""));
+	QCOMPARE(table.getSignature(), QString("public.\"table\""));
+
+	table.setName("MyTable");
+	QCOMPARE(table.getSignature(), QString("public.\"MyTable\""));
+
+	schema.setName("MySchema");
+	QCOMPARE(table.getSignature(), QString("\"MySchema\".\"MyTable\""));
+	QCOMPARE(table.getName(true, false), QString("\"MyTable\""));
+}
+
+void BaseObjectTest::codeIsRegeneratedAfterAttributesRelease()
+{
+	Schema schema;
+	QString sql_code, xml_code;
+
+	schema.setName("sch_test");
+	schema.setComment(QString("A long comment to force the cached code compression. ").repeated(20));
+
+	try
+	{
+		sql_code = schema.getCodeDefinition(SchemaParser::SqlDefinition);
+		xml_code = schema.getCodeDefinition(SchemaParser::XmlDefinition);
+
+		// Cached code
+		QCOMPARE(schema.getCodeDefinition(SchemaParser::SqlDefinition), sql_code);
+		QCOMPARE(schema.getCodeDefinition(SchemaParser::XmlDefinition), xml_code);
+
+		// Regenerated code using the attributes recreated from the registered names
+		schema.setCodeInvalidated(true);
+		QCOMPARE(schema.getCodeDefinition(SchemaParser::SqlDefinition), sql_code);
+		QCOMPARE(schema.getCodeDefinition(SchemaParser::XmlDefinition), xml_code);
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void BaseObjectTest::searchAttributesAreBuiltOnDemand()
+{
+	Schema schema;
+
+	schema.setName("sch_test");
+	schema.setComment("comment");
+	QCOMPARE(schema.getSearchAttributes()[Attributes::Name], QString("sch_test"));
+
+	schema.setName("sch_renamed");
+	QCOMPARE(schema.getSearchAttributes()[Attributes::Name], QString("sch_renamed"));
+	QCOMPARE(schema.getSearchAttributes()[Attributes::Comment], QString("comment"));
+}
+
+void BaseObjectTest::objectIdsAreUniqueAcrossThreads()
+{
+	const unsigned thread_cnt = 4, obj_cnt = 500;
+	std::vector<std::thread> threads;
+	std::vector<std::vector<BaseObject *>> objects(thread_cnt);
+	std::map<ObjectType, std::set<unsigned>> unique_ids;
+
+	for(unsigned th = 0; th < thread_cnt; th++)
+	{
+		threads.emplace_back([th, &objects](){
+			for(unsigned i = 0; i < obj_cnt; i++)
+			{
+				objects[th].push_back(new Tag);
+				objects[th].push_back(new Schema);
+				objects[th].push_back(new Role);
+				objects[th].push_back(new Tablespace);
+			}
+		});
+	}
+
+	for(auto &thread : threads)
+		thread.join();
+
+	/* Each object type has its own id sequence (that may overlap the other types' ones),
+	 * so the ids must be unique among the objects of the same type */
+	for(auto &th_objs : objects)
+	{
+		for(auto &obj : th_objs)
+		{
+			unique_ids[obj->getObjectType()].insert(obj->getObjectId());
+			delete obj;
+		}
+	}
+
+	QCOMPARE(unique_ids.size(), static_cast<size_t>(4));
+
+	for(auto &itr : unique_ids)
+		QCOMPARE(itr.second.size(), static_cast<size_t>(thread_cnt * obj_cnt));
+}
+
+void BaseObjectTest::scopedSettingsDontLeakToOtherThreads()
+{
+	QString global_ver = BaseObject::getPgSQLVersion(), thread_ver, nested_ver;
+	bool global_esc = BaseObject::isEscapeComments(), nested_esc = true;
+
+	std::thread thread([&thread_ver, &nested_ver, &nested_esc](){
+		BaseObject::ScopedCodeGenSettings settings;
+
+		BaseObject::setPgSQLVersion(PgSqlVersions::PgSqlVersion100);
+		BaseObject::setEscapeComments(false);
+		thread_ver = BaseObject::getPgSQLVersion();
+
+		// Nested scopes start with the settings of the enclosing one
+		BaseObject::ScopedCodeGenSettings nested_settings;
+		nested_ver = BaseObject::getPgSQLVersion();
+		nested_esc = BaseObject::isEscapeComments();
+	});
+
+	thread.join();
+
+	QCOMPARE(thread_ver, PgSqlVersions::PgSqlVersion100);
+	QCOMPARE(nested_ver, thread_ver);
+	QCOMPARE(nested_esc, false);
+	QCOMPARE(BaseObject::getPgSQLVersion(), global_ver);
+	QCOMPARE(BaseObject::isEscapeComments(), global_esc);
+}
+
 QTEST_MAIN(BaseObjectTest)
 #include "baseobjecttest.moc"
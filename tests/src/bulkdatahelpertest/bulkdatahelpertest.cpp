@@ -0,0 +1,205 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2022 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "tools/bulkdatahelper.h"
+#include "pgmodelerunittest.h"
+
+class BulkDataHelperTest: public QObject {
+	private:
+		Q_OBJECT
+
+	private slots:
+		void formatsValuesAsTheGridDoes();
+		void formatsCopyValues();
+		void generatesCopyForPlainInserts();
+		void generatesBatchedUpdateAndDelete();
+		void savesChangesOnServer();
+};
+
+void BulkDataHelperTest::formatsValuesAsTheGridDoes()
+{
+	QCOMPARE(BulkDataHelper::formatValue("", 0, "col"), QString("DEFAULT"));
+	QCOMPARE(BulkDataHelper::formatValue("/now()/", 0, "col"), QString("now()"));
+	QCOMPARE(BulkDataHelper::formatValue("it's", 0, "col"), QString("E'it''s'"));
+	QCOMPARE(BulkDataHelper::formatValue("\\/path\\/", 0, "col"), QString("E'/path/'"));
+
+	try
+	{
+		BulkDataHelper::formatValue("/now()", 0, "col");
+		QFAIL("Malformed unescaped value accepted!");
+	}
+	catch(Exception &e)
+	{
+		QCOMPARE(e.getErrorCode(), ErrorCode::MalformedUnescapedValue);
+	}
+}
+
+void BulkDataHelperTest::formatsCopyValues()
+{
+	QCOMPARE(BulkDataHelper::formatCopyValue("a\tb\nc"), QString("a\\tb\\nc"));
+	QCOMPARE(BulkDataHelper::formatCopyValue("\\N"), QString("N"));
+	QCOMPARE(BulkDataHelper::formatCopyValue("\\/x\\/"), QString("/x/"));
+
+	// COPY has no unicode escapes so they're replaced by the characters, keeping the escaped backslashes and malformed sequences
+	QCOMPARE(BulkDataHelper::formatCopyValue("caf\\u00e9 \\U0001F600"), QString("caf%1 %2").arg(QChar(0xe9)).arg(QString::fromUcs4(U"\U0001F600", 1)));
+	QCOMPARE(BulkDataHelper::formatCopyValue("\\ud83d\\ude00"), QString::fromUcs4(U"\U0001F600", 1));
+	QCOMPARE(BulkDataHelper::formatCopyValue("a\\u0009b\\u005c"), QString("a\\tb\\\\"));
+	QCOMPARE(BulkDataHelper::formatCopyValue("\\\\u00e9 \\u00g1 \\u12"), QString("\\\\u00e9 \\u00g1 \\u12"));
+}
+
+void BulkDataHelperTest::generatesCopyForPlainInserts()
+{
+	BulkDataHelper helper;
+	BulkDataHelper::RowData row1 { 0, {}, {"1", "", "a"}, {} },
+			row2 { 1, {}, {"2", "", "b\tc"}, {} };
+	QByteArray buffer;
+
+	helper.setTable("public", "tab", {"id", "dt", "name"}, {"id"}, true);
+
+	QCOMPARE(helper.getInsertCommand({ &row1, &row2 }, true, &buffer),
+					 QString("COPY \"public\".\"tab\"(\"id\", \"name\") FROM STDIN"));
+	QCOMPARE(buffer, QByteArray("1\ta\n2\tb\\tc\n"));
+
+	QCOMPARE(helper.getInsertCommand({ &row1 }, false),
+					 QString("INSERT INTO \"public\".\"tab\"(\"id\", \"dt\", \"name\") VALUES (E'1', DEFAULT, E'a')"));
+}
+
+void BulkDataHelperTest::generatesBatchedUpdateAndDelete()
+{
+	BulkDataHelper helper;
+	BulkDataHelper::RowData row1 { 0, {"1"}, {"1", "x"}, { false, true } },
+			row2 { 1, {"2"}, {"2", "/upper('y')/"}, { false, true } };
+
+	helper.setTable("public", "tab", {"id", "name"}, {"id"}, true);
+	helper.setColumnTypes({{ "id", "integer" }, { "name", "character varying" }});
+
+	QCOMPARE(helper.getUpdateCommand({ &row1, &row2 }),
+					 QString("UPDATE \"public\".\"tab\" AS _t SET \"name\"=_v._c1 FROM (VALUES ('1'::integer, E'x'::character varying), "
+									 "('2'::integer, (upper('y'))::character varying)) AS _v(_k0, _c1) WHERE _t.\"id\" = _v._k0"));
+
+	QCOMPARE(helper.getUpdateCommand({ &row1 }),
+					 QString("UPDATE \"public\".\"tab\" SET \"name\"=E'x' WHERE \"id\"='1'"));
+
+	helper.setTable("public", "tab", {"id", "name"}, {"id", "name"}, false);
+	helper.setColumnTypes({{ "id", "integer" }, { "name", "character varying" }});
+	row1.key_values = QStringList { "1", QString() };
+	row2.key_values = QStringList { "2", "it's" };
+
+	QCOMPARE(helper.getDeleteCommand({ &row1 }),
+					 QString("DELETE FROM \"public\".\"tab\" WHERE \"id\"='1' AND \"name\" IS NULL"));
+
+	QCOMPARE(helper.getDeleteCommand({ &row1, &row2 }),
+					 QString("DELETE FROM \"public\".\"tab\" AS _t USING (VALUES ('1'::integer, NULL::character varying), "
+									 "('2'::integer, 'it''s'::character varying)) AS _v(_k0, _k1) "
+									 "WHERE _t.\"id\" IS NOT DISTINCT FROM _v._k0 AND _t.\"name\" IS NOT DISTINCT FROM _v._k1"));
+}
+
+void BulkDataHelperTest::savesChangesOnServer()
+{
+	attribs_map conn_params = PgModelerUnitTest::getTestConnectionParams();
+
+	if(conn_params.empty())
+		QSKIP("PGMODELER_TEST_CONN is not set, skipping the test that needs a running server.");
+
+	Connection conn(conn_params);
+	BulkDataHelper helper;
+	ResultSet res;
+	QStringList rows;
+
+	conn.connect();
+
+	// Temporary tables live as long as the connection, so no cleanup is needed
+	conn.executeDDLCommand("CREATE TEMPORARY TABLE bulk_pk (id integer PRIMARY KEY, name varchar(10), "
+												 "amount numeric(10,2), flag boolean, code char(3), created date)");
+	conn.executeDDLCommand("CREATE TEMPORARY TABLE bulk_no_pk (num bigint, label text)");
+
+	helper.setTable("pg_temp", "bulk_pk", {"id", "name", "amount", "flag", "code", "created"}, {"id"}, true);
+
+	for(int id = 1; id <= 6; id++)
+		helper.addInsertedRow(id, { QString::number(id), QString("name %1").arg(id), "1.5", "true", "abc", "2024-01-01" });
+
+	helper.addInsertedRow(7, { "7", "", "", "", "", "/current_date/" });
+	helper.saveChanges(conn);
+
+	// Batched updates of non-text columns (including an expression) and the deletion of several rows and of a single one
+	helper.addUpdatedRow(1, {"1"}, { "1", "one", "10.25", "false", "xyz", "2024-02-01" }, { false, true, true, true, true, true });
+	helper.addUpdatedRow(2, {"2"}, { "2", "two", "20", "/1 = 2/", "def", "/'2024-03-01'::date + 1/" }, { false, true, true, true, true, true });
+	helper.addUpdatedRow(3, {"3"}, { "3", "three", "1.5", "true", "abc", "2024-01-01" }, { false, true, false, false, false, false });
+	helper.addDeletedRow(4, {"4"});
+	helper.addDeletedRow(5, {"5"});
+	helper.saveChanges(conn);
+
+	helper.addDeletedRow(6, {"6"});
+	helper.saveChanges(conn);
+
+	conn.executeDMLCommand("SELECT id, name, amount, flag, code, created FROM bulk_pk WHERE id < 7 ORDER BY id", res);
+
+	if(res.accessTuple(ResultSet::FirstTuple))
+	{
+		do
+		{
+			QStringList values;
+
+			for(auto &col : { "id", "name", "amount", "flag", "code", "created" })
+				values.append(res.getColumnValue(col));
+
+			rows.append(values.join('|'));
+		}
+		while(res.accessTuple(ResultSet::NextTuple));
+	}
+
+	QCOMPARE(rows, QStringList({ "1|one|10.25|f|xyz|2024-02-01", "2|two|20.00|f|def|2024-03-02", "3|three|1.50|t|abc|2024-01-01" }));
+
+	// Values exceeding the column's length must raise an error instead of being truncated by the casts
+	helper.addUpdatedRow(1, {"1"}, { "1", "a too long name", "1", "true", "abc", "2024-01-01" }, { false, true, false, false, false, false });
+	helper.addUpdatedRow(2, {"2"}, { "2", "b too long name", "1", "true", "abc", "2024-01-01" }, { false, true, false, false, false, false });
+
+	try
+	{
+		helper.saveChanges(conn);
+		QFAIL("Value longer than the column's length accepted!");
+	}
+	catch(Exception &)
+	{
+		QCOMPARE(helper.getFailedRow(), 1);
+	}
+
+	// Tables without primary key compare the NULL values in the keys too
+	helper.setTable("pg_temp", "bulk_no_pk", {"num", "label"}, {"num", "label"}, false);
+	helper.addInsertedRow(0, { "1", "/NULL/" });
+	helper.addInsertedRow(1, { "2", "b" });
+	helper.addInsertedRow(2, { "3", "c" });
+	helper.addInsertedRow(3, { "4", "caf\\u00e9" });
+	helper.saveChanges(conn);
+
+	helper.addDeletedRow(0, { "1", QString() });
+	helper.addDeletedRow(1, { "2", "b" });
+	helper.saveChanges(conn);
+
+	conn.executeDMLCommand("SELECT string_agg(num::text, ',' ORDER BY num) AS nums FROM bulk_no_pk", res);
+	res.accessTuple(ResultSet::FirstTuple);
+	QCOMPARE(QString(res.getColumnValue("nums")), QString("3,4"));
+
+	conn.executeDMLCommand("SELECT label FROM bulk_no_pk WHERE num = 4", res);
+	res.accessTuple(ResultSet::FirstTuple);
+	QCOMPARE(QString(res.getColumnValue("label")), QString("caf%1").arg(QChar(0xe9)));
+}
+
+QTEST_MAIN(BulkDataHelperTest)
+#include "bulkdatahelpertest.moc"
@@ -0,0 +1,183 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2022 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "catalog.h"
+#include <random>
+
+class CatalogTest: public QObject {
+	private:
+		Q_OBJECT
+
+		/*! \brief Fills the catalog with a large amount of extension objects
+		 * (similar to a database with PostGIS and other big extensions installed) */
+		void createExtensionObjects(Catalog &catalog);
+
+	private slots:
+		void checksExtensionObjectsMembership();
+		void benchmarkExtensionObjectLookup();
+		void copiesShareDatabaseContext();
+		void parsesArrayValues();
+		void parsesDefaultValues();
+		void fuzzArrayAndDefaultValues();
+		void benchmarkArrayAndDefaultValues();
+};
+
+void CatalogTest::createExtensionObjects(Catalog &catalog)
+{
+	std::map<QString, std::vector<unsigned>> ext_objs;
+	unsigned oid = 16384;
+
+	for(auto &ext_name : { "postgis", "postgis_raster", "postgis_topology", "pg_trgm", "hstore" })
+	{
+		for(unsigned i = 0; i < 8000; i++)
+			ext_objs[ext_name].push_back(oid++);
+	}
+
+	catalog.setExtensionObjects(ext_objs);
+}
+
+void CatalogTest::checksExtensionObjectsMembership()
+{
+	Catalog catalog;
+
+	catalog.setExtensionObjects({{ "hstore", { 20000, 20001 } }, { "pg_trgm", { 30000 } }});
+
+	QVERIFY(catalog.isExtensionObject(20001));
+	QVERIFY(catalog.isExtensionObject(30000, "pg_trgm"));
+	QVERIFY(!catalog.isExtensionObject(30000, "hstore"));
+	QVERIFY(!catalog.isExtensionObject(30000, "postgis"));
+	QVERIFY(!catalog.isExtensionObject(40000));
+	QCOMPARE(catalog.getExtensionObjectsOids().size(), static_cast<size_t>(3));
+	QCOMPARE(catalog.getExtensionObjectsOids("hstore").size(), static_cast<size_t>(2));
+	QVERIFY(catalog.getExtensionObjectsOids("postgis").empty());
+}
+
+void CatalogTest::copiesShareDatabaseContext()
+{
+	Catalog catalog;
+
+	createExtensionObjects(catalog);
+
+	// Copying a catalog must neither connect to the server nor duplicate the database metadata
+	QBENCHMARK
+	{
+		Catalog aux_cat = catalog;
+		QVERIFY(aux_cat.isExtensionObject(16384, "postgis"));
+	}
+
+	Catalog copy = catalog;
+
+	// Changing the metadata of a copy must not affect the original catalog
+	copy.setExtensionObjects({{ "hstore", { 1 } }});
+	QVERIFY(copy.isExtensionObject(1));
+	QVERIFY(!copy.isExtensionObject(16384));
+	QVERIFY(catalog.isExtensionObject(16384));
+	QVERIFY(!catalog.isExtensionObject(1));
+}
+
+void CatalogTest::benchmarkExtensionObjectLookup()
+{
+	Catalog catalog;
+	unsigned found = 0;
+
+	createExtensionObjects(catalog);
+
+	QBENCHMARK
+	{
+		found = 0;
+
+		// Simulates the checks made by the import for objects inside and outside extensions
+		for(unsigned oid = 16384; oid < 16384 + 80000; oid += 8)
+		{
+			if(catalog.isExtensionObject(oid))
+				found++;
+		}
+	}
+
+	QCOMPARE(found, static_cast<unsigned>(5000));
+}
+
+void CatalogTest::parsesArrayValues()
+{
+	QCOMPARE(Catalog::parseArrayValues("{a,b,c}"), QStringList({ "a", "b", "c" }));
+	QCOMPARE(Catalog::parseArrayValues("[0:2]={1,2,3}"), QStringList({ "1", "2", "3" }));
+	QCOMPARE(Catalog::parseArrayValues("{\"a,b\",c}"), QStringList({ "\"a,b\"", "c" }));
+	QCOMPARE(Catalog::parseArrayValues("{\"a\\\",b\",c}"), QStringList({ "\"a\\\",b\"", "c" }));
+	QVERIFY(Catalog::parseArrayValues("{}").isEmpty());
+	QVERIFY(Catalog::parseArrayValues("a,b").isEmpty());
+	QVERIFY(Catalog::parseArrayValues("[a:2]={1,2}").isEmpty());
+}
+
+void CatalogTest::parsesDefaultValues()
+{
+	QCOMPARE(Catalog::parseDefaultValues("0, '*', ARRAY[0, 1, 2 ,3], 'foo', ARRAY['a', 'b', 'c']"),
+					 QStringList({ "0", "'*'", "ARRAY[0, 1, 2 ,3]", "'foo'", "ARRAY['a', 'b', 'c']" }));
+	QCOMPARE(Catalog::parseDefaultValues("'a, b', 2"), QStringList({ "'a, b'", "2" }));
+	QCOMPARE(Catalog::parseDefaultValues("'it''s', NULL::text"), QStringList({ "'it''s'", "NULL::text" }));
+	QCOMPARE(Catalog::parseDefaultValues("now(), 'x'::character varying"), QStringList({ "now()", "'x'::character varying" }));
+	QCOMPARE(Catalog::parseDefaultValues("1"), QStringList({ "1" }));
+	QVERIFY(Catalog::parseDefaultValues("").isEmpty());
+}
+
+void CatalogTest::fuzzArrayAndDefaultValues()
+{
+	std::mt19937 rand_gen(20221019);
+	std::uniform_int_distribution<int> len_dist(0, 40);
+	QString alphabet = "{}[]()'\",\\:=ARY0123 abc";
+	std::uniform_int_distribution<int> chr_dist(0, alphabet.size() - 1);
+	QString value;
+
+	// Random strings built from the relevant tokens must never crash or loop forever
+	for(unsigned i = 0; i < 20000; i++)
+	{
+		value.clear();
+
+		for(int len = len_dist(rand_gen); len > 0; len--)
+			value.append(alphabet.at(chr_dist(rand_gen)));
+
+		QStringList def_vals = Catalog::parseDefaultValues(value);
+		Catalog::parseArrayValues(value);
+		Catalog::parseArrayValues(QString("{%1}").arg(value));
+
+		QVERIFY(value.isEmpty() || !def_vals.isEmpty());
+	}
+}
+
+void CatalogTest::benchmarkArrayAndDefaultValues()
+{
+	QStringList arrays = { "{r,w,a,d,D,x,t}", "[0:3]={1,2,3,4}", "{\"name, with comma\",regular,\"with \\\"quote\"}",
+												 "{integer,text,\"character varying\",\"timestamp with time zone\"}" },
+			def_values = { "0, '*', ARRAY[0, 1, 2 ,3], 'foo', ARRAY['a', 'b', 'c']", "NULL::text, 10, 'x'::character varying",
+										 "now(), 'it''s', true" };
+
+	QBENCHMARK
+	{
+		for(unsigned i = 0; i < 100; i++)
+		{
+			for(auto &value : arrays)
+				Catalog::parseArrayValues(value);
+
+			for(auto &value : def_values)
+				Catalog::parseDefaultValues(value);
+		}
+	}
+}
+
+QTEST_MAIN(CatalogTest)
+#include "catalogtest.moc"
@@ -0,0 +1,158 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2022 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "csvreader.h"
+
+class CsvReaderTest: public QObject {
+	private:
+		Q_OBJECT
+
+		//! \brief Size (in MB) of the file used in the benchmark. Can be changed via PGMODELER_CSV_BENCH_MB (e.g. 1024)
+		int getBenchmarkSize();
+
+	private slots:
+		void parsesRfc4180Values();
+		void keepsEscapeRules();
+		void readsFileInChunks();
+		void benchmarkFileThroughput();
+};
+
+int CsvReaderTest::getBenchmarkSize()
+{
+	int size = qEnvironmentVariableIntValue("PGMODELER_CSV_BENCH_MB");
+	return size > 0 ? size : 16;
+}
+
+void CsvReaderTest::parsesRfc4180Values()
+{
+	CsvReader reader(';', '"', true);
+	QList<QStringList> rows;
+
+	reader.setBuffer("id;name;notes\r\n1;\"Doe; John\";\"line1\nline2\"\r\n2; \"say \"\"hi\"\"\" ;plain\r3;x;y");
+	QCOMPARE(reader.getColumns(), QStringList({ "id", "name", "notes" }));
+
+	rows = reader.readRows();
+	QCOMPARE(rows.size(), 3);
+	QCOMPARE(rows[0], QStringList({ "1", "Doe; John", "line1\nline2" }));
+	QCOMPARE(rows[1], QStringList({ "2", "say \"hi\"", "plain" }));
+	QCOMPARE(rows[2], QStringList({ "3", "x", "y" }));
+	QVERIFY(reader.atEnd());
+}
+
+void CsvReaderTest::keepsEscapeRules()
+{
+	CsvReader reader(';', '"', false);
+	QList<QStringList> rows;
+
+	reader.setBuffer("  a \\;b ; \\\"q\\\" ;\"x\\\"y\"\n\n\nC:\\path;\n");
+	rows = reader.readRows();
+
+	QCOMPARE(reader.getColumns(), QStringList());
+	QCOMPARE(rows.size(), 2);
+	QCOMPARE(rows[0], QStringList({ "a ;b", "\"q\"", "x\"y" }));
+	QCOMPARE(rows[1], QStringList({ "C:\\path", "" }));
+
+	// Without text delimiter the quotes are part of the values
+	reader.setFormat('\t', QChar(), false);
+	reader.setBuffer("\"a\"\tb");
+	rows = reader.readRows();
+	QCOMPARE(rows.size(), 1);
+	QCOMPARE(rows[0], QStringList({ "\"a\"", "b" }));
+}
+
+void CsvReaderTest::readsFileInChunks()
+{
+	QTemporaryFile file;
+	CsvReader buf_reader(';', '"', true), file_reader(';', '"', true);
+	QString buffer = QString("código;descrição\n1;\"ação\nreação\"\r\n\r\n2;\"ç\"\"ã\"\n3;\\;õ");
+	QList<QStringList> rows;
+	int batches = 0;
+
+	QVERIFY(file.open());
+	file.write(buffer.toUtf8());
+	file.close();
+
+	buf_reader.setBuffer(buffer);
+
+	// Tiny chunks force values, line breaks and multibyte chars to be split between reads
+	file_reader.setChunkSize(3);
+	file_reader.setFile(file.fileName());
+
+	QCOMPARE(file_reader.getColumns(), buf_reader.getColumns());
+
+	while(!file_reader.atEnd())
+	{
+		QList<QStringList> batch = file_reader.readRows(2);
+
+		QVERIFY(batch.size() <= 2);
+		rows.append(batch);
+		batches++;
+	}
+
+	QCOMPARE(batches, 2);
+	QCOMPARE(rows, buf_reader.readRows());
+	QCOMPARE(rows[2], QStringList({ "3", ";õ" }));
+	QCOMPARE(file_reader.getBytesRead(), file_reader.getTotalBytes());
+}
+
+void CsvReaderTest::benchmarkFileThroughput()
+{
+	QTemporaryFile file;
+	qint64 max_size = static_cast<qint64>(getBenchmarkSize()) * 1048576;
+	unsigned gen_rows = 0, read_rows = 0;
+	QByteArray block;
+
+	QVERIFY(file.open());
+
+	// Generating the file in blocks so the test itself doesn't need the whole data in memory
+	while(file.size() < max_size)
+	{
+		block.clear();
+
+		for(int i = 0; i < 1000; i++, gen_rows++)
+			block.append(QString("%1;\"name %1\";\"text with ; separator and \"\"quotes\"\"\";3.1415\n").arg(gen_rows).toUtf8());
+
+		file.write(block);
+	}
+
+	file.close();
+
+	QBENCHMARK
+	{
+		CsvReader reader(';', '"', false);
+		QElapsedTimer timer;
+
+		read_rows = 0;
+		timer.start();
+		reader.setFile(file.fileName());
+
+		/* Only the current chunk and the batch of rows are held in memory,
+		 * so the memory used doesn't depend on the size of the file */
+		while(!reader.atEnd())
+			read_rows += reader.readRows(1000).size();
+
+		qInfo("%d MB parsed at %.1f MB/s", getBenchmarkSize(),
+					getBenchmarkSize() / (qMax<qint64>(timer.elapsed(), 1) / 1000.0));
+	}
+
+	QCOMPARE(read_rows, gen_rows);
+}
+
+QTEST_MAIN(CsvReaderTest)
+#include "csvreadertest.moc"
@@ -31,6 +31,7 @@ class DatabaseModelTest: public QObject, public PgModelerUnitTest {
 		void saveObjectsMetadata();
 		void loadObjectsMetadata();
 		void saveSplitSQLDefinition();
+		void objectsSQLDefinitionKeepsCreationOrder();
 };
 
 void DatabaseModelTest::saveObjectsMetadata()
@@ -102,5 +103,64 @@ void DatabaseModelTest::saveSplitSQLDefinition()
 	}
 }
 
+void DatabaseModelTest::objectsSQLDefinitionKeepsCreationOrder()
+{
+	DatabaseModel dbmodel;
+	QString input_dbm=SAMPLESDIR + GlobalAttributes::DirSeparator + QString("demo.dbm");
+	std::vector<std::pair<BaseObject *, QString>> objs_code;
+	QStringList session_cmds;
+	bool schemas_done = false, schemas_first = true;
+
+	try
+	{
+		dbmodel.createSystemObjects(false);
+		dbmodel.loadModel(input_dbm);
+		objs_code = dbmodel.getObjectsSQLDefinition(session_cmds);
+
+		QVERIFY(!objs_code.empty());
+		QVERIFY(session_cmds.last().startsWith("SET search_path TO pg_catalog,public"));
+
+		for(auto &itr : objs_code)
+		{
+			if(!itr.first)
+				continue;
+
+			// Database level objects are created separately so they're never returned
+			QVERIFY(itr.first->getObjectType() != ObjectType::Database &&
+							itr.first->getObjectType() != ObjectType::Role &&
+							itr.first->getObjectType() != ObjectType::Tablespace);
+
+			if(itr.first->getObjectType() != ObjectType::Schema)
+				schemas_done = true;
+			else if(schemas_done)
+				schemas_first = false;
+		}
+
+		QVERIFY(schemas_first);
+
+		// The prepended and appended SQL are returned in the first and the last entries
+		dbmodel.setPrependedSQL("CREATE SCHEMA prepended_schema;");
+		dbmodel.setAppendedSQL("CREATE SCHEMA appended_schema;");
+		dbmodel.setPrependAtBOD(true);
+		dbmodel.setAppendAtEOD(true);
+		objs_code = dbmodel.getObjectsSQLDefinition(session_cmds);
+
+		QVERIFY(!objs_code.front().first);
+		QVERIFY(objs_code.front().second.contains("CREATE SCHEMA prepended_schema;"));
+		QVERIFY(!objs_code.back().first);
+		QVERIFY(objs_code.back().second.contains("CREATE SCHEMA appended_schema;"));
+
+		for(unsigned idx = 1; idx < objs_code.size() - 1; idx++)
+		{
+			QVERIFY(!objs_code[idx].second.contains("prepended_schema") &&
+							!objs_code[idx].second.contains("appended_schema"));
+		}
+	}
+	catch (Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
 QTEST_MAIN(DatabaseModelTest)
 #include "databasemodeltest.moc"
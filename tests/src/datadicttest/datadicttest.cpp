@@ -30,6 +30,7 @@ class DataDictTest: public QObject, public PgModelerUnitTest {
 	private slots:
 		void generateASimpleDataDict();
 		void generateASplittedDataDictFromSampleModel();
+		void splitDataDictFilesMatchInMemoryGeneration();
 };
 
 void DataDictTest::generateASimpleDataDict()
@@ -150,5 +151,35 @@ void DataDictTest::generateASplittedDataDictFromSampleModel()
 	}
 }
 
+void DataDictTest::splitDataDictFilesMatchInMemoryGeneration()
+{
+	DatabaseModel dbmodel;
+	attribs_map datadict;
+	QString path = "./dict_split";
+	QFile file;
+
+	try
+	{
+		dbmodel.createSystemObjects(false);
+		dbmodel.loadModel(QString(SAMPLESDIR)+ "/demo.dbm");
+		dbmodel.getDataDictionary(datadict, true, true);
+		dbmodel.saveDataDictionary(path, true, true);
+
+		QVERIFY(!datadict.empty());
+
+		for(auto &itr : datadict)
+		{
+			file.setFileName(path + GlobalAttributes::DirSeparator + itr.first);
+			QVERIFY2(file.open(QFile::ReadOnly), itr.first.toStdString().c_str());
+			QCOMPARE(QString(file.readAll()), itr.second);
+			file.close();
+		}
+	}
+	catch (Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
 QTEST_MAIN(DataDictTest)
 #include "datadicttest.moc"
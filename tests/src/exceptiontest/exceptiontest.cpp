@@ -0,0 +1,131 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2022 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "exception.h"
+
+class ExceptionTest: public QObject {
+	private:
+		Q_OBJECT
+
+		static constexpr unsigned ChainLevels = 10;
+
+		//! \brief Raises an error at the deepest level and rethrows it in each one of the upper levels
+		void raiseNestedError(unsigned level);
+
+	private slots:
+		void keepsRethrowOrder();
+		void keepsVectorOfErrorsOrder();
+		void sharesChainWithoutChangingIt();
+		void benchmarkRethrowChain();
+};
+
+void ExceptionTest::raiseNestedError(unsigned level)
+{
+	try
+	{
+		if(level == ChainLevels - 1)
+			throw Exception(ErrorCode::InvalidSyntax, __PRETTY_FUNCTION__, __FILE__, __LINE__, nullptr, QString::number(level));
+
+		raiseNestedError(level + 1);
+	}
+	catch(Exception &e)
+	{
+		if(level == ChainLevels - 1)
+			throw;
+
+		throw Exception(e.getErrorMessage(), e.getErrorCode(), __PRETTY_FUNCTION__, __FILE__, __LINE__, &e, QString::number(level));
+	}
+}
+
+void ExceptionTest::keepsRethrowOrder()
+{
+	std::vector<Exception> list;
+
+	try
+	{
+		raiseNestedError(0);
+		QFAIL("No error raised!");
+	}
+	catch(Exception &e)
+	{
+		e.getExceptionsList(list);
+
+		// The list starts with the first raised error and ends with the last one
+		QCOMPARE(list.size(), static_cast<size_t>(ChainLevels));
+		QCOMPARE(list.front().getExtraInfo(), QString::number(ChainLevels - 1));
+		QCOMPARE(list.back().getExtraInfo(), QString("0"));
+		QCOMPARE(e.getFile(), QString(__FILE__));
+		QVERIFY(e.getMethod().contains("raiseNestedError"));
+		QVERIFY(e.getExceptionsText().startsWith("[0] "));
+		QCOMPARE(e.getExceptiosExtraInfo().split('\n').size(), static_cast<int>(ChainLevels));
+	}
+}
+
+void ExceptionTest::keepsVectorOfErrorsOrder()
+{
+	Exception err_a("A", __PRETTY_FUNCTION__, __FILE__, __LINE__),
+			err_b("B", __PRETTY_FUNCTION__, __FILE__, __LINE__, &err_a),
+			err_c("C", __PRETTY_FUNCTION__, __FILE__, __LINE__);
+	std::vector<Exception> errors = { err_b, err_c }, list;
+	Exception error("D", __PRETTY_FUNCTION__, __FILE__, __LINE__, errors);
+
+	error.getExceptionsList(list);
+
+	QCOMPARE(list.size(), static_cast<size_t>(4));
+	QCOMPARE(list[0].getErrorMessage(), QString("A"));
+	QCOMPARE(list[1].getErrorMessage(), QString("B"));
+	QCOMPARE(list[2].getErrorMessage(), QString("C"));
+	QCOMPARE(list[3].getErrorMessage(), QString("D"));
+}
+
+void ExceptionTest::sharesChainWithoutChangingIt()
+{
+	Exception err_a("A", __PRETTY_FUNCTION__, __FILE__, __LINE__),
+			err_b("B", __PRETTY_FUNCTION__, __FILE__, __LINE__, &err_a),
+			err_c("C", __PRETTY_FUNCTION__, __FILE__, __LINE__, &err_b),
+			err_d("D", __PRETTY_FUNCTION__, __FILE__, __LINE__, &err_b);
+	std::vector<Exception> list;
+
+	// Wrapping an error must not change it, so the same error can be wrapped several times
+	err_b.getExceptionsList(list);
+	QCOMPARE(list.size(), static_cast<size_t>(2));
+
+	err_c.getExceptionsList(list);
+	QCOMPARE(list.size(), static_cast<size_t>(3));
+
+	err_d.getExceptionsList(list);
+	QCOMPARE(list.size(), static_cast<size_t>(3));
+	QCOMPARE(list[0].getErrorMessage(), QString("A"));
+}
+
+void ExceptionTest::benchmarkRethrowChain()
+{
+	QBENCHMARK
+	{
+		try
+		{
+			raiseNestedError(0);
+		}
+		catch(Exception &)
+		{}
+	}
+}
+
+QTEST_MAIN(ExceptionTest)
+#include "exceptiontest.moc"
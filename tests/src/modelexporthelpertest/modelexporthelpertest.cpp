@@ -0,0 +1,177 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2022 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "tools/modelexporthelper.h"
+#include "pgmodelerunittest.h"
+#include <set>
+
+class ModelExportHelperTest: public QObject, public PgModelerUnitTest {
+	private:
+		Q_OBJECT
+
+		/*! \brief Loads the demo model adding to it prepended and appended SQL as well objects that can't be created
+		 * concurrently: foreign keys between two tables in opposite directions and permissions on the same table.
+		 * These objects are returned in conflicting_objs */
+		void loadModel(DatabaseModel &dbmodel, std::vector<BaseObject *> &conflicting_objs);
+
+	public:
+		ModelExportHelperTest() : PgModelerUnitTest(SCHEMASDIR) {}
+
+	private slots:
+		void creationWavesSeparateConflictingObjects();
+		void validatesModelInWavesOnServer();
+};
+
+void ModelExportHelperTest::loadModel(DatabaseModel &dbmodel, std::vector<BaseObject *> &conflicting_objs)
+{
+	Table *tab_a = nullptr, *tab_b = nullptr;
+	Column *col = nullptr;
+	Constraint *fk = nullptr;
+	Permission *perm = nullptr;
+
+	dbmodel.createSystemObjects(false);
+	dbmodel.loadModel(SAMPLESDIR + GlobalAttributes::DirSeparator + "demo.dbm");
+
+	// The prepended and appended SQL must run before and after all the other objects
+	dbmodel.setPrependedSQL("CREATE SCHEMA prepended_schema;");
+	dbmodel.setAppendedSQL("CREATE TABLE prepended_schema.appended_table (id integer REFERENCES public.table_a);");
+	dbmodel.setPrependAtBOD(true);
+	dbmodel.setAppendAtEOD(true);
+
+	tab_a = dbmodel.getTable("public.table_a");
+	tab_b = dbmodel.getTable("public.table_b");
+
+	for(auto &tabs : std::vector<std::pair<Table *, Table *>>{ { tab_a, tab_b }, { tab_b, tab_a } })
+	{
+		col = new Column;
+		col->setName(QString("%1_ref").arg(tabs.second->getName()));
+		col->setType(PgSqlType("integer"));
+		tabs.first->addColumn(col);
+
+		fk = new Constraint;
+		fk->setName(QString("%1_%2_fk").arg(tabs.first->getName(), tabs.second->getName()));
+		fk->setConstraintType(ConstraintType::ForeignKey);
+		fk->setReferencedTable(tabs.second);
+		fk->addColumn(col, Constraint::SourceCols);
+		fk->addColumn(tabs.second->getPrimaryKey()->getColumn(0, Constraint::SourceCols), Constraint::ReferencedCols);
+		tabs.first->addConstraint(fk);
+		conflicting_objs.push_back(fk);
+	}
+
+	for(auto &obj : std::vector<BaseObject *>{ tab_a, tab_a->getColumn("id_a"), tab_a->getColumn("name") })
+	{
+		perm = new Permission(obj);
+		perm->setPrivilege(Permission::PrivSelect, true, false);
+		dbmodel.addPermission(perm);
+		conflicting_objs.push_back(perm);
+	}
+}
+
+void ModelExportHelperTest::creationWavesSeparateConflictingObjects()
+{
+	DatabaseModel dbmodel;
+	ModelExportHelper export_hlp;
+	std::vector<BaseObject *> conflicting_objs, deps;
+	std::vector<std::pair<BaseObject *, QString>> objs_code;
+	std::vector<std::vector<unsigned>> waves;
+	std::map<BaseObject *, unsigned> obj_waves, obj_idxs;
+	std::set<unsigned> conflicting_waves;
+	QStringList session_cmds;
+	unsigned entries_cnt = 0;
+
+	try
+	{
+		loadModel(dbmodel, conflicting_objs);
+		objs_code = dbmodel.getObjectsSQLDefinition(session_cmds);
+		waves = export_hlp.getCreationWaves(&dbmodel, objs_code);
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+
+	for(unsigned wave = 0; wave < waves.size(); wave++)
+	{
+		for(auto &idx : waves[wave])
+		{
+			if(objs_code[idx].first)
+			{
+				obj_waves[objs_code[idx].first] = wave;
+				obj_idxs[objs_code[idx].first] = idx;
+			}
+
+			entries_cnt++;
+		}
+	}
+
+	QCOMPARE(entries_cnt, static_cast<unsigned>(objs_code.size()));
+	QVERIFY(waves.front() == std::vector<unsigned>{ 0 });
+	QVERIFY(waves.back() == std::vector<unsigned>{ static_cast<unsigned>(objs_code.size() - 1) });
+
+	// The objects that change the same tables must be created in different waves
+	for(auto &obj : conflicting_objs)
+	{
+		QVERIFY(obj_waves.count(obj));
+		conflicting_waves.insert(obj_waves[obj]);
+	}
+
+	QCOMPARE(conflicting_waves.size(), conflicting_objs.size());
+
+	// The dependencies placed before an object in the creation order must be created in previous waves
+	for(auto &itr : obj_waves)
+	{
+		deps.clear();
+		dbmodel.getObjectDependecies(itr.first, deps);
+
+		for(auto &dep : deps)
+		{
+			if(dep != itr.first && obj_idxs.count(dep) && obj_idxs[dep] < obj_idxs[itr.first])
+				QVERIFY(obj_waves[dep] < itr.second);
+		}
+	}
+}
+
+void ModelExportHelperTest::validatesModelInWavesOnServer()
+{
+	attribs_map conn_params = PgModelerUnitTest::getTestConnectionParams();
+
+	if(conn_params.empty())
+		QSKIP("PGMODELER_TEST_CONN is not set, skipping the test that needs a running server.");
+
+	DatabaseModel dbmodel;
+	ModelExportHelper export_hlp;
+	std::vector<BaseObject *> conflicting_objs;
+	Connection conn(conn_params);
+
+	try
+	{
+		loadModel(dbmodel, conflicting_objs);
+
+		// Simulating the export with temporary names so the database is created and dropped in the end
+		export_hlp.setValidationConnections(4);
+		export_hlp.exportToDBMS(&dbmodel, conn, "", false, false, false, true, true);
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+QTEST_MAIN(ModelExportHelperTest)
+#include "modelexporthelpertest.moc"
@@ -0,0 +1,2 @@
+include(../../tests.pri)
+SOURCES += modelexporthelpertest.cpp
\ No newline at end of file
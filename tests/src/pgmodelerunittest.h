@@ -28,12 +28,33 @@ they must inherit from this class.
 #define PGMODELER_UNIT_TEST_H
 
 #include "globalattributes.h"
+#include "attribsmap.h"
 
 class PgModelerUnitTest {
     public:
 	    PgModelerUnitTest(const QString &search_path){
 			GlobalAttributes::setSearchPath(search_path);
 	};
+
+	/*! \brief Returns the parameters of the connection used by the tests that need a running server.
+	 * The parameters are read from the PGMODELER_TEST_CONN environment variable in the libpq keyword/value
+	 * format (e.g. "host=localhost port=5432 dbname=postgres user=postgres password=postgres").
+	 * An empty map is returned when the variable is not set, in which case those tests are skipped */
+	static attribs_map getTestConnectionParams()
+	{
+		attribs_map params;
+		int pos = -1;
+
+		for(auto &param : qEnvironmentVariable("PGMODELER_TEST_CONN").split(' ', Qt::SkipEmptyParts))
+		{
+			pos = param.indexOf('=');
+
+			if(pos > 0)
+				params[param.left(pos)] = param.mid(pos + 1);
+		}
+
+		return params;
+	}
 };
 
 #endif
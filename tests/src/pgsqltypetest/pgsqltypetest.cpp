@@ -0,0 +1,328 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2022 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include <random>
+#include <thread>
+#include <atomic>
+#include "pgsqltypes/pgsqltype.h"
+#include "databasemodel.h"
+#include "pgmodelerunittest.h"
+
+class PgSqlTypeTest: public QObject, public PgModelerUnitTest {
+	private:
+		Q_OBJECT
+
+		//! \brief Type strings in the format returned by format_type() in real catalogs
+		static const QStringList CatalogTypes;
+
+		//! \brief Creates a domain in the public schema of the model (registering it as user type)
+		static Domain *createDomain(DatabaseModel &model, const QString &name);
+
+	public:
+		PgSqlTypeTest() : PgModelerUnitTest(SCHEMASDIR) {}
+
+	private slots:
+		void parsesLengthAndPrecision();
+		void parsesTimezoneAndDimension();
+		void parsesIntervalQualifiers();
+		void parsesSpatialTypes();
+		void parsesQuotedAndQualifiedNames();
+		void fuzzParseString();
+		void benchmarkParseString();
+		void userTypesAreIsolatedPerModel();
+		void userTypeIdsAreNotReusedAfterRemoval();
+		void renamedUserTypesAreReindexed();
+		void modelsRegisterUserTypesConcurrently();
+};
+
+const QStringList PgSqlTypeTest::CatalogTypes = {
+	"integer", "bigint", "smallint", "text", "boolean", "bytea", "uuid", "jsonb",
+	"character varying(255)", "character varying", "character(2)", "varchar(200)[]",
+	"numeric(10,6)", "numeric(12, 2)", "numeric", "double precision", "real[]",
+	"timestamp without time zone", "timestamp(3) with time zone", "timestamp with time zone[]",
+	"time(6) without time zone", "date", "interval", "interval day to second", "interval year to month",
+	"interval second(3)", "bit varying(8)", "inet", "tsvector", "integer[][]", "\"char\"",
+	"geography(POINTZ, 4296)", "geometry(Point,4326)", "geometry(MultiPolygon, 4326)", "geometry"
+};
+
+void PgSqlTypeTest::parsesLengthAndPrecision()
+{
+	PgSqlType type;
+
+	type = PgSqlType::parseString("varchar(200)");
+	QCOMPARE(~type, QString("varchar"));
+	QCOMPARE(type.getLength(), 200u);
+
+	type = PgSqlType::parseString("numeric(10,6)");
+	QCOMPARE(~type, QString("numeric"));
+	QCOMPARE(type.getLength(), 10u);
+	QCOMPARE(type.getPrecision(), 6);
+
+	type = PgSqlType::parseString("numeric( 12 , 2 )");
+	QCOMPARE(type.getLength(), 12u);
+	QCOMPARE(type.getPrecision(), 2);
+
+	type = PgSqlType::parseString("character varying(30)");
+	QCOMPARE(~type, QString("character varying"));
+	QCOMPARE(type.getLength(), 30u);
+}
+
+void PgSqlTypeTest::parsesTimezoneAndDimension()
+{
+	PgSqlType type;
+
+	type = PgSqlType::parseString("timestamp(3) with time zone");
+	QCOMPARE(~type, QString("timestamp with time zone"));
+	QCOMPARE(type.isWithTimezone(), true);
+	QCOMPARE(type.getPrecision(), 3);
+
+	type = PgSqlType::parseString("timestamp without time zone[]");
+	QCOMPARE(type.isWithTimezone(), false);
+	QCOMPARE(type.getDimension(), 1u);
+
+	type = PgSqlType::parseString("integer[][]");
+	QCOMPARE(~type, QString("integer"));
+	QCOMPARE(type.getDimension(), 2u);
+}
+
+void PgSqlTypeTest::parsesIntervalQualifiers()
+{
+	PgSqlType type;
+
+	type = PgSqlType::parseString("interval day to second");
+	QCOMPARE(~type, QString("interval"));
+	QCOMPARE(~type.getIntervalType(), QString("DAY TO SECOND"));
+
+	type = PgSqlType::parseString("interval year");
+	QCOMPARE(~type.getIntervalType(), QString("YEAR"));
+
+	type = PgSqlType::parseString("interval second(3)");
+	QCOMPARE(~type.getIntervalType(), QString("SECOND"));
+	QCOMPARE(type.getPrecision(), 3);
+}
+
+void PgSqlTypeTest::parsesSpatialTypes()
+{
+	PgSqlType type = PgSqlType::parseString("geography(POINTZ, 4296)");
+
+	QCOMPARE(~type, QString("geography"));
+	QCOMPARE(type.getSpatialType().getSRID(), 4296);
+
+	type = PgSqlType::parseString("geometry(point,4326)");
+	QCOMPARE(~type, QString("geometry"));
+	QCOMPARE(type.getSpatialType().getSRID(), 4326);
+}
+
+void PgSqlTypeTest::parsesQuotedAndQualifiedNames()
+{
+	PgSqlType type = PgSqlType::parseString("\"char\"");
+	QCOMPARE(~type, QString("\"char\""));
+
+	type = PgSqlType::parseString("pg_catalog.int4");
+	QCOMPARE(~type, QString("int4"));
+}
+
+void PgSqlTypeTest::fuzzParseString()
+{
+	std::mt19937 rand_gen(20221019);
+	std::uniform_int_distribution<int> op_dist(0, 3), chr_dist(0x20, 0x7e);
+	unsigned parsed = 0, failed = 0;
+
+	// Mutating real type strings at random positions, the parser must either succeed or raise an Exception
+	for(unsigned i = 0; i < 20000; i++)
+	{
+		QString type_str = CatalogTypes.at(i % CatalogTypes.size());
+		std::uniform_int_distribution<int> pos_dist(0, type_str.size());
+		int pos = pos_dist(rand_gen);
+
+		switch(op_dist(rand_gen))
+		{
+			case 0: type_str.insert(pos, QChar(chr_dist(rand_gen))); break;
+			case 1: type_str.remove(pos, 1); break;
+			case 2: type_str.insert(pos, QString("()[], ").at(pos % 6)); break;
+			default: type_str = type_str.left(pos); break;
+		}
+
+		try
+		{
+			PgSqlType::parseString(type_str);
+			parsed++;
+		}
+		catch(Exception &)
+		{
+			failed++;
+		}
+	}
+
+	QCOMPARE(parsed + failed, 20000u);
+	QVERIFY(parsed > 0);
+}
+
+void PgSqlTypeTest::benchmarkParseString()
+{
+	QBENCHMARK
+	{
+		for(auto &type_str : CatalogTypes)
+			PgSqlType::parseString(type_str);
+	}
+}
+
+Domain *PgSqlTypeTest::createDomain(DatabaseModel &model, const QString &name)
+{
+	Domain *domain = new Domain;
+
+	domain->setName(name);
+	domain->setSchema(model.getSchema("public"));
+	domain->setType(PgSqlType("integer"));
+	model.addDomain(domain);
+
+	return domain;
+}
+
+void PgSqlTypeTest::userTypesAreIsolatedPerModel()
+{
+	try
+	{
+		DatabaseModel model_a, model_b;
+		QStringList types;
+
+		model_a.createSystemObjects(true);
+		model_b.createSystemObjects(true);
+
+		Domain *dom_a = createDomain(model_a, "dom"),
+				*dom_b = createDomain(model_b, "dom");
+		createDomain(model_b, "dom_b");
+
+		unsigned id_a = PgSqlType::getUserTypeIndex("public.dom", nullptr, &model_a),
+				id_b = PgSqlType::getUserTypeIndex("public.dom", nullptr, &model_b);
+
+		QVERIFY(id_a != PgSqlType::Null);
+		QVERIFY(id_b != PgSqlType::Null);
+		QVERIFY(id_a != id_b);
+		QCOMPARE(PgSqlType::getUserTypeIndex("", dom_a, &model_a), id_a);
+		QCOMPARE(PgSqlType::getUserTypeIndex("", dom_b, &model_a), PgSqlType::Null);
+		QCOMPARE(PgSqlType(dom_b).getUserTypeReference(), dom_b);
+		QCOMPARE(PgSqlType::getUserTypeIndex("public.dom_b", nullptr, &model_a), PgSqlType::Null);
+
+		PgSqlType::getUserTypes(types, &model_b, UserTypeConfig::AllUserTypes);
+		QCOMPARE(types, QStringList({ "public.dom", "public.dom_b" }));
+
+		PgSqlType::getUserTypes(types, &model_a, UserTypeConfig::DomainType);
+		QCOMPARE(types, QStringList({ "public.dom" }));
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void PgSqlTypeTest::userTypeIdsAreNotReusedAfterRemoval()
+{
+	try
+	{
+		DatabaseModel model;
+		model.createSystemObjects(true);
+
+		Domain *dom = createDomain(model, "dom");
+		PgSqlType type(dom);
+		unsigned type_id = type.getTypeId();
+
+		model.removeObject(dom);
+		QCOMPARE(PgSqlType::getUserTypeIndex("public.dom", nullptr, &model), PgSqlType::Null);
+		QVERIFY(type.getUserTypeReference() == nullptr);
+		QCOMPARE(~type, QString());
+
+		Domain *new_dom = createDomain(model, "dom");
+		QVERIFY(PgSqlType(new_dom).getTypeId() != type_id);
+		QVERIFY(type.getUserTypeReference() == nullptr);
+
+		delete dom;
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void PgSqlTypeTest::renamedUserTypesAreReindexed()
+{
+	try
+	{
+		DatabaseModel model;
+		model.createSystemObjects(true);
+
+		Domain *dom = createDomain(model, "dom");
+		unsigned type_id = PgSqlType(dom).getTypeId();
+
+		dom->setName("dom_renamed");
+		QCOMPARE(PgSqlType::getUserTypeIndex("public.dom", nullptr, &model), PgSqlType::Null);
+		QCOMPARE(PgSqlType::getUserTypeIndex("public.dom_renamed", nullptr, &model), type_id);
+		QCOMPARE(~PgSqlType(dom), QString("public.dom_renamed"));
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void PgSqlTypeTest::modelsRegisterUserTypesConcurrently()
+{
+	static constexpr unsigned ThreadCount = 4, DomainCount = 200;
+	std::vector<std::thread> threads;
+	std::atomic<unsigned> failures(0);
+
+	for(unsigned thread_id = 0; thread_id < ThreadCount; thread_id++)
+	{
+		threads.emplace_back([&failures]() {
+			try
+			{
+				DatabaseModel model;
+				QStringList types;
+
+				model.createSystemObjects(true);
+
+				for(unsigned i = 0; i < DomainCount; i++)
+				{
+					Domain *dom = createDomain(model, QString("dom_%1").arg(i));
+
+					if(PgSqlType::getUserTypeIndex(dom->getName(true), nullptr, &model) != PgSqlType(dom).getTypeId() ||
+						 ~PgSqlType(dom) != dom->getName(true))
+						failures++;
+				}
+
+				PgSqlType::getUserTypes(types, &model, UserTypeConfig::AllUserTypes);
+
+				if(types.size() != DomainCount)
+					failures++;
+			}
+			catch(Exception &)
+			{
+				failures++;
+			}
+		});
+	}
+
+	for(auto &thread : threads)
+		thread.join();
+
+	QCOMPARE(failures.load(), 0u);
+}
+
+QTEST_MAIN(PgSqlTypeTest)
+#include "pgsqltypetest.moc"
@@ -0,0 +1,162 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2022 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "progressreporter.h"
+
+class ProgressReporterTest: public QObject {
+	private:
+		Q_OBJECT
+
+	private slots:
+		void throttlesUpdatesAndCountsDiscarded();
+		void alwaysReportsCompletion();
+		void registersItemsWithoutDiscarding();
+		void recordsNestedPhases();
+		void finishesPhaseOnException();
+		void discardsOldestPhasesWhenFull();
+};
+
+void ProgressReporterTest::throttlesUpdatesAndCountsDiscarded()
+{
+	ProgressReporter rep(1);
+	unsigned reported = 0;
+
+	for(int i = 0; i < 1000; i++)
+	{
+		if(rep.isReportDue(i / 20))
+			reported++;
+	}
+
+	// With one update per second only the first update of this fast loop is emitted
+	QCOMPARE(reported, 1u);
+	QCOMPARE(rep.getItemsCount(), 1000u);
+	QCOMPARE(rep.getDiscardedCount(), 999u);
+
+	rep.setMaxUpdatesPerSecond(0);
+	QVERIFY(rep.isReportDue(10));
+	QVERIFY(rep.isReportDue(10));
+}
+
+void ProgressReporterTest::alwaysReportsCompletion()
+{
+	ProgressReporter rep(1);
+
+	QVERIFY(rep.isReportDue(10));
+	QVERIFY(!rep.isReportDue(50));
+	QVERIFY(rep.isReportDue(100));
+}
+
+void ProgressReporterTest::registersItemsWithoutDiscarding()
+{
+	ProgressReporter rep(1);
+	std::vector<ProgressReporter::PhaseTiming> timings;
+
+	{
+		ProgressReporter::ScopedPhase phase(rep, "Log");
+
+		for(unsigned i = 0; i < 100; i++)
+			rep.registerItem();
+	}
+
+	timings = rep.getPhaseTimings();
+
+	QCOMPARE(rep.getItemsCount(), 100u);
+	QCOMPARE(rep.getDiscardedCount(), 0u);
+	QCOMPARE(timings.front().items, 100u);
+
+	// Registered items don't consume the rate limit
+	QVERIFY(rep.isReportDue(10));
+}
+
+void ProgressReporterTest::recordsNestedPhases()
+{
+	ProgressReporter rep;
+	std::vector<ProgressReporter::PhaseTiming> timings;
+
+	{
+		ProgressReporter::ScopedPhase load(rep, "Load");
+		rep.isReportDue(10);
+
+		{
+			ProgressReporter::ScopedPhase valid(rep, "Validate");
+			rep.isReportDue(20);
+			rep.isReportDue(30);
+		}
+	}
+
+	rep.beginPhase("Export");
+	timings = rep.getPhaseTimings();
+
+	QCOMPARE(timings.size(), static_cast<size_t>(3));
+	QCOMPARE(timings[0].name, QString("Load"));
+	QCOMPARE(timings[0].depth, 0u);
+	QCOMPARE(timings[0].items, 3u);
+	QCOMPARE(timings[1].name, QString("Validate"));
+	QCOMPARE(timings[1].depth, 1u);
+	QCOMPARE(timings[1].items, 2u);
+	QVERIFY(timings[0].elapsed >= timings[1].elapsed);
+	QCOMPARE(timings[2].name, QString("Export"));
+	QCOMPARE(timings[2].depth, 0u);
+
+	rep.reset();
+	QVERIFY(rep.getPhaseTimings().empty());
+	QCOMPARE(rep.getItemsCount(), 0u);
+}
+
+void ProgressReporterTest::finishesPhaseOnException()
+{
+	ProgressReporter rep;
+
+	try
+	{
+		ProgressReporter::ScopedPhase phase(rep, "Failing");
+		throw std::runtime_error("error");
+	}
+	catch(std::runtime_error &)
+	{}
+
+	rep.beginPhase("Next");
+	rep.endPhase();
+
+	QCOMPARE(rep.getPhaseTimings().size(), static_cast<size_t>(2));
+	QCOMPARE(rep.getPhaseTimings().at(1).depth, 0u);
+}
+
+void ProgressReporterTest::discardsOldestPhasesWhenFull()
+{
+	ProgressReporter rep;
+	std::vector<ProgressReporter::PhaseTiming> timings;
+
+	// Simulates a long-lived object running the same operation (with a nested phase) many times
+	for(unsigned i = 0; i < ProgressReporter::MaxStoredPhases * 4; i++)
+	{
+		ProgressReporter::ScopedPhase gen(rep, QString("Generate %1").arg(i));
+		ProgressReporter::ScopedPhase nested(rep, "Nested");
+	}
+
+	timings = rep.getPhaseTimings();
+
+	QVERIFY(timings.size() <= ProgressReporter::MaxStoredPhases);
+	QCOMPARE(timings.front().depth, 0u);
+	QCOMPARE(timings.at(timings.size() - 2).name, QString("Generate %1").arg(ProgressReporter::MaxStoredPhases * 4 - 1));
+	QCOMPARE(timings.back().depth, 1u);
+}
+
+QTEST_MAIN(ProgressReporterTest)
+#include "progressreportertest.moc"
@@ -0,0 +1,127 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2022 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "databasemodel.h"
+#include "pgmodelerunittest.h"
+
+class RelationshipTest: public QObject, public PgModelerUnitTest {
+	private:
+		Q_OBJECT
+
+		//! \brief Stores the SQL of the relationships and their receiver tables as well the objects generated by them
+		void getGeneratedObjects(DatabaseModel &dbmodel, QStringList &sql_defs, std::vector<TableObject *> &objects);
+
+	public:
+		RelationshipTest() : PgModelerUnitTest(SCHEMASDIR) {}
+
+	private slots:
+		void reconnectionReusesGeneratedObjects();
+};
+
+void RelationshipTest::getGeneratedObjects(DatabaseModel &dbmodel, QStringList &sql_defs, std::vector<TableObject *> &objects)
+{
+	Relationship *rel = nullptr;
+	PhysicalTable *recv_tab = nullptr;
+
+	sql_defs.clear();
+	objects.clear();
+
+	for(auto &obj : *dbmodel.getObjectList(ObjectType::Relationship))
+	{
+		rel = dynamic_cast<Relationship *>(obj);
+		recv_tab = rel->getReceiverTable();
+		sql_defs.append(rel->getCodeDefinition(SchemaParser::SqlDefinition));
+
+		/* The table generated by n-n relationships is destroyed on disconnection
+		 * along with its constraints, only its columns are reused */
+		if(rel->getRelationshipType() != BaseRelationship::RelationshipNn)
+			sql_defs.append(recv_tab->getCodeDefinition(SchemaParser::SqlDefinition));
+
+		for(auto &type : { ObjectType::Column, ObjectType::Constraint })
+		{
+			if(type == ObjectType::Constraint && rel->getRelationshipType() == BaseRelationship::RelationshipNn)
+				continue;
+
+			for(auto &tab_obj : *recv_tab->getObjectList(type))
+			{
+				// The relationship attributes and constraints are not regenerated, so they are ignored
+				if(tab_obj->isAddedByRelationship() && rel->getObjectIndex(tab_obj) < 0)
+					objects.push_back(tab_obj);
+			}
+		}
+	}
+}
+
+void RelationshipTest::reconnectionReusesGeneratedObjects()
+{
+	DatabaseModel dbmodel;
+	Table *table_one = new Table;
+	Column *col = new Column;
+	Relationship *rel = nullptr;
+	QStringList orig_sql, sql;
+	std::vector<TableObject *> orig_objs, objs;
+	std::vector<unsigned> orig_ids;
+
+	try
+	{
+		dbmodel.createSystemObjects(false);
+		dbmodel.loadModel(SAMPLESDIR + GlobalAttributes::DirSeparator + "demo.dbm");
+
+		// The demo model has no 1-1 relationship so one is created between table_a and a new table
+		table_one->setName("table_one");
+		table_one->setSchema(dbmodel.getSchema("public"));
+		col->setName("description");
+		col->setType(PgSqlType("text"));
+		table_one->addColumn(col);
+		dbmodel.addTable(table_one);
+
+		rel = new Relationship(BaseRelationship::Relationship11, dbmodel.getTable("public.table_a"), table_one);
+		dbmodel.addRelationship(rel);
+
+		getGeneratedObjects(dbmodel, orig_sql, orig_objs);
+
+		for(auto &obj : orig_objs)
+			orig_ids.push_back(obj->getObjectId());
+
+		// Reconnecting the relationships in the same way the model validation does
+		dbmodel.disconnectRelationships();
+
+		for(auto &obj : *dbmodel.getObjectList(ObjectType::Relationship))
+			dynamic_cast<Relationship *>(obj)->connectRelationship();
+
+		getGeneratedObjects(dbmodel, sql, objs);
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+
+	QCOMPARE(sql, orig_sql);
+	QVERIFY(!orig_objs.empty());
+	QCOMPARE(objs.size(), orig_objs.size());
+
+	for(unsigned idx = 0; idx < objs.size(); idx++)
+	{
+		QCOMPARE(objs[idx], orig_objs[idx]);
+		QVERIFY(objs[idx]->getObjectId() != orig_ids[idx]);
+	}
+}
+
+QTEST_MAIN(RelationshipTest)
+#include "relationshiptest.moc"
@@ -27,6 +27,7 @@ class SchemaParserTest: public QObject {
 		void testExpressionEvaluationWithCasts();
 		void testSetOperationInIf();
 		void testSetOperationUnderIfEvaluatedAsFalse();
+		void testProfilingCountsPerSourceLine();
 };
 
 void SchemaParserTest::testExpressionEvaluationWithCasts()
@@ -110,5 +111,47 @@ void SchemaParserTest::testSetOperationUnderIfEvaluatedAsFalse()
 	}
 }
 
+void SchemaParserTest::testProfilingCountsPerSourceLine()
+{
+	SchemaParser schparser;
+	QString buffer;
+	attribs_map attribs = {{ "a", "1" }, { "b", "value" }};
+	std::map<int, SchemaParser::LineProfile> profile;
+
+	buffer = "# comment\n";
+	buffer += "%if {a} %then\n";
+	buffer += " {b}\n";
+	buffer += "%end\n";
+	buffer += "%set {c} 10.0\n";
+
+	try
+	{
+		schparser.setProfilingEnabled(true);
+
+		for(unsigned i = 0; i < 2; i++)
+		{
+			schparser.loadBuffer(buffer);
+			QCOMPARE(schparser.getCodeDefinition(attribs).trimmed(), QString("value"));
+		}
+
+		profile = schparser.getProfile();
+
+		// Commented lines are not parsed so they must not appear in the profile
+		QCOMPARE(profile.count(1), 0);
+		QCOMPARE(profile[2].if_count, 2u);
+		QCOMPARE(profile[3].hits, 2u);
+		QCOMPARE(profile[3].attrib_count, 2u);
+		QCOMPARE(profile[3].alloc_count > 0, true);
+		QCOMPARE(profile[5].set_count, 2u);
+
+		schparser.clearProfile();
+		QCOMPARE(schparser.getProfile().empty(), true);
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
 QTEST_MAIN(SchemaParserTest)
 #include "schemaparsertest.moc"
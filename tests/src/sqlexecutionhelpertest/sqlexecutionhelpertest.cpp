@@ -0,0 +1,80 @@
+/*
+# PostgreSQL Database Modeler (pgModeler)
+#
+# Copyright 2006-2022 - Raphael Araújo e Silva <raphael@pgmodeler.io>
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation version 3.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# The complete text of GPLv3 is at LICENSE file on source code root directory.
+# Also, you can get the complete GNU General Public License at <http://www.gnu.org/licenses/>
+*/
+
+#include <QtTest/QtTest>
+#include "tools/sqlexecutionhelper.h"
+
+class SQLExecutionHelperTest: public QObject {
+	private:
+		Q_OBJECT
+
+	private slots:
+		void wrapsQueryInCopyCommand();
+		void copyCommandIgnoresTrailingSemicolonsAndComments();
+		void copyCommandRejectsMultipleStatements();
+};
+
+void SQLExecutionHelperTest::wrapsQueryInCopyCommand()
+{
+	QCOMPARE(SQLExecutionHelper::getCopyToCommand("SELECT * FROM public.table_a"),
+					 QString("COPY (SELECT * FROM public.table_a\n) TO STDOUT WITH (FORMAT csv, HEADER true, DELIMITER ';', FORCE_QUOTE *)"));
+}
+
+void SQLExecutionHelperTest::copyCommandIgnoresTrailingSemicolonsAndComments()
+{
+	QString cmd = SQLExecutionHelper::getCopyToCommand("  SELECT 1 ; ;\n");
+
+	QVERIFY(cmd.startsWith("COPY (SELECT 1\n)"));
+
+	cmd = SQLExecutionHelper::getCopyToCommand("SELECT 1 -- comment");
+	QVERIFY(cmd.startsWith("COPY (SELECT 1\n)"));
+
+	// Comments after the semicolon must not hide it from the stripping
+	cmd = SQLExecutionHelper::getCopyToCommand("SELECT 1; -- note\n/* other /* nested */ note */\n");
+	QVERIFY(cmd.startsWith("COPY (SELECT 1\n)"));
+
+	// Semicolons and comment markers inside quotes are part of the query
+	cmd = SQLExecutionHelper::getCopyToCommand("SELECT ';--', \"a;b\", $fn$ ; $fn$, E'\\';' -- x ;");
+	QVERIFY(cmd.startsWith("COPY (SELECT ';--', \"a;b\", $fn$ ; $fn$, E'\\';'\n)"));
+}
+
+void SQLExecutionHelperTest::copyCommandRejectsMultipleStatements()
+{
+	try
+	{
+		SQLExecutionHelper::getCopyToCommand("SELECT 1; SELECT 2;");
+		QFAIL("Query with multiple statements accepted!");
+	}
+	catch(Exception &e)
+	{
+		QCOMPARE(e.getErrorCode(), ErrorCode::MultipleStatementsExportQuery);
+	}
+
+	try
+	{
+		SQLExecutionHelper::getCopyToCommand("SELECT 1; /* comment */ DELETE FROM tab");
+		QFAIL("Query with multiple statements accepted!");
+	}
+	catch(Exception &e)
+	{
+		QCOMPARE(e.getErrorCode(), ErrorCode::MultipleStatementsExportQuery);
+	}
+}
+
+QTEST_MAIN(SQLExecutionHelperTest)
+#include "sqlexecutionhelpertest.moc"
@@ -0,0 +1,2 @@
+include(../../tests.pri)
+SOURCES += sqlexecutionhelpertest.cpp
\ No newline at end of file
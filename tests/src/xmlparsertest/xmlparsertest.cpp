@@ -25,6 +25,9 @@ class XmlParserTest: public QObject {
 
 	private slots:
 		void correctlyConvertJsonValsToXmlEntites();
+		void streamReadsRootChildrenInOrder();
+		void streamAppliesDtdDefaultsWithoutValidation();
+		void streamRaisesErrorOnInvalidDocument();
 };
 
 void XmlParserTest::correctlyConvertJsonValsToXmlEntites()
@@ -44,5 +47,127 @@ void XmlParserTest::correctlyConvertJsonValsToXmlEntites()
 	}
 }
 
+void XmlParserTest::streamReadsRootChildrenInOrder()
+{
+	QTemporaryFile file;
+	XmlParser parser;
+	attribs_map attribs;
+	QStringList names;
+
+	try
+	{
+		QVERIFY(file.open());
+		file.write("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+							 "<root version=\"1\">\n"
+							 "\t<item name=\"a\">\n\t\t<child name=\"a1\"/>\n\t</item>\n"
+							 "\t<!-- comment -->\n"
+							 "\t<item name=\"b\"/>\n"
+							 "</root>\n");
+		file.close();
+
+		parser.openXMLFileStream(file.fileName());
+		parser.getElementAttributes(attribs);
+		QCOMPARE(attribs["version"], QString("1"));
+
+		while(parser.readNextStreamElement())
+		{
+			parser.getElementAttributes(attribs);
+			names.append(attribs["name"]);
+
+			parser.savePosition();
+
+			if(parser.accessElement(XmlParser::ChildElement))
+			{
+				parser.getElementAttributes(attribs);
+				names.append(attribs["name"]);
+			}
+
+			parser.restorePosition();
+		}
+
+		QCOMPARE(names, QStringList({ "a", "a1", "b" }));
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void XmlParserTest::streamAppliesDtdDefaultsWithoutValidation()
+{
+	QTemporaryFile dtd_file, file;
+	XmlParser parser;
+	attribs_map attribs;
+	QStringList values;
+
+	try
+	{
+		QVERIFY(dtd_file.open());
+		dtd_file.write("<!ELEMENT root (item*)>\n"
+									 "<!ELEMENT item EMPTY>\n"
+									 "<!ATTLIST item name CDATA #REQUIRED>\n"
+									 "<!ATTLIST item protected (false|true) \"false\">\n");
+		dtd_file.close();
+
+		// The undeclared attribute "extra" is accepted since validation is disabled
+		QVERIFY(file.open());
+		file.write("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+							 "<root>\n"
+							 "\t<item name=\"a\" protected=\"true\"/>\n"
+							 "\t<item name=\"b\" extra=\"1\"/>\n"
+							 "</root>\n");
+		file.close();
+
+		parser.setDTDFile(dtd_file.fileName(), "root");
+		parser.setDTDValidation(false);
+		parser.openXMLFileStream(file.fileName());
+
+		while(parser.readNextStreamElement())
+		{
+			parser.getElementAttributes(attribs);
+			values.append(attribs["protected"]);
+		}
+
+		QCOMPARE(values, QStringList({ "true", "false" }));
+	}
+	catch(Exception &e)
+	{
+		QFAIL(e.getExceptionsText().toStdString().c_str());
+	}
+}
+
+void XmlParserTest::streamRaisesErrorOnInvalidDocument()
+{
+	QTemporaryFile dtd_file, file;
+	XmlParser parser;
+
+	QVERIFY(dtd_file.open());
+	dtd_file.write("<!ELEMENT root (item*)>\n"
+								 "<!ELEMENT item EMPTY>\n"
+								 "<!ATTLIST item name CDATA #REQUIRED>\n");
+	dtd_file.close();
+
+	QVERIFY(file.open());
+	file.write("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+						 "<root>\n"
+						 "\t<item name=\"a\"/>\n"
+						 "\t<item/>\n"
+						 "</root>\n");
+	file.close();
+
+	parser.setDTDFile(dtd_file.fileName(), "root");
+
+	try
+	{
+		parser.openXMLFileStream(file.fileName());
+		while(parser.readNextStreamElement());
+		QFAIL("The invalid document was not rejected!");
+	}
+	catch(Exception &e)
+	{
+		QCOMPARE(e.getErrorCode(), ErrorCode::LibXMLError);
+	}
+}
+
 QTEST_MAIN(XmlParserTest)
 #include "xmlparsertest.moc"
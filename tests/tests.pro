@@ -8,6 +8,7 @@ src/databasemodeltest \
 src/schemaparsertest \
 src/linenumberstest \
 src/partrelationshiptest \
+src/relationshiptest \
 src/foreigndatawrappertest \
 src/servertest \
 src/usermappingtest \
@@ -15,5 +16,14 @@ src/datadicttest \
 src/fileselectortest \
 src/transformtest \
 src/xmlparsertest \
+src/attribsmaptest \
+src/catalogtest \
+src/pgsqltypetest \
 src/proceduretest \
-src/basefunctiontest
+src/basefunctiontest \
+src/progressreportertest \
+src/bulkdatahelpertest \
+src/sqlexecutionhelpertest \
+src/modelexporthelpertest \
+src/csvreadertest \
+src/exceptiontest